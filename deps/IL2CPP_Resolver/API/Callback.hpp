@@ -48,24 +48,46 @@ namespace IL2CPP
 			}
 		}
 
-		void Initialize()
+		// Native MonoBehaviour vtable: from the engine module's RTTI first (no objects needed,
+		// works before the first scene), otherwise from a live MonoBehaviour in the scene
+		void** FindMonoBehaviourVTable()
 		{
+			HMODULE m_UnityPlayer = GetModuleHandleA(UNITY_PLAYER_MODULE);
+			void** m_VTable = Utils::RTTI::FindVTable(m_UnityPlayer ? m_UnityPlayer : GetModuleHandleA(nullptr), UNITY_MONOBEHAVIOUR_RTTI);
+			if (m_VTable)
+				return m_VTable;
+
 			void* m_IL2CPPThread = Thread::Attach(IL2CPP::Domain::Get());
+			Unity::CComponent* m_MonoBehaviour = IL2CPP::Helper::GetMonoBehaviour();
+			if (m_MonoBehaviour && m_MonoBehaviour->m_CachedPtr)
+				m_VTable = *reinterpret_cast<void***>(m_MonoBehaviour->m_CachedPtr);
+			IL2CPP::Thread::Detach(m_IL2CPPThread);
+
+			return m_VTable;
+		}
 
+		void Initialize()
+		{
 			// Find
-			void** m_MonoBehaviourVTable = *reinterpret_cast<void***>(IL2CPP::Helper::GetMonoBehaviour()->m_CachedPtr);
+			void** m_MonoBehaviourVTable = FindMonoBehaviourVTable();
 			if (m_MonoBehaviourVTable)
 			{
+				const Utils::VTable::Pattern_t m_Patterns[] =
+				{
 #ifdef _WIN64
-				OnUpdate::m_CallbackHook.m_VFunc		= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0x33, 0xD2, 0xE9 }); // xor edx, edx | jmp
-				OnLateUpdate::m_CallbackHook.m_VFunc	= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0xBA, 0x01, 0x00, 0x00, 0x00, 0xE9 }); //  mov edx, 1 | jmp
+					{ 0x33, 0xD2, 0xE9 },                   // xor edx, edx | jmp
+					{ 0xBA, 0x01, 0x00, 0x00, 0x00, 0xE9 }, // mov edx, 1 | jmp
 #elif _WIN32
-				OnUpdate::m_CallbackHook.m_VFunc		= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0x6A, 0x00, 0xE8 }); // push 00 | call
-				OnLateUpdate::m_CallbackHook.m_VFunc	= Utils::VTable::FindFunction(m_MonoBehaviourVTable, 99, { 0x6A, 0x01, 0xE8 }); // push 01 | call
+					{ 0x6A, 0x00, 0xE8 },                   // push 00 | call
+					{ 0x6A, 0x01, 0xE8 },                   // push 01 | call
 #endif
-			}
+				};
 
-			IL2CPP::Thread::Detach(m_IL2CPPThread);
+				void** m_Results[2] = {};
+				Utils::VTable::FindFunctions(m_MonoBehaviourVTable, 99, m_Patterns, 2, m_Results);
+				OnUpdate::m_CallbackHook.m_VFunc		= m_Results[0];
+				OnLateUpdate::m_CallbackHook.m_VFunc	= m_Results[1];
+			}
 
 			// Replace (Hook)
 			Utils::VTable::ReplaceFunction(OnUpdate::m_CallbackHook.m_VFunc, OnUpdate::Hook, &OnUpdate::m_CallbackHook.m_Original);
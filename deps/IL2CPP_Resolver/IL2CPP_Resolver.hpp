@@ -7,6 +7,7 @@
 #include <math.h>
 #include <vector>
 #include <unordered_map>
+#include <emmintrin.h>
 #include <Windows.h>
 
 // Application Defines
@@ -34,6 +35,11 @@
 	#define IL2CPP_MAIN_MODULE IL2CPP_RStr("GameAssembly.dll")
 #endif
 
+#ifndef UNITY_PLAYER_MODULE
+	// Native engine module (older players link it into the executable, see Callback::Initialize).
+	#define UNITY_PLAYER_MODULE IL2CPP_RStr("UnityPlayer.dll")
+#endif
+
 #include "Defines.hpp"
 
 // IL2CPP Headers
@@ -51,6 +57,7 @@
 // IL2CPP Utils
 #include "Utils/Hash.hpp"
 #include "Utils/VTable.hpp"
+#include "Utils/RTTI.hpp"
 
 // IL2CPP API Headers
 #include "API/Domain.hpp"
@@ -16,6 +16,9 @@ namespace Unity
 		void* m_GetTransform = nullptr;
 		void* m_SetActive = nullptr;
 		void* m_SetLayer = nullptr;
+
+		// Reusable List<Component> for GetComponentsInternal (set by the host, nullptr = allocate per call)
+		il2cppList<CComponent*>* m_pResultList = nullptr;
 	};
 	GameObjectFunctions_t m_GameObjectFunctions;
 
@@ -68,8 +71,22 @@ namespace Unity
 			return GetComponents(IL2CPP::Class::GetSystemType(m_pClass));
 		}
 
+		// Fills m_pResultList (cleared by Unity first) instead of allocating an array
+		void GetComponents(il2cppObject* m_pSystemType, il2cppList<CComponent*>* m_pResultList)
+		{
+			reinterpret_cast<void*(UNITY_CALLING_CONVENTION)(void*, void*, bool, bool, bool, bool, void*)>(m_GameObjectFunctions.m_GetComponents)(this, m_pSystemType, false, false, true, false, m_pResultList);
+		}
+
 		CComponent* GetComponentByIndex(il2cppObject* m_pSystemType, unsigned int m_uIndex = 0U)
 		{
+			if (il2cppList<CComponent*>* m_pList = m_GameObjectFunctions.m_pResultList)
+			{
+				GetComponents(m_pSystemType, m_pList);
+				if (m_uIndex >= static_cast<unsigned int>(m_pList->m_iSize)) return nullptr;
+
+				return m_pList->operator[](m_uIndex);
+			}
+
 			il2cppArray<CComponent*>* m_pComponents = GetComponents(m_pSystemType);
 			if (!m_pComponents || m_uIndex >= m_pComponents->m_uMaxLength) return nullptr;
 
@@ -43,6 +43,7 @@
 
 // MonoBehaviour
 #define UNITY_MONOBEHAVIOUR_CLASS                                   "UnityEngine.MonoBehaviour"
+#define UNITY_MONOBEHAVIOUR_RTTI                                    IL2CPP_RStr(".?AVMonoBehaviour@@")
 
 // Object
 #define UNITY_OBJECT_CLASS											"UnityEngine.Object"
@@ -91,7 +91,13 @@ namespace Unity
 	struct il2cppList : il2cppObject
 	{
 		il2cppArray<T>* m_pListArray;
+		int m_iSize;
+		int m_iVersion;
+		void* m_pSyncRoot;
 
 		il2cppArray<T>* ToArray() { return m_pListArray; }
+
+		// m_pListArray holds the capacity, only [0, m_iSize) is valid
+		T operator[](unsigned int m_uIndex) { return m_pListArray->operator[](m_uIndex); }
 	};
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#pragma once
+
+namespace IL2CPP
+{
+    namespace Utils
+    {
+        // Native vtables from MSVC RTTI: TypeDescriptor (.data) -> CompleteObjectLocator (.rdata)
+        // -> vtable whose slot [-1] points at the locator. Needs no live object of the class.
+        namespace RTTI
+        {
+            struct TypeDescriptor_t
+            {
+                const void* m_pVFTable;
+                void* m_pSpare;
+                char m_Name[1];
+            };
+
+            struct CompleteObjectLocator_t
+            {
+                uint32_t m_uSignature;
+                uint32_t m_uOffset;
+                uint32_t m_uCDOffset;
+#ifdef _WIN64
+                int32_t m_iTypeDescriptor;      // RVA
+                int32_t m_iClassDescriptor;     // RVA
+                int32_t m_iSelf;                // RVA
+#else
+                TypeDescriptor_t* m_pTypeDescriptor;
+                void* m_pClassDescriptor;
+#endif
+            };
+
+#ifdef _WIN64
+            static constexpr uint32_t m_uLocatorSignature = 1;
+#else
+            static constexpr uint32_t m_uLocatorSignature = 0;
+#endif
+
+            bool GetSection(HMODULE m_hModule, const char* m_Name, uint8_t** m_Begin, size_t* m_Size)
+            {
+                uint8_t* m_Base = reinterpret_cast<uint8_t*>(m_hModule);
+                IMAGE_DOS_HEADER* m_DosHeader = reinterpret_cast<IMAGE_DOS_HEADER*>(m_Base);
+                if (m_DosHeader->e_magic != IMAGE_DOS_SIGNATURE)
+                    return false;
+
+                IMAGE_NT_HEADERS* m_NtHeaders = reinterpret_cast<IMAGE_NT_HEADERS*>(m_Base + m_DosHeader->e_lfanew);
+                IMAGE_SECTION_HEADER* m_Section = IMAGE_FIRST_SECTION(m_NtHeaders);
+                for (WORD i = 0; m_NtHeaders->FileHeader.NumberOfSections > i; ++i, ++m_Section)
+                {
+                    if (strncmp(reinterpret_cast<const char*>(m_Section->Name), m_Name, IMAGE_SIZEOF_SHORT_NAME) == 0)
+                    {
+                        *m_Begin = m_Base + m_Section->VirtualAddress;
+                        *m_Size = m_Section->Misc.VirtualSize;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            // m_TypeName is the decorated name, e.g. ".?AVMonoBehaviour@@". Returns the primary vtable (offset 0)
+            void** FindVTable(HMODULE m_hModule, const char* m_TypeName)
+            {
+                uint8_t* m_Data = nullptr; size_t m_DataSize = 0;
+                uint8_t* m_RData = nullptr; size_t m_RDataSize = 0;
+                if (!m_hModule || !GetSection(m_hModule, ".data", &m_Data, &m_DataSize) || !GetSection(m_hModule, ".rdata", &m_RData, &m_RDataSize))
+                    return nullptr;
+
+                // TypeDescriptor is pointer-aligned, so its name is too
+                size_t m_NameSize = strlen(m_TypeName) + 1;
+                size_t m_NameOffset = offsetof(TypeDescriptor_t, m_Name);
+                TypeDescriptor_t* m_TypeDescriptor = nullptr;
+                for (size_t i = m_NameOffset; m_DataSize >= i + m_NameSize; i += sizeof(void*))
+                {
+                    if (m_Data[i] == m_TypeName[0] && memcmp(&m_Data[i], m_TypeName, m_NameSize) == 0)
+                    {
+                        m_TypeDescriptor = reinterpret_cast<TypeDescriptor_t*>(&m_Data[i - m_NameOffset]);
+                        break;
+                    }
+                }
+                if (!m_TypeDescriptor)
+                    return nullptr;
+
+                uint8_t* m_Base = reinterpret_cast<uint8_t*>(m_hModule);
+                CompleteObjectLocator_t* m_Locator = nullptr;
+                for (size_t i = 0; m_RDataSize >= i + sizeof(CompleteObjectLocator_t); i += sizeof(uint32_t))
+                {
+                    CompleteObjectLocator_t* m_Candidate = reinterpret_cast<CompleteObjectLocator_t*>(&m_RData[i]);
+                    if (m_Candidate->m_uSignature != m_uLocatorSignature || m_Candidate->m_uOffset != 0)
+                        continue;
+#ifdef _WIN64
+                    if (m_Base + m_Candidate->m_iTypeDescriptor != reinterpret_cast<uint8_t*>(m_TypeDescriptor) || m_Base + m_Candidate->m_iSelf != &m_RData[i])
+                        continue;
+#else
+                    if (m_Candidate->m_pTypeDescriptor != m_TypeDescriptor)
+                        continue;
+#endif
+                    m_Locator = m_Candidate;
+                    break;
+                }
+                if (!m_Locator)
+                    return nullptr;
+
+                for (size_t i = 0; m_RDataSize >= i + 2 * sizeof(void*); i += sizeof(void*))
+                {
+                    void** m_Slot = reinterpret_cast<void**>(&m_RData[i]);
+                    if (*m_Slot == m_Locator)
+                        return m_Slot + 1;
+                }
+
+                return nullptr;
+            }
+        }
+    }
+}
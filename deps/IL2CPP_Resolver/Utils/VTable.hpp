@@ -22,18 +22,61 @@ namespace IL2CPP
                 VirtualProtect(m_VTableFunc, sizeof(void*), m_OldProtection, &m_OldProtection);
             }
 
-            void** FindFunction(void** m_VTable, int m_Count, std::initializer_list<unsigned char> m_Opcodes)
+            // Prologue pattern, up to 16 bytes (compared against the first bytes of a function)
+            struct Pattern_t
             {
-                size_t m_OpcodeSize = m_Opcodes.size();
-                const void* m_OpcodesPtr = m_Opcodes.begin();
+                __m128i m_Bytes;
+                int m_Mask = 0;
 
-                for (int i = 0; m_Count > i; ++i)
+                Pattern_t(std::initializer_list<unsigned char> m_Opcodes)
                 {
-                    if (memcmp(m_VTable[i], m_OpcodesPtr, m_OpcodeSize) == 0)
-                        return &m_VTable[i];
+                    alignas(16) unsigned char m_Buffer[16] = {};
+                    size_t m_Size = (m_Opcodes.size() > sizeof(m_Buffer) ? sizeof(m_Buffer) : m_Opcodes.size());
+                    memcpy(m_Buffer, m_Opcodes.begin(), m_Size);
+
+                    m_Bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(m_Buffer));
+                    m_Mask = static_cast<int>((1u << m_Size) - 1u);
                 }
+            };
+
+            // Single pass over the table for all patterns: each function's prologue is loaded once
+            // and compared against every pattern with SSE2. m_Results[p] gets the first slot matching
+            // pattern p (nullptr if none). Returns the number of patterns found.
+            int FindFunctions(void** m_VTable, int m_Count, const Pattern_t* m_Patterns, int m_PatternCount, void*** m_Results)
+            {
+                int m_Pending = m_PatternCount;
+                for (int p = 0; m_PatternCount > p; ++p)
+                    m_Results[p] = nullptr;
+
+                for (int i = 0; m_Count > i && m_Pending; ++i)
+                {
+                    if (!m_VTable[i])
+                        continue;
+
+                    __m128i m_Prologue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_VTable[i]));
+                    for (int p = 0; m_PatternCount > p; ++p)
+                    {
+                        if (m_Results[p])
+                            continue;
 
-                return 0;
+                        int m_Equal = _mm_movemask_epi8(_mm_cmpeq_epi8(m_Prologue, m_Patterns[p].m_Bytes));
+                        if ((m_Equal & m_Patterns[p].m_Mask) == m_Patterns[p].m_Mask)
+                        {
+                            m_Results[p] = &m_VTable[i];
+                            --m_Pending;
+                        }
+                    }
+                }
+
+                return m_PatternCount - m_Pending;
+            }
+
+            void** FindFunction(void** m_VTable, int m_Count, std::initializer_list<unsigned char> m_Opcodes)
+            {
+                Pattern_t m_Pattern(m_Opcodes);
+                void** m_Result = nullptr;
+                FindFunctions(m_VTable, m_Count, &m_Pattern, 1, &m_Result);
+                return m_Result;
             }
         }
     }
@@ -6,7 +6,7 @@
 #pragma comment(lib, "dxgi.lib")
 
 // DLL Entry Point
-BOOL APIENTRY DllMain(HMODULE /*hModule*/, DWORD ul_reason_for_call, LPVOID /*lpReserved*/)
+BOOL APIENTRY DllMain(HMODULE /*hModule*/, DWORD ul_reason_for_call, LPVOID lpReserved)
 {
     switch (ul_reason_for_call)
     {
@@ -21,10 +21,15 @@ BOOL APIENTRY DllMain(HMODULE /*hModule*/, DWORD ul_reason_for_call, LPVOID /*lp
         }
         break;
     case DLL_PROCESS_DETACH:
-        // Cleanup console
-        Console::Cleanup();
-        // Cleanup render
-        CleanupRender();
+        {
+            // lpReserved != NULL: the process is exiting and Windows has already terminated
+            // every other thread; NULL: FreeLibrary, the threads are still running
+            bool processExit = lpReserved != nullptr;
+            // Cleanup console (writes what is left in the log ring)
+            Console::Cleanup(processExit);
+            // Cleanup render
+            CleanupRender(processExit);
+        }
         break;
     }
     return TRUE;
@@ -1,11 +1,21 @@
 #include "hook_render.h"
-#include "../deps/minhook/include/MinHook.h"
+#include "../modules/hooks/hooks.h"
 #include "../deps/imgui/imgui.h"
 #include "../deps/imgui/backends/imgui_impl_dx11.h"
 #include "../deps/imgui/backends/imgui_impl_win32.h"
 #include "../modules/watermark/watermark.h"
 #include "../modules/console/console.h"
-#include "../modules/il2cpp_api/IL2CPP_API.hpp"
+#include "../modules/il2cpp_api/il2cpp_runtime.h"
+#include "../modules/jobs/job_system.h"
+#include "../modules/input/input.h"
+#include "../modules/scheduler/scheduler.h"
+#include "../modules/perf/perf.h"
+#include "../modules/memory/memory.h"
+#include "../modules/anim/anim.h"
+#include "../modules/text/text_cache.h"
+#include "../modules/fonts/fonts.h"
+#include "../modules/objects/object_registry.h"
+#include "../modules/signatures/signatures.h"
 #include "../hud/hud.h"
 
 // Forward declare
@@ -19,7 +29,6 @@ ID3D11RenderTargetView* g_mainRenderTargetView = nullptr;
 bool g_ImGuiInitialized = false;
 HWND g_hWnd = nullptr;
 WNDPROC g_OriginalWndProc = nullptr;
-bool g_ShowMenu = false;
 
 // Function pointers
 typedef HRESULT(__stdcall* PresentFn)(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags);
@@ -28,9 +37,76 @@ typedef HRESULT(__stdcall* ResizeBuffersFn)(IDXGISwapChain* pSwapChain, UINT Buf
 static PresentFn oPresent = nullptr;
 static ResizeBuffersFn oResizeBuffers = nullptr;
 
+// cubixdlc.sigcache next to the DLL (empty if the path could not be built)
+static char g_SignatureCachePath[MAX_PATH] = {};
+
+// Forward window input to the render thread (drained once per frame in hkPresent)
+static void PushInputEvent(UINT msg, WPARAM wParam)
+{
+    Input::Event event = {};
+    switch (msg)
+    {
+    case WM_KEYDOWN:
+    case WM_SYSKEYDOWN:
+        event.type = Input::EventType::KeyDown;
+        event.code = (uint16_t)wParam;
+        break;
+    case WM_KEYUP:
+    case WM_SYSKEYUP:
+        event.type = Input::EventType::KeyUp;
+        event.code = (uint16_t)wParam;
+        break;
+    case WM_LBUTTONDOWN: case WM_LBUTTONDBLCLK:
+        event.type = Input::EventType::MouseDown;
+        event.code = Input::KEY_LBUTTON;
+        break;
+    case WM_RBUTTONDOWN: case WM_RBUTTONDBLCLK:
+        event.type = Input::EventType::MouseDown;
+        event.code = Input::KEY_RBUTTON;
+        break;
+    case WM_MBUTTONDOWN: case WM_MBUTTONDBLCLK:
+        event.type = Input::EventType::MouseDown;
+        event.code = Input::KEY_MBUTTON;
+        break;
+    case WM_LBUTTONUP:
+        event.type = Input::EventType::MouseUp;
+        event.code = Input::KEY_LBUTTON;
+        break;
+    case WM_RBUTTONUP:
+        event.type = Input::EventType::MouseUp;
+        event.code = Input::KEY_RBUTTON;
+        break;
+    case WM_MBUTTONUP:
+        event.type = Input::EventType::MouseUp;
+        event.code = Input::KEY_MBUTTON;
+        break;
+    case WM_MOUSEWHEEL:
+        event.type = Input::EventType::MouseWheel;
+        event.wheel = (int16_t)(GET_WHEEL_DELTA_WPARAM(wParam) / WHEEL_DELTA);
+        break;
+    case WM_KILLFOCUS:
+        event.type = Input::EventType::FocusLost;
+        break;
+    default:
+        return;
+    }
+    Input::PushEvent(event);
+}
+
+// Toggle menu ("Del" keybind)
+static void ToggleMenuAction(void*)
+{
+    g_ShowMenu = !g_ShowMenu;
+    
+    // Play sound when opening/closing HUD
+    Audio::Play(g_ShowMenu ? IDR_SOUND_ON : IDR_SOUND_OFF);
+}
+
 // WndProc hook
 LRESULT WINAPI HookedWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 {
+    PushInputEvent(msg, wParam);
+    
     if (g_ImGuiInitialized)
     {
         if (ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam))
@@ -56,6 +132,8 @@ HRESULT __stdcall hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
             g_pSwapChain = pSwapChain;
             
             // Initialize ImGui
+            // ImGui allocates from size-class pools instead of the game's heap
+            Memory::InstallImGuiAllocator();
             IMGUI_CHECKVERSION();
             ImGui::CreateContext();
             ImGuiIO& io = ImGui::GetIO();
@@ -63,14 +141,44 @@ HRESULT __stdcall hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
             
             ImGui::StyleColorsDark();
             
+            // Font glyphs come from the atlas baked at build time (no stb_truetype rasterization here)
+            const void* fontAtlas = nullptr;
+            size_t fontAtlasSize = 0;
+            LoadResourceData(IDR_FONT_ATLAS, &fontAtlas, &fontAtlasSize);
+            Fonts::AddOverlayFont(io.Fonts, fontAtlas, fontAtlasSize);
+            
             ImGui_ImplWin32_Init(g_hWnd);
             ImGui_ImplDX11_Init(g_pd3dDevice, g_pd3dDeviceContext);
             
+            // Toggle menu with "Del" key (VK_DELETE) unless the settings file binds another chord
+            Input::Binding menuBind;
+            menuBind.key = GetHUDSettings().menuKey;
+            menuBind.mods = GetHUDSettings().menuMods;
+            menuBind.action = ToggleMenuAction;
+            Input::Bind(menuBind);
+            
             // Initialize console after ImGui is ready
             Console::Initialize();
             
-            // Initialize IL2CPP API (writes to console)
-            IL2CPP_API::Initialize();
+            // Console commands for runtime introspection: perf, sched, alloc and overlay.* from Perf,
+            // the rest from the module they describe
+            Perf::RegisterCommands();
+            Anim::RegisterCommands();
+            Text::RegisterCommands();
+            Fonts::RegisterCommands();
+            Audio::RegisterCommands();
+            Settings::RegisterCommands();
+            Objects::RegisterCommands();
+            Signatures::RegisterCommands();
+            IL2CPP_API::Runtime::RegisterCommands();
+            
+            // Periodic HUD work runs as scheduler tasks (shown in the scheduler stats panel)
+            RegisterHUDTasks();
+            
+            // Initialize IL2CPP API (writes to console), then invalidate cached object
+            // handles on every scene change
+            if (IL2CPP_API::Runtime::Initialize())
+                Objects::WatchScenes();
             
             // Hook WndProc to handle window messages (only once)
             if (!g_OriginalWndProc)
@@ -93,47 +201,46 @@ HRESULT __stdcall hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
     
     if (g_ImGuiInitialized && g_pd3dDeviceContext && g_mainRenderTargetView)
     {
+        Memory::BeginFrame();
+        Perf::BeginFrame();
+        
         // Start ImGui frame
         ImGui_ImplDX11_NewFrame();
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
+        Perf::EndStage(Perf::Stage::NewFrame);
         
-        // Toggle menu with "Del" key (VK_DELETE)
-        static bool prevKeyState = false;
-        bool currentKeyState = (GetAsyncKeyState(VK_DELETE) & 0x8000) != 0;
-        if (currentKeyState && !prevKeyState)
-        {
-            bool wasOpen = g_ShowMenu;
-            g_ShowMenu = !g_ShowMenu;
-            
-            // Play sound when opening/closing HUD
-            if (g_ShowMenu && !wasOpen)
-            {
-                // HUD opened - play ON sound
-                PlaySoundResource(IDR_SOUND_ON);
-            }
-            else if (!g_ShowMenu && wasOpen)
-            {
-                // HUD closed - play OFF sound
-                PlaySoundResource(IDR_SOUND_OFF);
-            }
-        }
-        prevKeyState = currentKeyState;
+        // Dispatch keybinds for input received since the last frame
+        Input::ProcessEvents(ImGui::GetTime());
+        Perf::EndStage(Perf::Stage::Input);
         
         // Update console
         Console::Update();
+        Perf::EndStage(Perf::Stage::ConsoleUpdate);
+        
+        // Advance HUD/watermark animations (settled ones are skipped)
+        Anim::Update(ImGui::GetIO().DeltaTime);
+        Perf::EndStage(Perf::Stage::Animation);
+        
+        // Update modules registered with the scheduler (settings autosave included)
+        Scheduler::RunFrame();
+        Perf::EndStage(Perf::Stage::Modules);
         
         // Render watermark (always visible)
         RenderWatermark();
+        Perf::EndStage(Perf::Stage::Watermark);
         
         // Render HUD menu
         RenderHUD();
+        Perf::EndStage(Perf::Stage::HUD);
         
         // Render console (always visible, independent of menu)
         Console::Render();
+        Perf::EndStage(Perf::Stage::ConsoleRender);
         
         // Render ImGui
         ImGui::Render();
+        Perf::EndStage(Perf::Stage::ImGuiRender);
         
         // Save current render targets
         ID3D11RenderTargetView* pOldRTV = nullptr;
@@ -148,6 +255,9 @@ HRESULT __stdcall hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
         g_pd3dDeviceContext->OMSetRenderTargets(1, &pOldRTV, pOldDSV);
         if (pOldRTV) pOldRTV->Release();
         if (pOldDSV) pOldDSV->Release();
+        Perf::EndStage(Perf::Stage::Draw);
+        
+        Perf::EndFrame();
     }
     
     return oPresent(pSwapChain, SyncInterval, Flags);
@@ -180,14 +290,66 @@ HRESULT __stdcall hkResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount,
     return hr;
 }
 
+// Full path of a file in the DLL's directory
+static bool GetPathNextToModule(const char* fileName, char (&path)[MAX_PATH])
+{
+    HMODULE hSelf = nullptr;
+    if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+            (LPCSTR)&GetPathNextToModule, &hSelf) ||
+        !GetModuleFileNameA(hSelf, path, MAX_PATH))
+        return false;
+    
+    char* slash = strrchr(path, '\\');
+    if (!slash)
+        return false;
+    return strcpy_s(slash + 1, MAX_PATH - (slash + 1 - path), fileName) == 0;
+}
+
 // Thread function to initialize hooks
 DWORD WINAPI InitHookThread(LPVOID)
 {
+    // Persist console output to cubixdlc.log next to the DLL
+    char logPath[MAX_PATH] = {};
+    if (GetPathNextToModule("cubixdlc.log", logPath))
+        Console::StartFileSink(logPath);
+    
+    // Restore module states, panel layout and keybinds from cubixdlc.settings
+    char settingsPath[MAX_PATH] = {};
+    if (GetPathNextToModule("cubixdlc.settings", settingsPath))
+    {
+        Settings::Snapshot settings = CaptureHUDSettings();   // defaults
+        Settings::LoadResult result = Settings::Load(settingsPath, settings);
+        if (result == Settings::LoadResult::Corrupt)
+            Console::Warning("Settings: %s is damaged, using defaults", settingsPath);
+        else if (result == Settings::LoadResult::Unsupported)
+            Console::Warning("Settings: %s is from a newer version, changes will not be saved", settingsPath);
+        ApplyHUDSettings(settings);
+    }
+    
     // Wait a bit for the game to initialize
     Sleep(1000);
     
-    // Initialize MinHook
-    if (MH_Initialize() != MH_OK)
+    // Start worker threads for background work (snapshots, indexing, scanning)
+    Jobs::Initialize();
+    
+    // Code signatures are looked up in GameAssembly; results for the same game build
+    // are reused from cubixdlc.sigcache instead of rescanning
+    if (HMODULE gameAssembly = GetModuleHandleA("GameAssembly.dll"))
+        Signatures::SetDefaultImage(gameAssembly, "GameAssembly.dll");
+    if (GetPathNextToModule("cubixdlc.sigcache", g_SignatureCachePath))
+        Signatures::LoadCache(g_SignatureCachePath);
+    else
+        g_SignatureCachePath[0] = '\0';
+    
+    // Open the audio device and decode the UI sounds once (Play only queues a trigger)
+    if (Audio::Initialize())
+    {
+        Audio::LoadCueResource(IDR_SOUND_ON);
+        Audio::LoadCueResource(IDR_SOUND_OFF);
+    }
+    
+    // Initialize the hook manager (MinHook on Windows)
+    if (Hooks::Initialize() != Hooks::Status::Ok)
     {
         return 1;
     }
@@ -203,7 +365,7 @@ DWORD WINAPI InitHookThread(LPVOID)
     
     if (!RegisterClassExW(&wc))
     {
-        MH_Uninitialize();
+        Hooks::Shutdown();
         return 1;
     }
     
@@ -211,7 +373,7 @@ DWORD WINAPI InitHookThread(LPVOID)
     if (!hwnd)
     {
         UnregisterClassW(wc.lpszClassName, wc.hInstance);
-        MH_Uninitialize();
+        Hooks::Shutdown();
         return 1;
     }
     
@@ -247,7 +409,7 @@ DWORD WINAPI InitHookThread(LPVOID)
     {
         DestroyWindow(hwnd);
         UnregisterClassW(wc.lpszClassName, wc.hInstance);
-        MH_Uninitialize();
+        Hooks::Shutdown();
         return 1;
     }
     
@@ -266,22 +428,23 @@ DWORD WINAPI InitHookThread(LPVOID)
     UnregisterClassW(wc.lpszClassName, wc.hInstance);
     
     // Create hooks
-    if (MH_CreateHook(pPresent, &hkPresent, (LPVOID*)&oPresent) != MH_OK)
+    if (Hooks::Create(pPresent, (void*)&hkPresent, (void**)&oPresent) != Hooks::Status::Ok)
     {
-        MH_Uninitialize();
+        Hooks::Shutdown();
         return 1;
     }
     
-    if (MH_CreateHook(pResizeBuffers, &hkResizeBuffers, (LPVOID*)&oResizeBuffers) != MH_OK)
+    if (Hooks::Create(pResizeBuffers, (void*)&hkResizeBuffers, (void**)&oResizeBuffers) != Hooks::Status::Ok)
     {
-        MH_Uninitialize();
+        Hooks::Shutdown();
         return 1;
     }
     
-    // Enable hooks
-    if (MH_EnableHook(MH_ALL_HOOKS) != MH_OK)
+    // Enable both hooks in one batch: the game threads are frozen once
+    Hooks::QueueEnable(Hooks::ALL_HOOKS);
+    if (Hooks::ApplyQueued() != Hooks::Status::Ok)
     {
-        MH_Uninitialize();
+        Hooks::Shutdown();
         return 1;
     }
     
@@ -289,7 +452,7 @@ DWORD WINAPI InitHookThread(LPVOID)
 }
 
 // Cleanup
-void CleanupRender()
+void CleanupRender(bool processExit)
 {
     if (g_ImGuiInitialized)
     {
@@ -300,6 +463,7 @@ void CleanupRender()
         ImGui_ImplDX11_Shutdown();
         ImGui_ImplWin32_Shutdown();
         ImGui::DestroyContext();
+        Text::Reset();
         
         if (g_mainRenderTargetView)
             g_mainRenderTargetView->Release();
@@ -309,12 +473,27 @@ void CleanupRender()
             g_pd3dDevice->Release();
     }
     
-    // Disable and remove hooks
+    Input::Reset();
+    
+    // Stop worker threads and the audio device thread. Called from DllMain under the
+    // loader lock: these wait for the threads to leave their loops, never join them
+    Jobs::Shutdown(processExit);
+    Audio::Shutdown(processExit);
+    
+    // Write settings that changed less than Settings::SAVE_DELAY ago (the settings
+    // task samples the HUD a few times a second, so take the final state too)
+    Settings::Update(CaptureHUDSettings(), 0.0);
+    Settings::Shutdown(processExit);
+    
+    // Keep signature scan results for the next run
+    if (g_SignatureCachePath[0] && Signatures::GetCacheSize())
+        Signatures::SaveCache(g_SignatureCachePath);
+    
+    // Disable and remove hooks (lifecycle and scene hooks first)
     if (oPresent)
     {
-        MH_DisableHook(MH_ALL_HOOKS);
-        MH_RemoveHook(MH_ALL_HOOKS);
-        MH_Uninitialize();
+        Objects::Untrack();
+        Hooks::Shutdown();
     }
 }
 
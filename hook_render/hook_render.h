@@ -12,7 +12,6 @@ extern ID3D11RenderTargetView* g_mainRenderTargetView;
 extern bool g_ImGuiInitialized;
 extern HWND g_hWnd;
 extern WNDPROC g_OriginalWndProc;
-extern bool g_ShowMenu;
 
 // Hook initialization
 DWORD WINAPI InitHookThread(LPVOID);
@@ -24,6 +23,7 @@ HRESULT __stdcall hkResizeBuffers(IDXGISwapChain* pSwapChain, UINT BufferCount,
 // WndProc hook
 LRESULT WINAPI HookedWndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
 
-// Cleanup
-void CleanupRender();
+// Cleanup. processExit: DLL_PROCESS_DETACH at process exit (lpReserved != NULL) - the other
+// threads are already terminated, so nothing waits for them
+void CleanupRender(bool processExit = false);
 
@@ -1,42 +1,46 @@
 #include "hud.h"
 #include "../deps/imgui/imgui.h"
-#include "../hook_render/hook_render.h"
 #include "../modules/watermark/watermark.h"
 #include "../modules/console/console.h"
+#include "../modules/scheduler/scheduler.h"
+#include "../modules/memory/memory.h"
+#include "../modules/anim/anim.h"
+#include "../modules/text/text_cache.h"
 #include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <vector>
 #include <string>
-#include <map>
 #include <algorithm>
-#include <windows.h>
-#include <mmsystem.h>
-#pragma comment(lib, "winmm.lib")
 
 // Module structure
 struct Module {
     std::string name;
     bool enabled;
     bool expanded;
+    Anim::Handle expandAnim;  // Settings expand progress (0..1)
     std::vector<std::string> settings;
     
-    Module(const char* n) : name(n), enabled(false), expanded(false) {}
+    Module(const char* n) : name(n), enabled(false), expanded(false), expandAnim(Anim::INVALID_HANDLE) {}
 };
 
 // Category structure
 struct Category {
     std::string name;
     std::vector<Module> modules;
-    float scrollOffset;
-    float scrollTarget;
+    Anim::Handle scrollAnim;  // Scroll offset, animated towards the wheel target
     float posX;
     float posY;
     bool isDragging;
     float dragOffsetX;
     float dragOffsetY;
     
-    Category(const char* n) : name(n), scrollOffset(0.0f), scrollTarget(0.0f), posX(0.0f), posY(0.0f), isDragging(false), dragOffsetX(0.0f), dragOffsetY(0.0f) {}
+    Category(const char* n) : name(n), scrollAnim(Anim::INVALID_HANDLE), posX(0.0f), posY(0.0f), isDragging(false), dragOffsetX(0.0f), dragOffsetY(0.0f) {}
 };
 
+// Menu visibility (toggled with "Del")
+bool g_ShowMenu = false;
+
 // Global categories
 static std::vector<Category> g_Categories;
 static bool g_CategoriesInitialized = false;
@@ -52,32 +56,55 @@ const float SCROLL_AREA_Y_OFFSET = TITLE_MARGIN_TOP + TITLE_HEIGHT;
 const float SCROLL_AREA_HEIGHT = PANEL_HEIGHT - SCROLL_AREA_Y_OFFSET - 7.5f;  // 5 * 1.5
 const float SCROLL_SPEED = 18.0f;  // 12 * 1.5
 const float SCROLL_LERP_FACTOR = 20.0f;
+const float EXPAND_SPEED = 15.0f;
+const float SETTING_HEIGHT = 27.0f;  // 18 * 1.5
+const float GRID_CELL_SIZE = 128.0f;
+const float SETTINGS_TASK_RATE = 10.0f;  // Hz; the save itself waits for Settings::SAVE_DELAY
+
+// Row geometry of one module, relative to the top of its panel's scroll area
+struct RowLayout {
+    float top;     // Prefix sum of the heights of the rows above
+    float height;  // FUNCTION_HEIGHT + expanded settings
+};
+
+// Slice of g_Rows that belongs to one panel
+struct PanelLayout {
+    int firstRow;
+    int rowCount;
+    float contentHeight;
+    float maxScroll;
+};
+
+// Flat layout of all panels, rebuilt only while an expand animation is running
+static std::vector<RowLayout> g_Rows;
+static std::vector<PanelLayout> g_PanelLayouts;
+static bool g_LayoutDirty = true;
+
+// Uniform grid over the screen: indices of the panels overlapping each cell,
+// ascending (cell c owns g_GridPanels[g_GridStart[c] .. g_GridStart[c + 1]))
+static std::vector<int> g_GridStart;
+static std::vector<int> g_GridPanels;
+static int g_GridWidth = 0;
+static int g_GridHeight = 0;
+static bool g_GridDirty = true;
+
+// HUD settings
+static HUDSettings g_HUDSettings;
 
-// Animation progress for modules
-static std::map<std::string, float> g_ExpandProgress;
+// Saved state (ApplyHUDSettings) and the live state in the same layout (CaptureHUDSettings)
+static Settings::Snapshot g_SavedSettings = {};
+static Settings::Snapshot g_CurrentSettings = {};
+
+HUDSettings& GetHUDSettings()
+{
+    return g_HUDSettings;
+}
 
 // Purple color for enabled modules
 static ImU32 GetPurpleColor() {
     return IM_COL32(147, 51, 234, 255); // Purple color
 }
 
-// Play sound from embedded resources
-void PlaySoundResource(int resourceId)
-{
-    HMODULE hModule = GetModuleHandleA("cubixdlc.dll");
-    if (!hModule)
-    {
-        // Fallback: get module from current address
-        GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
-            (LPCSTR)&PlaySoundResource, &hModule);
-    }
-    
-    if (hModule)
-    {
-        PlaySoundA(MAKEINTRESOURCEA(resourceId), hModule, SND_RESOURCE | SND_ASYNC | SND_NODEFAULT);
-    }
-}
-
 // Initialize categories
 void InitializeCategories()
 {
@@ -141,7 +168,7 @@ void InitializeCategories()
     visual.posY = startY;
     Module watermarkMod("Watermark");
     watermarkMod.settings.push_back("Show FPS");
-    watermarkMod.enabled = true; // Watermark enabled by default
+    watermarkMod.enabled = GetWatermarkSettings().enabled; // Mirrors WatermarkSettings (saved with the overlay settings)
     visual.modules.push_back(watermarkMod);
     g_Categories.push_back(visual);
     
@@ -149,44 +176,169 @@ void InitializeCategories()
     totalWidth = 6 * (PANEL_WIDTH + PANEL_MARGIN) - PANEL_MARGIN;
     startX = (screenSize.x - totalWidth) * 0.5f;
     
-    // Recalculate positions for all categories
+    // Recalculate positions for all categories and create their animations
     for (size_t i = 0; i < g_Categories.size(); i++)
     {
         g_Categories[i].posX = startX + i * (PANEL_WIDTH + PANEL_MARGIN);
+        g_Categories[i].scrollAnim = Anim::CreateFollow(0.0f, SCROLL_LERP_FACTOR);
+        for (auto& mod : g_Categories[i].modules)
+            mod.expandAnim = Anim::CreateFollow(0.0f, EXPAND_SPEED);
+    }
+    
+    // Saved positions, scroll and module states replace the defaults above
+    for (auto& cat : g_Categories)
+    {
+        uint32_t catHash = Settings::HashName(cat.name.c_str());
+        if (const Settings::PanelRecord* panel = Settings::FindPanel(g_SavedSettings, catHash))
+        {
+            cat.posX = (std::max)(0.0f, (std::min)(screenSize.x - PANEL_WIDTH, panel->posX));
+            cat.posY = (std::max)(0.0f, (std::min)(screenSize.y - PANEL_HEIGHT, panel->posY));
+            Anim::SetValue(cat.scrollAnim, panel->scroll);
+        }
+        
+        for (auto& mod : cat.modules)
+        {
+            const Settings::ModuleRecord* saved = Settings::FindModule(g_SavedSettings, Settings::HashName(mod.name.c_str(), catHash));
+            if (!saved || mod.name == "Watermark")
+                continue;
+            mod.enabled = saved->enabled != 0;
+            mod.expanded = saved->expanded != 0 && !mod.settings.empty();
+            Anim::SetValue(mod.expandAnim, mod.expanded ? 1.0f : 0.0f);
+        }
     }
     
     g_CategoriesInitialized = true;
 }
 
-// Update expand animation
-float UpdateExpandAnimation(const std::string& moduleName, bool expanded)
+// Recompute row heights and their prefix sums for every panel
+void UpdateLayout()
 {
-    float target = expanded ? 1.0f : 0.0f;
-    float current = g_ExpandProgress[moduleName];
-    current = current + (target - current) * 15.0f * ImGui::GetIO().DeltaTime;
-    if (fabsf(target - current) < 0.001f) current = target;
-    g_ExpandProgress[moduleName] = current;
-    return current;
+    if (!g_LayoutDirty)
+        return;
+    
+    g_LayoutDirty = false;
+    size_t rowCount = 0;
+    for (const auto& cat : g_Categories)
+        rowCount += cat.modules.size();
+    g_Rows.resize(rowCount);
+    g_PanelLayouts.resize(g_Categories.size());
+    
+    int row = 0;
+    for (size_t i = 0; i < g_Categories.size(); i++)
+    {
+        PanelLayout& panel = g_PanelLayouts[i];
+        panel.firstRow = row;
+        panel.rowCount = (int)g_Categories[i].modules.size();
+        
+        float top = 0.0f;
+        for (const auto& mod : g_Categories[i].modules)
+        {
+            // Keep rebuilding until the expand animation settles
+            if (Anim::IsAwake(mod.expandAnim))
+                g_LayoutDirty = true;
+            
+            float settingsHeight = mod.settings.size() * SETTING_HEIGHT * Anim::Get(mod.expandAnim);
+            g_Rows[row].top = top;
+            g_Rows[row].height = FUNCTION_HEIGHT + settingsHeight;
+            top += g_Rows[row].height;
+            row++;
+        }
+        
+        panel.contentHeight = top;
+        panel.maxScroll = (std::max)(0.0f, top - SCROLL_AREA_HEIGHT);
+    }
+}
+
+// First row of the panel whose bottom is at or below contentY (binary search)
+int FirstRowBelow(const PanelLayout& panel, float contentY)
+{
+    const RowLayout* begin = g_Rows.data() + panel.firstRow;
+    const RowLayout* end = begin + panel.rowCount;
+    const RowLayout* it = std::partition_point(begin, end, [contentY](const RowLayout& row) {
+        return row.top + row.height < contentY;
+    });
+    return (int)(it - g_Rows.data());
+}
+
+// Row containing contentY, -1 if none
+int FindRow(const PanelLayout& panel, float contentY)
+{
+    int row = FirstRowBelow(panel, contentY);
+    if (row >= panel.firstRow + panel.rowCount || contentY < g_Rows[row].top)
+        return -1;
+    return row;
 }
 
-// Calculate max scroll for category
-float CalculateMaxScroll(const Category& cat)
+// Rebuild the panel grid after a drag or a display size change
+void UpdateGrid(ImVec2 screenSize)
 {
-    float totalHeight = 0.0f;
-    for (const auto& mod : cat.modules)
+    int width = (std::max)(1, (int)ceilf(screenSize.x / GRID_CELL_SIZE));
+    int height = (std::max)(1, (int)ceilf(screenSize.y / GRID_CELL_SIZE));
+    if (!g_GridDirty && width == g_GridWidth && height == g_GridHeight)
+        return;
+    
+    g_GridDirty = false;
+    g_GridWidth = width;
+    g_GridHeight = height;
+    g_GridStart.assign(width * height + 1, 0);
+    
+    // Two passes: count panels per cell, then fill in index order
+    for (int pass = 0; pass < 2; pass++)
     {
-        float prog = g_ExpandProgress[mod.name];
-        float settingsHeight = mod.settings.size() * 27.0f * prog;  // 18 * 1.5
-        totalHeight += FUNCTION_HEIGHT + settingsHeight;
+        if (pass == 1)
+        {
+            for (int c = 0; c < width * height; c++)
+                g_GridStart[c + 1] += g_GridStart[c];
+            g_GridPanels.resize(g_GridStart[width * height]);
+        }
+        
+        for (size_t i = 0; i < g_Categories.size(); i++)
+        {
+            int x0 = (std::max)(0, (int)(g_Categories[i].posX / GRID_CELL_SIZE));
+            int y0 = (std::max)(0, (int)(g_Categories[i].posY / GRID_CELL_SIZE));
+            int x1 = (std::min)(width - 1, (int)((g_Categories[i].posX + PANEL_WIDTH) / GRID_CELL_SIZE));
+            int y1 = (std::min)(height - 1, (int)((g_Categories[i].posY + PANEL_HEIGHT) / GRID_CELL_SIZE));
+            
+            for (int y = y0; y <= y1; y++)
+            {
+                for (int x = x0; x <= x1; x++)
+                {
+                    int cell = y * width + x;
+                    if (pass == 0)
+                        g_GridStart[cell + 1]++;
+                    else
+                        g_GridPanels[g_GridStart[cell]++] = (int)i;
+                }
+            }
+        }
     }
-    float maxScroll = totalHeight - SCROLL_AREA_HEIGHT;
-    return (std::max)(0.0f, maxScroll);
+    
+    // The fill pass advanced every start to the next cell's start
+    for (int c = width * height; c > 0; c--)
+        g_GridStart[c] = g_GridStart[c - 1];
+    g_GridStart[0] = 0;
+}
+
+// Panels that may contain pos, in index order
+const int* PanelsAt(ImVec2 pos, int& count)
+{
+    count = 0;
+    UpdateGrid(ImGui::GetIO().DisplaySize);
+    
+    int x = (int)floorf(pos.x / GRID_CELL_SIZE);
+    int y = (int)floorf(pos.y / GRID_CELL_SIZE);
+    if (x < 0 || y < 0 || x >= g_GridWidth || y >= g_GridHeight)
+        return nullptr;
+    
+    int cell = y * g_GridWidth + x;
+    count = g_GridStart[cell + 1] - g_GridStart[cell];
+    return g_GridPanels.data() + g_GridStart[cell];
 }
 
 // Render scrollbar
-void RenderScrollbar(ImDrawList* draw_list, float x, float y, const Category& cat)
+void RenderScrollbar(ImDrawList* draw_list, float x, float y, const Category& cat, const PanelLayout& layout)
 {
-    float maxScroll = CalculateMaxScroll(cat);
+    float maxScroll = layout.maxScroll;
     if (maxScroll <= 0.0f) return;
     
     float scrollbarWidth = 4.5f;  // 3 * 1.5
@@ -199,7 +351,7 @@ void RenderScrollbar(ImDrawList* draw_list, float x, float y, const Category& ca
     draw_list->AddRectFilled(ImVec2(scrollbarX, scrollbarY), ImVec2(scrollbarX + scrollbarWidth, scrollbarY + scrollbarHeight), bgColor, 1.0f);
     
     // Scrollbar thumb
-    float scrollProgress = cat.scrollOffset / maxScroll;
+    float scrollProgress = Anim::Get(cat.scrollAnim) / maxScroll;
     float thumbHeight = (std::max)(6.0f, scrollbarHeight * (SCROLL_AREA_HEIGHT / (SCROLL_AREA_HEIGHT + maxScroll)));
     float thumbY = scrollbarY + scrollProgress * (scrollbarHeight - thumbHeight);
     
@@ -208,7 +360,7 @@ void RenderScrollbar(ImDrawList* draw_list, float x, float y, const Category& ca
 }
 
 // Render panel
-void RenderPanel(ImDrawList* draw_list, float x, float y, Category& cat, float)
+void RenderPanel(ImDrawList* draw_list, float x, float y, Category& cat, const PanelLayout& layout)
 {
     // Panel background (Exosware dark color: 17, 15, 28)
     ImU32 panelColor = IM_COL32(17, 15, 28, 200);
@@ -221,35 +373,35 @@ void RenderPanel(ImDrawList* draw_list, float x, float y, Category& cat, float)
     // Title
     ImFont* font = ImGui::GetFont();
     float font_size = ImGui::GetFontSize();
-    ImVec2 titleSize = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, cat.name.c_str());
+    ImVec2 titleSize = Text::Measure(font, font_size, cat.name.c_str());
     ImVec2 titlePos = ImVec2(x + (PANEL_WIDTH - titleSize.x) * 0.5f, y + TITLE_MARGIN_TOP + 3.0f);  // 2 * 1.5
-    draw_list->AddText(font, font_size, titlePos, IM_COL32(255, 255, 255, 255), cat.name.c_str());
+    Text::Draw(draw_list, font, font_size, titlePos, IM_COL32(255, 255, 255, 255), cat.name.c_str());
     
-    // Update scroll
-    cat.scrollOffset = cat.scrollOffset + (cat.scrollTarget - cat.scrollOffset) * SCROLL_LERP_FACTOR * ImGui::GetIO().DeltaTime;
-    float maxScroll = CalculateMaxScroll(cat);
-    cat.scrollTarget = (std::max)(0.0f, (std::min)(cat.scrollTarget, maxScroll));
-    cat.scrollOffset = (std::max)(0.0f, (std::min)(cat.scrollOffset, maxScroll));
+    // Clamp scroll (the offset itself is advanced by Anim::Update)
+    float maxScroll = layout.maxScroll;
+    float scrollTarget = (std::max)(0.0f, (std::min)(Anim::GetTarget(cat.scrollAnim), maxScroll));
+    if (Anim::Get(cat.scrollAnim) > maxScroll)
+        Anim::SetValue(cat.scrollAnim, maxScroll);
+    Anim::SetTarget(cat.scrollAnim, scrollTarget);
     
     // Render scrollbar
-    RenderScrollbar(draw_list, x, y, cat);
+    RenderScrollbar(draw_list, x, y, cat, layout);
     
-    // Render modules
-    float currentY = y + SCROLL_AREA_Y_OFFSET - cat.scrollOffset;
-    ImVec2 clipMin = ImVec2(x, y + SCROLL_AREA_Y_OFFSET);
-    ImVec2 clipMax = ImVec2(x + PANEL_WIDTH, y + SCROLL_AREA_Y_OFFSET + SCROLL_AREA_HEIGHT);
+    // Render visible modules only: the first one is found by binary search over the row prefix sums
+    float scrollOffset = Anim::Get(cat.scrollAnim);
+    float areaY = y + SCROLL_AREA_Y_OFFSET - scrollOffset;
     
-    for (auto& mod : cat.modules)
+    int endRow = layout.firstRow + layout.rowCount;
+    for (int row = FirstRowBelow(layout, scrollOffset); row < endRow; row++)
     {
-        float prog = UpdateExpandAnimation(mod.name, mod.expanded);
-        float settingsHeight = mod.settings.size() * 27.0f * prog;  // 18 * 1.5
-        float totalHeight = FUNCTION_HEIGHT + settingsHeight;
+        float currentY = areaY + g_Rows[row].top;
+        if (currentY > y + PANEL_HEIGHT)
+            break;
         
-        if (currentY + totalHeight < y + SCROLL_AREA_Y_OFFSET || currentY > y + PANEL_HEIGHT)
-        {
-            currentY += totalHeight;
-            continue;
-        }
+        Module& mod = cat.modules[row - layout.firstRow];
+        float prog = Anim::Get(mod.expandAnim);
+        float totalHeight = g_Rows[row].height;
+        float settingsHeight = totalHeight - FUNCTION_HEIGHT;
         
         // Module background (if enabled) - purple fill
         ImU32 purpleColor = GetPurpleColor();
@@ -263,7 +415,7 @@ void RenderPanel(ImDrawList* draw_list, float x, float y, Category& cat, float)
         // Module name - white text if enabled, gray if disabled
         ImVec2 textPos = ImVec2(x + 15, currentY + 4.5f);  // 10 * 1.5, 3 * 1.5
         ImU32 textColor = mod.enabled ? IM_COL32(255, 255, 255, 255) : IM_COL32(198, 198, 198, 255);
-        draw_list->AddText(font, font_size, textPos, textColor, mod.name.c_str());
+        Text::Draw(draw_list, font, font_size, textPos, textColor, mod.name.c_str());
         
         // Arrow for expandable modules
         if (!mod.settings.empty())
@@ -285,7 +437,7 @@ void RenderPanel(ImDrawList* draw_list, float x, float y, Category& cat, float)
             for (size_t i = 0; i < mod.settings.size(); i++)
             {
                 float alpha = prog;
-                float settingLineY = settingY + i * 27.0f;  // 18 * 1.5
+                float settingLineY = settingY + i * SETTING_HEIGHT;
                 ImVec2 settingPos = ImVec2(x + 37.5f, settingLineY + 3.0f);  // 25 * 1.5, 2 * 1.5
                 ImU32 settingColor = IM_COL32(200, 200, 200, (int)(255 * alpha));
                 
@@ -314,11 +466,85 @@ void RenderPanel(ImDrawList* draw_list, float x, float y, Category& cat, float)
                     draw_list->AddLine(p2, p3, IM_COL32(255, 255, 255, (int)(255 * alpha)), checkThickness);
                 }
                 
-                draw_list->AddText(font, font_size * 0.85f, settingPos, settingColor, mod.settings[i].c_str());
+                Text::Draw(draw_list, font, font_size * 0.85f, settingPos, settingColor, mod.settings[i].c_str());
             }
         }
+    }
+}
+
+// Render per-module scheduler timings (bottom-left corner)
+void RenderSchedulerStats(ImDrawList* draw_list, ImVec2 screenSize)
+{
+    int taskCount = Scheduler::GetTaskCount();
+    if (taskCount == 0)
+        return;
+    
+    ImFont* font = ImGui::GetFont();
+    float font_size = ImGui::GetFontSize();
+    const float padding = 9.0f;  // 6 * 1.5
+    const float lineHeight = font_size + 3.0f;  // 2 * 1.5
+    const float width = 420.0f;  // 280 * 1.5
+    float height = padding * 2 + lineHeight * (taskCount + 1);
+    
+    ImVec2 bgMin = ImVec2(15.0f, screenSize.y - height - 15.0f);
+    ImVec2 bgMax = ImVec2(bgMin.x + width, bgMin.y + height);
+    draw_list->AddRectFilled(bgMin, bgMax, IM_COL32(17, 15, 28, 200), 9.0f);
+    draw_list->AddRect(bgMin, bgMax, IM_COL32(40, 40, 50, 150), 9.0f, 0, 1.5f);
+    
+    char line[128];
+    const Scheduler::FrameStats& frame = Scheduler::GetFrameStats();
+    snprintf(line, sizeof(line), "Scheduler  %.2f / %.2f ms  run %d  deferred %d",
+        frame.spentMs, frame.budgetMs, frame.executed, frame.deferred);
+    float textY = bgMin.y + padding;
+    draw_list->AddText(font, font_size, ImVec2(bgMin.x + padding, textY), IM_COL32(255, 255, 255, 255), line);
+    
+    for (int i = 0; i < taskCount; i++)
+    {
+        const Scheduler::TaskStats& stats = Scheduler::GetTaskStats(i);
+        snprintf(line, sizeof(line), "%-14s avg %.3f  max %.3f ms  runs %llu  def %llu",
+            stats.name, stats.avgMs, stats.maxMs,
+            (unsigned long long)stats.runs, (unsigned long long)stats.deferrals);
         
-        currentY += totalHeight;
+        textY += lineHeight;
+        ImU32 color = stats.enabled ? IM_COL32(198, 198, 198, 255) : IM_COL32(198, 198, 198, 100);
+        draw_list->AddText(font, font_size, ImVec2(bgMin.x + padding, textY), color, line);
+    }
+}
+
+// Render per-frame allocation counters (bottom-right corner)
+void RenderMemoryStats(ImDrawList* draw_list, ImVec2 screenSize)
+{
+    const Memory::FrameStats& stats = Memory::GetFrameStats();
+    
+    ImFont* font = ImGui::GetFont();
+    float font_size = ImGui::GetFontSize();
+    const float padding = 9.0f;  // 6 * 1.5
+    const float lineHeight = font_size + 3.0f;  // 2 * 1.5
+    const float width = 330.0f;  // 220 * 1.5
+    const int lineCount = 4;
+    float height = padding * 2 + lineHeight * lineCount;
+    
+    ImVec2 bgMax = ImVec2(screenSize.x - 15.0f, screenSize.y - 15.0f);
+    ImVec2 bgMin = ImVec2(bgMax.x - width, bgMax.y - height);
+    draw_list->AddRectFilled(bgMin, bgMax, IM_COL32(17, 15, 28, 200), 9.0f);
+    draw_list->AddRect(bgMin, bgMax, IM_COL32(40, 40, 50, 150), 9.0f, 0, 1.5f);
+    
+    char lines[lineCount][96];
+    snprintf(lines[0], sizeof(lines[0]), "Memory / frame");
+    snprintf(lines[1], sizeof(lines[1]), "heap   %llu alloc  %llu B",
+        (unsigned long long)stats.heapAllocations, (unsigned long long)stats.heapBytes);
+    snprintf(lines[2], sizeof(lines[2]), "imgui  %llu alloc  %llu B  (%llu malloc)",
+        (unsigned long long)stats.poolAllocations, (unsigned long long)stats.poolBytes,
+        (unsigned long long)stats.poolHeapAllocations);
+    snprintf(lines[3], sizeof(lines[3]), "arena  %llu alloc  %zu / %zu KB",
+        (unsigned long long)stats.arenaAllocations, stats.arenaBytes / 1024, stats.arenaCapacity / 1024);
+    
+    float textY = bgMin.y + padding;
+    for (int i = 0; i < lineCount; i++)
+    {
+        ImU32 color = i == 0 ? IM_COL32(255, 255, 255, 255) : IM_COL32(198, 198, 198, 255);
+        draw_list->AddText(font, font_size, ImVec2(bgMin.x + padding, textY), color, lines[i]);
+        textY += lineHeight;
     }
 }
 
@@ -328,10 +554,7 @@ void RenderHUD()
         return;
     
     InitializeCategories();
-    
-    static float time = 0.0f;
-    time += ImGui::GetIO().DeltaTime;
-    if (time > 100.0f) time = 0.0f;
+    UpdateLayout();
     
     ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
     ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
@@ -353,15 +576,18 @@ void RenderHUD()
     if (ImGui::IsMouseClicked(0))
     {
         // Check if clicking on title bar to start dragging
-        for (size_t i = 0; i < g_Categories.size(); i++)
+        int candidateCount = 0;
+        const int* candidates = PanelsAt(mousePos, candidateCount);
+        for (int c = 0; c < candidateCount; c++)
         {
+            int i = candidates[c];
             float titleY = g_Categories[i].posY + TITLE_MARGIN_TOP;
             float titleH = TITLE_HEIGHT;
             
             if (mousePos.x >= g_Categories[i].posX && mousePos.x <= g_Categories[i].posX + PANEL_WIDTH &&
                 mousePos.y >= g_Categories[i].posY && mousePos.y <= titleY + titleH)
             {
-                draggingPanel = (int)i;
+                draggingPanel = i;
                 g_Categories[i].isDragging = true;
                 g_Categories[i].dragOffsetX = mousePos.x - g_Categories[i].posX;
                 g_Categories[i].dragOffsetY = mousePos.y - g_Categories[i].posY;
@@ -388,21 +614,34 @@ void RenderHUD()
         // Clamp to screen bounds
         g_Categories[draggingPanel].posX = (std::max)(0.0f, (std::min)(screenSize.x - PANEL_WIDTH, g_Categories[draggingPanel].posX));
         g_Categories[draggingPanel].posY = (std::max)(0.0f, (std::min)(screenSize.y - PANEL_HEIGHT, g_Categories[draggingPanel].posY));
+        g_GridDirty = true;
     }
     
     // Render panels
     for (size_t i = 0; i < g_Categories.size(); i++)
     {
-        RenderPanel(draw_list, g_Categories[i].posX, g_Categories[i].posY, g_Categories[i], time);
+        RenderPanel(draw_list, g_Categories[i].posX, g_Categories[i].posY, g_Categories[i], g_PanelLayouts[i]);
     }
     
+    // Render module scheduler statistics
+    if (g_HUDSettings.showSchedulerStats)
+        RenderSchedulerStats(draw_list, screenSize);
+    
+    // Render per-frame allocation counters
+    if (g_HUDSettings.showMemoryStats)
+        RenderMemoryStats(draw_list, screenSize);
+    
     // Handle mouse input for modules
     if (ImGui::IsMouseClicked(0) || ImGui::IsMouseClicked(1))
     {
         int button = ImGui::IsMouseClicked(0) ? 0 : 1;
         
-        for (size_t i = 0; i < g_Categories.size(); i++)
+        int candidateCount = 0;
+        const int* candidates = PanelsAt(mousePos, candidateCount);
+        for (int c = 0; c < candidateCount; c++)
         {
+            int i = candidates[c];
+            
             // Skip if clicking on title bar (for dragging)
             float titleY = g_Categories[i].posY + TITLE_MARGIN_TOP;
             float titleH = TITLE_HEIGHT;
@@ -412,18 +651,18 @@ void RenderHUD()
             if (mousePos.x >= g_Categories[i].posX && mousePos.x <= g_Categories[i].posX + PANEL_WIDTH &&
                 mousePos.y >= g_Categories[i].posY && mousePos.y <= g_Categories[i].posY + PANEL_HEIGHT)
             {
-                float currentY = g_Categories[i].posY + SCROLL_AREA_Y_OFFSET - g_Categories[i].scrollOffset;
+                const PanelLayout& layout = g_PanelLayouts[i];
+                float areaTop = g_Categories[i].posY + SCROLL_AREA_Y_OFFSET;
+                float contentY = mousePos.y - areaTop + Anim::Get(g_Categories[i].scrollAnim);
+                int row = FindRow(layout, contentY);
                 
-                for (auto& mod : g_Categories[i].modules)
+                if (row >= 0 && mousePos.y >= areaTop && mousePos.y <= areaTop + SCROLL_AREA_HEIGHT)
                 {
-                    float prog = g_ExpandProgress[mod.name];
-                    float settingsHeight = mod.settings.size() * 27.0f * prog;  // 18 * 1.5
-                    float totalHeight = FUNCTION_HEIGHT + settingsHeight;
+                    Module& mod = g_Categories[i].modules[row - layout.firstRow];
+                    float rowY = contentY - g_Rows[row].top;
                     
                     // Check if clicking on module name area
-                    if (mousePos.y >= currentY && mousePos.y <= currentY + FUNCTION_HEIGHT &&
-                        mousePos.y >= g_Categories[i].posY + SCROLL_AREA_Y_OFFSET &&
-                        mousePos.y <= g_Categories[i].posY + SCROLL_AREA_Y_OFFSET + SCROLL_AREA_HEIGHT)
+                    if (rowY <= FUNCTION_HEIGHT)
                     {
                         if (button == 0)
                         {
@@ -439,45 +678,32 @@ void RenderHUD()
                             // Play sound from embedded resources
                             if (mod.enabled && !wasEnabled)
                             {
-                                PlaySoundResource(IDR_SOUND_ON);
+                                Audio::Play(IDR_SOUND_ON);
                             }
                             else if (!mod.enabled && wasEnabled)
                             {
-                                PlaySoundResource(IDR_SOUND_OFF);
+                                Audio::Play(IDR_SOUND_OFF);
                             }
                         }
                         else if (button == 1 && !mod.settings.empty())
                         {
                             mod.expanded = !mod.expanded;
+                            Anim::SetTarget(mod.expandAnim, mod.expanded ? 1.0f : 0.0f);
+                            g_LayoutDirty = true;
                         }
                     }
                     // Check if clicking on settings (if expanded)
-                    else if (mod.expanded && settingsHeight > 0.0f && button == 0 &&
-                             mousePos.y >= currentY + FUNCTION_HEIGHT &&
-                             mousePos.y <= currentY + totalHeight &&
-                             mousePos.y >= g_Categories[i].posY + SCROLL_AREA_Y_OFFSET &&
-                             mousePos.y <= g_Categories[i].posY + SCROLL_AREA_Y_OFFSET + SCROLL_AREA_HEIGHT)
+                    else if (mod.expanded && button == 0)
                     {
-                        float settingY = currentY + FUNCTION_HEIGHT;
-                        for (size_t j = 0; j < mod.settings.size(); j++)
+                        size_t j = (size_t)((rowY - FUNCTION_HEIGHT) / SETTING_HEIGHT);
+                        
+                        // Toggle setting for watermark module
+                        if (j < mod.settings.size() && mod.name == "Watermark" && mod.settings[j] == "Show FPS")
                         {
-                            float settingTop = settingY + j * 27.0f;  // 18 * 1.5
-                            float settingBottom = settingTop + 27.0f;  // 18 * 1.5
-                            
-                            if (mousePos.y >= settingTop && mousePos.y <= settingBottom)
-                            {
-                                // Toggle setting for watermark module
-                                if (mod.name == "Watermark" && mod.settings[j] == "Show FPS")
-                                {
-                                    GetWatermarkSettings().showFPS = !GetWatermarkSettings().showFPS;
-                                    PlaySoundResource(GetWatermarkSettings().showFPS ? IDR_SOUND_ON : IDR_SOUND_OFF);
-                                }
-                                break;
-                            }
+                            GetWatermarkSettings().showFPS = !GetWatermarkSettings().showFPS;
+                            Audio::Play(GetWatermarkSettings().showFPS ? IDR_SOUND_ON : IDR_SOUND_OFF);
                         }
                     }
-                    
-                    currentY += totalHeight;
                 }
                 break;
             }
@@ -488,13 +714,17 @@ void RenderHUD()
     float scroll = ImGui::GetIO().MouseWheel;
     if (scroll != 0.0f)
     {
-        for (size_t i = 0; i < g_Categories.size(); i++)
+        int candidateCount = 0;
+        const int* candidates = PanelsAt(mousePos, candidateCount);
+        for (int c = 0; c < candidateCount; c++)
         {
+            int i = candidates[c];
             if (mousePos.x >= g_Categories[i].posX && mousePos.x <= g_Categories[i].posX + PANEL_WIDTH &&
                 mousePos.y >= g_Categories[i].posY + SCROLL_AREA_Y_OFFSET &&
                 mousePos.y <= g_Categories[i].posY + SCROLL_AREA_Y_OFFSET + SCROLL_AREA_HEIGHT)
             {
-                g_Categories[i].scrollTarget -= scroll * SCROLL_SPEED;
+                Anim::Handle scrollAnim = g_Categories[i].scrollAnim;
+                Anim::SetTarget(scrollAnim, Anim::GetTarget(scrollAnim) - scroll * SCROLL_SPEED);
                 break;
             }
         }
@@ -505,3 +735,77 @@ void RenderHUD()
     ImGui::PopStyleVar(2);
 }
 
+void ApplyHUDSettings(const Settings::Snapshot& snapshot)
+{
+    g_SavedSettings = snapshot;
+    
+    const Settings::OverlayRecord& overlay = snapshot.overlay;
+    GetWatermarkSettings().enabled = overlay.watermark != 0;
+    GetWatermarkSettings().showFPS = overlay.watermarkFPS != 0;
+    g_HUDSettings.showSchedulerStats = overlay.schedulerStats != 0;
+    g_HUDSettings.showMemoryStats = overlay.memoryStats != 0;
+    if (overlay.menuKey != 0)
+    {
+        g_HUDSettings.menuKey = overlay.menuKey;
+        g_HUDSettings.menuMods = overlay.menuMods;
+    }
+}
+
+const Settings::Snapshot& CaptureHUDSettings()
+{
+    Settings::Snapshot& out = g_CurrentSettings;
+    out.overlay.watermark = GetWatermarkSettings().enabled;
+    out.overlay.watermarkFPS = GetWatermarkSettings().showFPS;
+    out.overlay.schedulerStats = g_HUDSettings.showSchedulerStats;
+    out.overlay.memoryStats = g_HUDSettings.showMemoryStats;
+    out.overlay.menuKey = g_HUDSettings.menuKey;
+    out.overlay.menuMods = g_HUDSettings.menuMods;
+    
+    // Until the ClickGUI is opened the saved panels and modules are kept as they are
+    if (!g_CategoriesInitialized)
+    {
+        out.panelCount = g_SavedSettings.panelCount;
+        out.moduleCount = g_SavedSettings.moduleCount;
+        memcpy(out.panels, g_SavedSettings.panels, sizeof(out.panels));
+        memcpy(out.modules, g_SavedSettings.modules, sizeof(out.modules));
+        return out;
+    }
+    
+    out.panelCount = 0;
+    out.moduleCount = 0;
+    for (const auto& cat : g_Categories)
+    {
+        if (out.panelCount == Settings::MAX_PANELS)
+            break;
+        
+        uint32_t catHash = Settings::HashName(cat.name.c_str());
+        Settings::PanelRecord& panel = out.panels[out.panelCount++];
+        panel.nameHash = catHash;
+        panel.posX = cat.posX;
+        panel.posY = cat.posY;
+        panel.scroll = Anim::GetTarget(cat.scrollAnim);
+        
+        for (const auto& mod : cat.modules)
+        {
+            if (out.moduleCount == Settings::MAX_MODULES)
+                break;
+            Settings::ModuleRecord& record = out.modules[out.moduleCount++];
+            record.nameHash = Settings::HashName(mod.name.c_str(), catHash);
+            record.enabled = mod.enabled;
+            record.expanded = mod.expanded;
+            record.reserved = 0;
+        }
+    }
+    return out;
+}
+
+// Compares the live HUD state with the last one and hands settled changes to the writer thread
+static void SettingsTask()
+{
+    Settings::Update(CaptureHUDSettings(), ImGui::GetTime());
+}
+
+void RegisterHUDTasks()
+{
+    Scheduler::Register({ "Settings", SettingsTask, Scheduler::TickMode::FixedRate, SETTINGS_TASK_RATE });
+}
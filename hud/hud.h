@@ -1,11 +1,37 @@
 #pragma once
 
+#include "../platform/platform.h"
+#include "../modules/audio/audio.h"
+#include "../modules/settings/settings.h"
+#include <cstdint>
+
 // Resource IDs for embedded sounds
 #define IDR_SOUND_ON   101
 #define IDR_SOUND_OFF  102
 
-// Play sound from embedded resources
-void PlaySoundResource(int resourceId);
+// HUD settings
+struct HUDSettings {
+    bool showSchedulerStats = true;  // Scheduler timings panel (bottom-left)
+    bool showMemoryStats = false;    // Per-frame allocation counters (bottom-right)
+    uint16_t menuKey = 0x2E;         // Menu toggle chord: virtual-key (VK_DELETE) ...
+    uint8_t menuMods = 0;            // ... + Input::Modifier flags
+};
+
+// Get current HUD settings
+HUDSettings& GetHUDSettings();
+
+// Menu visibility (toggled with "Del")
+extern bool g_ShowMenu;
 
 // Render HUD menu
 void RenderHUD();
+
+// Restores saved state: overlay settings right away, panels and modules when the
+// ClickGUI is first built
+void ApplyHUDSettings(const Settings::Snapshot& snapshot);
+
+// Current HUD/watermark state in the settings file layout (for Settings::Update)
+const Settings::Snapshot& CaptureHUDSettings();
+
+// Registers the HUD's periodic work with the scheduler (settings autosave)
+void RegisterHUDTasks();
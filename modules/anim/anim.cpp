@@ -0,0 +1,508 @@
+#include "anim.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include <cmath>
+#include <utility>
+
+namespace Anim
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	// Дескриптор: вид в старших битах, номер значения в младших
+	enum Kind : int32_t
+	{
+		Kind_Follow = 0,
+		Kind_Tween = 1,
+		Kind_Oscillator = 2,
+		Kind_Count
+	};
+
+	static const int KIND_SHIFT = 16;
+	static const int32_t ID_MASK = (1 << KIND_SHIFT) - 1;
+
+	static const float PI = 3.14159265358979f;
+	static const float TWO_PI = 6.28318530717959f;
+	static const float INV_TWO_PI = 0.159154943091895f;
+
+	// Соответствие id <-> слот. Проснувшиеся значения занимают слоты [0, awake),
+	// поэтому проход Update идёт по непрерывным массивам без пропусков
+	struct SlotIndex
+	{
+		uint16_t slotOf[MAX_ANIMATIONS];
+		uint16_t idOf[MAX_ANIMATIONS];
+		bool running[MAX_ANIMATIONS];   // по id
+		int count;
+		int awake;
+	};
+
+	struct FollowPool
+	{
+		float value[MAX_ANIMATIONS];
+		float target[MAX_ANIMATIONS];
+		float rate[MAX_ANIMATIONS];
+		float epsilon[MAX_ANIMATIONS];
+		SlotIndex index;
+
+		void Swap(int a, int b)
+		{
+			std::swap(value[a], value[b]);
+			std::swap(target[a], target[b]);
+			std::swap(rate[a], rate[b]);
+			std::swap(epsilon[a], epsilon[b]);
+		}
+	};
+
+	struct TweenPool
+	{
+		float t[MAX_ANIMATIONS];            // прогресс 0..1
+		float invDuration[MAX_ANIMATIONS];
+		float start[MAX_ANIMATIONS];
+		float target[MAX_ANIMATIONS];
+		Ease ease[MAX_ANIMATIONS];
+		SlotIndex index;
+
+		void Swap(int a, int b)
+		{
+			std::swap(t[a], t[b]);
+			std::swap(invDuration[a], invDuration[b]);
+			std::swap(start[a], start[b]);
+			std::swap(target[a], target[b]);
+			std::swap(ease[a], ease[b]);
+		}
+	};
+
+	struct OscillatorPool
+	{
+		float phase[MAX_ANIMATIONS];        // [-PI, PI]
+		float speed[MAX_ANIMATIONS];
+		float value[MAX_ANIMATIONS];
+		SlotIndex index;
+
+		void Swap(int a, int b)
+		{
+			std::swap(phase[a], phase[b]);
+			std::swap(speed[a], speed[b]);
+			std::swap(value[a], value[b]);
+		}
+	};
+
+	static FollowPool g_Follow;
+	static TweenPool g_Tween;
+	static OscillatorPool g_Oscillator;
+	static Stats g_Stats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static Kind KindOf(Handle handle)
+	{
+		return static_cast<Kind>(handle >> KIND_SHIFT);
+	}
+
+	static int IdOf(Handle handle)
+	{
+		return handle & ID_MASK;
+	}
+
+	static Handle MakeHandle(Kind kind, int id)
+	{
+		return (static_cast<int32_t>(kind) << KIND_SHIFT) | id;
+	}
+
+	// Слот значения или -1 для чужого/устаревшего дескриптора
+	static int SlotOf(const SlotIndex& index, Handle handle, Kind kind)
+	{
+		if (handle < 0 || KindOf(handle) != kind)
+			return -1;
+
+		int id = IdOf(handle);
+		return id < index.count ? index.slotOf[id] : -1;
+	}
+
+	template<typename Pool>
+	static void SwapSlots(Pool& pool, int a, int b)
+	{
+		if (a == b)
+			return;
+
+		SlotIndex& index = pool.index;
+		pool.Swap(a, b);
+		std::swap(index.idOf[a], index.idOf[b]);
+		index.slotOf[index.idOf[a]] = static_cast<uint16_t>(a);
+		index.slotOf[index.idOf[b]] = static_cast<uint16_t>(b);
+	}
+
+	// Возвращает новый слот (значение перемещается в проснувшуюся часть)
+	template<typename Pool>
+	static int Wake(Pool& pool, int slot)
+	{
+		SlotIndex& index = pool.index;
+		if (slot < index.awake || !index.running[index.idOf[slot]])
+			return slot;
+
+		int awakeSlot = index.awake++;
+		SwapSlots(pool, slot, awakeSlot);
+		return awakeSlot;
+	}
+
+	template<typename Pool>
+	static int Sleep(Pool& pool, int slot)
+	{
+		SlotIndex& index = pool.index;
+		if (slot >= index.awake)
+			return slot;
+
+		int lastAwake = --index.awake;
+		SwapSlots(pool, slot, lastAwake);
+		return lastAwake;
+	}
+
+	// Новый id в конце пула (спящий)
+	template<typename Pool>
+	static int Allocate(Pool& pool)
+	{
+		SlotIndex& index = pool.index;
+		if (index.count >= MAX_ANIMATIONS)
+			return -1;
+
+		int id = index.count++;
+		index.slotOf[id] = static_cast<uint16_t>(id);
+		index.idOf[id] = static_cast<uint16_t>(id);
+		index.running[id] = true;
+		return id;
+	}
+
+	static float Evaluate(Ease ease, float t)
+	{
+		switch (ease)
+		{
+		case Ease::InQuad:
+			return t * t;
+		case Ease::OutQuad:
+			return t * (2.0f - t);
+		case Ease::InOutQuad:
+			return t < 0.5f ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+		case Ease::OutCubic:
+		{
+			float u = 1.0f - t;
+			return 1.0f - u * u * u;
+		}
+		default:
+			return t;
+		}
+	}
+
+	// sin для x в [-PI, PI]: отражение в [-PI/2, PI/2] и ряд до x^9 (ошибка < 2e-4).
+	// Без ветвлений, чтобы цикл по осцилляторам векторизовался
+	static inline float FastSin(float x)
+	{
+		float magnitude = fabsf(x);
+		float mirrored = PI - magnitude;
+		x = copysignf(magnitude < mirrored ? magnitude : mirrored, x);
+
+		float x2 = x * x;
+		return x * (1.0f - x2 / 6.0f * (1.0f - x2 / 20.0f * (1.0f - x2 / 42.0f * (1.0f - x2 / 72.0f))));
+	}
+
+	static float TweenValue(int slot)
+	{
+		float start = g_Tween.start[slot];
+		return start + (g_Tween.target[slot] - start) * Evaluate(g_Tween.ease[slot], g_Tween.t[slot]);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	Handle CreateFollow(float value, float rate, float epsilon)
+	{
+		int id = Allocate(g_Follow);
+		if (id < 0)
+			return INVALID_HANDLE;
+
+		g_Follow.value[id] = value;
+		g_Follow.target[id] = value;
+		g_Follow.rate[id] = rate;
+		g_Follow.epsilon[id] = epsilon;
+		g_Stats.follows = g_Follow.index.count;
+		return MakeHandle(Kind_Follow, id);
+	}
+
+	Handle CreateTween(float value, float duration, Ease ease)
+	{
+		int id = Allocate(g_Tween);
+		if (id < 0)
+			return INVALID_HANDLE;
+
+		g_Tween.t[id] = 1.0f;
+		g_Tween.invDuration[id] = duration > 0.0f ? 1.0f / duration : 0.0f;
+		g_Tween.start[id] = value;
+		g_Tween.target[id] = value;
+		g_Tween.ease[id] = ease;
+		g_Stats.tweens = g_Tween.index.count;
+		return MakeHandle(Kind_Tween, id);
+	}
+
+	Handle CreateOscillator(float speed, float phase)
+	{
+		int id = Allocate(g_Oscillator);
+		if (id < 0)
+			return INVALID_HANDLE;
+
+		phase = remainderf(phase, TWO_PI);
+		g_Oscillator.phase[id] = phase;
+		g_Oscillator.speed[id] = speed;
+		g_Oscillator.value[id] = sinf(phase);
+		g_Stats.oscillators = g_Oscillator.index.count;
+
+		// Осциллятор всегда в движении
+		Wake(g_Oscillator, id);
+		return MakeHandle(Kind_Oscillator, id);
+	}
+
+	void SetTarget(Handle handle, float target)
+	{
+		int slot = SlotOf(g_Follow.index, handle, Kind_Follow);
+		if (slot >= 0)
+		{
+			if (g_Follow.target[slot] != target)
+			{
+				g_Follow.target[slot] = target;
+				Wake(g_Follow, slot);
+			}
+			return;
+		}
+
+		slot = SlotOf(g_Tween.index, handle, Kind_Tween);
+		if (slot < 0 || g_Tween.target[slot] == target)
+			return;
+
+		if (g_Tween.invDuration[slot] <= 0.0f)
+		{
+			SetValue(handle, target);
+			return;
+		}
+
+		// Новый переход начинается с текущего значения
+		g_Tween.start[slot] = TweenValue(slot);
+		g_Tween.target[slot] = target;
+		g_Tween.t[slot] = 0.0f;
+		Wake(g_Tween, slot);
+	}
+
+	void SetValue(Handle handle, float value)
+	{
+		int slot = SlotOf(g_Follow.index, handle, Kind_Follow);
+		if (slot >= 0)
+		{
+			g_Follow.value[slot] = value;
+			g_Follow.target[slot] = value;
+			Sleep(g_Follow, slot);
+			return;
+		}
+
+		slot = SlotOf(g_Tween.index, handle, Kind_Tween);
+		if (slot >= 0)
+		{
+			g_Tween.start[slot] = value;
+			g_Tween.target[slot] = value;
+			g_Tween.t[slot] = 1.0f;
+			Sleep(g_Tween, slot);
+		}
+	}
+
+	void SetRunning(Handle handle, bool running)
+	{
+		switch (KindOf(handle))
+		{
+		case Kind_Follow:
+		{
+			int slot = SlotOf(g_Follow.index, handle, Kind_Follow);
+			if (slot < 0)
+				return;
+			g_Follow.index.running[IdOf(handle)] = running;
+			if (running)
+				Wake(g_Follow, slot);
+			else
+				Sleep(g_Follow, slot);
+			break;
+		}
+		case Kind_Tween:
+		{
+			int slot = SlotOf(g_Tween.index, handle, Kind_Tween);
+			if (slot < 0)
+				return;
+			g_Tween.index.running[IdOf(handle)] = running;
+			if (!running)
+				Sleep(g_Tween, slot);
+			else if (g_Tween.t[slot] < 1.0f)
+				Wake(g_Tween, slot);
+			break;
+		}
+		case Kind_Oscillator:
+		{
+			int slot = SlotOf(g_Oscillator.index, handle, Kind_Oscillator);
+			if (slot < 0)
+				return;
+			g_Oscillator.index.running[IdOf(handle)] = running;
+			if (running)
+				Wake(g_Oscillator, slot);
+			else
+				Sleep(g_Oscillator, slot);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	float Get(Handle handle)
+	{
+		switch (KindOf(handle))
+		{
+		case Kind_Follow:
+		{
+			int slot = SlotOf(g_Follow.index, handle, Kind_Follow);
+			return slot >= 0 ? g_Follow.value[slot] : 0.0f;
+		}
+		case Kind_Tween:
+		{
+			int slot = SlotOf(g_Tween.index, handle, Kind_Tween);
+			return slot >= 0 ? TweenValue(slot) : 0.0f;
+		}
+		case Kind_Oscillator:
+		{
+			int slot = SlotOf(g_Oscillator.index, handle, Kind_Oscillator);
+			return slot >= 0 ? g_Oscillator.value[slot] : 0.0f;
+		}
+		default:
+			return 0.0f;
+		}
+	}
+
+	float GetTarget(Handle handle)
+	{
+		int slot = SlotOf(g_Follow.index, handle, Kind_Follow);
+		if (slot >= 0)
+			return g_Follow.target[slot];
+
+		slot = SlotOf(g_Tween.index, handle, Kind_Tween);
+		if (slot >= 0)
+			return g_Tween.target[slot];
+
+		return Get(handle);
+	}
+
+	bool IsAwake(Handle handle)
+	{
+		switch (KindOf(handle))
+		{
+		case Kind_Follow:
+		{
+			int slot = SlotOf(g_Follow.index, handle, Kind_Follow);
+			return slot >= 0 && slot < g_Follow.index.awake;
+		}
+		case Kind_Tween:
+		{
+			int slot = SlotOf(g_Tween.index, handle, Kind_Tween);
+			return slot >= 0 && slot < g_Tween.index.awake;
+		}
+		case Kind_Oscillator:
+		{
+			int slot = SlotOf(g_Oscillator.index, handle, Kind_Oscillator);
+			return slot >= 0 && slot < g_Oscillator.index.awake;
+		}
+		default:
+			return false;
+		}
+	}
+
+	void Update(float dt)
+	{
+		if (dt < 0.0f)
+			dt = 0.0f;
+
+		// Follow: шаг для всех проснувшихся, затем засыпание догнавших цель
+		// (обход с конца: Sleep меняет слот с последним проснувшимся, который уже проверен)
+		int count = g_Follow.index.awake;
+		for (int i = 0; i < count; i++)
+		{
+			float k = g_Follow.rate[i] * dt;
+			k = k > 1.0f ? 1.0f : k;
+			g_Follow.value[i] += (g_Follow.target[i] - g_Follow.value[i]) * k;
+		}
+		for (int i = count - 1; i >= 0; i--)
+		{
+			if (fabsf(g_Follow.target[i] - g_Follow.value[i]) < g_Follow.epsilon[i])
+			{
+				g_Follow.value[i] = g_Follow.target[i];
+				Sleep(g_Follow, i);
+			}
+		}
+
+		// Tween: продвигается только прогресс, кривая применяется при чтении
+		count = g_Tween.index.awake;
+		for (int i = 0; i < count; i++)
+		{
+			float t = g_Tween.t[i] + g_Tween.invDuration[i] * dt;
+			g_Tween.t[i] = t > 1.0f ? 1.0f : t;
+		}
+		for (int i = count - 1; i >= 0; i--)
+		{
+			if (g_Tween.t[i] >= 1.0f)
+				Sleep(g_Tween, i);
+		}
+
+		// Осцилляторы: фаза держится в [-PI, PI], чтобы не терять точность.
+		// Округление через int, а не floorf/remainderf - иначе цикл не векторизуется
+		count = g_Oscillator.index.awake;
+		for (int i = 0; i < count; i++)
+		{
+			float phase = g_Oscillator.phase[i] + g_Oscillator.speed[i] * dt;
+			float turns = phase * INV_TWO_PI;
+			turns += copysignf(0.5f, turns);
+			phase -= static_cast<float>(static_cast<int>(turns)) * TWO_PI;
+			g_Oscillator.phase[i] = phase;
+			g_Oscillator.value[i] = FastSin(phase);
+		}
+
+		g_Stats.awake = g_Follow.index.awake + g_Tween.index.awake + g_Oscillator.index.awake;
+	}
+
+	bool IsIdle()
+	{
+		return g_Follow.index.awake == 0 && g_Tween.index.awake == 0 && g_Oscillator.index.awake == 0;
+	}
+
+	const Stats& GetStats()
+	{
+		return g_Stats;
+	}
+
+	void Reset()
+	{
+		g_Follow.index.count = g_Follow.index.awake = 0;
+		g_Tween.index.count = g_Tween.index.awake = 0;
+		g_Oscillator.index.count = g_Oscillator.index.awake = 0;
+		g_Stats = Stats();
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void AnimCommand(const Console::Commands::Args&, void*)
+	{
+		const Stats& stats = GetStats();
+		Console::Log("Animations: %d follow, %d tween, %d oscillator; %d awake%s",
+			stats.follows, stats.tweens, stats.oscillators, stats.awake, IsIdle() ? " (idle)" : "");
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "anim", "", "animated values: total and awake", AnimCommand });
+	}
+}
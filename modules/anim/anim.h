@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Anim
+{
+	/// Дескриптор анимируемого значения
+	typedef int32_t Handle;
+
+	constexpr Handle INVALID_HANDLE = -1;
+
+	/// Максимальное количество значений каждого вида
+	constexpr int MAX_ANIMATIONS = 256;
+
+	/// Кривая для Tween
+	enum class Ease : uint8_t
+	{
+		Linear,
+		InQuad,
+		OutQuad,
+		InOutQuad,
+		OutCubic
+	};
+
+	/// Статистика последнего Update
+	struct Stats
+	{
+		int follows = 0;        // создано значений каждого вида
+		int tweens = 0;
+		int oscillators = 0;
+		int awake = 0;          // обновлялось в последнем кадре
+	};
+
+	/// Значение, экспоненциально догоняющее цель: value += (target - value) * rate * dt.
+	/// Засыпает, когда до цели меньше epsilon
+	Handle CreateFollow(float value, float rate, float epsilon = 0.001f);
+
+	/// Переход к цели за duration секунд по кривой ease
+	Handle CreateTween(float value, float duration, Ease ease = Ease::OutCubic);
+
+	/// sin(phase + speed * t). Работает, пока не остановлен через SetRunning
+	Handle CreateOscillator(float speed, float phase = 0.0f);
+
+	/// Новая цель (Follow/Tween). Будит значение, если цель изменилась
+	void SetTarget(Handle handle, float target);
+
+	/// Мгновенно устанавливает значение (и цель) - анимация засыпает
+	void SetValue(Handle handle, float value);
+
+	/// Останавливает/возобновляет обновление значения (например, для скрытого элемента)
+	void SetRunning(Handle handle, bool running);
+
+	/// Текущее значение
+	float Get(Handle handle);
+
+	/// Текущая цель (для осциллятора - значение)
+	float GetTarget(Handle handle);
+
+	/// Изменится ли значение в следующем Update
+	bool IsAwake(Handle handle);
+
+	/// Продвигает все проснувшиеся значения на dt секунд (один раз за кадр)
+	void Update(float dt);
+
+	/// Нет ни одного проснувшегося значения - кадр без анимаций
+	bool IsIdle();
+
+	/// Статистика
+	const Stats& GetStats();
+
+	/// Удаляет все значения (дескрипторы становятся недействительными)
+	void Reset();
+
+	/// Регистрирует команду консоли anim
+	void RegisterCommands();
+}
@@ -0,0 +1,265 @@
+#include "audio.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include "wav.h"
+#include "../common/spsc_queue.h"
+#include "../../platform/platform.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace Audio
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	// Декодированный звук: float стерео на частоте микшера. Не меняется после публикации
+	struct Cue
+	{
+		int id = 0;
+		float volume = 1.0f;       // читает и пишет только поток Play
+		std::vector<float> samples;
+		uint32_t frames = 0;
+	};
+
+	struct Voice
+	{
+		const Cue* cue;
+		uint32_t position;         // кадр
+		float gain;
+	};
+
+	// Событие Play -> поток микшера
+	struct Trigger
+	{
+		int cue;
+		float gain;
+	};
+
+	static Cue g_Cues[MAX_CUES];
+	static std::atomic<int> g_CueCount{ 0 };   // cue [0, count) опубликованы
+
+	static Common::SpscQueue<Trigger, 64> g_Triggers;
+
+	// Только поток микшера
+	static Voice g_Voices[MAX_VOICES];
+	static int g_VoiceCount = 0;
+
+	static int g_SampleRate = 0;
+	static bool g_Device = false;
+
+	static std::atomic<uint64_t> g_Triggered{ 0 };
+	static std::atomic<uint64_t> g_Dropped{ 0 };
+	static std::atomic<uint64_t> g_Stolen{ 0 };
+	static std::atomic<uint64_t> g_MixedFrames{ 0 };
+	static std::atomic<int> g_ActiveVoices{ 0 };
+	static std::atomic<int> g_PeakVoices{ 0 };
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static Cue* FindCue(int id)
+	{
+		int count = g_CueCount.load(std::memory_order_acquire);
+		for (int i = 0; i < count; i++)
+		{
+			if (g_Cues[i].id == id)
+				return &g_Cues[i];
+		}
+		return nullptr;
+	}
+
+	// Новый голос; если свободных нет - вытесняется тот, что звучит дольше всех
+	static void StartVoice(const Trigger& trigger)
+	{
+		Voice voice = { &g_Cues[trigger.cue], 0, trigger.gain };
+		if (g_VoiceCount < MAX_VOICES)
+		{
+			g_Voices[g_VoiceCount++] = voice;
+			return;
+		}
+
+		int oldest = 0;
+		for (int i = 1; i < g_VoiceCount; i++)
+		{
+			if (g_Voices[i].position > g_Voices[oldest].position)
+				oldest = i;
+		}
+		g_Voices[oldest] = voice;
+		g_Stolen.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void ResetState()
+	{
+		// Поток устройства уже остановлен - можно разбирать очередь отсюда
+		Trigger trigger;
+		while (g_Triggers.TryPop(trigger)) {}
+
+		g_VoiceCount = 0;
+		for (int i = 0; i < g_CueCount.load(std::memory_order_relaxed); i++)
+			g_Cues[i] = Cue();
+		g_CueCount.store(0, std::memory_order_release);
+
+		g_Triggered = 0;
+		g_Dropped = 0;
+		g_Stolen = 0;
+		g_MixedFrames = 0;
+		g_ActiveVoices = 0;
+		g_PeakVoices = 0;
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	bool Initialize()
+	{
+		Shutdown();
+
+		int sampleRate = 0;
+		if (!StartAudioOutput(Mix, &sampleRate))
+			return false;
+
+		g_SampleRate = sampleRate;
+		g_Device = true;
+		return true;
+	}
+
+	void InitializeHeadless(int sampleRate)
+	{
+		Shutdown();
+		g_SampleRate = sampleRate;
+	}
+
+	void Shutdown(bool processExit)
+	{
+		if (g_Device)
+			StopAudioOutput(processExit);
+		g_Device = false;
+		g_SampleRate = 0;
+		ResetState();
+	}
+
+	bool LoadCue(int id, const void* wav, size_t size, float volume)
+	{
+		int count = g_CueCount.load(std::memory_order_relaxed);
+		if (g_SampleRate == 0 || count >= MAX_CUES || FindCue(id))
+			return false;
+
+		Cue& cue = g_Cues[count];
+		if (!DecodeWav(wav, size, g_SampleRate, cue.samples))
+			return false;
+
+		cue.id = id;
+		cue.volume = volume;
+		cue.frames = static_cast<uint32_t>(cue.samples.size() / 2);
+		g_CueCount.store(count + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool LoadCueResource(int resourceId, float volume)
+	{
+		const void* data = nullptr;
+		size_t size = 0;
+		return LoadResourceData(resourceId, &data, &size) && LoadCue(resourceId, data, size, volume);
+	}
+
+	void SetCueVolume(int id, float volume)
+	{
+		if (Cue* cue = FindCue(id))
+			cue->volume = volume;
+	}
+
+	bool Play(int id, float gain)
+	{
+		Cue* cue = g_SampleRate ? FindCue(id) : nullptr;
+		if (!cue || !g_Triggers.TryPush({ static_cast<int>(cue - g_Cues), cue->volume * gain }))
+		{
+			g_Dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		g_Triggered.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	void Mix(float* out, int frames)
+	{
+		Trigger trigger;
+		while (g_Triggers.TryPop(trigger))
+			StartVoice(trigger);
+
+		const uint32_t samples = static_cast<uint32_t>(frames) * 2;
+		memset(out, 0, samples * sizeof(float));
+
+		for (int v = 0; v < g_VoiceCount;)
+		{
+			Voice& voice = g_Voices[v];
+			uint32_t count = voice.cue->frames - voice.position;
+			if (count > static_cast<uint32_t>(frames))
+				count = static_cast<uint32_t>(frames);
+
+			const float* src = voice.cue->samples.data() + static_cast<size_t>(voice.position) * 2;
+			const float gain = voice.gain;
+			for (uint32_t i = 0; i < count * 2; i++)
+				out[i] += src[i] * gain;
+
+			voice.position += count;
+			if (voice.position >= voice.cue->frames)
+				g_Voices[v] = g_Voices[--g_VoiceCount];
+			else
+				v++;
+		}
+
+		// Наложение голосов может выйти за [-1, 1]
+		for (uint32_t i = 0; i < samples; i++)
+			out[i] = out[i] > 1.0f ? 1.0f : (out[i] < -1.0f ? -1.0f : out[i]);
+
+		g_MixedFrames.fetch_add(static_cast<uint64_t>(frames), std::memory_order_relaxed);
+		g_ActiveVoices.store(g_VoiceCount, std::memory_order_relaxed);
+		if (g_VoiceCount > g_PeakVoices.load(std::memory_order_relaxed))
+			g_PeakVoices.store(g_VoiceCount, std::memory_order_relaxed);
+	}
+
+	Stats GetStats()
+	{
+		Stats stats;
+		stats.device = g_Device;
+		stats.sampleRate = g_SampleRate;
+		stats.cues = g_CueCount.load(std::memory_order_acquire);
+		for (int i = 0; i < stats.cues; i++)
+			stats.pcmBytes += g_Cues[i].samples.size() * sizeof(float);
+		stats.voices = g_ActiveVoices.load(std::memory_order_relaxed);
+		stats.peakVoices = g_PeakVoices.load(std::memory_order_relaxed);
+		stats.triggered = g_Triggered.load(std::memory_order_relaxed);
+		stats.dropped = g_Dropped.load(std::memory_order_relaxed);
+		stats.stolen = g_Stolen.load(std::memory_order_relaxed);
+		stats.mixedFrames = g_MixedFrames.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void AudioCommand(const Console::Commands::Args&, void*)
+	{
+		Stats stats = GetStats();
+		if (!stats.device)
+		{
+			Console::Log("Audio: no output device, sounds are disabled");
+			return;
+		}
+		Console::Log("Audio: %d Hz, %d cue(s), %zu KB PCM; voices %d (peak %d)",
+			stats.sampleRate, stats.cues, stats.pcmBytes / 1024, stats.voices, stats.peakVoices);
+		Console::Log("  triggered %llu, dropped %llu, stolen %llu, mixed %.1f s",
+			static_cast<unsigned long long>(stats.triggered), static_cast<unsigned long long>(stats.dropped),
+			static_cast<unsigned long long>(stats.stolen), static_cast<double>(stats.mixedFrames) / stats.sampleRate);
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "audio", "", "sound cue mixer: voices, triggers, dropped", AudioCommand });
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Audio
+{
+	/// Звуков (cue), загруженных одновременно
+	constexpr int MAX_CUES = 16;
+	/// Одновременно звучащих голосов; при нехватке вытесняется самый старый
+	constexpr int MAX_VOICES = 16;
+	/// Частота микшера без устройства (InitializeHeadless по умолчанию)
+	constexpr int DEFAULT_SAMPLE_RATE = 48000;
+
+	/// Статистика
+	struct Stats
+	{
+		bool device = false;       // вывод открыт (WASAPI / null sink)
+		int sampleRate = 0;
+		int cues = 0;
+		size_t pcmBytes = 0;       // декодированный PCM всех cue
+		int voices = 0;            // звучат сейчас
+		int peakVoices = 0;
+		uint64_t triggered = 0;    // Play принят
+		uint64_t dropped = 0;      // очередь заполнена или cue не найден
+		uint64_t stolen = 0;       // голос вытеснен новым
+		uint64_t mixedFrames = 0;
+	};
+
+	/// Открывает устройство вывода (platform layer) и запускает микшер в его потоке.
+	/// false - устройства нет, Play ничего не делает
+	bool Initialize();
+
+	/// Микшер без устройства: Mix вызывает сам владелец (бенчмарк)
+	void InitializeHeadless(int sampleRate = DEFAULT_SAMPLE_RATE);
+
+	/// Останавливает вывод и освобождает cue (processExit - см. StopAudioOutput)
+	void Shutdown(bool processExit = false);
+
+	/// Декодирует WAV в PCM микшера (float стерео, частота устройства) один раз.
+	/// id - идентификатор для Play (например, ID ресурса). Вызывать после Initialize
+	bool LoadCue(int id, const void* wav, size_t size, float volume = 1.0f);
+
+	/// LoadCue для RCDATA-ресурса DLL
+	bool LoadCueResource(int resourceId, float volume = 1.0f);
+
+	/// Громкость cue для следующих Play. Только из потока, который вызывает Play
+	void SetCueVolume(int id, float volume);
+
+	/// Запуск звука: кладёт событие в очередь без блокировок и сразу возвращается.
+	/// Звуки накладываются друг на друга. Вызывать из одного потока (render thread)
+	bool Play(int id, float gain = 1.0f);
+
+	/// Смешивает frames стерео-кадров в out (float, чередование L/R).
+	/// Вызывается потоком устройства (или владельцем при InitializeHeadless)
+	void Mix(float* out, int frames);
+
+	/// Статистика
+	Stats GetStats();
+
+	/// Регистрирует команду консоли audio
+	void RegisterCommands();
+}
@@ -0,0 +1,178 @@
+#include "wav.h"
+#include <cstring>
+
+namespace Audio
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	static const uint16_t FORMAT_PCM = 0x0001;
+	static const uint16_t FORMAT_FLOAT = 0x0003;
+	static const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static uint16_t ReadU16(const uint8_t* p)
+	{
+		return static_cast<uint16_t>(p[0] | (p[1] << 8));
+	}
+
+	static uint32_t ReadU32(const uint8_t* p)
+	{
+		return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+			(static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+	}
+
+	static bool ParseFormat(const uint8_t* chunk, uint32_t size, WavFormat& format)
+	{
+		if (size < 16)
+			return false;
+
+		uint16_t tag = ReadU16(chunk);
+		format.channels = ReadU16(chunk + 2);
+		format.sampleRate = static_cast<int>(ReadU32(chunk + 4));
+		uint16_t blockAlign = ReadU16(chunk + 12);
+		format.bitsPerSample = ReadU16(chunk + 14);
+
+		// WAVE_FORMAT_EXTENSIBLE: настоящий тег - первые два байта SubFormat GUID
+		if (tag == FORMAT_EXTENSIBLE)
+		{
+			if (size < 40)
+				return false;
+			tag = ReadU16(chunk + 24);
+		}
+
+		if (tag == FORMAT_FLOAT)
+			format.isFloat = true;
+		else if (tag != FORMAT_PCM)
+			return false;
+
+		bool bitsValid = format.isFloat ? format.bitsPerSample == 32 :
+			(format.bitsPerSample == 8 || format.bitsPerSample == 16 || format.bitsPerSample == 24 || format.bitsPerSample == 32);
+		return bitsValid && format.channels >= 1 && format.channels <= 8 && format.sampleRate > 0 &&
+			blockAlign == format.channels * format.bitsPerSample / 8;
+	}
+
+	// Один сэмпл в [-1, 1]
+	static float ReadSample(const uint8_t* p, const WavFormat& format)
+	{
+		switch (format.bitsPerSample)
+		{
+		case 8:
+			return (static_cast<int>(p[0]) - 128) * (1.0f / 128.0f);
+		case 16:
+			return static_cast<int16_t>(ReadU16(p)) * (1.0f / 32768.0f);
+		case 24:
+			return static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+				(static_cast<uint32_t>(p[2]) << 24)) * (1.0f / 2147483648.0f);
+		default:
+			if (format.isFloat)
+			{
+				uint32_t bits = ReadU32(p);
+				float value;
+				memcpy(&value, &bits, sizeof(value));
+				return value;
+			}
+			return static_cast<int32_t>(ReadU32(p)) * (1.0f / 2147483648.0f);
+		}
+	}
+
+	// Кадр -> стерео (моно в оба канала)
+	static void ReadFrame(const WavData& wav, uint32_t frame, float& left, float& right)
+	{
+		const int bytes = wav.format.bitsPerSample / 8;
+		const uint8_t* p = wav.samples + static_cast<size_t>(frame) * wav.format.channels * bytes;
+		left = ReadSample(p, wav.format);
+		right = wav.format.channels > 1 ? ReadSample(p + bytes, wav.format) : left;
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	bool ParseWav(const void* data, size_t size, WavData& out)
+	{
+		out = WavData();
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		if (!bytes || size < 12 || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0)
+			return false;
+
+		bool hasFormat = false;
+		size_t pos = 12;
+		while (pos + 8 <= size)
+		{
+			const uint8_t* chunk = bytes + pos + 8;
+			uint32_t chunkSize = ReadU32(bytes + pos + 4);
+			size_t available = size - pos - 8;
+
+			if (memcmp(bytes + pos, "fmt ", 4) == 0)
+			{
+				if (chunkSize > available || !ParseFormat(chunk, chunkSize, out.format))
+					return false;
+				hasFormat = true;
+			}
+			else if (memcmp(bytes + pos, "data", 4) == 0)
+			{
+				if (!hasFormat)
+					return false;
+
+				// Обрезанный файл: берём сколько есть, целыми кадрами
+				size_t dataSize = chunkSize < available ? chunkSize : available;
+				size_t frameBytes = static_cast<size_t>(out.format.channels) * (out.format.bitsPerSample / 8);
+				out.samples = chunk;
+				out.frameCount = static_cast<uint32_t>(dataSize / frameBytes);
+				return true;
+			}
+
+			// Чанки выровнены на 2 байта
+			pos += 8 + static_cast<size_t>(chunkSize) + (chunkSize & 1);
+		}
+		return false;
+	}
+
+	bool DecodeWav(const void* data, size_t size, int sampleRate, std::vector<float>& out)
+	{
+		out.clear();
+		WavData wav;
+		if (sampleRate <= 0 || !ParseWav(data, size, wav) || wav.frameCount == 0)
+			return false;
+
+		if (wav.format.sampleRate == sampleRate)
+		{
+			out.resize(static_cast<size_t>(wav.frameCount) * 2);
+			for (uint32_t i = 0; i < wav.frameCount; i++)
+				ReadFrame(wav, i, out[i * 2], out[i * 2 + 1]);
+			return true;
+		}
+
+		// Частота устройства отличается (44.1 -> 48 кГц): линейная интерполяция, один раз при загрузке
+		const double step = static_cast<double>(wav.format.sampleRate) / sampleRate;
+		const uint32_t frames = static_cast<uint32_t>((wav.frameCount - 1) / step) + 1;
+		out.resize(static_cast<size_t>(frames) * 2);
+		for (uint32_t i = 0; i < frames; i++)
+		{
+			double position = i * step;
+			uint32_t index = static_cast<uint32_t>(position);
+			float t = static_cast<float>(position - index);
+
+			float l0, r0, l1, r1;
+			ReadFrame(wav, index, l0, r0);
+			if (index + 1 < wav.frameCount)
+			{
+				ReadFrame(wav, index + 1, l1, r1);
+			}
+			else
+			{
+				l1 = l0;
+				r1 = r0;
+			}
+
+			out[i * 2] = l0 + (l1 - l0) * t;
+			out[i * 2 + 1] = r0 + (r1 - r0) * t;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Audio
+{
+	/// Формат сэмплов WAV
+	struct WavFormat
+	{
+		int channels = 0;
+		int sampleRate = 0;
+		int bitsPerSample = 0;   // 8 (unsigned), 16, 24, 32
+		bool isFloat = false;    // 32-bit IEEE float
+	};
+
+	/// Разобранный WAV: указатель на сэмплы внутри исходных данных (без копирования)
+	struct WavData
+	{
+		WavFormat format;
+		const uint8_t* samples = nullptr;
+		uint32_t frameCount = 0;
+	};
+
+	/// Разбирает RIFF/WAVE: PCM 8/16/24/32 бит, float 32 бит, WAVE_FORMAT_EXTENSIBLE,
+	/// 1-8 каналов. Чанки кроме "fmt " и "data" (LIST, JUNK, ...) пропускаются
+	bool ParseWav(const void* data, size_t size, WavData& out);
+
+	/// Декодирует WAV в формат микшера: float, стерео (моно дублируется, каналы после
+	/// второго отбрасываются), частота sampleRate (линейная интерполяция)
+	bool DecodeWav(const void* data, size_t size, int sampleRate, std::vector<float>& out);
+}
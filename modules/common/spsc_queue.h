@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace Common
+{
+	/// Очередь без блокировок "один производитель - один потребитель".
+	/// Фиксированная ёмкость (степень двойки), без аллокаций после создания
+	template<typename T, size_t Capacity>
+	class SpscQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		SpscQueue() : m_Head(0), m_Tail(0), m_CachedHead(0), m_CachedTail(0) {}
+
+		/// Вызывается только производителем. false, если очередь заполнена
+		bool TryPush(const T& item)
+		{
+			size_t tail = m_Tail.load(std::memory_order_relaxed);
+			if (tail - m_CachedHead >= Capacity)
+			{
+				m_CachedHead = m_Head.load(std::memory_order_acquire);
+				if (tail - m_CachedHead >= Capacity)
+					return false;
+			}
+
+			m_Items[tail & (Capacity - 1)] = item;
+			m_Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Вызывается только потребителем. false, если очередь пуста
+		bool TryPop(T& item)
+		{
+			size_t head = m_Head.load(std::memory_order_relaxed);
+			if (head == m_CachedTail)
+			{
+				m_CachedTail = m_Tail.load(std::memory_order_acquire);
+				if (head == m_CachedTail)
+					return false;
+			}
+
+			item = m_Items[head & (Capacity - 1)];
+			m_Head.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Приблизительное количество элементов
+		size_t Size() const
+		{
+			return m_Tail.load(std::memory_order_acquire) - m_Head.load(std::memory_order_acquire);
+		}
+
+	private:
+		// Индексы производителя и потребителя на разных кэш-линиях
+		alignas(64) std::atomic<size_t> m_Head;
+		alignas(64) std::atomic<size_t> m_Tail;
+		alignas(64) size_t m_CachedHead;  // копия m_Head у производителя
+		alignas(64) size_t m_CachedTail;  // копия m_Tail у потребителя
+		alignas(64) T m_Items[Capacity];
+	};
+}
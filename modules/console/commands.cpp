@@ -0,0 +1,549 @@
+#include "commands.h"
+#include "console.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+namespace Console
+{
+	namespace Commands
+	{
+		// ============================================================================
+		// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+		// ============================================================================
+
+		// Префиксное дерево имён: узлы в статическом пуле, дети одного узла
+		// связаны списком в алфавитном порядке. Узел 0 - корень
+		struct TrieNode
+		{
+			char c;
+			int16_t firstChild;
+			int16_t nextSibling;
+			int16_t command;  // индекс в g_Commands или -1
+		};
+
+		constexpr int MAX_TRIE_NODES = MAX_COMMANDS * 16;
+
+		static CommandDesc g_Commands[MAX_COMMANDS];
+		static int g_CommandCount = 0;
+
+		static TrieNode g_Nodes[MAX_TRIE_NODES];
+		static int g_NodeCount = 0;
+
+		static char g_History[HISTORY_SIZE][MAX_LINE];
+		static int g_HistoryHead = 0;   // куда запишется следующая строка
+		static int g_HistoryCount = 0;
+
+		// ============================================================================
+		// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+		// ============================================================================
+
+		static bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+		}
+
+		static char ToLower(char c)
+		{
+			return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+		}
+
+		static bool IsNameChar(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '.' || c == '_' || c == '-';
+		}
+
+		static bool EqualsNoCase(const char* a, const char* b)
+		{
+			while (*a && *b)
+			{
+				if (ToLower(*a++) != ToLower(*b++))
+					return false;
+			}
+			return *a == *b;
+		}
+
+		static int NewNode(char c)
+		{
+			if (g_NodeCount >= MAX_TRIE_NODES)
+				return -1;
+
+			TrieNode& node = g_Nodes[g_NodeCount];
+			node.c = c;
+			node.firstChild = -1;
+			node.nextSibling = -1;
+			node.command = -1;
+			return g_NodeCount++;
+		}
+
+		static void EnsureRoot()
+		{
+			if (g_NodeCount == 0)
+				NewNode('\0');
+		}
+
+		static int FindChild(int parent, char c)
+		{
+			for (int child = g_Nodes[parent].firstChild; child >= 0; child = g_Nodes[child].nextSibling)
+			{
+				if (g_Nodes[child].c == c)
+					return child;
+				if (g_Nodes[child].c > c)
+					break;
+			}
+			return -1;
+		}
+
+		// Дети хранятся отсортированными - обход дерева сразу даёт алфавитный порядок
+		static int InsertChild(int parent, char c)
+		{
+			int16_t* link = &g_Nodes[parent].firstChild;
+			while (*link >= 0 && g_Nodes[*link].c < c)
+				link = &g_Nodes[*link].nextSibling;
+
+			if (*link >= 0 && g_Nodes[*link].c == c)
+				return *link;
+
+			int node = NewNode(c);
+			if (node < 0)
+				return -1;
+
+			g_Nodes[node].nextSibling = *link;
+			*link = static_cast<int16_t>(node);
+			return node;
+		}
+
+		static int FindNode(const char* prefix, size_t length)
+		{
+			if (g_NodeCount == 0)
+				return -1;
+
+			int node = 0;
+			for (size_t i = 0; i < length && node >= 0; i++)
+				node = FindChild(node, ToLower(prefix[i]));
+			return node;
+		}
+
+		static void Collect(int node, const CommandDesc** results, int maxResults, int& count)
+		{
+			if (g_Nodes[node].command >= 0)
+			{
+				if (count < maxResults)
+					results[count] = &g_Commands[g_Nodes[node].command];
+				count++;
+			}
+
+			for (int child = g_Nodes[node].firstChild; child >= 0; child = g_Nodes[child].nextSibling)
+				Collect(child, results, maxResults, count);
+		}
+
+		static const char* TypeName(char type)
+		{
+			switch (type)
+			{
+			case 'i': return "int";
+			case 'f': return "float";
+			case 'b': return "bool";
+			case 's': return "string";
+			}
+			return "?";
+		}
+
+		// "s|i" -> "<string> [int]"
+		static void FormatUsage(const char* signature, char* out, size_t outSize)
+		{
+			size_t length = 0;
+			bool optional = false;
+			out[0] = '\0';
+
+			for (const char* p = signature; *p && length < outSize; p++)
+			{
+				if (*p == '|')
+				{
+					optional = true;
+					continue;
+				}
+
+				int written = snprintf(out + length, outSize - length, optional ? "%s[%s]" : "%s<%s>",
+					length ? " " : "", TypeName(*p));
+				if (written < 0)
+					break;
+				length += static_cast<size_t>(written);
+			}
+		}
+
+		static bool ParseBool(const char* text, bool& out)
+		{
+			static const char* const yes[] = { "1", "true", "on", "yes" };
+			static const char* const no[] = { "0", "false", "off", "no" };
+			for (size_t i = 0; i < sizeof(yes) / sizeof(yes[0]); i++)
+			{
+				if (EqualsNoCase(text, yes[i])) { out = true; return true; }
+				if (EqualsNoCase(text, no[i])) { out = false; return true; }
+			}
+			return false;
+		}
+
+		static bool ParseArg(char type, const Token& token, Arg& arg)
+		{
+			arg.s = token.text;
+			arg.i = 0;
+			arg.f = 0.0;
+			arg.b = false;
+
+			char* end = nullptr;
+			errno = 0;
+
+			switch (type)
+			{
+			case 'i':
+				arg.type = ArgType::Int;
+				arg.i = strtoll(token.text, &end, 0);
+				arg.f = static_cast<double>(arg.i);
+				arg.b = arg.i != 0;
+				return token.length > 0 && *end == '\0' && errno == 0;
+			case 'f':
+				arg.type = ArgType::Float;
+				arg.f = strtod(token.text, &end);
+				arg.i = static_cast<int64_t>(arg.f);
+				return token.length > 0 && *end == '\0' && errno == 0;
+			case 'b':
+				arg.type = ArgType::Bool;
+				if (!ParseBool(token.text, arg.b))
+					return false;
+				arg.i = arg.b ? 1 : 0;
+				arg.f = static_cast<double>(arg.i);
+				return true;
+			case 's':
+				arg.type = ArgType::String;
+				return true;
+			}
+			return false;
+		}
+
+		// ============================================================================
+		// РЕАЛИЗАЦИЯ
+		// ============================================================================
+
+		int Tokenize(char* line, Token* tokens, int maxTokens)
+		{
+			int count = 0;
+			char* read = line;
+
+			for (;;)
+			{
+				while (IsSpace(*read))
+					read++;
+				if (*read == '\0')
+					break;
+
+				if (count >= maxTokens)
+					return -1;
+
+				Token& token = tokens[count++];
+				token.quoted = (*read == '"');
+
+				if (token.quoted)
+				{
+					// Экранирование сжимает строку на месте: write отстаёт от read
+					char* write = ++read;
+					token.text = write;
+					for (;;)
+					{
+						if (*read == '\0')
+							return -1;  // незакрытая кавычка
+						if (*read == '"')
+							break;
+						if (*read == '\\' && (read[1] == '"' || read[1] == '\\'))
+							read++;
+						*write++ = *read++;
+					}
+					read++;
+					token.length = static_cast<size_t>(write - token.text);
+					*write = '\0';
+				}
+				else
+				{
+					token.text = read;
+					while (*read && !IsSpace(*read))
+						read++;
+					token.length = static_cast<size_t>(read - token.text);
+				}
+
+				// Разделитель после токена заменяется нулём
+				if (!token.quoted && *read)
+					*read++ = '\0';
+			}
+
+			return count;
+		}
+
+		bool ParseArgs(const char* signature, const Token* tokens, int count, Args& out,
+			char* error, size_t errorSize)
+		{
+			out.count = 0;
+			bool optional = false;
+
+			for (const char* p = signature; *p; p++)
+			{
+				if (*p == '|')
+				{
+					optional = true;
+					continue;
+				}
+
+				int index = out.count;
+				if (index >= count)
+				{
+					if (optional)
+						break;
+					snprintf(error, errorSize, "missing argument %d (%s)", index + 1, TypeName(*p));
+					return false;
+				}
+
+				if (index >= MAX_ARGS || !ParseArg(*p, tokens[index], out.values[index]))
+				{
+					snprintf(error, errorSize, "argument %d: expected %s, got '%s'",
+						index + 1, TypeName(*p), tokens[index].text);
+					return false;
+				}
+				out.count++;
+			}
+
+			if (out.count < count)
+			{
+				snprintf(error, errorSize, "too many arguments (%d, expected at most %d)", count, out.count);
+				return false;
+			}
+			return true;
+		}
+
+		bool Register(const CommandDesc& desc)
+		{
+			if (!desc.name || !desc.fn || !desc.signature || g_CommandCount >= MAX_COMMANDS)
+				return false;
+
+			size_t length = strlen(desc.name);
+			if (length == 0 || length >= MAX_NAME)
+				return false;
+			for (size_t i = 0; i < length; i++)
+			{
+				if (!IsNameChar(desc.name[i]))
+					return false;
+			}
+
+			EnsureRoot();
+			int node = 0;
+			for (size_t i = 0; i < length && node >= 0; i++)
+				node = InsertChild(node, desc.name[i]);
+
+			if (node < 0 || g_Nodes[node].command >= 0)
+				return false;
+
+			g_Commands[g_CommandCount] = desc;
+			g_Nodes[node].command = static_cast<int16_t>(g_CommandCount);
+			g_CommandCount++;
+			return true;
+		}
+
+		const CommandDesc* Find(const char* name, size_t length)
+		{
+			int node = FindNode(name, length);
+			if (node < 0 || g_Nodes[node].command < 0)
+				return nullptr;
+			return &g_Commands[g_Nodes[node].command];
+		}
+
+		bool Execute(const char* line)
+		{
+			if (!line)
+				return false;
+
+			char buffer[MAX_LINE];
+			size_t length = strlen(line);
+			if (length >= MAX_LINE)
+			{
+				Error("Command line is too long (max %d characters)", static_cast<int>(MAX_LINE - 1));
+				return false;
+			}
+			memcpy(buffer, line, length + 1);
+
+			Token tokens[MAX_TOKENS];
+			int count = Tokenize(buffer, tokens, MAX_TOKENS);
+			if (count < 0)
+			{
+				Error("Unterminated quote or more than %d arguments", MAX_ARGS);
+				return false;
+			}
+			if (count == 0)
+				return false;
+
+			const CommandDesc* command = Find(tokens[0].text, tokens[0].length);
+			if (!command)
+			{
+				Error("Unknown command '%s' (type 'help')", tokens[0].text);
+				return false;
+			}
+
+			Args args;
+			char error[128];
+			if (!ParseArgs(command->signature, tokens + 1, count - 1, args, error, sizeof(error)))
+			{
+				char usage[96];
+				FormatUsage(command->signature, usage, sizeof(usage));
+				Error("%s: %s. Usage: %s %s", command->name, error, command->name, usage);
+				return false;
+			}
+
+			command->fn(args, command->user);
+			return true;
+		}
+
+		int Complete(char* buffer, size_t bufferSize)
+		{
+			char* start = buffer;
+			while (IsSpace(*start))
+				start++;
+
+			// Дополняется только имя команды
+			size_t length = strlen(start);
+			for (size_t i = 0; i < length; i++)
+			{
+				if (IsSpace(start[i]))
+					return 0;
+			}
+
+			int node = FindNode(start, length);
+			if (node < 0)
+				return 0;
+
+			const CommandDesc* matches[16];
+			int count = 0;
+			Collect(node, matches, 16, count);
+
+			// Спускаемся, пока путь однозначен: это общий префикс всех совпадений
+			size_t end = static_cast<size_t>(start - buffer) + length;
+			for (size_t i = 0; i < length; i++)
+				start[i] = ToLower(start[i]);
+			while (g_Nodes[node].command < 0 && g_Nodes[node].firstChild >= 0 &&
+				g_Nodes[g_Nodes[node].firstChild].nextSibling < 0 && end + 1 < bufferSize)
+			{
+				node = g_Nodes[node].firstChild;
+				buffer[end++] = g_Nodes[node].c;
+			}
+
+			if (count == 1 && end + 1 < bufferSize)
+				buffer[end++] = ' ';
+			buffer[end] = '\0';
+
+			if (count > 1)
+			{
+				int shown = count < 16 ? count : 16;
+				for (int i = 0; i < shown; i++)
+					Log("  %-20s %s", matches[i]->name, matches[i]->help);
+				if (count > shown)
+					Log("  ... %d more", count - shown);
+			}
+			return count;
+		}
+
+		int ListByPrefix(const char* prefix, const CommandDesc** results, int maxResults)
+		{
+			int node = FindNode(prefix ? prefix : "", prefix ? strlen(prefix) : 0);
+			if (node < 0)
+				return 0;
+
+			int count = 0;
+			Collect(node, results, maxResults, count);
+			return count < maxResults ? count : maxResults;
+		}
+
+		int GetCount()
+		{
+			return g_CommandCount;
+		}
+
+		void PushHistory(const char* line)
+		{
+			if (!line || !*line)
+				return;
+
+			// Повтор последней команды не засоряет историю
+			const char* last = GetHistory(0);
+			if (last && strcmp(last, line) == 0)
+				return;
+
+			snprintf(g_History[g_HistoryHead], MAX_LINE, "%s", line);
+			g_HistoryHead = (g_HistoryHead + 1) % HISTORY_SIZE;
+			if (g_HistoryCount < HISTORY_SIZE)
+				g_HistoryCount++;
+		}
+
+		const char* GetHistory(int back)
+		{
+			if (back < 0 || back >= g_HistoryCount)
+				return nullptr;
+			return g_History[(g_HistoryHead - 1 - back + HISTORY_SIZE) % HISTORY_SIZE];
+		}
+
+		int GetHistoryCount()
+		{
+			return g_HistoryCount;
+		}
+
+		// ============================================================================
+		// ВСТРОЕННЫЕ КОМАНДЫ
+		// ============================================================================
+
+		static void HelpCommand(const Args& args, void*)
+		{
+			const CommandDesc* commands[MAX_COMMANDS];
+			int count = ListByPrefix(args.GetString(0), commands, MAX_COMMANDS);
+			if (count == 0)
+			{
+				Warning("No commands matching '%s'", args.GetString(0));
+				return;
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				char usage[96];
+				FormatUsage(commands[i]->signature, usage, sizeof(usage));
+				Log("  %-18s %-22s %s", commands[i]->name, usage, commands[i]->help);
+			}
+		}
+
+		static void ClearCommand(const Args&, void*)
+		{
+			Clear();
+		}
+
+		static void EchoCommand(const Args& args, void*)
+		{
+			Log("%s", args.GetString(0));
+		}
+
+		static void LogStatsCommand(const Args&, void*)
+		{
+			Log("Log: dropped %llu message(s) on ring overflow, %llu written to the file only (window queue full)",
+				static_cast<unsigned long long>(GetDroppedCount()), static_cast<unsigned long long>(GetWindowDroppedCount()));
+		}
+
+		void RegisterBuiltins()
+		{
+			Register({ "help", "|s", "list commands (optionally by prefix)", HelpCommand });
+			Register({ "clear", "", "clear the console", ClearCommand });
+			Register({ "echo", "s", "print a string", EchoCommand });
+			Register({ "log.stats", "", "console ring statistics", LogStatsCommand });
+		}
+
+		void Reset()
+		{
+			g_CommandCount = 0;
+			g_NodeCount = 0;
+			g_HistoryHead = 0;
+			g_HistoryCount = 0;
+		}
+	}
+}
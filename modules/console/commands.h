@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Console
+{
+	namespace Commands
+	{
+		/// Максимальная длина строки команды
+		constexpr size_t MAX_LINE = 256;
+
+		/// Максимальное количество токенов в строке (имя команды + аргументы)
+		constexpr int MAX_TOKENS = 9;
+
+		/// Максимальное количество аргументов команды
+		constexpr int MAX_ARGS = MAX_TOKENS - 1;
+
+		/// Максимальное количество команд
+		constexpr int MAX_COMMANDS = 128;
+
+		/// Максимальная длина имени команды
+		constexpr size_t MAX_NAME = 32;
+
+		/// Размер истории введённых команд
+		constexpr int HISTORY_SIZE = 32;
+
+		/// Токен: указывает в буфер строки, который Tokenize разрезает нулями
+		struct Token
+		{
+			const char* text;
+			size_t length;
+			bool quoted;
+		};
+
+		/// Тип аргумента в сигнатуре: 'i' - целое, 'f' - дробное, 'b' - bool, 's' - строка
+		enum class ArgType : uint8_t
+		{
+			Int,
+			Float,
+			Bool,
+			String
+		};
+
+		struct Arg
+		{
+			ArgType type;
+			int64_t i;
+			double f;
+			bool b;
+			const char* s;  // исходный текст токена (для любого типа)
+		};
+
+		/// Разобранные аргументы. Живут только во время вызова команды
+		struct Args
+		{
+			int count = 0;
+			Arg values[MAX_ARGS];
+
+			bool Has(int index) const { return index >= 0 && index < count; }
+			int64_t GetInt(int index, int64_t fallback = 0) const { return Has(index) ? values[index].i : fallback; }
+			double GetFloat(int index, double fallback = 0.0) const { return Has(index) ? values[index].f : fallback; }
+			bool GetBool(int index, bool fallback = false) const { return Has(index) ? values[index].b : fallback; }
+			const char* GetString(int index, const char* fallback = "") const { return Has(index) ? values[index].s : fallback; }
+		};
+
+		/// Обработчик команды
+		typedef void (*CommandFn)(const Args& args, void* user);
+
+		/// Описание команды. name/signature/help должны жить всё время работы (литералы).
+		/// signature - типы аргументов по порядку, после '|' идут необязательные:
+		/// "" - без аргументов, "b" - один bool, "s|i" - строка и необязательное целое
+		struct CommandDesc
+		{
+			const char* name = "";
+			const char* signature = "";
+			const char* help = "";
+			CommandFn fn = nullptr;
+			void* user = nullptr;
+		};
+
+		/// Разрезает строку на токены (пробелы - разделители, "..." - один токен,
+		/// внутри кавычек \" и \\). Возвращает количество токенов или -1 при ошибке
+		int Tokenize(char* line, Token* tokens, int maxTokens);
+
+		/// Разбирает токены по сигнатуре. При ошибке пишет причину в error и возвращает false
+		bool ParseArgs(const char* signature, const Token* tokens, int count, Args& out,
+			char* error, size_t errorSize);
+
+		/// Регистрирует команду. false, если имя занято, некорректно или нет места
+		bool Register(const CommandDesc& desc);
+
+		/// Находит команду по точному имени
+		const CommandDesc* Find(const char* name, size_t length);
+
+		/// Выполняет строку: разбор, проверка аргументов, вызов. Ошибки пишутся в консоль
+		bool Execute(const char* line);
+
+		/// Дополняет имя команды в buffer до общего префикса всех подходящих команд.
+		/// Возвращает количество подходящих команд (при > 1 они выводятся в консоль)
+		int Complete(char* buffer, size_t bufferSize);
+
+		/// Перебирает команды с именем, начинающимся с prefix, в алфавитном порядке.
+		/// Возвращает количество найденных (не больше maxResults)
+		int ListByPrefix(const char* prefix, const CommandDesc** results, int maxResults);
+
+		/// Количество зарегистрированных команд
+		int GetCount();
+
+		/// Добавляет строку в историю
+		void PushHistory(const char* line);
+
+		/// Строка истории: 0 - последняя введённая. nullptr, если такой нет
+		const char* GetHistory(int back);
+
+		/// Количество строк в истории
+		int GetHistoryCount();
+
+		/// Регистрирует встроенные команды консоли (help, clear, log.stats)
+		void RegisterBuiltins();
+
+		/// Удаляет все команды и историю
+		void Reset();
+	}
+}
@@ -1,8 +1,19 @@
 #include "console.h"
 #include "../../deps/imgui/imgui.h"
-#include <windows.h>
+#include "../input/input.h"
+#include "../common/spsc_queue.h"
+#include "log_sink.h"
+#include "log_index.h"
+#include "commands.h"
 #include <cstdio>
 #include <cstdarg>
+#include <cstring>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
 
 namespace Console
 {
@@ -10,21 +21,460 @@ namespace Console
 	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
 	// ============================================================================
 
-	static std::vector<LogMessage> g_Logs;
+	// Кольцо, в которое пишут все потоки (InitHookThread, IL2CPP, render thread)
+	static LogRing<4096> g_Ring;
+
+	// Буфер окна консоли: кольцо фиксированного размера, вытеснение за O(1).
+	// Блоки выделяются по мере роста истории. Принадлежит render thread
+	static LogMessage* g_LogChunks[MAX_LOGS / LOG_CHUNK_SIZE] = {};
+	static size_t g_LogHead = 0;   // индекс самого старого сообщения, всегда (g_NextSeq - g_LogCount) % MAX_LOGS
+	static size_t g_LogCount = 0;
+	static uint64_t g_NextSeq = 0;  // порядковый номер следующего сообщения окна
+	static uint64_t g_NextLine = 0; // сквозной номер первой строки следующего сообщения
+	static float g_MaxLineWidth = 0.0f;
+
+	// Фильтр окна консоли
+	static char g_FilterBuffer[128] = {};
+	static bool g_FilterRegex = false;
+	static bool g_FilterTypes[3] = { true, true, true };
+	static bool g_FilterValid = true;
+
+	// Цвета по типу сообщения: normal, warning, error
+	static const ImVec4 g_TypeColors[] = {
+		ImVec4(1, 1, 1, 1),
+		ImVec4(1, 1, 0, 1),
+		ImVec4(1, 0, 0, 1)
+	};
+
+	// Поток записи в файл: пока он работает, он единственный читатель g_Ring
+	// и передаёт готовые сообщения в окно через g_WindowQueue
+	static std::thread g_SinkThread;
+	static std::atomic<bool> g_SinkRunning(false);
+	static std::atomic<bool> g_SinkOwnsRing(false);
+	static std::mutex g_SinkMutex;
+	static std::condition_variable g_SinkCv;
+	static LogFile g_LogFile;
+	static Common::SpscQueue<LogRecord, 2048> g_WindowQueue;
+	static std::atomic<uint64_t> g_WindowDropped(0);  // не влезли в g_WindowQueue (есть только в файле)
+
+	static const std::chrono::steady_clock::time_point g_StartTime = std::chrono::steady_clock::now();
+
+	static std::atomic<bool> g_StdoutMirror(true);
+
 	static bool g_IsOpen = false;
-	static float g_LastTime = 0.0f;
+	static int g_ToggleBind = -1;
 	static bool g_AutoScroll = true;
-	static char g_InputBuffer[256] = {};
+	static char g_InputBuffer[Commands::MAX_LINE] = {};
+	static int g_HistoryPos = -1;  // -1 - новая строка, иначе глубина в истории
+	static bool g_RefocusInput = false;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static float Elapsed()
+	{
+		using namespace std::chrono;
+		return duration<float>(steady_clock::now() - g_StartTime).count();
+	}
+
+	// Форматирует сообщение прямо в слот кольца; длинный текст обрезается
+	static void Write(int type, const char* prefix, const char* format, va_list args)
+	{
+		uint64_t ticket = 0;
+		LogSlot* slot = g_Ring.Reserve(ticket);
+		if (!slot) return;
+
+		size_t prefixLen = strlen(prefix);
+		memcpy(slot->text, prefix, prefixLen);
+
+		int written = vsnprintf(slot->text + prefixLen, LOG_TEXT_SIZE - prefixLen, format, args);
+		size_t length = prefixLen + (written > 0 ? static_cast<size_t>(written) : 0);
+		if (length > LOG_TEXT_SIZE - 1)
+			length = LOG_TEXT_SIZE - 1;
+		slot->text[length] = '\0';
+
+		slot->length = static_cast<uint16_t>(length);
+		slot->format = nullptr;
+		slot->formatter = nullptr;
+		slot->timestamp = Elapsed();
+		slot->type = static_cast<uint8_t>(type);
+
+		g_Ring.Commit(slot, ticket);
+	}
+
+	static LogMessage& LogAt(size_t index)
+	{
+		return g_LogChunks[index / LOG_CHUNK_SIZE][index % LOG_CHUNK_SIZE];
+	}
+
+	// Готовый текст сообщения окна: короткий - в самом сообщении, длинный - в longText
+	static const char* TextOf(const LogMessage& msg)
+	{
+		return msg.length < LOG_WINDOW_TEXT_SIZE ? msg.text : msg.longText.get();
+	}
+
+	// Строк в тексте без завершающих переводов строк (для формата отложенного сообщения)
+	static uint16_t CountLines(const char* text)
+	{
+		size_t length = text ? strlen(text) : 0;
+		while (length && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+			length--;
+
+		uint16_t lines = 1;
+		for (size_t i = 0; i < length; i++)
+		{
+			if (text[i] == '\n' && lines < UINT16_MAX)
+				lines++;
+		}
+		return lines;
+	}
+
+	// Текст собирается один раз и хранится целиком. Переводы строк остаются: сообщение
+	// занимает msg.lines строк окна, высота считается при добавлении. fixedLines -
+	// высота отложенного сообщения, посчитанная по формату: переводы строк сверх неё
+	// (из аргументов) заменяются пробелами. Ширина считается при первом показе
+	static void FinalizeText(LogMessage& msg, const char* text, size_t length, uint16_t fixedLines = 0)
+	{
+		if (length > LOG_TEXT_SIZE - 1)
+			length = LOG_TEXT_SIZE - 1;
+		while (length && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+			length--;
+
+		char* out = msg.text;
+		if (length >= LOG_WINDOW_TEXT_SIZE)
+		{
+			if (!msg.longText)
+				msg.longText.reset(new char[LOG_TEXT_SIZE]);
+			out = msg.longText.get();
+		}
+		else
+		{
+			msg.longText.reset();
+		}
+
+		uint16_t lines = 1;
+		for (size_t i = 0; i < length; i++)
+		{
+			char c = text[i];
+			if (c == '\r')
+				c = ' ';
+			else if (c == '\n' && (fixedLines ? lines < fixedLines : lines < UINT16_MAX))
+				lines++;
+			else if (c == '\n')
+				c = ' ';
+			out[i] = c;
+		}
+		out[length] = '\0';
+		msg.length = static_cast<uint16_t>(length);
+		msg.lines = fixedLines ? fixedLines : lines;
+		msg.formatter = nullptr;
+		msg.width = -1.0f;
+	}
+
+	// Отложенное сообщение хранит аргументы до первого показа или поиска по тексту
+	static void ResolveText(LogMessage& msg)
+	{
+		if (!msg.formatter)
+			return;
+
+		char buffer[LOG_TEXT_SIZE];
+		size_t length = FormatMessage(msg.format, msg.formatter, msg.type, msg.text, buffer, sizeof(buffer));
+		FinalizeText(msg, buffer, length, msg.lines);
+	}
+
+	static bool LookupLog(uint64_t seq, LogView& out)
+	{
+		if (seq >= g_NextSeq || seq < g_NextSeq - g_LogCount)
+			return false;
+
+		LogMessage& msg = LogAt(static_cast<size_t>(seq % MAX_LOGS));
+		ResolveText(msg);
+		out.text = TextOf(msg);
+		out.length = msg.length;
+		out.type = msg.type;
+		out.lines = msg.lines;
+		return true;
+	}
+
+	// Индекс поиска создаётся при первом сообщении окна
+	static LogIndex& Index()
+	{
+		static LogIndex index(MAX_LOGS, LookupLog);
+		return index;
+	}
+
+	// Позиция в окне (от g_LogHead) сообщения, которому принадлежит строка line
+	static size_t FindRowAtLine(uint64_t line)
+	{
+		uint64_t target = LogAt(g_LogHead).lineStart + line;
+		size_t low = 0, high = g_LogCount;
+		while (high - low > 1)
+		{
+			size_t mid = (low + high) / 2;
+			if (LogAt((g_LogHead + mid) % MAX_LOGS).lineStart <= target)
+				low = mid;
+			else
+				high = mid;
+		}
+		return low;
+	}
+
+	static const char* GetText(LogMessage& msg)
+	{
+		ResolveText(msg);
+		const char* text = TextOf(msg);
+		if (msg.width < 0.0f)
+		{
+			msg.width = ImGui::CalcTextSize(text, text + msg.length).x;
+			if (msg.width > g_MaxLineWidth)
+				g_MaxLineWidth = msg.width;
+		}
+		return text;
+	}
+
+	// Принимает LogSlot (из кольца) или LogRecord (из потока записи или уже
+	// отформатированный для stdout)
+	template<typename Message>
+	static void PushToWindow(const Message& slot)
+	{
+		size_t index;
+		if (g_LogCount < MAX_LOGS)
+		{
+			index = (g_LogHead + g_LogCount) % MAX_LOGS;
+			g_LogCount++;
+		}
+		else
+		{
+			// Буфер заполнен - перезаписываем самое старое сообщение
+			index = g_LogHead;
+			g_LogHead = (g_LogHead + 1) % MAX_LOGS;
+		}
+
+		LogMessage*& chunk = g_LogChunks[index / LOG_CHUNK_SIZE];
+		if (!chunk)
+			chunk = new LogMessage[LOG_CHUNK_SIZE];
+
+		LogMessage& msg = chunk[index % LOG_CHUNK_SIZE];
+		msg.format = slot.format;
+		msg.timestamp = slot.timestamp;
+		msg.type = slot.type;
+
+		if (slot.formatter && slot.length <= LOG_WINDOW_TEXT_SIZE)
+		{
+			// Аргументы копируются как есть: форматирование - при показе (GetText)
+			memcpy(msg.text, slot.text, slot.length);
+			msg.longText.reset();
+			msg.formatter = slot.formatter;
+			msg.length = slot.length;
+			msg.lines = CountLines(slot.format);
+			msg.width = -1.0f;
+		}
+		else if (slot.formatter)
+		{
+			// Аргументы не помещаются в сообщение окна - собираем текст сразу
+			char buffer[LOG_TEXT_SIZE];
+			size_t length = FormatMessage(slot.format, slot.formatter, slot.type, slot.text, buffer, sizeof(buffer));
+			FinalizeText(msg, buffer, length);
+		}
+		else
+		{
+			FinalizeText(msg, slot.text, slot.length);
+		}
+
+		// Сквозной номер первой строки: позиция сообщения в окне без прохода по истории
+		msg.lineStart = g_NextLine;
+		g_NextLine += msg.lines;
+
+		// Готовый текст сразу попадает в индекс поиска, отложенный - через IndexPending
+		uint64_t seq = g_NextSeq++;
+		Index().Add(seq, msg.type, msg.formatter ? nullptr : TextOf(msg), msg.length, msg.lines);
+		Index().SetOldest(g_NextSeq - g_LogCount);
+	}
+
+	// Собирает текст слота кольца (поток записи, дублирование в stdout)
+	static void FormatRecord(const LogSlot& slot, LogRecord& record)
+	{
+		record.format = nullptr;
+		record.formatter = nullptr;
+		record.timestamp = slot.timestamp;
+		record.type = slot.type;
+		record.length = static_cast<uint16_t>(FormatMessage(slot.format, slot.formatter, slot.type,
+			slot.text, record.text, sizeof(record.text)));
+	}
+
+	static void MirrorToStdout(int type, const char* text)
+	{
+		if (!g_StdoutMirror.load(std::memory_order_relaxed))
+			return;
+
+		// Выводим в отладчик
+		if (type == 0)
+			printf("[LOG] %s\n", text);
+		else
+			printf("%s\n", text);
+	}
+
+	// Забирает всё, что накопилось в кольце, одной пачкой: файл, stdout и окно консоли.
+	// Читатель g_Ring один - поток записи или (после его остановки) вызывающий StopFileSink.
+	// Возвращает число сообщений; flushNow - среди них была ошибка
+	static size_t DrainToFile(bool& flushNow)
+	{
+		char line[LOG_TEXT_SIZE + 32];
+		LogRecord record;
+		size_t count = 0;
+
+		while (LogSlot* slot = g_Ring.Peek())
+		{
+			FormatRecord(*slot, record);
+			g_Ring.Release(slot);
+
+			int length = snprintf(line, sizeof(line), "[%10.3f] %s\n", record.timestamp, record.text);
+			if (length > 0)
+				g_LogFile.Write(line, (std::min)(static_cast<size_t>(length), sizeof(line) - 1));
+			MirrorToStdout(record.type, record.text);
+
+			// Окно консоли не должно тормозить запись: при переполнении сообщение
+			// остаётся только в файле
+			if (!g_WindowQueue.TryPush(record))
+				g_WindowDropped.fetch_add(1, std::memory_order_relaxed);
+
+			count++;
+			if (record.type == 2)
+				flushNow = true;
+		}
+		return count;
+	}
+
+	static void SinkMain()
+	{
+		auto lastFlush = std::chrono::steady_clock::now();
+		bool dirty = false;
+
+		for (;;)
+		{
+			bool stopping = !g_SinkRunning.load(std::memory_order_acquire);
+			bool flushNow = false;
+			if (DrainToFile(flushNow))
+				dirty = true;
+
+			auto now = std::chrono::steady_clock::now();
+			if (dirty && (flushNow || now - lastFlush > std::chrono::seconds(1)))
+			{
+				g_LogFile.Flush();
+				lastFlush = now;
+				dirty = false;
+			}
+
+			if (stopping)
+				break;
+
+			std::unique_lock<std::mutex> lock(g_SinkMutex);
+			g_SinkCv.wait_for(lock, std::chrono::milliseconds(5));
+		}
+
+		g_LogFile.Flush();
+		g_LogFile.Close();
+
+		// Последнее действие потока: StopFileSink ждёт этого флага, а не выхода потока
+		g_SinkOwnsRing.store(false, std::memory_order_release);
+	}
 
 	// ============================================================================
 	// РЕАЛИЗАЦИЯ
 	// ============================================================================
 
+	namespace Deferred
+	{
+		LogSlot* Reserve(uint64_t& ticket)
+		{
+			return g_Ring.Reserve(ticket);
+		}
+
+		void Commit(LogSlot* slot, uint64_t ticket)
+		{
+			slot->timestamp = Elapsed();
+			g_Ring.Commit(slot, ticket);
+		}
+	}
+
+	size_t FormatMessage(const char* format, FormatFn formatter, int type,
+		const char* payload, char* out, size_t outSize)
+	{
+		if (!formatter)
+		{
+			size_t length = strlen(payload);
+			if (length > outSize - 1) length = outSize - 1;
+			memcpy(out, payload, length);
+			out[length] = '\0';
+			return length;
+		}
+
+		static const char* const prefixes[] = { "", "[WARNING] ", "[ERROR] " };
+		const char* prefix = (type >= 0 && type <= 2) ? prefixes[type] : "";
+		size_t prefixLen = strlen(prefix);
+		memcpy(out, prefix, prefixLen);
+
+		size_t length = prefixLen + formatter(format, reinterpret_cast<const unsigned char*>(payload),
+			out + prefixLen, outSize - prefixLen);
+		out[length] = '\0';
+		return length;
+	}
+
+	static void ToggleAction(void*)
+	{
+		Toggle();
+	}
+
+	// Tab - дополнение имени команды, стрелки - история
+	static int InputCallback(ImGuiInputTextCallbackData* data)
+	{
+		if (data->EventFlag == ImGuiInputTextFlags_CallbackCompletion)
+		{
+			char buffer[Commands::MAX_LINE];
+			memcpy(buffer, data->Buf, static_cast<size_t>(data->BufTextLen) + 1);
+			if (Commands::Complete(buffer, sizeof(buffer)) > 0)
+			{
+				data->DeleteChars(0, data->BufTextLen);
+				data->InsertChars(0, buffer);
+			}
+		}
+		else if (data->EventFlag == ImGuiInputTextFlags_CallbackHistory)
+		{
+			int pos = g_HistoryPos;
+			if (data->EventKey == ImGuiKey_UpArrow && pos + 1 < Commands::GetHistoryCount())
+				pos++;
+			else if (data->EventKey == ImGuiKey_DownArrow && pos >= 0)
+				pos--;
+
+			if (pos != g_HistoryPos)
+			{
+				g_HistoryPos = pos;
+				const char* line = pos >= 0 ? Commands::GetHistory(pos) : "";
+				data->DeleteChars(0, data->BufTextLen);
+				data->InsertChars(0, line);
+			}
+		}
+		return 0;
+	}
+
 	void Initialize()
 	{
-		g_Logs.clear();
+		Clear();
 		g_IsOpen = false;
 		g_AutoScroll = true;
+
+		// F1 - открыть/закрыть консоль
+		if (g_ToggleBind < 0)
+		{
+			Input::Binding bind;
+			bind.key = Input::KEY_F1;
+			bind.action = ToggleAction;
+			g_ToggleBind = Input::Bind(bind);
+		}
+
+		Commands::RegisterBuiltins();
+
 		Log("[Console] Initialized");
 	}
 
@@ -38,100 +488,143 @@ namespace Console
 		g_IsOpen = !g_IsOpen;
 	}
 
+	bool GetMessage(size_t i, LogView& out)
+	{
+		return i < g_LogCount && LookupLog(g_NextSeq - g_LogCount + i, out);
+	}
+
 	void Clear()
 	{
-		g_Logs.clear();
+		// Номера не сбрасываются (индекс поиска требует возрастания), поэтому голова
+		// встаёт туда, куда попадёт следующее сообщение: LogAt(seq % MAX_LOGS) остаётся верным
+		g_LogHead = static_cast<size_t>(g_NextSeq % MAX_LOGS);
+		g_LogCount = 0;
+		g_MaxLineWidth = 0.0f;
+		Index().Clear();
 	}
 
 	void Log(const char* format, ...)
 	{
 		if (!format) return;
 
-		char buffer[512] = {};
 		va_list args;
 		va_start(args, format);
-		vsprintf_s(buffer, sizeof(buffer), format, args);
+		Write(0, "", format, args);  // Normal
 		va_end(args);
-
-		LogMessage msg;
-		msg.text = buffer;
-		msg.timestamp = static_cast<float>(ImGui::GetTime());
-		msg.type = 0;  // Normal
-
-		g_Logs.push_back(msg);
-
-		// Выводим в отладчик
-		printf("[LOG] %s\n", buffer);
-
-		// Ограничиваем размер буфера до 1000 сообщений
-		if (g_Logs.size() > 1000)
-		{
-			g_Logs.erase(g_Logs.begin());
-		}
 	}
 
 	void Warning(const char* format, ...)
 	{
 		if (!format) return;
 
-		char buffer[512] = {};
 		va_list args;
 		va_start(args, format);
-		vsprintf_s(buffer, sizeof(buffer), format, args);
+		Write(1, "[WARNING] ", format, args);  // Warning
 		va_end(args);
-
-		LogMessage msg;
-		msg.text = std::string("[WARNING] ") + buffer;
-		msg.timestamp = static_cast<float>(ImGui::GetTime());
-		msg.type = 1;  // Warning
-
-		g_Logs.push_back(msg);
-
-		printf("[WARNING] %s\n", buffer);
-
-		if (g_Logs.size() > 1000)
-		{
-			g_Logs.erase(g_Logs.begin());
-		}
 	}
 
 	void Error(const char* format, ...)
 	{
 		if (!format) return;
 
-		char buffer[512] = {};
 		va_list args;
 		va_start(args, format);
-		vsprintf_s(buffer, sizeof(buffer), format, args);
+		Write(2, "[ERROR] ", format, args);  // Error
 		va_end(args);
+	}
+
+	void Update()
+	{
+		// Сообщения, уже записанные потоком записи
+		LogRecord record;
+		while (g_WindowQueue.TryPop(record))
+			PushToWindow(record);
+
+		// Потока записи нет - забираем всё, что накопилось в кольце с прошлого кадра.
+		// Текст для stdout собирается один раз и сразу уходит в окно; без дублирования
+		// отложенные сообщения остаются аргументами до показа или индексации
+		if (!g_SinkOwnsRing.load(std::memory_order_acquire))
+		{
+			bool mirror = g_StdoutMirror.load(std::memory_order_relaxed);
+			while (LogSlot* slot = g_Ring.Peek())
+			{
+				if (mirror)
+				{
+					FormatRecord(*slot, record);
+					MirrorToStdout(record.type, record.text);
+					PushToWindow(record);
+				}
+				else
+				{
+					PushToWindow(*slot);
+				}
+				g_Ring.Release(slot);
+			}
+		}
 
-		LogMessage msg;
-		msg.text = std::string("[ERROR] ") + buffer;
-		msg.timestamp = static_cast<float>(ImGui::GetTime());
-		msg.type = 2;  // Error
+		// Отложенные сообщения попадают в индекс понемногу, а не все при первом поиске
+		if (g_LogCount)
+			Index().IndexPending(INDEX_BUDGET);
+	}
 
-		g_Logs.push_back(msg);
+	bool StartFileSink(const char* path, size_t maxFileBytes, int maxBackups)
+	{
+		if (g_SinkRunning.load())
+			return true;
 
-		printf("[ERROR] %s\n", buffer);
+		if (!g_LogFile.Open(path, maxFileBytes, maxBackups))
+			return false;
 
-		if (g_Logs.size() > 1000)
-		{
-			g_Logs.erase(g_Logs.begin());
-		}
+		g_SinkOwnsRing.store(true, std::memory_order_release);
+		g_SinkRunning.store(true, std::memory_order_release);
+		g_SinkThread = std::thread(SinkMain);
+		return true;
 	}
 
-	void Update()
+	void StopFileSink(bool processExit)
 	{
-		// Проверяем нажатие F1
-		if ((GetAsyncKeyState(VK_F1) & 0x8000) != 0)
+		if (!g_SinkRunning.exchange(false))
+			return;
+
+		if (processExit)
+		{
+			// Система уже остановила поток, возможно до последнего прохода: дописываем
+			// кольцо здесь. Мьютексы не трогаем - их мог держать убитый поток
+			bool flushNow = false;
+			DrainToFile(flushNow);
+			g_LogFile.Flush();
+			g_LogFile.Close();
+			g_SinkOwnsRing.store(false, std::memory_order_release);
+		}
+		else
 		{
-			float currentTime = static_cast<float>(ImGui::GetTime());
-			if (currentTime - g_LastTime > 0.5f)  // Debounce 500ms
 			{
-				Toggle();
-				g_LastTime = currentTime;
+				std::lock_guard<std::mutex> lock(g_SinkMutex);
+				g_SinkCv.notify_all();
 			}
+
+			// Не join: выход потока ждёт loader lock, а FreeLibrary держит его на время DllMain
+			while (g_SinkOwnsRing.load(std::memory_order_acquire))
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
 		}
+
+		if (g_SinkThread.joinable())
+			g_SinkThread.detach();
+	}
+
+	void SetStdoutMirror(bool enabled)
+	{
+		g_StdoutMirror.store(enabled, std::memory_order_relaxed);
+	}
+
+	uint64_t GetDroppedCount()
+	{
+		return g_Ring.GetDropped();
+	}
+
+	uint64_t GetWindowDroppedCount()
+	{
+		return g_WindowDropped.load(std::memory_order_relaxed);
 	}
 
 	void Render()
@@ -150,27 +643,103 @@ namespace Console
 			ImGui::SameLine();
 			ImGui::Checkbox("Auto-scroll", &g_AutoScroll);
 
+			// Фильтр: подстрока или regex + типы сообщений
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(250.0f);
+			ImGui::InputTextWithHint("##filter", "Filter", g_FilterBuffer, sizeof(g_FilterBuffer));
+			ImGui::SameLine();
+			ImGui::Checkbox("Regex", &g_FilterRegex);
+			ImGui::SameLine();
+			ImGui::Checkbox("Log", &g_FilterTypes[0]);
+			ImGui::SameLine();
+			ImGui::Checkbox("Warning", &g_FilterTypes[1]);
+			ImGui::SameLine();
+			ImGui::Checkbox("Error", &g_FilterTypes[2]);
+
+			uint8_t severity = (g_FilterTypes[0] ? Severity_Log : 0) |
+				(g_FilterTypes[1] ? Severity_Warning : 0) | (g_FilterTypes[2] ? Severity_Error : 0);
+			g_FilterValid = Index().SetQuery(g_FilterBuffer, g_FilterRegex, severity);
+
+			bool filtering = Index().IsFiltering();
+			if (filtering)
+			{
+				ImGui::SameLine();
+				if (g_FilterValid)
+					ImGui::TextDisabled("%zu (%.2f ms)", Index().GetResultCount(), Index().GetLastQueryMs());
+				else
+					ImGui::TextColored(g_TypeColors[2], "bad regex");
+			}
+
+			// Сообщения, которые поток записи не смог передать окну
+			uint64_t windowDropped = GetWindowDroppedCount();
+			if (windowDropped)
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(g_TypeColors[1], "%llu not shown (see log file)",
+					static_cast<unsigned long long>(windowDropped));
+			}
+
 			ImGui::Separator();
 
 			// Область с логами
 			ImGui::BeginChild("LogArea", ImVec2(0, -30), true, ImGuiWindowFlags_HorizontalScrollbar);
 
-			for (const auto& log : g_Logs)
+			// Виртуализация по строкам окна: высота строки одна для всех, число строк
+			// каждого сообщения посчитано при добавлении, поэтому многострочные
+			// сообщения не ломают клиппер
+			uint64_t lineCount = 0;
+			if (filtering)
+				lineCount = Index().GetResultLineCount();
+			else if (g_LogCount)
+				lineCount = g_NextLine - LogAt(g_LogHead).lineStart;
+
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(lineCount), ImGui::GetTextLineHeightWithSpacing());
+			while (clipper.Step())
 			{
-				// Цвет в зависимости от типа сообщения
-				switch (log.type)
+				size_t row = filtering
+					? Index().FindResultAtLine(static_cast<uint64_t>(clipper.DisplayStart))
+					: FindRowAtLine(static_cast<uint64_t>(clipper.DisplayStart));
+				int line = clipper.DisplayStart;
+				while (line < clipper.DisplayEnd)
 				{
-				case 0:  // Normal
-					ImGui::TextColored(ImVec4(1, 1, 1, 1), "%s", log.text.c_str());
-					break;
-				case 1:  // Warning
-					ImGui::TextColored(ImVec4(1, 1, 0, 1), "%s", log.text.c_str());
-					break;
-				case 2:  // Error
-					ImGui::TextColored(ImVec4(1, 0, 0, 1), "%s", log.text.c_str());
-					break;
+					LogMessage& log = LogAt(filtering
+						? static_cast<size_t>(Index().GetResult(row) % MAX_LOGS)
+						: (g_LogHead + row) % MAX_LOGS);
+					uint64_t first = filtering
+						? Index().GetResultLine(row)
+						: log.lineStart - LogAt(g_LogHead).lineStart;
+					const char* text = GetText(log);
+					const char* end = text + log.length;
+
+					// Пропускаем строки сообщения выше видимой области
+					for (uint64_t skip = static_cast<uint64_t>(line) - first; skip && text < end; skip--)
+					{
+						const char* newline = static_cast<const char*>(memchr(text, '\n', end - text));
+						text = newline ? newline + 1 : end;
+					}
+
+					// Цвет в зависимости от типа сообщения
+					ImGui::PushStyleColor(ImGuiCol_Text, g_TypeColors[log.type < 3 ? log.type : 0]);
+					for (uint64_t k = static_cast<uint64_t>(line) - first; k < log.lines && line < clipper.DisplayEnd; k++, line++)
+					{
+						const char* newline = static_cast<const char*>(memchr(text, '\n', end - text));
+						const char* lineEnd = newline ? newline : end;
+						ImGui::TextUnformatted(text, lineEnd);
+						text = newline ? newline + 1 : end;
+					}
+					ImGui::PopStyleColor();
+					row++;
 				}
 			}
+			clipper.End();
+
+			// Горизонтальная прокрутка по самой длинной из уже показанных строк
+			if (g_MaxLineWidth > 0.0f)
+			{
+				ImGui::SetCursorPosX(ImGui::GetCursorStartPos().x + g_MaxLineWidth);
+				ImGui::Dummy(ImVec2(0.0f, 0.0f));
+			}
 
 			if (g_AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
 			{
@@ -179,17 +748,45 @@ namespace Console
 
 			ImGui::EndChild();
 
-			// Поле ввода (для будущего использования)
-			ImGui::InputText("##input", g_InputBuffer, sizeof(g_InputBuffer));
+			// Строка команд: Enter - выполнить, Tab - дополнить, стрелки - история
+			if (g_RefocusInput)
+			{
+				ImGui::SetKeyboardFocusHere();
+				g_RefocusInput = false;
+			}
+
+			ImGui::SetNextItemWidth(-FLT_MIN);
+			ImGuiInputTextFlags inputFlags = ImGuiInputTextFlags_EnterReturnsTrue |
+				ImGuiInputTextFlags_CallbackCompletion | ImGuiInputTextFlags_CallbackHistory;
+			if (ImGui::InputTextWithHint("##input", "Command (Tab - complete, 'help' - list)",
+				g_InputBuffer, sizeof(g_InputBuffer), inputFlags, InputCallback))
+			{
+				if (g_InputBuffer[0])
+				{
+					Log("> %s", g_InputBuffer);
+					Commands::PushHistory(g_InputBuffer);
+					Commands::Execute(g_InputBuffer);
+				}
+				g_InputBuffer[0] = '\0';
+				g_HistoryPos = -1;
+				g_AutoScroll = true;
+				g_RefocusInput = true;
+			}
 
 			ImGui::End();
 		}
 	}
 
-	void Cleanup()
+	void Cleanup(bool processExit)
 	{
-		g_Logs.clear();
+		Clear();
 		g_IsOpen = false;
+		Input::Unbind(g_ToggleBind);
+		g_ToggleBind = -1;
+		Commands::Reset();
 		Log("[Console] Cleaned up");
+
+		// Сбрасываем на диск всё, что ещё не записано
+		StopFileSink(processExit);
 	}
 }
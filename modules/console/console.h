@@ -2,17 +2,42 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <ctime>
+#include "log_ring.h"
+#include "log_deferred.h"
 
 namespace Console
 {
+	/// Размер встроенного буфера сообщения окна. Более длинный текст (до LOG_TEXT_SIZE)
+	/// хранится целиком в отдельном буфере longText
+	constexpr size_t LOG_WINDOW_TEXT_SIZE = 200;
+
+	struct LogView;
+
 	struct LogMessage
 	{
-		std::string text;
+		char text[LOG_WINDOW_TEXT_SIZE];  // текст или аргументы, пока formatter != nullptr
+		std::unique_ptr<char[]> longText; // текст длиной от LOG_WINDOW_TEXT_SIZE
+		const char* format;
+		FormatFn formatter;
+		uint64_t lineStart; // сквозной номер первой строки сообщения в окне
 		float timestamp;
-		int type;  // 0 = normal, 1 = warning, 2 = error
+		float width;      // ширина самой длинной строки, считается один раз при форматировании
+		uint16_t length;
+		uint16_t lines;   // строк в окне, считается при добавлении
+		uint8_t type;     // 0 = normal, 1 = warning, 2 = error
 	};
 
+	/// Максимальное количество сообщений в окне консоли
+	constexpr size_t MAX_LOGS = 131072;
+
+	/// Сообщения окна выделяются блоками по мере заполнения
+	constexpr size_t LOG_CHUNK_SIZE = 1024;
+
+	/// Сколько отложенных сообщений Update индексирует для поиска (форматирует) за кадр
+	constexpr size_t INDEX_BUDGET = 256;
+
 	/// Инициализирует консоль
 	void Initialize();
 
@@ -34,12 +59,41 @@ namespace Console
 	/// Добавляет error в лог
 	void Error(const char* format, ...);
 
+	// Для горячих путей (render thread) - CONSOLE_LOG / CONSOLE_WARNING / CONSOLE_ERROR
+	// из log_deferred.h: форматирование откладывается до показа сообщения
+
+	/// Собирает текст сообщения (для отложенных - форматирует). Возвращает длину
+	size_t FormatMessage(const char* format, FormatFn formatter, int type,
+		const char* payload, char* out, size_t outSize);
+
 	/// Рендерит консоль (вызывается из hud)
 	void Render();
 
-	/// Обновляет консоль (вызывается каждый кадр)
+	/// Обновляет консоль: переносит новые сообщения в буфер окна (вызывается каждый кадр)
 	void Update();
 
-	/// Очищает ресурсы консоли
-	void Cleanup();
+	/// Количество сообщений, отброшенных из-за переполнения кольца
+	uint64_t GetDroppedCount();
+
+	/// Количество сообщений, записанных в файл, но не попавших в окно
+	/// (очередь от потока записи к окну переполнена)
+	uint64_t GetWindowDroppedCount();
+
+	/// Полный текст i-го сообщения окна (0 - самое старое) и число его строк
+	bool GetMessage(size_t i, LogView& out);
+
+	/// Запускает фоновый поток, который забирает сообщения пачками, пишет их в файл
+	/// (с ротацией по размеру) и передаёт в окно консоли. Вызывать до первого Update
+	bool StartFileSink(const char* path, size_t maxFileBytes = 8 * 1024 * 1024, int maxBackups = 3);
+
+	/// Дописывает оставшиеся сообщения, сбрасывает файл и останавливает поток. Не ждёт выхода
+	/// потока (можно из DllMain). processExit - DLL_PROCESS_DETACH при завершении процесса:
+	/// поток уже убит системой, кольцо дописывает вызывающий
+	void StopFileSink(bool processExit = false);
+
+	/// Включает/выключает дублирование сообщений в stdout (по умолчанию включено)
+	void SetStdoutMirror(bool enabled);
+
+	/// Очищает ресурсы консоли (processExit - см. StopFileSink)
+	void Cleanup(bool processExit = false);
 }
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include "log_ring.h"
+
+namespace Console
+{
+	namespace Deferred
+	{
+		// ============================================================================
+		// ПРОВЕРКА ФОРМАТА НА ЭТАПЕ КОМПИЛЯЦИИ
+		// ============================================================================
+
+		// Никогда не вызывается: нужна только для проверки format/аргументов компилятором
+#if defined(__GNUC__) || defined(__clang__)
+		__attribute__((format(printf, 1, 2)))
+#endif
+		inline void CheckFormat(
+#if defined(_MSC_VER)
+			_Printf_format_string_
+#endif
+			const char*, ...) {}
+
+		// ============================================================================
+		// КОДИРОВАНИЕ АРГУМЕНТОВ
+		// ============================================================================
+
+		template<typename T>
+		struct IsString : std::integral_constant<bool,
+			std::is_same<T, const char*>::value || std::is_same<T, char*>::value> {};
+
+		template<typename T>
+		struct ArgCheck
+		{
+			static_assert(IsString<T>::value || std::is_arithmetic<T>::value ||
+				std::is_enum<T>::value || std::is_pointer<T>::value,
+				"deferred log arguments must be numbers, enums, pointers or C strings");
+			static constexpr bool value = true;
+		};
+
+		// Фиксированная часть аргумента: значение или длина строки
+		template<typename T>
+		constexpr size_t FixedSize()
+		{
+			return IsString<T>::value ? sizeof(uint16_t) : sizeof(T);
+		}
+
+		template<typename... Args>
+		constexpr size_t TotalFixedSize()
+		{
+			size_t total = 0;
+			size_t sizes[] = { size_t(0), FixedSize<Args>()... };
+			for (size_t s : sizes) total += s;
+			return total;
+		}
+
+		template<typename... Args>
+		constexpr size_t StringCount()
+		{
+			size_t count = 0;
+			bool flags[] = { false, IsString<Args>::value... };
+			for (bool f : flags) count += f ? 1 : 0;
+			return count;
+		}
+
+		struct Writer
+		{
+			unsigned char* cursor;
+			size_t stringBudget;  // сколько символов строк ещё помещается
+		};
+
+		template<typename T>
+		inline typename std::enable_if<!IsString<T>::value>::type Encode(Writer& w, const T& value)
+		{
+			memcpy(w.cursor, &value, sizeof(T));
+			w.cursor += sizeof(T);
+		}
+
+		template<typename T>
+		inline typename std::enable_if<IsString<T>::value>::type Encode(Writer& w, T value)
+		{
+			if (!value) value = "(null)";
+			size_t length = strlen(value);
+			if (length > w.stringBudget) length = w.stringBudget;
+			w.stringBudget -= length;
+
+			uint16_t stored = static_cast<uint16_t>(length);
+			memcpy(w.cursor, &stored, sizeof(stored));
+			memcpy(w.cursor + sizeof(stored), value, length);
+			w.cursor[sizeof(stored) + length] = '\0';
+			w.cursor += sizeof(stored) + length + 1;
+		}
+
+		/// Кодирует аргументы в payload. Возвращает размер или 0, если они не помещаются
+		template<typename... Args>
+		inline size_t EncodeArgs(unsigned char* payload, size_t capacity, Args... args)
+		{
+			constexpr size_t fixed = TotalFixedSize<Args...>() + StringCount<Args...>();
+			if (fixed == 0 || fixed > capacity)
+				return fixed == 0 ? 1 : 0;
+
+			Writer w = { payload, capacity - fixed };
+			int expand[] = { 0, (Encode<Args>(w, args), 0)... };
+			(void)expand;
+			return static_cast<size_t>(w.cursor - payload);
+		}
+
+		// ============================================================================
+		// ДЕКОДИРОВАНИЕ И ФОРМАТИРОВАНИЕ
+		// ============================================================================
+
+		template<typename T>
+		inline typename std::enable_if<!IsString<T>::value, T>::type Decode(const unsigned char*& cursor)
+		{
+			T value;
+			memcpy(&value, cursor, sizeof(T));
+			cursor += sizeof(T);
+			return value;
+		}
+
+		template<typename T>
+		inline typename std::enable_if<IsString<T>::value, const char*>::type Decode(const unsigned char*& cursor)
+		{
+			uint16_t length;
+			memcpy(&length, cursor, sizeof(length));
+			const char* text = reinterpret_cast<const char*>(cursor + sizeof(length));
+			cursor += sizeof(length) + length + 1;
+			return text;
+		}
+
+		template<typename T>
+		struct Decoded { typedef typename std::conditional<IsString<T>::value, const char*, T>::type type; };
+
+		template<typename... Args>
+		size_t Format(const char* format, const unsigned char* payload, char* out, size_t outSize)
+		{
+			const unsigned char* cursor = payload;
+			// Фигурные скобки гарантируют порядок декодирования слева направо
+			std::tuple<typename Decoded<Args>::type...> values{ Decode<Args>(cursor)... };
+			(void)cursor;
+
+			int written = std::apply([&](auto... v) {
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+				return snprintf(out, outSize, format, v...);
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+			}, values);
+
+			if (written < 0)
+				written = 0;
+			return static_cast<size_t>(written) < outSize ? static_cast<size_t>(written) : outSize - 1;
+		}
+
+		/// Резервирует слот в кольце консоли (реализация в console.cpp)
+		LogSlot* Reserve(uint64_t& ticket);
+
+		/// Публикует слот с отметкой времени
+		void Commit(LogSlot* slot, uint64_t ticket);
+
+		template<typename... Args>
+		inline void Log(int type, const char* format, Args... args)
+		{
+			bool checks[] = { true, ArgCheck<Args>::value... };
+			(void)checks;
+
+			uint64_t ticket = 0;
+			LogSlot* slot = Reserve(ticket);
+			if (!slot)
+				return;
+
+			slot->type = static_cast<uint8_t>(type);
+			slot->format = format;
+			slot->formatter = &Format<Args...>;
+
+			// Аргументы пишутся прямо в слот: на вызывающем потоке нет snprintf
+			unsigned char* payload = reinterpret_cast<unsigned char*>(slot->text);
+			size_t size = EncodeArgs<Args...>(payload, LOG_TEXT_SIZE, args...);
+			slot->length = static_cast<uint16_t>(size);
+			if (size == 0)
+			{
+				slot->formatter = nullptr;
+				int written = snprintf(slot->text, LOG_TEXT_SIZE, "(too many log arguments: %s)", format);
+				slot->length = static_cast<uint16_t>(written < static_cast<int>(LOG_TEXT_SIZE) ? written : LOG_TEXT_SIZE - 1);
+			}
+
+			Commit(slot, ticket);
+		}
+	}
+}
+
+/// Логирование с отложенным форматированием. format должен быть строковым литералом:
+/// сохраняется только указатель на него и сырые байты аргументов, а текст собирается,
+/// когда сообщение показывается в окне консоли или выводится
+#define CONSOLE_LOG(format, ...) \
+	do { if (false) Console::Deferred::CheckFormat("" format, ##__VA_ARGS__); \
+		Console::Deferred::Log(0, "" format, ##__VA_ARGS__); } while (0)
+
+#define CONSOLE_WARNING(format, ...) \
+	do { if (false) Console::Deferred::CheckFormat("" format, ##__VA_ARGS__); \
+		Console::Deferred::Log(1, "" format, ##__VA_ARGS__); } while (0)
+
+#define CONSOLE_ERROR(format, ...) \
+	do { if (false) Console::Deferred::CheckFormat("" format, ##__VA_ARGS__); \
+		Console::Deferred::Log(2, "" format, ##__VA_ARGS__); } while (0)
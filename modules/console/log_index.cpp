@@ -0,0 +1,494 @@
+#include "log_index.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Console
+{
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static inline unsigned char Lower(unsigned char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+	}
+
+	static inline uint32_t TrigramBucket(unsigned char a, unsigned char b, unsigned char c)
+	{
+		uint32_t key = (static_cast<uint32_t>(Lower(a)) << 16) | (static_cast<uint32_t>(Lower(b)) << 8) | Lower(c);
+		return (key * 2654435761u) >> 16;
+	}
+
+	static inline int CountTrailingZeros(uint64_t value)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctzll(value);
+#endif
+	}
+
+	// Поиск подстроки без учёта регистра ASCII (needle уже в нижнем регистре)
+	static bool ContainsLower(const char* text, size_t length, const std::string& needle)
+	{
+		size_t n = needle.size();
+		if (n == 0)
+			return true;
+		if (n > length)
+			return false;
+
+		unsigned char first = static_cast<unsigned char>(needle[0]);
+		for (size_t i = 0; i + n <= length; i++)
+		{
+			if (Lower(static_cast<unsigned char>(text[i])) != first)
+				continue;
+
+			size_t j = 1;
+			while (j < n && Lower(static_cast<unsigned char>(text[i + j])) == static_cast<unsigned char>(needle[j]))
+				j++;
+			if (j == n)
+				return true;
+		}
+		return false;
+	}
+
+	// Совпадает ли строка в нижнем регистре с lowered (без временной копии)
+	static bool EqualsLower(const char* text, const std::string& lowered)
+	{
+		size_t i = 0;
+		for (; text[i]; i++)
+		{
+			if (i >= lowered.size() || Lower(static_cast<unsigned char>(text[i])) != static_cast<unsigned char>(lowered[i]))
+				return false;
+		}
+		return i == lowered.size();
+	}
+
+	// Самый длинный фрагмент регулярного выражения без метасимволов, который обязан быть
+	// в совпадении. Только вне групп: группа может быть необязательной ((a)?, (a)*),
+	// отрицанием ((?!a)) или альтернативой ((a|b)). Пустая строка - полный просмотр
+	static std::string LongestLiteral(const std::string& pattern)
+	{
+		static const char* const meta = ".^$|()[]{}*+?\\";
+		std::string best, current;
+		bool inClass = false;
+		int depth = 0;
+
+		for (size_t i = 0; i < pattern.size(); i++)
+		{
+			char c = pattern[i];
+			if (inClass)
+			{
+				if (c == '\\') i++;
+				else if (c == ']') inClass = false;
+				continue;
+			}
+
+			// После квантификатора предыдущий символ необязателен
+			bool quantified = i + 1 < pattern.size() &&
+				(pattern[i + 1] == '*' || pattern[i + 1] == '?' || pattern[i + 1] == '{');
+
+			if (c == '[') inClass = true;
+			if (c == '(') depth++;
+			if (c == ')' && depth > 0) depth--;
+			if (c == '|' && depth == 0)
+				return std::string();  // альтернатива: общего литерала нет
+
+			if (strchr(meta, c) || quantified || depth > 0)
+			{
+				if (current.size() > best.size()) best = current;
+				current.clear();
+				if (c == '\\') i++;  // пропускаем экранированный символ
+				continue;
+			}
+			current.push_back(static_cast<char>(Lower(static_cast<unsigned char>(c))));
+		}
+
+		if (current.size() > best.size()) best = current;
+		return best;
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	LogIndex::LogIndex(size_t capacity, LogLookupFn lookup)
+		: m_Capacity(capacity), m_Lookup(lookup), m_Buckets(BUCKETS)
+	{
+		// capacity должна быть кратна 64 (см. CollectBySeverity)
+		for (auto& bits : m_TypeBits)
+			bits.assign((capacity + 63) / 64, 0);
+		m_Lines.assign(capacity, 1);
+	}
+
+	void LogIndex::Add(uint64_t seq, uint8_t type, const char* text, size_t length, uint16_t lines)
+	{
+		if (type > 2) type = 0;
+		m_Next = seq + 1;
+		m_Lines[static_cast<size_t>(seq % m_Capacity)] = lines ? lines : 1;
+
+		// Битовые карты типов: слот окна переиспользуется, старый бит снимаем
+		size_t slot = static_cast<size_t>(seq % m_Capacity);
+		uint64_t bit = 1ull << (slot & 63);
+		for (int t = 0; t < 3; t++)
+			m_TypeBits[t][slot >> 6] &= ~bit;
+		m_TypeBits[type][slot >> 6] |= bit;
+
+		// Списки триграмм отсортированы: сразу индексируем, только если все предыдущие
+		// уже в индексе, иначе сообщение дождётся IndexPending вместе с ними
+		if (m_Indexed < m_Oldest)
+			m_Indexed = m_Oldest;
+		if (text && m_Indexed == seq)
+		{
+			IndexText(seq, text, length);
+			m_Indexed = m_Next;
+		}
+	}
+
+	void LogIndex::SetOldest(uint64_t oldest)
+	{
+		m_Oldest = oldest;
+
+		while (m_ResultsStart < m_Results.size() && m_Results[m_ResultsStart] < oldest)
+			m_ResultsStart++;
+
+		// Не даём вектору результатов расти бесконечно
+		if (m_ResultsStart > 4096 && m_ResultsStart * 2 > m_Results.size())
+		{
+			m_Results.erase(m_Results.begin(), m_Results.begin() + m_ResultsStart);
+			m_ResultLines.erase(m_ResultLines.begin(), m_ResultLines.begin() + m_ResultsStart);
+			m_ResultsStart = 0;
+		}
+	}
+
+	void LogIndex::Clear()
+	{
+		for (auto& list : m_Buckets)
+		{
+			list.seqs.clear();
+			list.start = 0;
+		}
+		for (auto& bits : m_TypeBits)
+			std::fill(bits.begin(), bits.end(), 0);
+
+		m_Oldest = m_Next;
+		m_Indexed = m_Next;
+		m_Matched = m_Next;
+		ClearResults();
+		m_AddsSinceCompact = 0;
+	}
+
+	bool LogIndex::SetQuery(const char* query, bool regex, uint8_t severityMask)
+	{
+		if (!query)
+			query = "";
+
+		// Вызывается каждый кадр: неизменный запрос проверяется без выделений
+		// Ошибка regex запоминается до смены запроса
+		if (regex == m_IsRegex && severityMask == m_Severity && EqualsLower(query, m_Query))
+		{
+			if (m_QueryValid)
+				MatchPending();
+			return m_QueryValid;
+		}
+
+		std::string lowered;
+		for (const char* p = query; *p; p++)
+			lowered.push_back(static_cast<char>(Lower(static_cast<unsigned char>(*p))));
+
+		// Уточнение: тот же режим, новая подстрока содержит старую, типов не больше
+		bool refine = m_Filtering && !regex && !m_IsRegex &&
+			lowered.find(m_Query) != std::string::npos &&
+			(severityMask & ~m_Severity) == 0;
+
+		m_Query = lowered;
+		m_IsRegex = regex;
+		m_Severity = severityMask;
+		m_Regex.reset();
+		m_QueryValid = true;
+
+		if (regex && !m_Query.empty())
+		{
+			try
+			{
+				m_Regex.reset(new std::regex(query, std::regex::ECMAScript | std::regex::icase | std::regex::optimize));
+			}
+			catch (const std::regex_error&)
+			{
+				m_QueryValid = false;
+				m_Filtering = true;
+				ClearResults();
+				m_Matched = m_Next;
+				return false;
+			}
+			m_Literal = LongestLiteral(query);
+		}
+		else
+		{
+			m_Literal = m_Query;
+		}
+
+		m_Filtering = !m_Query.empty() || m_Severity != Severity_All;
+
+		auto start = std::chrono::steady_clock::now();
+		if (!m_Filtering)
+		{
+			ClearResults();
+			m_Matched = m_Next;
+		}
+		else if (refine)
+		{
+			Refine();
+			MatchPending();
+		}
+		else
+		{
+			Rebuild();
+		}
+		m_LastQueryMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return true;
+	}
+
+	bool LogIndex::Matches(const LogView& view) const
+	{
+		if (!(m_Severity & (1u << view.type)))
+			return false;
+
+		if (m_IsRegex && m_Regex)
+			return std::regex_search(view.text, view.text + view.length, *m_Regex);
+
+		return ContainsLower(view.text, view.length, m_Query);
+	}
+
+	uint64_t LogIndex::GetResultLineCount() const
+	{
+		return m_ResultsStart < m_Results.size() ? m_ResultLineTotal - m_ResultLines[m_ResultsStart] : 0;
+	}
+
+	size_t LogIndex::FindResultAtLine(uint64_t line) const
+	{
+		if (m_ResultsStart >= m_Results.size())
+			return 0;
+
+		uint64_t target = m_ResultLines[m_ResultsStart] + line;
+		auto it = std::upper_bound(m_ResultLines.begin() + m_ResultsStart, m_ResultLines.end(), target);
+		size_t index = static_cast<size_t>(it - m_ResultLines.begin());
+		return index > m_ResultsStart ? index - 1 - m_ResultsStart : 0;
+	}
+
+	void LogIndex::ClearResults()
+	{
+		m_Results.clear();
+		m_ResultLines.clear();
+		m_ResultLineTotal = 0;
+		m_ResultsStart = 0;
+	}
+
+	void LogIndex::PushResult(uint64_t seq)
+	{
+		m_Results.push_back(seq);
+		m_ResultLines.push_back(m_ResultLineTotal);
+		m_ResultLineTotal += m_Lines[static_cast<size_t>(seq % m_Capacity)];
+	}
+
+	void LogIndex::IndexText(uint64_t seq, const char* text, size_t length)
+	{
+		// Каждый список получает номер не более одного раза
+		for (size_t i = 0; i + 2 < length; i++)
+		{
+			PostingList& list = m_Buckets[TrigramBucket(text[i], text[i + 1], text[i + 2])];
+			if (list.seqs.size() > list.start && list.seqs.back() == seq)
+				continue;
+			list.seqs.push_back(seq);
+		}
+
+		if (++m_AddsSinceCompact >= m_Capacity / 4)
+			Compact();
+	}
+
+	// Триграммы для сообщений, добавленных без текста: текст берётся через lookup
+	// (отложенные сообщения при этом форматируются)
+	void LogIndex::IndexPending(size_t maxCount)
+	{
+		LogView view;
+		uint64_t seq = (std::max)(m_Indexed, m_Oldest);
+		for (; seq < m_Next && maxCount > 0; seq++, maxCount--)
+		{
+			if (m_Lookup(seq, view))
+				IndexText(seq, view.text, view.length);
+		}
+		m_Indexed = seq;
+	}
+
+	// Новые сообщения попадают в результаты активного фильтра; для фильтра
+	// только по типу текст не нужен
+	void LogIndex::MatchPending()
+	{
+		if (m_Filtering)
+		{
+			LogView view;
+			for (uint64_t seq = (std::max)(m_Matched, m_Oldest); seq < m_Next; seq++)
+			{
+				size_t slot = static_cast<size_t>(seq % m_Capacity);
+				bool typeMatches = false;
+				for (int t = 0; t < 3; t++)
+				{
+					if ((m_Severity & (1u << t)) && (m_TypeBits[t][slot >> 6] >> (slot & 63) & 1))
+						typeMatches = true;
+				}
+				if (!typeMatches)
+					continue;
+
+				if (m_Query.empty() || (m_Lookup(seq, view) && Matches(view)))
+					PushResult(seq);
+			}
+		}
+		m_Matched = m_Next;
+	}
+
+	void LogIndex::Rebuild()
+	{
+		// Кандидаты и рабочие списки живут до конца вызова - берём их из арены кадра
+		Memory::FrameVector<uint64_t> candidates;
+		if (m_Literal.size() >= 3)
+		{
+			IndexPending();
+			CollectCandidates(m_Literal, candidates);
+		}
+		else
+		{
+			CollectBySeverity(candidates);
+		}
+		m_Matched = m_Next;
+
+		ClearResults();
+
+		LogView view;
+		for (uint64_t seq : candidates)
+		{
+			if (m_Lookup(seq, view) && Matches(view))
+				PushResult(seq);
+		}
+	}
+
+	void LogIndex::Refine()
+	{
+		size_t out = 0;
+		LogView view;
+		for (size_t i = m_ResultsStart; i < m_Results.size(); i++)
+		{
+			if (m_Lookup(m_Results[i], view) && Matches(view))
+				m_Results[out++] = m_Results[i];
+		}
+		m_Results.resize(out);
+		m_ResultsStart = 0;
+
+		// Строки результатов считаются заново по оставшимся
+		m_ResultLines.resize(out);
+		m_ResultLineTotal = 0;
+		for (size_t i = 0; i < out; i++)
+		{
+			m_ResultLines[i] = m_ResultLineTotal;
+			m_ResultLineTotal += m_Lines[static_cast<size_t>(m_Results[i] % m_Capacity)];
+		}
+	}
+
+	void LogIndex::CollectCandidates(const std::string& literal, Memory::FrameVector<uint64_t>& out)
+	{
+		// Списки всех триграмм литерала; перебираем самый короткий,
+		// остальные проверяем бинарным поиском
+		Memory::FrameVector<PostingList*> lists;
+		for (size_t i = 0; i + 2 < literal.size(); i++)
+		{
+			PostingList* list = &m_Buckets[TrigramBucket(literal[i], literal[i + 1], literal[i + 2])];
+			while (list->start < list->seqs.size() && list->seqs[list->start] < m_Oldest)
+				list->start++;
+			if (std::find(lists.begin(), lists.end(), list) == lists.end())
+				lists.push_back(list);
+		}
+
+		std::sort(lists.begin(), lists.end(), [](const PostingList* a, const PostingList* b) {
+			return a->seqs.size() - a->start < b->seqs.size() - b->start;
+		});
+
+		// Номера во всех списках возрастают, поэтому курсоры других списков
+		// только двигаются вперёд (экспоненциальный поиск от курсора)
+		Memory::FrameVector<size_t> cursors(lists.size());
+		for (size_t l = 0; l < lists.size(); l++)
+			cursors[l] = lists[l]->start;
+
+		const PostingList* smallest = lists.front();
+		for (size_t i = smallest->start; i < smallest->seqs.size(); i++)
+		{
+			uint64_t seq = smallest->seqs[i];
+			bool inAll = true;
+			for (size_t l = 1; l < lists.size() && inAll; l++)
+			{
+				const std::vector<uint64_t>& seqs = lists[l]->seqs;
+				size_t lo = cursors[l];
+				size_t step = 1;
+				size_t hi = lo;
+				while (hi < seqs.size() && seqs[hi] < seq)
+				{
+					lo = hi + 1;
+					hi += step;
+					step *= 2;
+				}
+				if (hi > seqs.size()) hi = seqs.size();
+				size_t pos = std::lower_bound(seqs.begin() + lo, seqs.begin() + hi, seq) - seqs.begin();
+				cursors[l] = pos;
+				inAll = pos < seqs.size() && seqs[pos] == seq;
+			}
+			if (inAll)
+				out.push_back(seq);
+		}
+	}
+
+	void LogIndex::CollectBySeverity(Memory::FrameVector<uint64_t>& out) const
+	{
+		// Проходим по словам объединённой битовой карты выбранных типов.
+		// Ёмкость кратна 64, поэтому слово не пересекает границу кольца
+		for (uint64_t wordBase = m_Oldest - (m_Oldest & 63); wordBase < m_Next; wordBase += 64)
+		{
+			size_t word = static_cast<size_t>((wordBase % m_Capacity) >> 6);
+
+			uint64_t bits = 0;
+			for (int t = 0; t < 3; t++)
+			{
+				if (m_Severity & (1u << t))
+					bits |= m_TypeBits[t][word];
+			}
+			if (wordBase < m_Oldest)
+				bits &= ~0ull << (m_Oldest - wordBase);
+			if (m_Next - wordBase < 64)
+				bits &= (1ull << (m_Next - wordBase)) - 1;
+
+			while (bits)
+			{
+				out.push_back(wordBase + CountTrailingZeros(bits));
+				bits &= bits - 1;
+			}
+		}
+	}
+
+	void LogIndex::Compact()
+	{
+		m_AddsSinceCompact = 0;
+		for (auto& list : m_Buckets)
+		{
+			while (list.start < list.seqs.size() && list.seqs[list.start] < m_Oldest)
+				list.start++;
+			if (list.start == 0)
+				continue;
+
+			list.seqs.erase(list.seqs.begin(), list.seqs.begin() + list.start);
+			list.start = 0;
+		}
+	}
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <regex>
+#include <memory>
+#include "../memory/frame_arena.h"
+
+namespace Console
+{
+	/// Сообщение для индекса (текст берётся из буфера окна)
+	struct LogView
+	{
+		const char* text;
+		size_t length;
+		uint8_t type;
+		uint16_t lines;   // строк в окне консоли
+	};
+
+	/// Доступ к сообщению по порядковому номеру. false, если сообщение вытеснено
+	typedef bool (*LogLookupFn)(uint64_t seq, LogView& out);
+
+	/// Маски типов сообщений для фильтра
+	enum SeverityMask : uint8_t
+	{
+		Severity_Log     = 1 << 0,
+		Severity_Warning = 1 << 1,
+		Severity_Error   = 1 << 2,
+		Severity_All     = Severity_Log | Severity_Warning | Severity_Error
+	};
+
+	/// Инкрементальный индекс поиска по истории консоли:
+	/// триграммы (без учёта регистра ASCII) -> отсортированные списки номеров сообщений,
+	/// плюс битовые карты по типу сообщения. Готовый текст индексируется при добавлении;
+	/// отложенные сообщения (только аргументы) - позже через lookup, понемногу в каждом
+	/// кадре (IndexPending) или при поиске. Вытесненные сообщения вычищаются лениво
+	class LogIndex
+	{
+	public:
+		LogIndex(size_t capacity, LogLookupFn lookup);
+
+		/// Добавляет сообщение (номера идут подряд по возрастанию). text - готовый текст:
+		/// триграммы строятся сразу. nullptr - текста ещё нет, его возьмёт IndexPending.
+		/// lines - сколько строк сообщение занимает в окне (для GetResultLine)
+		void Add(uint64_t seq, uint8_t type, const char* text = nullptr, size_t length = 0, uint16_t lines = 1);
+
+		/// Триграммы не более чем для maxCount сообщений, добавленных без текста (текст через
+		/// lookup). Каждый кадр с небольшим бюджетом, чтобы первый поиск не разбирал всю историю
+		void IndexPending(size_t maxCount = SIZE_MAX);
+
+		/// Номер самого старого сообщения, которое ещё хранится
+		void SetOldest(uint64_t oldest);
+
+		/// Удаляет всё
+		void Clear();
+
+		/// Меняет запрос (вызывается каждый кадр: новые сообщения проверяются здесь же).
+		/// Если новый запрос уточняет старый, результаты фильтруются, а не ищутся заново.
+		/// false - некорректное регулярное выражение
+		bool SetQuery(const char* query, bool regex, uint8_t severityMask);
+
+		/// Активен ли фильтр (есть текст или выключен хотя бы один тип)
+		bool IsFiltering() const { return m_Filtering; }
+
+		/// Количество найденных сообщений
+		size_t GetResultCount() const { return m_Results.size() - m_ResultsStart; }
+
+		/// Номер i-го найденного сообщения (по возрастанию)
+		uint64_t GetResult(size_t i) const { return m_Results[m_ResultsStart + i]; }
+
+		/// Строк окна у всех найденных сообщений вместе
+		uint64_t GetResultLineCount() const;
+
+		/// Первая строка i-го найденного сообщения среди строк результатов
+		uint64_t GetResultLine(size_t i) const { return m_ResultLines[m_ResultsStart + i] - m_ResultLines[m_ResultsStart]; }
+
+		/// Индекс найденного сообщения, которому принадлежит строка line (бинарный поиск)
+		size_t FindResultAtLine(uint64_t line) const;
+
+		/// Время последнего полного/уточняющего поиска в миллисекундах
+		float GetLastQueryMs() const { return m_LastQueryMs; }
+
+	private:
+		static const size_t BUCKETS = 65536;
+
+		struct PostingList
+		{
+			std::vector<uint64_t> seqs;  // полные номера: сравниваются с m_Oldest без переполнения
+			size_t start = 0;  // всё до start уже вытеснено
+		};
+
+		bool Matches(const LogView& view) const;
+		void IndexText(uint64_t seq, const char* text, size_t length);
+		void ClearResults();
+		void PushResult(uint64_t seq);
+		void MatchPending();
+		void Rebuild();
+		void Refine();
+		void Compact();
+		void CollectCandidates(const std::string& literal, Memory::FrameVector<uint64_t>& out);
+		void CollectBySeverity(Memory::FrameVector<uint64_t>& out) const;
+
+		size_t m_Capacity;
+		LogLookupFn m_Lookup;
+
+		std::vector<PostingList> m_Buckets;
+		std::vector<uint64_t> m_TypeBits[3];   // бит на слот окна для каждого типа
+		std::vector<uint16_t> m_Lines;         // строк окна на слот
+		uint64_t m_Oldest = 0;
+		uint64_t m_Next = 0;
+		uint64_t m_Indexed = 0;    // триграммы построены для всех номеров до m_Indexed
+		uint64_t m_Matched = 0;    // результаты фильтра учитывают номера до m_Matched
+		size_t m_AddsSinceCompact = 0;
+
+		// Текущий запрос
+		std::string m_Query;       // в нижнем регистре
+		std::string m_Literal;     // литерал для триграмм (для regex - самый длинный)
+		std::unique_ptr<std::regex> m_Regex;
+		bool m_IsRegex = false;
+		uint8_t m_Severity = Severity_All;
+		bool m_Filtering = false;
+		bool m_QueryValid = true;  // false - регулярное выражение не скомпилировалось
+
+		std::vector<uint64_t> m_Results;
+		std::vector<uint64_t> m_ResultLines;   // первая строка каждого результата (нарастающим итогом)
+		uint64_t m_ResultLineTotal = 0;
+		size_t m_ResultsStart = 0;
+		float m_LastQueryMs = 0.0f;
+	};
+}
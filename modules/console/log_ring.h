@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Console
+{
+	/// Размер текста одного сообщения (включая завершающий ноль)
+	constexpr size_t LOG_TEXT_SIZE = 496;
+
+	/// Форматирует отложенное сообщение: format + сырые байты аргументов -> текст.
+	/// Возвращает длину текста (без завершающего нуля)
+	typedef size_t (*FormatFn)(const char* format, const unsigned char* payload, char* out, size_t outSize);
+
+	/// Слот кольца сообщений
+	struct LogSlot
+	{
+		std::atomic<uint64_t> sequence;
+		const char* format;   // для отложенных сообщений: строковый литерал
+		FormatFn formatter;   // nullptr - text уже содержит готовый текст
+		float timestamp;
+		uint16_t length;
+		uint8_t type;  // 0 = normal, 1 = warning, 2 = error
+		char text[LOG_TEXT_SIZE];  // текст или закодированные аргументы
+	};
+
+	/// Копия сообщения вне кольца (передаётся из потока записи в окно консоли)
+	struct LogRecord
+	{
+		const char* format;
+		FormatFn formatter;
+		float timestamp;
+		uint16_t length;
+		uint8_t type;
+		char text[LOG_TEXT_SIZE];
+	};
+
+	/// Кольцо предвыделенных слотов: много производителей, один потребитель.
+	/// Производитель резервирует слот атомарным CAS позиции, пишет в него
+	/// и публикует через sequence. Переполнение не блокирует: сообщение отбрасывается
+	template<size_t Capacity>
+	class LogRing
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		LogRing() : m_EnqueuePos(0), m_DequeuePos(0), m_Dropped(0)
+		{
+			for (size_t i = 0; i < Capacity; i++)
+				m_Slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		/// Резервирует слот (любой поток). nullptr, если кольцо заполнено
+		LogSlot* Reserve(uint64_t& ticket)
+		{
+			uint64_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				LogSlot* slot = &m_Slots[pos & (Capacity - 1)];
+				uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+				int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+
+				if (diff == 0)
+				{
+					if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						ticket = pos;
+						return slot;
+					}
+				}
+				else if (diff < 0)
+				{
+					m_Dropped.fetch_add(1, std::memory_order_relaxed);
+					return nullptr;
+				}
+				else
+				{
+					pos = m_EnqueuePos.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/// Публикует заполненный слот
+		void Commit(LogSlot* slot, uint64_t ticket)
+		{
+			slot->sequence.store(ticket + 1, std::memory_order_release);
+		}
+
+		/// Следующий опубликованный слот (только потребитель) или nullptr
+		LogSlot* Peek()
+		{
+			uint64_t pos = m_DequeuePos;
+			LogSlot* slot = &m_Slots[pos & (Capacity - 1)];
+			if (slot->sequence.load(std::memory_order_acquire) != pos + 1)
+				return nullptr;
+			return slot;
+		}
+
+		/// Освобождает слот, полученный через Peek
+		void Release(LogSlot* slot)
+		{
+			slot->sequence.store(m_DequeuePos + Capacity, std::memory_order_release);
+			m_DequeuePos++;
+		}
+
+		/// Количество отброшенных из-за переполнения сообщений
+		uint64_t GetDropped() const
+		{
+			return m_Dropped.load(std::memory_order_relaxed);
+		}
+
+	private:
+		alignas(64) std::atomic<uint64_t> m_EnqueuePos;
+		alignas(64) uint64_t m_DequeuePos;
+		alignas(64) std::atomic<uint64_t> m_Dropped;
+		LogSlot m_Slots[Capacity];
+	};
+}
@@ -0,0 +1,98 @@
+#include "log_sink.h"
+#include <cstdlib>
+
+namespace Console
+{
+	// Буфер stdio: записи копятся в памяти и уходят в ОС крупными блоками
+	static const size_t FILE_BUFFER_SIZE = 256 * 1024;
+
+	LogFile::~LogFile()
+	{
+		Close();
+	}
+
+	bool LogFile::Open(const char* path, size_t maxBytes, int maxBackups)
+	{
+		Close();
+		if (!path || !*path)
+			return false;
+
+		m_Path = path;
+		m_MaxBytes = maxBytes;
+		m_MaxBackups = maxBackups;
+
+		m_File = fopen(path, "ab");
+		if (!m_File)
+			return false;
+
+		m_Buffer = static_cast<char*>(malloc(FILE_BUFFER_SIZE));
+		if (m_Buffer)
+			setvbuf(m_File, m_Buffer, _IOFBF, FILE_BUFFER_SIZE);
+
+		fseek(m_File, 0, SEEK_END);
+		long size = ftell(m_File);
+		m_Size = size > 0 ? static_cast<size_t>(size) : 0;
+		return true;
+	}
+
+	void LogFile::Write(const char* data, size_t size)
+	{
+		if (!m_File)
+			return;
+
+		if (m_MaxBytes > 0 && m_Size > 0 && m_Size + size > m_MaxBytes)
+			Rotate();
+		if (!m_File)
+			return;
+
+		fwrite(data, 1, size, m_File);
+		m_Size += size;
+	}
+
+	void LogFile::Flush()
+	{
+		if (m_File)
+			fflush(m_File);
+	}
+
+	void LogFile::Close()
+	{
+		if (m_File)
+		{
+			fclose(m_File);
+			m_File = nullptr;
+		}
+		free(m_Buffer);
+		m_Buffer = nullptr;
+		m_Size = 0;
+	}
+
+	void LogFile::Rotate()
+	{
+		fclose(m_File);
+		m_File = nullptr;
+
+		// Сдвигаем резервные копии: .N-1 -> .N, ..., текущий -> .1
+		if (m_MaxBackups > 0)
+		{
+			std::string oldest = m_Path + "." + std::to_string(m_MaxBackups);
+			remove(oldest.c_str());
+			for (int i = m_MaxBackups - 1; i >= 1; i--)
+			{
+				std::string from = m_Path + "." + std::to_string(i);
+				std::string to = m_Path + "." + std::to_string(i + 1);
+				rename(from.c_str(), to.c_str());
+			}
+			rename(m_Path.c_str(), (m_Path + ".1").c_str());
+		}
+		else
+		{
+			remove(m_Path.c_str());
+		}
+
+		m_File = fopen(m_Path.c_str(), "wb");
+		if (m_File && m_Buffer)
+			setvbuf(m_File, m_Buffer, _IOFBF, FILE_BUFFER_SIZE);
+		m_Size = 0;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace Console
+{
+	/// Файл лога с большим буфером записи и ротацией по размеру:
+	/// cubixdlc.log -> cubixdlc.log.1 -> ... -> cubixdlc.log.N (самый старый удаляется)
+	class LogFile
+	{
+	public:
+		LogFile() = default;
+		~LogFile();
+
+		LogFile(const LogFile&) = delete;
+		LogFile& operator=(const LogFile&) = delete;
+
+		/// Открывает файл на дозапись
+		bool Open(const char* path, size_t maxBytes, int maxBackups);
+
+		/// Дописывает данные, при превышении размера ротирует файлы
+		void Write(const char* data, size_t size);
+
+		/// Сбрасывает буфер в ОС (переживает падение процесса)
+		void Flush();
+
+		/// Закрывает файл
+		void Close();
+
+		bool IsOpen() const { return m_File != nullptr; }
+
+	private:
+		void Rotate();
+
+		FILE* m_File = nullptr;
+		char* m_Buffer = nullptr;
+		std::string m_Path;
+		size_t m_Size = 0;
+		size_t m_MaxBytes = 0;
+		int m_MaxBackups = 0;
+	};
+}
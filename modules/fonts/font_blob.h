@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../../deps/imgui/imgui.h"
+#include <cstddef>
+#include <cstdint>
+
+// Формат запечённого атласа шрифтов. Пишет tools/font_baker, читает Fonts::AddOverlayFont.
+//
+//   BlobHeader
+//   BlobSet[setCount]       - (источник шрифта, размер); глифы набора отсортированы по кодовой точке
+//   BlobGlyph[glyphCount]
+//   uint8_t[pixelBytes]     - альфа-маски глифов: 1 бит на пиксель, если маска только из 0 и 255
+//                             (ProggyClean), иначе PackBits
+//
+// Все поля little-endian, структуры читаются из ресурса как есть.
+
+namespace Fonts
+{
+	constexpr uint32_t BLOB_MAGIC = 0x41465843;   // "CXFA"
+	constexpr uint32_t BLOB_VERSION = 1;
+
+	/// Источники шрифта (порядок как в ImFont::Sources)
+	enum Source : uint16_t
+	{
+		SOURCE_LATIN = 0,      // ProggyClean (встроен в ImGui)
+		SOURCE_CYRILLIC = 1,   // DroidSans, подмешан к ProggyClean
+		SOURCE_COUNT
+	};
+
+	/// Размеры, которые запекаются: ImGui::GetFontSize() и 0.85 от него (настройки в HUD),
+	/// после округления ImFont::GetFontBaked
+	constexpr float BAKED_SIZES[] = { 11.0f, 13.0f };
+
+	/// Диапазоны кодовых точек для каждого источника
+	constexpr ImWchar LATIN_RANGE[] = { 0x0001, 0x00FF };      // с управляющими: ImGui загружает \t для ширины табуляции
+	constexpr ImWchar CYRILLIC_RANGE[] = { 0x0400, 0x045F };   // основная кириллица (русский, украинский, ...)
+
+	/// Кодирование маски глифа
+	enum Encoding : uint16_t
+	{
+		ENCODING_BITS = 0,       // 1 бит на пиксель (0 / 255), строки подряд, старший бит первый
+		ENCODING_PACKBITS = 1
+	};
+
+	struct BlobHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t setCount;
+		uint32_t glyphCount;
+		uint32_t pixelBytes;
+	};
+
+	struct BlobSet
+	{
+		uint16_t source;
+		uint16_t size;          // пиксели, RasterizerDensity = 1
+		uint32_t firstGlyph;
+		uint32_t glyphCount;
+	};
+
+	struct BlobGlyph
+	{
+		uint32_t codepoint;
+		float advanceX;
+		float x0, y0, x1, y1;   // как ImFontGlyph::X0..Y1
+		uint16_t width;         // размер маски в атласе (0 - невидимый глиф)
+		uint16_t height;
+		uint16_t encoding;
+		uint16_t reserved;
+		uint32_t offset;        // смещение сжатой маски от начала пикселей
+		uint32_t packedSize;
+	};
+
+	/// Распаковка PackBits: n < 128 - дальше n + 1 байт как есть, n >= 128 - следующий байт
+	/// повторяется n - 125 раз. false, если данные не совпадают с размером маски
+	inline bool UnpackBits(const uint8_t* src, uint32_t srcSize, uint8_t* dst, uint32_t dstSize)
+	{
+		const uint8_t* srcEnd = src + srcSize;
+		uint8_t* dstEnd = dst + dstSize;
+		while (src < srcEnd)
+		{
+			uint32_t n = *src++;
+			if (n < 128)
+			{
+				n += 1;
+				if (srcEnd - src < (ptrdiff_t)n || dstEnd - dst < (ptrdiff_t)n)
+					return false;
+				for (uint32_t i = 0; i < n; i++)
+					*dst++ = *src++;
+			}
+			else
+			{
+				n -= 125;
+				if (src == srcEnd || dstEnd - dst < (ptrdiff_t)n)
+					return false;
+				uint8_t value = *src++;
+				for (uint32_t i = 0; i < n; i++)
+					*dst++ = value;
+			}
+		}
+		return dst == dstEnd;
+	}
+
+	/// Распаковка маски глифа (width * height байт в dst)
+	inline bool UnpackMask(const BlobGlyph& glyph, const uint8_t* pixels, uint8_t* dst)
+	{
+		const uint8_t* src = pixels + glyph.offset;
+		const uint32_t count = static_cast<uint32_t>(glyph.width) * glyph.height;
+		if (glyph.encoding == ENCODING_PACKBITS)
+			return UnpackBits(src, glyph.packedSize, dst, count);
+		if (glyph.encoding != ENCODING_BITS || glyph.packedSize != (count + 7) / 8)
+			return false;
+
+		for (uint32_t i = 0; i < count; i++)
+			dst[i] = (src[i >> 3] & (0x80 >> (i & 7))) ? 255 : 0;
+		return true;
+	}
+}
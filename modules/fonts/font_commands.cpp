@@ -0,0 +1,29 @@
+#include "fonts.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+
+// Отдельно от fonts.cpp: font_baker собирает загрузчик без консоли
+namespace Fonts
+{
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void FontCommand(const Console::Commands::Args&, void*)
+	{
+		Stats stats = GetStats();
+		if (!stats.prebaked)
+		{
+			Console::Log("Font atlas: not prebaked (resource missing or invalid), glyphs rasterized by stb_truetype");
+			return;
+		}
+		Console::Log("Font atlas: prebaked, %d glyph(s) in %d set(s), %zu bytes; %llu glyph(s) loaded, %llu rasterized",
+			stats.glyphs, stats.sets, stats.blobBytes,
+			static_cast<unsigned long long>(stats.loaded), static_cast<unsigned long long>(stats.rasterized));
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "font", "", "prebaked font atlas: glyphs loaded vs rasterized", FontCommand });
+	}
+}
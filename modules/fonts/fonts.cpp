@@ -0,0 +1,277 @@
+#include "fonts.h"
+#include "font_blob.h"
+#include "../../deps/imgui/imgui_internal.h"
+#include <algorithm>
+
+namespace Fonts
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	// Данные загрузчика для одного источника (ImFontConfig::FontLoaderData)
+	struct SourceData
+	{
+		uint16_t source = 0;
+		void* stbData = nullptr;   // состояние stb_truetype, если у источника есть TTF
+	};
+
+	static const BlobSet* g_Sets = nullptr;
+	static const BlobGlyph* g_Glyphs = nullptr;
+	static const uint8_t* g_Pixels = nullptr;
+	static uint32_t g_SetCount = 0;
+	static Stats g_Stats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static const ImFontLoader* StbLoader()
+	{
+		return ImFontAtlasGetFontLoaderForStbTruetype();
+	}
+
+	// stb_truetype хранит своё состояние в src->FontLoaderData - на время вызова подставляем его
+	struct StbScope
+	{
+		ImFontConfig* src;
+		void* own;
+
+		StbScope(ImFontConfig* src, SourceData* data) : src(src), own(src->FontLoaderData) { src->FontLoaderData = data->stbData; }
+		~StbScope() { src->FontLoaderData = own; }
+	};
+
+	// Проверяет заголовок и границы всех таблиц, чтобы дальше читать без проверок
+	static bool ParseBlob(const void* blob, size_t size)
+	{
+		if (!blob || size < sizeof(BlobHeader))
+			return false;
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(blob);
+		const BlobHeader* header = reinterpret_cast<const BlobHeader*>(bytes);
+		if (header->magic != BLOB_MAGIC || header->version != BLOB_VERSION)
+			return false;
+
+		size_t setsBytes = static_cast<size_t>(header->setCount) * sizeof(BlobSet);
+		size_t glyphsBytes = static_cast<size_t>(header->glyphCount) * sizeof(BlobGlyph);
+		if (size != sizeof(BlobHeader) + setsBytes + glyphsBytes + header->pixelBytes)
+			return false;
+
+		const BlobSet* sets = reinterpret_cast<const BlobSet*>(bytes + sizeof(BlobHeader));
+		const BlobGlyph* glyphs = reinterpret_cast<const BlobGlyph*>(bytes + sizeof(BlobHeader) + setsBytes);
+		for (uint32_t i = 0; i < header->setCount; i++)
+		{
+			const BlobSet& set = sets[i];
+			if (set.source >= SOURCE_COUNT || set.firstGlyph > header->glyphCount ||
+				set.glyphCount > header->glyphCount - set.firstGlyph)
+				return false;
+		}
+		for (uint32_t i = 0; i < header->glyphCount; i++)
+		{
+			const BlobGlyph& glyph = glyphs[i];
+			if (glyph.offset > header->pixelBytes || glyph.packedSize > header->pixelBytes - glyph.offset)
+				return false;
+		}
+
+		g_Sets = sets;
+		g_Glyphs = glyphs;
+		g_Pixels = bytes + sizeof(BlobHeader) + setsBytes + glyphsBytes;
+		g_SetCount = header->setCount;
+		g_Stats.sets = static_cast<int>(header->setCount);
+		g_Stats.glyphs = static_cast<int>(header->glyphCount);
+		g_Stats.blobBytes = size;
+		return true;
+	}
+
+	static const BlobGlyph* FindGlyph(const BlobSet& set, ImWchar codepoint)
+	{
+		const BlobGlyph* begin = g_Glyphs + set.firstGlyph;
+		const BlobGlyph* end = begin + set.glyphCount;
+		const BlobGlyph* it = std::lower_bound(begin, end, static_cast<uint32_t>(codepoint),
+			[](const BlobGlyph& glyph, uint32_t value) { return glyph.codepoint < value; });
+		return (it != end && it->codepoint == codepoint) ? it : nullptr;
+	}
+
+	// Глиф запечённого размера (атлас запекается при RasterizerDensity = 1)
+	static const BlobGlyph* FindBakedGlyph(const SourceData* data, const ImFontConfig* src, const ImFontBaked* baked, ImWchar codepoint)
+	{
+		if (baked->RasterizerDensity * src->RasterizerDensity != 1.0f)
+			return nullptr;
+
+		for (uint32_t i = 0; i < g_SetCount; i++)
+		{
+			if (g_Sets[i].source == data->source && g_Sets[i].size == baked->Size)
+				return FindGlyph(g_Sets[i], codepoint);
+		}
+		return nullptr;
+	}
+
+	// ============================================================================
+	// ЗАГРУЗЧИК (ImFontLoader)
+	// ============================================================================
+
+	static bool FontSrcInit(ImFontAtlas* atlas, ImFontConfig* src)
+	{
+		SourceData* data = IM_NEW(SourceData);
+		for (int i = 0; i < src->DstFont->Sources.Size; i++)
+		{
+			if (src->DstFont->Sources[i] == src)
+				data->source = static_cast<uint16_t>(i);
+		}
+
+		// Незапечённые размеры растеризуются как обычно, если есть TTF
+		if (src->FontData && !StbLoader()->FontSrcInit(atlas, src))
+		{
+			IM_DELETE(data);
+			return false;
+		}
+		data->stbData = src->FontLoaderData;
+		src->FontLoaderData = data;
+		return true;
+	}
+
+	static void FontSrcDestroy(ImFontAtlas* atlas, ImFontConfig* src)
+	{
+		SourceData* data = static_cast<SourceData*>(src->FontLoaderData);
+		if (!data)
+			return;
+		if (data->stbData)
+		{
+			src->FontLoaderData = data->stbData;
+			StbLoader()->FontSrcDestroy(atlas, src);
+		}
+		IM_DELETE(data);
+		src->FontLoaderData = nullptr;
+	}
+
+	static bool FontSrcContainsGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImWchar codepoint)
+	{
+		SourceData* data = static_cast<SourceData*>(src->FontLoaderData);
+		for (uint32_t i = 0; i < g_SetCount; i++)
+		{
+			if (g_Sets[i].source == data->source)
+			{
+				if (FindGlyph(g_Sets[i], codepoint))
+					return true;
+				break;
+			}
+		}
+
+		if (!data->stbData)
+			return false;
+		StbScope scope(src, data);
+		return StbLoader()->FontSrcContainsGlyph(atlas, src, codepoint);
+	}
+
+	// Ascent/Descent считает stb_truetype по TTF (только разбор таблиц, без растеризации)
+	static bool FontBakedInit(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loaderData)
+	{
+		SourceData* data = static_cast<SourceData*>(src->FontLoaderData);
+		if (!data->stbData)
+			return true;
+		StbScope scope(src, data);
+		return StbLoader()->FontBakedInit(atlas, src, baked, loaderData);
+	}
+
+	static bool FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loaderData, ImWchar codepoint, ImFontGlyph* outGlyph, float* outAdvanceX)
+	{
+		SourceData* data = static_cast<SourceData*>(src->FontLoaderData);
+		const BlobGlyph* glyph = FindBakedGlyph(data, src, baked, codepoint);
+		if (!glyph)
+		{
+			if (!data->stbData)
+				return false;
+			StbScope scope(src, data);
+			bool loaded = StbLoader()->FontBakedLoadGlyph(atlas, src, baked, loaderData, codepoint, outGlyph, outAdvanceX);
+			if (loaded && outGlyph)
+				g_Stats.rasterized++;
+			return loaded;
+		}
+
+		if (outAdvanceX)
+		{
+			*outAdvanceX = glyph->advanceX;
+			return true;
+		}
+
+		outGlyph->Codepoint = codepoint;
+		outGlyph->AdvanceX = glyph->advanceX;
+
+		if (glyph->width != 0 && glyph->height != 0)
+		{
+			// Маска распаковывается туда же, куда stb_truetype растеризует, и копируется в текстуру
+			const int w = glyph->width;
+			const int h = glyph->height;
+			ImVector<unsigned char>& pixels = atlas->Builder->TempBuffer;
+			pixels.resize(w * h);
+			if (!UnpackMask(*glyph, g_Pixels, pixels.Data))
+				return false;
+
+			ImFontAtlasRectId packId = ImFontAtlasPackAddRect(atlas, w, h);
+			if (packId == ImFontAtlasRectId_Invalid)
+			{
+				IM_ASSERT(packId != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+				return false;
+			}
+			ImTextureRect* r = ImFontAtlasPackGetRect(atlas, packId);
+
+			outGlyph->X0 = glyph->x0;
+			outGlyph->Y0 = glyph->y0;
+			outGlyph->X1 = glyph->x1;
+			outGlyph->Y1 = glyph->y1;
+			outGlyph->Visible = true;
+			outGlyph->PackId = packId;
+			ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, outGlyph, r, pixels.Data, ImTextureFormat_Alpha8, w);
+		}
+
+		g_Stats.loaded++;
+		return true;
+	}
+
+	static const ImFontLoader* PrebakedLoader()
+	{
+		static ImFontLoader loader;
+		loader.Name = "prebaked";
+		loader.FontSrcInit = FontSrcInit;
+		loader.FontSrcDestroy = FontSrcDestroy;
+		loader.FontSrcContainsGlyph = FontSrcContainsGlyph;
+		loader.FontBakedInit = FontBakedInit;
+		loader.FontBakedLoadGlyph = FontBakedLoadGlyph;
+		return &loader;
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	ImFont* AddOverlayFont(ImFontAtlas* atlas, const void* blob, size_t size)
+	{
+		g_Stats = Stats();
+		g_SetCount = 0;
+		if (!ParseBlob(blob, size))
+			return atlas->AddFontDefault();
+
+		// Те же параметры, с которыми tools/font_baker запекал атлас
+		ImFontConfig latin;
+		latin.OversampleH = latin.OversampleV = 1;
+		latin.PixelSnapH = true;
+		latin.FontLoader = PrebakedLoader();
+		ImFont* font = atlas->AddFontDefaultBitmap(&latin);
+		if (!font)
+			return nullptr;
+
+		ImFontConfig cyrillic;
+		cyrillic.MergeMode = true;
+		cyrillic.FontLoader = PrebakedLoader();
+		ImFormatString(cyrillic.Name, IM_COUNTOF(cyrillic.Name), "DroidSans.ttf (prebaked)");
+		atlas->AddFont(&cyrillic);
+
+		g_Stats.prebaked = true;
+		return font;
+	}
+
+	Stats GetStats()
+	{
+		return g_Stats;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../../deps/imgui/imgui.h"
+#include <cstddef>
+#include <cstdint>
+
+// Resource ID of the prebaked font atlas (resources.rc)
+#define IDR_FONT_ATLAS 103
+
+namespace Fonts
+{
+	/// Статистика загрузчика
+	struct Stats
+	{
+		bool prebaked = false;     // атлас из ресурса принят
+		int sets = 0;              // (источник, размер) в атласе
+		int glyphs = 0;
+		size_t blobBytes = 0;
+		uint64_t loaded = 0;       // глифы, распакованные из атласа
+		uint64_t rasterized = 0;   // глифы, которых нет в атласе (stb_truetype)
+	};
+
+	/// Добавляет шрифт оверлея: ProggyClean + кириллица. Глифы запечённых размеров
+	/// распаковываются из blob (см. font_blob.h) вместо растеризации stb_truetype.
+	/// Если blob нет или он не читается - обычный AddFontDefault() без кириллицы.
+	/// blob должен жить, пока жив атлас (ресурс DLL)
+	ImFont* AddOverlayFont(ImFontAtlas* atlas, const void* blob, size_t size);
+
+	/// Статистика
+	Stats GetStats();
+
+	/// Регистрирует команду консоли font (font_commands.cpp)
+	void RegisterCommands();
+}
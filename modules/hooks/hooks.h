@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Hooks
+{
+	/// Результат операции (совпадает по смыслу с MH_STATUS)
+	enum class Status : uint8_t
+	{
+		Ok,
+		NotInitialized,
+		AlreadyCreated,
+		NotCreated,
+		NotExecutable,     // цель или детур не в исполняемой памяти
+		Unsupported,       // пролог не переносится в трамплин
+		MemoryAlloc,       // нет памяти для трамплина в пределах rel32 от цели
+		MemoryProtect,
+		ThreadFreeze       // не все потоки остановились
+	};
+
+	/// Все хуки (для QueueEnable/QueueDisable)
+	constexpr void* ALL_HOOKS = nullptr;
+
+	/// Статистика
+	struct Stats
+	{
+		int hooks = 0;
+		int enabled = 0;               // -1 - бэкенд не сообщает
+		uint64_t freezes = 0;          // остановок потоков (одна на ApplyQueued/Enable/Disable/Remove)
+		int lastFrozenThreads = 0;     // -1 - бэкенд не сообщает
+		double lastFreezeMs = 0.0;     // сколько потоки стояли в последний раз
+	};
+
+	Status Initialize();
+
+	/// Снимает и удаляет все хуки (одна остановка потоков)
+	Status Shutdown();
+
+	/// Строит трамплин и возвращает в original адрес для вызова исходной функции.
+	/// Хук создаётся выключенным
+	Status Create(void* target, void* detour, void** original);
+
+	/// Снимает (если включён) и удаляет хук
+	Status Remove(void* target);
+
+	/// Отмечает хук (или ALL_HOOKS) для включения/выключения в ApplyQueued
+	Status QueueEnable(void* target);
+	Status QueueDisable(void* target);
+
+	/// Применяет все отмеченные изменения за одну остановку потоков
+	Status ApplyQueued();
+
+	/// QueueEnable/QueueDisable + ApplyQueued для одного хука
+	Status Enable(void* target);
+	Status Disable(void* target);
+
+	const char* StatusText(Status status);
+
+	/// Статистика
+	Stats GetStats();
+}
@@ -0,0 +1,628 @@
+#include "hooks.h"
+#include <windows.h>   // modules/hooks/posix: типы Win32 для trampoline.h / buffer.h
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <climits>
+#include <dirent.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+extern "C"
+{
+#include "../../deps/minhook/src/trampoline.h"
+#include "../../deps/minhook/src/buffer.h"
+}
+
+// POSIX (Linux x86-64): трамплины строит MinHook (trampoline.c + hde64), этот файл
+// даёт ему память рядом с целью (buffer.h) и заменяет SuspendThread/SetThreadContext
+// остановкой потоков сигналом
+
+namespace Hooks
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	struct Hook
+	{
+		uint8_t* target;
+		uint8_t* relay;           // jmp на детур внутри буфера трамплина
+		uint8_t* trampoline;
+		uint8_t backup[8];        // исходные байты под патчем
+		int protection;           // PROT_* страницы цели, восстанавливается после записи
+		bool patchAbove;          // jmp rel32 в 5 байтах над функцией + jmp rel8 на него
+		bool enabled;
+		bool queueEnable;
+		uint8_t nIP;
+		uint8_t oldIPs[8];
+		uint8_t newIPs[8];
+	};
+
+	// Регион /proc/self/maps
+	struct MapRegion
+	{
+		uintptr_t start;
+		uintptr_t end;
+		int protection;
+	};
+
+	// Поток, остановленный сигналом: контекст указывает в его стек обработчика
+	struct FrozenThread
+	{
+		pid_t tid;
+		std::atomic<ucontext_t*> context;
+	};
+
+	/// Регионы памяти под трамплины, нарезаются на слоты по MEMORY_SLOT_SIZE (как buffer.c)
+	constexpr size_t REGION_SIZE = 0x10000;
+	/// Трамплин не дальше 1 ГБ от цели: rel32 из патча и перенесённые RIP-relative операнды
+	constexpr uintptr_t MAX_DISTANCE = 0x40000000;
+	constexpr int MAX_FROZEN = 1024;
+	constexpr int FREEZE_TIMEOUT_MS = 500;
+
+	static std::mutex g_Mutex;
+	static bool g_Initialized = false;
+	static std::vector<Hook> g_Hooks;
+
+	static std::vector<uint8_t*> g_Regions;
+	static std::vector<uint8_t*> g_FreeSlots;
+
+	static FrozenThread g_Frozen[MAX_FROZEN];
+	static std::atomic<int> g_FrozenCount{ 0 };
+	static std::atomic<int> g_Arrived{ 0 };
+	static std::atomic<int> g_Inside{ 0 };
+	static std::atomic<int> g_Release{ 1 };   // 0 - потоки стоят; futex, поэтому int
+	static struct sigaction g_OldAction;
+	static int g_Signal = 0;
+
+	static Stats g_Stats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static bool ReadMaps(std::vector<MapRegion>& regions)
+	{
+		regions.clear();
+		FILE* file = fopen("/proc/self/maps", "r");
+		if (!file)
+			return false;
+
+		char line[1024];
+		while (fgets(line, sizeof(line), file))
+		{
+			unsigned long start = 0, end = 0;
+			char perms[5] = {};
+			if (sscanf(line, "%lx-%lx %4s", &start, &end, perms) != 3)
+				continue;
+			int protection = (perms[0] == 'r' ? PROT_READ : 0) | (perms[1] == 'w' ? PROT_WRITE : 0) |
+				(perms[2] == 'x' ? PROT_EXEC : 0);
+			regions.push_back({ start, end, protection });
+		}
+		fclose(file);
+		return true;
+	}
+
+	static const MapRegion* FindRegion(const std::vector<MapRegion>& regions, const void* address)
+	{
+		uintptr_t p = reinterpret_cast<uintptr_t>(address);
+		for (const MapRegion& r : regions)
+		{
+			if (p >= r.start && p < r.end)
+				return &r;
+		}
+		return nullptr;
+	}
+
+	static uintptr_t Distance(uintptr_t a, uintptr_t b)
+	{
+		return a > b ? a - b : b - a;
+	}
+
+	// Свободное место под регион, ближайшее к origin (промежутки между отображениями)
+	static uint8_t* AllocateRegion(uintptr_t origin)
+	{
+		std::vector<MapRegion> regions;
+		if (!ReadMaps(regions))
+			return nullptr;
+
+		uintptr_t best = 0;
+		uintptr_t previousEnd = REGION_SIZE;   // ниже mmap_min_addr не отображается
+		for (size_t i = 0; i <= regions.size(); i++)
+		{
+			uintptr_t gapStart = (previousEnd + REGION_SIZE - 1) & ~(REGION_SIZE - 1);
+			uintptr_t gapEnd = (i < regions.size() ? regions[i].start : 0x00007FFFFFFF0000ull) & ~(REGION_SIZE - 1);
+			if (i < regions.size())
+				previousEnd = (std::max)(previousEnd, regions[i].end);
+			if (gapEnd < gapStart + REGION_SIZE)
+				continue;
+
+			uintptr_t candidate = origin < gapStart ? gapStart : gapEnd - REGION_SIZE;
+			if (Distance(candidate, origin) < MAX_DISTANCE && (!best || Distance(candidate, origin) < Distance(best, origin)))
+				best = candidate;
+		}
+		if (!best)
+			return nullptr;
+
+		int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_FIXED_NOREPLACE
+		flags |= MAP_FIXED_NOREPLACE;
+#endif
+		void* p = mmap(reinterpret_cast<void*>(best), REGION_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, flags, -1, 0);
+		if (p == MAP_FAILED)
+			return nullptr;
+		if (Distance(reinterpret_cast<uintptr_t>(p), origin) >= MAX_DISTANCE)
+		{
+			// Ядро без MAP_FIXED_NOREPLACE выбрало другой адрес
+			munmap(p, REGION_SIZE);
+			return nullptr;
+		}
+
+		uint8_t* region = static_cast<uint8_t*>(p);
+		g_Regions.push_back(region);
+		for (size_t offset = REGION_SIZE; offset >= MEMORY_SLOT_SIZE; offset -= MEMORY_SLOT_SIZE)
+			g_FreeSlots.push_back(region + offset - MEMORY_SLOT_SIZE);
+		return region;
+	}
+
+	// Обработчик сигнала остановки: только атомики и pause, без блокировок и аллокаций
+	static void FreezeHandler(int, siginfo_t*, void* context)
+	{
+		int savedErrno = errno;
+		pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+
+		g_Inside.fetch_add(1, std::memory_order_acq_rel);
+		int count = g_FrozenCount.load(std::memory_order_acquire);
+		for (int i = 0; i < count; i++)
+		{
+			if (g_Frozen[i].tid == tid)
+			{
+				g_Frozen[i].context.store(static_cast<ucontext_t*>(context), std::memory_order_release);
+				g_Arrived.fetch_add(1, std::memory_order_acq_rel);
+				syscall(SYS_futex, reinterpret_cast<int*>(&g_Arrived), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+				break;
+			}
+		}
+
+		// Ждём в ядре, а не в цикле: остановленные потоки не отнимают ядра у того, кто патчит
+		while (g_Release.load(std::memory_order_acquire) == 0)
+			syscall(SYS_futex, reinterpret_cast<int*>(&g_Release), FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+
+		g_Inside.fetch_sub(1, std::memory_order_acq_rel);
+		errno = savedErrno;
+	}
+
+	// Останавливает все потоки процесса, кроме текущего. Аллокации - только до отправки сигналов
+	static bool Freeze()
+	{
+		DIR* dir = opendir("/proc/self/task");
+		if (!dir)
+			return false;
+
+		pid_t self = static_cast<pid_t>(syscall(SYS_gettid));
+		std::vector<pid_t> tids;
+		while (dirent* entry = readdir(dir))
+		{
+			pid_t tid = static_cast<pid_t>(atoi(entry->d_name));
+			if (tid > 0 && tid != self)
+				tids.push_back(tid);
+		}
+		closedir(dir);
+		if (tids.size() > static_cast<size_t>(MAX_FROZEN))
+			return false;
+
+		g_Release.store(0, std::memory_order_release);
+		g_Arrived.store(0, std::memory_order_release);
+		for (size_t i = 0; i < tids.size(); i++)
+		{
+			g_Frozen[i].tid = tids[i];
+			g_Frozen[i].context.store(nullptr, std::memory_order_relaxed);
+		}
+		g_FrozenCount.store(static_cast<int>(tids.size()), std::memory_order_release);
+
+		int signalled = 0;
+		pid_t pid = getpid();
+		for (pid_t tid : tids)
+		{
+			if (syscall(SYS_tgkill, pid, tid, g_Signal) == 0)
+				signalled++;   // ESRCH: поток уже завершился
+		}
+
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(FREEZE_TIMEOUT_MS);
+		const timespec poll = { 0, 1000000 };
+		for (int arrived; (arrived = g_Arrived.load(std::memory_order_acquire)) < signalled; )
+		{
+			if (std::chrono::steady_clock::now() > deadline)
+				return false;   // поток блокирует сигнал или завершился после tgkill
+			// Спим, пока не придёт следующий поток: на занятых ядрах им нужно процессорное время
+			syscall(SYS_futex, reinterpret_cast<int*>(&g_Arrived), FUTEX_WAIT_PRIVATE, arrived, &poll, nullptr, 0);
+		}
+
+		g_Stats.lastFrozenThreads = signalled;
+		return true;
+	}
+
+	static void Unfreeze()
+	{
+		g_Release.store(1, std::memory_order_release);
+		syscall(SYS_futex, reinterpret_cast<int*>(&g_Release), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+		while (g_Inside.load(std::memory_order_acquire) > 0)
+			std::this_thread::yield();
+		g_FrozenCount.store(0, std::memory_order_release);
+	}
+
+	// Поток стоит внутри переписываемых байт - переносим RIP (как ProcessThreadIPs в hook.c)
+	static void MoveThreadIP(ucontext_t* context, const Hook& hook, bool enable)
+	{
+		greg_t& rip = context->uc_mcontext.gregs[REG_RIP];
+		uintptr_t ip = static_cast<uintptr_t>(rip);
+		uintptr_t target = reinterpret_cast<uintptr_t>(hook.target);
+		uintptr_t trampoline = reinterpret_cast<uintptr_t>(hook.trampoline);
+
+		for (int i = 0; i < hook.nIP; i++)
+		{
+			uintptr_t from = enable ? target + hook.oldIPs[i] : trampoline + hook.newIPs[i];
+			if (ip == from)
+			{
+				rip = static_cast<greg_t>(enable ? trampoline + hook.newIPs[i] : target + hook.oldIPs[i]);
+				return;
+			}
+		}
+
+		if (!enable && (ip == reinterpret_cast<uintptr_t>(hook.relay) ||
+			(hook.patchAbove && ip == target - sizeof(JMP_REL))))
+			rip = static_cast<greg_t>(target);
+	}
+
+	static bool Patch(Hook& hook, bool enable)
+	{
+		uint8_t* patch = hook.target;
+		size_t size = sizeof(JMP_REL);
+		if (hook.patchAbove)
+		{
+			patch -= sizeof(JMP_REL);
+			size += sizeof(JMP_REL_SHORT);
+		}
+
+		const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+		uintptr_t first = reinterpret_cast<uintptr_t>(patch) & ~(pageSize - 1);
+		uintptr_t last = (reinterpret_cast<uintptr_t>(patch) + size + pageSize - 1) & ~(pageSize - 1);
+		if (mprotect(reinterpret_cast<void*>(first), last - first, PROT_READ | PROT_WRITE | PROT_EXEC) != 0)
+			return false;
+
+		if (enable)
+		{
+			JMP_REL jmp = { 0xE9, static_cast<INT32>(hook.relay - (patch + sizeof(JMP_REL))) };
+			memcpy(patch, &jmp, sizeof(jmp));
+			if (hook.patchAbove)
+			{
+				JMP_REL_SHORT shortJmp = { 0xEB, static_cast<INT8>(0 - (sizeof(JMP_REL_SHORT) + sizeof(JMP_REL))) };
+				memcpy(hook.target, &shortJmp, sizeof(shortJmp));
+			}
+		}
+		else
+		{
+			memcpy(patch, hook.backup, size);
+		}
+
+		mprotect(reinterpret_cast<void*>(first), last - first, hook.protection);
+		__builtin___clear_cache(reinterpret_cast<char*>(patch), reinterpret_cast<char*>(patch + size));
+		hook.enabled = enable;
+		hook.queueEnable = enable;
+		return true;
+	}
+
+	// Применяет queueEnable != enabled у одного хука (only >= 0) или у всех за одну остановку
+	static Status ApplyChanges(int only)
+	{
+		size_t begin = only >= 0 ? static_cast<size_t>(only) : 0;
+		size_t end = only >= 0 ? begin + 1 : g_Hooks.size();
+
+		bool any = false;
+		for (size_t i = begin; i < end; i++)
+			any |= g_Hooks[i].queueEnable != g_Hooks[i].enabled;
+		if (!any)
+			return Status::Ok;
+
+		auto start = std::chrono::steady_clock::now();
+		if (!Freeze())
+		{
+			Unfreeze();
+			return Status::ThreadFreeze;
+		}
+
+		Status status = Status::Ok;
+		int frozen = g_FrozenCount.load(std::memory_order_acquire);
+		for (size_t i = begin; i < end; i++)
+		{
+			Hook& hook = g_Hooks[i];
+			if (hook.queueEnable == hook.enabled)
+				continue;
+
+			bool enable = hook.queueEnable;
+			for (int t = 0; t < frozen; t++)
+			{
+				if (ucontext_t* context = g_Frozen[t].context.load(std::memory_order_acquire))
+					MoveThreadIP(context, hook, enable);
+			}
+			if (!Patch(hook, enable))
+				status = Status::MemoryProtect;
+		}
+
+		Unfreeze();
+		g_Stats.freezes++;
+		g_Stats.lastFreezeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		return status;
+	}
+
+	static int FindHook(void* target)
+	{
+		for (size_t i = 0; i < g_Hooks.size(); i++)
+		{
+			if (g_Hooks[i].target == target)
+				return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	static Status Queue(void* target, bool enable)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (!g_Initialized)
+			return Status::NotInitialized;
+
+		if (target == ALL_HOOKS)
+		{
+			for (Hook& hook : g_Hooks)
+				hook.queueEnable = enable;
+			return Status::Ok;
+		}
+
+		int pos = FindHook(target);
+		if (pos < 0)
+			return Status::NotCreated;
+		g_Hooks[pos].queueEnable = enable;
+		return Status::Ok;
+	}
+
+	static Status EnableOne(void* target, bool enable)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (!g_Initialized)
+			return Status::NotInitialized;
+
+		int pos = FindHook(target);
+		if (pos < 0)
+			return Status::NotCreated;
+		g_Hooks[pos].queueEnable = enable;
+		return ApplyChanges(pos);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	Status Initialize()
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (g_Initialized)
+			return Status::Ok;
+
+		// Третий сигнал реального времени: первые занимает NPTL
+		g_Signal = SIGRTMIN + 2;
+		struct sigaction action = {};
+		action.sa_sigaction = FreezeHandler;
+		action.sa_flags = SA_SIGINFO | SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		if (sigaction(g_Signal, &action, &g_OldAction) != 0)
+			return Status::ThreadFreeze;
+
+		g_Stats = Stats();
+		g_Initialized = true;
+		return Status::Ok;
+	}
+
+	Status Shutdown()
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (!g_Initialized)
+			return Status::NotInitialized;
+
+		for (Hook& hook : g_Hooks)
+			hook.queueEnable = false;
+		Status status = ApplyChanges(-1);
+		if (status != Status::Ok)
+			return status;   // хуки остались на месте - трамплины не освобождаем
+
+		g_Hooks.clear();
+		g_FreeSlots.clear();
+		for (uint8_t* region : g_Regions)
+			munmap(region, REGION_SIZE);
+		g_Regions.clear();
+
+		sigaction(g_Signal, &g_OldAction, nullptr);
+		g_Initialized = false;
+		g_Stats.hooks = 0;
+		g_Stats.enabled = 0;
+		return Status::Ok;
+	}
+
+	Status Create(void* target, void* detour, void** original)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (!g_Initialized)
+			return Status::NotInitialized;
+		if (FindHook(target) >= 0)
+			return Status::AlreadyCreated;
+
+		// Одно чтение /proc/self/maps на цель и детур
+		std::vector<MapRegion> regions;
+		ReadMaps(regions);
+		const MapRegion* region = FindRegion(regions, target);
+		const MapRegion* detourRegion = FindRegion(regions, detour);
+		if (!region || !detourRegion || !(region->protection & PROT_EXEC) || !(detourRegion->protection & PROT_EXEC))
+			return Status::NotExecutable;
+
+		void* buffer = AllocateBuffer(target);
+		if (!buffer)
+			return Status::MemoryAlloc;
+
+		TRAMPOLINE ct = {};
+		ct.pTarget = target;
+		ct.pDetour = detour;
+		ct.pTrampoline = buffer;
+		if (!CreateTrampolineFunction(&ct))
+		{
+			FreeBuffer(buffer);
+			return Status::Unsupported;
+		}
+
+		Hook hook = {};
+		hook.target = static_cast<uint8_t*>(target);
+		hook.relay = static_cast<uint8_t*>(ct.pRelay);
+		hook.trampoline = static_cast<uint8_t*>(buffer);
+		hook.protection = region->protection;
+		hook.patchAbove = ct.patchAbove != FALSE;
+		hook.nIP = static_cast<uint8_t>(ct.nIP);
+		memcpy(hook.oldIPs, ct.oldIPs, sizeof(hook.oldIPs));
+		memcpy(hook.newIPs, ct.newIPs, sizeof(hook.newIPs));
+		if (hook.patchAbove)
+			memcpy(hook.backup, hook.target - sizeof(JMP_REL), sizeof(JMP_REL) + sizeof(JMP_REL_SHORT));
+		else
+			memcpy(hook.backup, hook.target, sizeof(JMP_REL));
+		g_Hooks.push_back(hook);
+
+		if (original)
+			*original = buffer;
+		return Status::Ok;
+	}
+
+	Status Remove(void* target)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (!g_Initialized)
+			return Status::NotInitialized;
+
+		int pos = FindHook(target);
+		if (pos < 0)
+			return Status::NotCreated;
+
+		g_Hooks[pos].queueEnable = false;
+		Status status = ApplyChanges(pos);
+		if (status != Status::Ok)
+			return status;
+
+		FreeBuffer(g_Hooks[pos].trampoline);
+		g_Hooks.erase(g_Hooks.begin() + pos);
+		return Status::Ok;
+	}
+
+	Status QueueEnable(void* target)
+	{
+		return Queue(target, true);
+	}
+
+	Status QueueDisable(void* target)
+	{
+		return Queue(target, false);
+	}
+
+	Status ApplyQueued()
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (!g_Initialized)
+			return Status::NotInitialized;
+		return ApplyChanges(-1);
+	}
+
+	Status Enable(void* target)
+	{
+		return EnableOne(target, true);
+	}
+
+	Status Disable(void* target)
+	{
+		return EnableOne(target, false);
+	}
+
+	const char* StatusText(Status status)
+	{
+		static const char* const TEXT[] = {
+			"ok", "not initialized", "already created", "not created", "not executable",
+			"unsupported function", "memory alloc", "memory protect", "thread freeze"
+		};
+		return TEXT[static_cast<int>(status)];
+	}
+
+	Stats GetStats()
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		Stats stats = g_Stats;
+		stats.hooks = static_cast<int>(g_Hooks.size());
+		stats.enabled = static_cast<int>(std::count_if(g_Hooks.begin(), g_Hooks.end(), [](const Hook& hook) { return hook.enabled; }));
+		return stats;
+	}
+}
+
+// ============================================================================
+// buffer.h для trampoline.c
+// ============================================================================
+
+extern "C"
+{
+	VOID InitializeBuffer(VOID)
+	{
+	}
+
+	VOID UninitializeBuffer(VOID)
+	{
+	}
+
+	LPVOID AllocateBuffer(LPVOID pOrigin)
+	{
+		using namespace Hooks;
+		uintptr_t origin = reinterpret_cast<uintptr_t>(pOrigin);
+		for (size_t i = 0; i < g_FreeSlots.size(); i++)
+		{
+			if (Distance(reinterpret_cast<uintptr_t>(g_FreeSlots[i]), origin) < MAX_DISTANCE)
+			{
+				uint8_t* slot = g_FreeSlots[i];
+				g_FreeSlots[i] = g_FreeSlots.back();
+				g_FreeSlots.pop_back();
+				memset(slot, 0xCC, MEMORY_SLOT_SIZE);
+				return slot;
+			}
+		}
+
+		if (!AllocateRegion(origin))
+			return nullptr;
+		uint8_t* slot = g_FreeSlots.back();
+		g_FreeSlots.pop_back();
+		memset(slot, 0xCC, MEMORY_SLOT_SIZE);
+		return slot;
+	}
+
+	VOID FreeBuffer(LPVOID pBuffer)
+	{
+		Hooks::g_FreeSlots.push_back(static_cast<uint8_t*>(pBuffer));
+	}
+
+	BOOL IsExecutableAddress(LPVOID pAddress)
+	{
+		std::vector<Hooks::MapRegion> regions;
+		Hooks::ReadMaps(regions);
+		const Hooks::MapRegion* region = Hooks::FindRegion(regions, pAddress);
+		return region && (region->protection & PROT_EXEC) ? TRUE : FALSE;
+	}
+}
@@ -0,0 +1,125 @@
+#include "hooks.h"
+#include "../../deps/minhook/include/MinHook.h"
+#include <chrono>
+
+// Windows: MinHook целиком. Пакетное включение - его очередь (MH_QueueEnableHook +
+// MH_ApplyQueued): все потоки процесса останавливаются один раз на весь пакет
+
+namespace Hooks
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	static Stats g_Stats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static Status FromMinHook(MH_STATUS status)
+	{
+		switch (status)
+		{
+		case MH_OK: return Status::Ok;
+		case MH_ERROR_ALREADY_INITIALIZED: return Status::Ok;
+		case MH_ERROR_NOT_INITIALIZED: return Status::NotInitialized;
+		case MH_ERROR_ALREADY_CREATED: return Status::AlreadyCreated;
+		case MH_ERROR_NOT_CREATED: return Status::NotCreated;
+		case MH_ERROR_ENABLED: return Status::Ok;
+		case MH_ERROR_DISABLED: return Status::Ok;
+		case MH_ERROR_NOT_EXECUTABLE: return Status::NotExecutable;
+		case MH_ERROR_UNSUPPORTED_FUNCTION: return Status::Unsupported;
+		case MH_ERROR_MEMORY_ALLOC: return Status::MemoryAlloc;
+		case MH_ERROR_MEMORY_PROTECT: return Status::MemoryProtect;
+		default: return Status::ThreadFreeze;
+		}
+	}
+
+	// Вызов MinHook, который останавливает потоки
+	template<typename Fn>
+	static Status Frozen(Fn fn)
+	{
+		auto start = std::chrono::steady_clock::now();
+		MH_STATUS status = fn();
+		g_Stats.lastFreezeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		g_Stats.freezes++;
+		return FromMinHook(status);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	Status Initialize()
+	{
+		g_Stats = Stats();
+		g_Stats.enabled = -1;
+		g_Stats.lastFrozenThreads = -1;
+		return FromMinHook(MH_Initialize());
+	}
+
+	Status Shutdown()
+	{
+		// MH_Uninitialize освобождает трамплины всех хуков
+		Status status = Frozen([] { return MH_DisableHook(MH_ALL_HOOKS); });
+		MH_Uninitialize();
+		g_Stats.hooks = 0;
+		return status;
+	}
+
+	Status Create(void* target, void* detour, void** original)
+	{
+		Status status = FromMinHook(MH_CreateHook(target, detour, original));
+		if (status == Status::Ok)
+			g_Stats.hooks++;
+		return status;
+	}
+
+	Status Remove(void* target)
+	{
+		Status status = Frozen([target] { return MH_RemoveHook(target); });
+		if (status == Status::Ok)
+			g_Stats.hooks--;
+		return status;
+	}
+
+	Status QueueEnable(void* target)
+	{
+		return FromMinHook(MH_QueueEnableHook(target == ALL_HOOKS ? MH_ALL_HOOKS : target));
+	}
+
+	Status QueueDisable(void* target)
+	{
+		return FromMinHook(MH_QueueDisableHook(target == ALL_HOOKS ? MH_ALL_HOOKS : target));
+	}
+
+	Status ApplyQueued()
+	{
+		return Frozen([] { return MH_ApplyQueued(); });
+	}
+
+	Status Enable(void* target)
+	{
+		return Frozen([target] { return MH_EnableHook(target); });
+	}
+
+	Status Disable(void* target)
+	{
+		return Frozen([target] { return MH_DisableHook(target); });
+	}
+
+	const char* StatusText(Status status)
+	{
+		static const char* const TEXT[] = {
+			"ok", "not initialized", "already created", "not created", "not executable",
+			"unsupported function", "memory alloc", "memory protect", "thread freeze"
+		};
+		return TEXT[static_cast<int>(status)];
+	}
+
+	Stats GetStats()
+	{
+		return g_Stats;
+	}
+}
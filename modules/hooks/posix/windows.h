@@ -0,0 +1,32 @@
+#pragma once
+
+// Win32 types used by MinHook's trampoline.c, buffer.h and hde64 (via pstdint.h).
+// Only on the include path of the POSIX hook backend: lets those files build
+// unchanged outside Windows.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define WINAPI
+#define VOID void
+
+typedef int BOOL;
+#define TRUE  1
+#define FALSE 0
+
+typedef int8_t    INT8;
+typedef int16_t   INT16;
+typedef int32_t   INT32;
+typedef int64_t   INT64;
+typedef uint8_t   UINT8;
+typedef uint16_t  UINT16;
+typedef uint32_t  UINT32;
+typedef uint64_t  UINT64;
+typedef uint32_t* PUINT32;
+typedef unsigned int UINT;
+typedef uint8_t*  LPBYTE;
+typedef void*     LPVOID;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t DWORD_PTR;
+typedef size_t    SIZE_T;
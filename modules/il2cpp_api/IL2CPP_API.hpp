@@ -8,10 +8,138 @@
  */
 
 #include <IL2CPP_Resolver.hpp>
+#include <mutex>
 #include "../console/console.h"
+#include "../console/commands.h"
 
 namespace IL2CPP_API
 {
+	// ============================================================================
+	// КЭШ ПОИСКА
+	// ============================================================================
+
+	/// Статистика кэша поиска классов/полей/методов
+	struct CacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint32_t entries = 0;
+	};
+
+	namespace Detail
+	{
+		/// Размер таблицы (степень двойки). Найденные классы, поля и методы не
+		/// выгружаются, пока жив домен, поэтому записи не удаляются
+		constexpr uint32_t CACHE_SIZE = 512;
+		constexpr size_t CACHE_NAME_SIZE = 96;
+		constexpr uint32_t CACHE_MAX_PROBES = 16;
+
+		struct CacheEntry
+		{
+			const void* owner;  // класс для полей/методов, nullptr для классов
+			int extra;          // количество параметров метода, -1 если не задано
+			uint32_t hash;
+			void* value;        // nullptr - пустая запись
+			char name[CACHE_NAME_SIZE];
+		};
+
+		struct LookupCache
+		{
+			std::mutex mutex;
+			CacheEntry entries[CACHE_SIZE] = {};
+			CacheStats stats;
+		};
+
+		inline LookupCache g_ClassCache;
+		inline LookupCache g_FieldCache;
+		inline LookupCache g_MethodCache;
+
+		inline uint32_t HashKey(const void* owner, int extra, const char* name)
+		{
+			// FNV-1a по имени, затем владелец и количество параметров
+			uint32_t hash = 2166136261u;
+			for (const char* p = name; *p; p++)
+				hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+
+			uint64_t mix = reinterpret_cast<uintptr_t>(owner) ^ (static_cast<uint64_t>(static_cast<uint32_t>(extra)) << 3);
+			hash ^= static_cast<uint32_t>(mix ^ (mix >> 32));
+			return hash * 2654435761u;
+		}
+
+		/// Ищет в кэше, при промахе вызывает resolve (без блокировки) и запоминает
+		/// ненулевой результат. Пустые результаты не кэшируются: класс может
+		/// появиться позже, когда загрузится сборка
+		template<typename T, typename Resolve>
+		inline T* CachedLookup(LookupCache& cache, const void* owner, int extra, const char* name, Resolve resolve)
+		{
+			size_t length = strlen(name);
+			if (length >= CACHE_NAME_SIZE)
+			{
+				std::lock_guard<std::mutex> lock(cache.mutex);
+				cache.stats.misses++;
+			}
+			else
+			{
+				uint32_t hash = HashKey(owner, extra, name);
+				std::lock_guard<std::mutex> lock(cache.mutex);
+				for (uint32_t probe = 0; probe < CACHE_MAX_PROBES; probe++)
+				{
+					const CacheEntry& entry = cache.entries[(hash + probe) & (CACHE_SIZE - 1)];
+					if (!entry.value)
+						break;
+					if (entry.hash == hash && entry.owner == owner && entry.extra == extra && strcmp(entry.name, name) == 0)
+					{
+						cache.stats.hits++;
+						return static_cast<T*>(entry.value);
+					}
+				}
+				cache.stats.misses++;
+			}
+
+			T* value = resolve();
+			if (!value || length >= CACHE_NAME_SIZE)
+				return value;
+
+			uint32_t hash = HashKey(owner, extra, name);
+			std::lock_guard<std::mutex> lock(cache.mutex);
+			for (uint32_t probe = 0; probe < CACHE_MAX_PROBES; probe++)
+			{
+				CacheEntry& entry = cache.entries[(hash + probe) & (CACHE_SIZE - 1)];
+				if (entry.value)
+				{
+					// Другой поток успел добавить ту же запись
+					if (entry.hash == hash && entry.owner == owner && entry.extra == extra && strcmp(entry.name, name) == 0)
+						break;
+					continue;
+				}
+
+				entry.owner = owner;
+				entry.extra = extra;
+				entry.hash = hash;
+				memcpy(entry.name, name, length + 1);
+				entry.value = value;
+				cache.stats.entries++;
+				break;
+			}
+			return value;
+		}
+
+		inline CacheStats GetStats(LookupCache& cache)
+		{
+			std::lock_guard<std::mutex> lock(cache.mutex);
+			return cache.stats;
+		}
+	}
+
+	/// Статистика кэша FindClass
+	inline CacheStats GetClassCacheStats() { return Detail::GetStats(Detail::g_ClassCache); }
+
+	/// Статистика кэша FindField
+	inline CacheStats GetFieldCacheStats() { return Detail::GetStats(Detail::g_FieldCache); }
+
+	/// Статистика кэша FindMethod
+	inline CacheStats GetMethodCacheStats() { return Detail::GetStats(Detail::g_MethodCache); }
+
 	// ============================================================================
 	// ИНИЦИАЛИЗАЦИЯ
 	// ============================================================================
@@ -62,7 +190,8 @@ namespace IL2CPP_API
 		if (!fullName || !IsInitialized())
 			return nullptr;
 
-		return IL2CPP::Class::Find(fullName);
+		return Detail::CachedLookup<Unity::il2cppClass>(Detail::g_ClassCache, nullptr, -1, fullName,
+			[&]() { return IL2CPP::Class::Find(fullName); });
 	}
 
 	/// Получает класс по namespace и name
@@ -72,8 +201,9 @@ namespace IL2CPP_API
 			return nullptr;
 
 		// Используем поиск по полному имени
-		std::string fullName = std::string(namespaceName) + "." + className;
-		return IL2CPP::Class::Find(fullName.c_str());
+		char fullName[256];
+		snprintf(fullName, sizeof(fullName), "%s.%s", namespaceName, className);
+		return FindClass(fullName);
 	}
 
 	// ============================================================================
@@ -86,19 +216,21 @@ namespace IL2CPP_API
 		if (!klass || !fieldName)
 			return nullptr;
 
-		void* iterator = nullptr;
-		Unity::il2cppFieldInfo* field = nullptr;
+		return Detail::CachedLookup<Unity::il2cppFieldInfo>(Detail::g_FieldCache, klass, -1, fieldName, [&]() {
+			void* iterator = nullptr;
+			Unity::il2cppFieldInfo* field = nullptr;
 
-		while (true)
-		{
-			field = IL2CPP::Class::GetFields(klass, &iterator);
-			if (!field) break;
+			while (true)
+			{
+				field = IL2CPP::Class::GetFields(klass, &iterator);
+				if (!field) break;
 
-			if (field->m_pName && strcmp(field->m_pName, fieldName) == 0)
-				return field;
-		}
+				if (field->m_pName && strcmp(field->m_pName, fieldName) == 0)
+					return field;
+			}
 
-		return nullptr;
+			return static_cast<Unity::il2cppFieldInfo*>(nullptr);
+		});
 	}
 
 	// ============================================================================
@@ -111,19 +243,21 @@ namespace IL2CPP_API
 		if (!klass || !methodName)
 			return nullptr;
 
-		void* iterator = nullptr;
-		Unity::il2cppMethodInfo* method = nullptr;
+		return Detail::CachedLookup<Unity::il2cppMethodInfo>(Detail::g_MethodCache, klass, -1, methodName, [&]() {
+			void* iterator = nullptr;
+			Unity::il2cppMethodInfo* method = nullptr;
 
-		while (true)
-		{
-			method = IL2CPP::Class::GetMethods(klass, &iterator);
-			if (!method) break;
+			while (true)
+			{
+				method = IL2CPP::Class::GetMethods(klass, &iterator);
+				if (!method) break;
 
-			if (method->m_pName && strcmp(method->m_pName, methodName) == 0)
-				return method;
-		}
+				if (method->m_pName && strcmp(method->m_pName, methodName) == 0)
+					return method;
+			}
 
-		return nullptr;
+			return static_cast<Unity::il2cppMethodInfo*>(nullptr);
+		});
 	}
 
 	/// Получает метод класса по имени и количеству параметров
@@ -132,19 +266,21 @@ namespace IL2CPP_API
 		if (!klass || !methodName || paramCount < 0)
 			return nullptr;
 
-		void* iterator = nullptr;
-		Unity::il2cppMethodInfo* method = nullptr;
+		return Detail::CachedLookup<Unity::il2cppMethodInfo>(Detail::g_MethodCache, klass, paramCount, methodName, [&]() {
+			void* iterator = nullptr;
+			Unity::il2cppMethodInfo* method = nullptr;
 
-		while (true)
-		{
-			method = IL2CPP::Class::GetMethods(klass, &iterator);
-			if (!method) break;
+			while (true)
+			{
+				method = IL2CPP::Class::GetMethods(klass, &iterator);
+				if (!method) break;
 
-			if (method->m_pName && strcmp(method->m_pName, methodName) == 0 && method->m_uArgsCount == paramCount)
-				return method;
-		}
+				if (method->m_pName && strcmp(method->m_pName, methodName) == 0 && method->m_uArgsCount == paramCount)
+					return method;
+			}
 
-		return nullptr;
+			return static_cast<Unity::il2cppMethodInfo*>(nullptr);
+		});
 	}
 
 	// ============================================================================
@@ -186,4 +322,29 @@ namespace IL2CPP_API
 		Unity::il2cppObject* il2cppObj = reinterpret_cast<Unity::il2cppObject*>(obj);
 		return il2cppObj->m_pClass;
 	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	inline void LogCacheStats(const char* name, const CacheStats& stats)
+	{
+		uint64_t total = stats.hits + stats.misses;
+		Console::Log("  %-8s hits %llu  misses %llu  (%.1f%%)  entries %u/%u", name,
+			static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+			total ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(total) : 0.0,
+			stats.entries, Detail::CACHE_SIZE);
+	}
+
+	/// Регистрирует команду il2cpp.cache (статистика кэша поиска)
+	inline void RegisterCommands()
+	{
+		Console::Commands::Register({ "il2cpp.cache", "", "IL2CPP lookup cache hit rates",
+			[](const Console::Commands::Args&, void*) {
+				Console::Log("IL2CPP lookup cache (initialized: %s)", IsInitialized() ? "yes" : "no");
+				LogCacheStats("classes", GetClassCacheStats());
+				LogCacheStats("fields", GetFieldCacheStats());
+				LogCacheStats("methods", GetMethodCacheStats());
+			} });
+	}
 }
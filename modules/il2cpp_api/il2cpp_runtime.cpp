@@ -0,0 +1,337 @@
+#include "il2cpp_runtime.h"
+#include "IL2CPP_API.hpp"
+#include "../objects/object_handles.h"
+#include <cstddef>
+#include <cstring>
+
+// Единственная единица трансляции с IL2CPP_Resolver
+
+namespace IL2CPP_API
+{
+	namespace Runtime
+	{
+		// ============================================================================
+		// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+		// ============================================================================
+
+		/// Начальная ёмкость списка компонентов (растёт сам, если у объекта их больше)
+		constexpr int COMPONENT_LIST_CAPACITY = 32;
+
+		static_assert(offsetof(IL2CPP::CClass, m_CachedPtr) == Objects::CACHED_PTR_OFFSET, "UnityEngine.Object layout changed");
+
+		/// FIELD_ATTRIBUTE_* из metadata (il2cpp_field_get_flags)
+		constexpr int FIELD_ATTRIBUTE_STATIC = 0x0010;
+		constexpr int FIELD_ATTRIBUTE_LITERAL = 0x0040;
+
+		/// Смещение thread-static поля: значение лежит в блоке потока, а не в m_pStaticFields
+		constexpr int THREAD_STATIC_FIELD_OFFSET = -1;
+
+		/// Il2CppTypeEnum ссылочных типов
+		constexpr int IL2CPP_TYPE_STRING = 0x0e;
+		constexpr int IL2CPP_TYPE_CLASS = 0x12;
+		constexpr int IL2CPP_TYPE_ARRAY = 0x14;
+		constexpr int IL2CPP_TYPE_GENERICINST = 0x15;
+		constexpr int IL2CPP_TYPE_OBJECT = 0x1c;
+		constexpr int IL2CPP_TYPE_SZARRAY = 0x1d;
+
+		/// Наибольшее поле, которое сверяется с медленным путём при разрешении
+		constexpr uint32_t STATIC_CHECK_SIZE = 64;
+
+		typedef void(UNITY_CALLING_CONVENTION ListCtorFn)(void* list, int capacity, const void* method);
+		typedef uint32_t(IL2CPP_CALLING_CONVENTION GcHandleNewFn)(void* object, bool pinned);
+		typedef int(IL2CPP_CALLING_CONVENTION FieldGetFlagsFn)(void* field);
+		typedef size_t(IL2CPP_CALLING_CONVENTION FieldGetOffsetFn)(void* field);
+		typedef void*(IL2CPP_CALLING_CONVENTION FieldGetTypeFn)(void* field);
+		typedef int(IL2CPP_CALLING_CONVENTION TypeGetTypeFn)(void* type);
+		typedef void*(IL2CPP_CALLING_CONVENTION ClassFromTypeFn)(void* type);
+		typedef bool(IL2CPP_CALLING_CONVENTION ClassIsValueTypeFn)(void* klass);
+		typedef int32_t(IL2CPP_CALLING_CONVENTION ClassValueSizeFn)(void* klass, uint32_t* align);
+		typedef void(IL2CPP_CALLING_CONVENTION RuntimeClassInitFn)(void* klass);
+		typedef void(IL2CPP_CALLING_CONVENTION FieldStaticValueFn)(void* field, void* value);
+		typedef void(IL2CPP_CALLING_CONVENTION WriteBarrierFn)(void* object, void** targetAddress, void* value);
+
+		/// Экспорты для статических полей (IL2CPP_Resolver их не загружает)
+		struct StaticFieldExports
+		{
+			FieldGetFlagsFn fieldGetFlags = nullptr;
+			FieldGetOffsetFn fieldGetOffset = nullptr;
+			FieldGetTypeFn fieldGetType = nullptr;
+			TypeGetTypeFn typeGetType = nullptr;
+			ClassFromTypeFn classFromType = nullptr;
+			ClassIsValueTypeFn classIsValueType = nullptr;
+			ClassValueSizeFn classValueSize = nullptr;
+			RuntimeClassInitFn runtimeClassInit = nullptr;
+			WriteBarrierFn writeBarrier = nullptr;      // может отсутствовать (Boehm без барьеров)
+			bool loaded = false;
+		};
+
+		static StaticFieldExports g_StaticExports;
+		static Unity::il2cppList<Unity::CComponent*>* g_ComponentList = nullptr;
+		static uint32_t g_ComponentListHandle = 0;
+		static ComponentStats g_ComponentStats;
+		static Objects::Ref<Unity::CCamera> g_MainCamera;
+		static uint64_t g_MainCameraLookups = 0;
+
+		// ============================================================================
+		// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+		// ============================================================================
+
+		// List<Component> - тип второго параметра GameObject.GetComponents(Type, List<Component>).
+		// Список живёт до выгрузки: GC-хэндл не даёт сборщику его забрать
+		static Unity::il2cppList<Unity::CComponent*>* CreateComponentList()
+		{
+			Unity::il2cppClass* gameObject = IL2CPP_API::FindClass(UNITY_GAMEOBJECT_CLASS);
+			Unity::il2cppMethodInfo* getComponents = gameObject ? IL2CPP_API::FindMethod(gameObject, "GetComponents", 2) : nullptr;
+			Unity::il2cppType* listType = getComponents ? IL2CPP::Class::Utils::GetMethodParamType(getComponents, 1) : nullptr;
+			Unity::il2cppClass* listClass = listType ? IL2CPP::Class::Utils::ClassFromType(listType) : nullptr;
+			Unity::il2cppMethodInfo* ctor = listClass ? IL2CPP_API::FindMethod(listClass, ".ctor", 1) : nullptr;
+			auto gcHandleNew = reinterpret_cast<GcHandleNewFn>(GetProcAddress(IL2CPP::Globals.m_GameAssembly, "il2cpp_gchandle_new"));
+			if (!ctor || !ctor->m_pMethodPointer || !gcHandleNew)
+				return nullptr;
+
+			Unity::il2cppObject* list = Unity::Object::New(listClass);
+			if (!list)
+				return nullptr;
+
+			reinterpret_cast<ListCtorFn>(ctor->m_pMethodPointer)(list, COMPONENT_LIST_CAPACITY, ctor);
+			g_ComponentListHandle = gcHandleNew(list, false);
+			return reinterpret_cast<Unity::il2cppList<Unity::CComponent*>*>(list);
+		}
+
+		template<typename T>
+		static void LoadExport(T& function, const char* name)
+		{
+			function = reinterpret_cast<T>(GetProcAddress(IL2CPP::Globals.m_GameAssembly, name));
+		}
+
+		static bool LoadStaticFieldExports()
+		{
+			StaticFieldExports& e = g_StaticExports;
+			if (!e.loaded)
+			{
+				LoadExport(e.fieldGetFlags, "il2cpp_field_get_flags");
+				LoadExport(e.fieldGetOffset, "il2cpp_field_get_offset");
+				LoadExport(e.fieldGetType, "il2cpp_field_get_type");
+				LoadExport(e.typeGetType, "il2cpp_type_get_type");
+				LoadExport(e.classFromType, "il2cpp_class_from_type");
+				LoadExport(e.classIsValueType, "il2cpp_class_is_valuetype");
+				LoadExport(e.classValueSize, "il2cpp_class_value_size");
+				LoadExport(e.runtimeClassInit, "il2cpp_runtime_class_init");
+				LoadExport(e.writeBarrier, "il2cpp_gc_wbarrier_set_field");
+				e.loaded = true;
+			}
+			return e.fieldGetFlags && e.fieldGetOffset && e.fieldGetType && e.typeGetType &&
+				e.classFromType && e.classIsValueType && e.classValueSize && e.runtimeClassInit;
+		}
+
+		static bool IsReferenceType(void* type)
+		{
+			const StaticFieldExports& e = g_StaticExports;
+			switch (e.typeGetType(type))
+			{
+			case IL2CPP_TYPE_STRING:
+			case IL2CPP_TYPE_CLASS:
+			case IL2CPP_TYPE_ARRAY:
+			case IL2CPP_TYPE_OBJECT:
+			case IL2CPP_TYPE_SZARRAY:
+				return true;
+			case IL2CPP_TYPE_GENERICINST:
+			{
+				void* klass = e.classFromType(type);
+				return klass && !e.classIsValueType(klass);
+			}
+			default:
+				return false;
+			}
+		}
+
+		static uint32_t FieldValueSize(void* type, bool reference)
+		{
+			if (reference)
+				return sizeof(void*);
+			void* klass = g_StaticExports.classFromType(type);
+			uint32_t align = 0;
+			int32_t size = klass ? g_StaticExports.classValueSize(klass, &align) : 0;
+			return size > 0 ? static_cast<uint32_t>(size) : 0;
+		}
+
+		// Раскладка il2cppClass в IL2CPP_Resolver привязана к версии Unity: перед тем как
+		// доверять m_pStaticFields, значение по адресу сверяется с медленным путём
+		static bool DirectAddressMatches(const StaticFieldInfo& info)
+		{
+			if (info.size > STATIC_CHECK_SIZE)
+				return true;
+
+			uint8_t slow[STATIC_CHECK_SIZE];
+			ReadStaticSlow(info, slow);
+			return memcmp(slow, info.address, info.size) == 0;
+		}
+
+		// ============================================================================
+		// РЕАЛИЗАЦИЯ
+		// ============================================================================
+
+		bool Initialize()
+		{
+			if (!IL2CPP_API::Initialize())
+				return false;
+
+			if (!g_ComponentList)
+			{
+				g_ComponentList = CreateComponentList();
+				if (g_ComponentList)
+					CONSOLE_LOG("[IL2CPP_API] GetComponents reuses a List<Component> (capacity %d)", COMPONENT_LIST_CAPACITY);
+				else
+					CONSOLE_WARNING("[IL2CPP_API] List<Component> not available, GetComponents allocates an array per call");
+			}
+
+			// GetComponentByIndex (и Helper::GetMonoBehaviour) тоже пишут в этот список
+			Unity::m_GameObjectFunctions.m_pResultList = g_ComponentList;
+			return true;
+		}
+
+		bool IsInitialized()
+		{
+			return IL2CPP_API::IsInitialized();
+		}
+
+		void RegisterCommands()
+		{
+			IL2CPP_API::RegisterCommands();
+			Console::Commands::Register({ "il2cpp.components", "", "GetComponent calls: reused list vs new arrays",
+				[](const Console::Commands::Args&, void*) {
+					Console::Log("GetComponent: %llu queries, %llu through the reused list (capacity %d), %llu allocating",
+						static_cast<unsigned long long>(g_ComponentStats.queries), static_cast<unsigned long long>(g_ComponentStats.listCalls),
+						g_ComponentStats.listCapacity, static_cast<unsigned long long>(g_ComponentStats.arrayCalls));
+				} });
+			Console::Commands::Register({ "il2cpp.camera", "", "Camera.main and how often it was looked up",
+				[](const Console::Commands::Args&, void*) {
+					void* camera = GetMainCamera();
+					Console::Log("Camera.main: %p, %llu get_main calls", camera, static_cast<unsigned long long>(g_MainCameraLookups));
+				} });
+		}
+
+		void* FindClass(const char* fullName)
+		{
+			return IL2CPP_API::FindClass(fullName);
+		}
+
+		void* FindMethodPointer(void* klass, const char* methodName, int paramCount)
+		{
+			Unity::il2cppMethodInfo* method = IL2CPP_API::FindMethod(static_cast<Unity::il2cppClass*>(klass), methodName, paramCount);
+			return method ? method->m_pMethodPointer : nullptr;
+		}
+
+		void* GetComponent(void* gameObject, void* klass)
+		{
+			if (!gameObject || !klass || !Unity::m_GameObjectFunctions.m_GetComponents)
+				return nullptr;
+
+			g_ComponentStats.queries++;
+			Unity::il2cppObject* type = IL2CPP::Class::GetSystemType(static_cast<Unity::il2cppClass*>(klass));
+			Unity::CGameObject* object = static_cast<Unity::CGameObject*>(gameObject);
+			if (g_ComponentList)
+			{
+				g_ComponentStats.listCalls++;
+				object->GetComponents(type, g_ComponentList);
+				g_ComponentStats.listCapacity = g_ComponentList->m_pListArray ? static_cast<int>(g_ComponentList->m_pListArray->m_uMaxLength) : 0;
+				return g_ComponentList->m_iSize > 0 ? (*g_ComponentList)[0] : nullptr;
+			}
+
+			g_ComponentStats.arrayCalls++;
+			Unity::il2cppArray<Unity::CComponent*>* components = object->GetComponents(type);
+			return components && components->m_uMaxLength ? (*components)[0] : nullptr;
+		}
+
+		ComponentStats GetComponentStats()
+		{
+			return g_ComponentStats;
+		}
+
+		void* GetMainCamera()
+		{
+			if (!Unity::m_CameraFunctions.m_GetMain)
+				return nullptr;
+
+			return Objects::CachedOr(g_MainCamera, [] {
+				g_MainCameraLookups++;
+				return Unity::Camera::GetMain();
+			});
+		}
+
+		uint64_t GetMainCameraLookups()
+		{
+			return g_MainCameraLookups;
+		}
+
+		StaticFieldInfo ResolveStaticField(const char* className, const char* fieldName, uint32_t size)
+		{
+			StaticFieldInfo info;
+			Unity::il2cppClass* klass = IL2CPP_API::FindClass(className);
+			Unity::il2cppFieldInfo* field = klass ? IL2CPP_API::FindField(klass, fieldName) : nullptr;
+			if (!field || !LoadStaticFieldExports() || !IL2CPP::Functions.m_FieldStaticGetValue)
+				return info;
+
+			const StaticFieldExports& e = g_StaticExports;
+			int flags = e.fieldGetFlags(field);
+			if (!(flags & FIELD_ATTRIBUTE_STATIC))
+			{
+				CONSOLE_WARNING("[IL2CPP_API] %s.%s is not static", className, fieldName);
+				return info;
+			}
+
+			void* type = e.fieldGetType(field);
+			bool reference = IsReferenceType(type);
+			uint32_t fieldSize = FieldValueSize(type, reference);
+			if (fieldSize != size)
+			{
+				CONSOLE_WARNING("[IL2CPP_API] %s.%s is %u bytes, accessor expects %u", className, fieldName, fieldSize, size);
+				return info;
+			}
+
+			info.field = field;
+			info.size = fieldSize;
+			info.reference = reference;
+
+			// const-поля живут в метаданных, thread-static - в блоке каждого потока
+			int offset = static_cast<int>(e.fieldGetOffset(field));
+			info.threadStatic = offset == THREAD_STATIC_FIELD_OFFSET;
+			if (info.threadStatic || (flags & FIELD_ATTRIBUTE_LITERAL))
+				return info;
+
+			// Статический конструктор до первого чтения; после него блок полей не переезжает
+			e.runtimeClassInit(klass);
+			if (!klass->m_pStaticFields)
+				return info;
+
+			info.address = static_cast<uint8_t*>(klass->m_pStaticFields) + offset;
+			if (!DirectAddressMatches(info))
+			{
+				CONSOLE_WARNING("[IL2CPP_API] %s.%s: static field block mismatch, using il2cpp_field_static_get_value", className, fieldName);
+				info.address = nullptr;
+			}
+			return info;
+		}
+
+		void ReadStaticSlow(const StaticFieldInfo& info, void* value)
+		{
+			if (info.field && IL2CPP::Functions.m_FieldStaticGetValue)
+				reinterpret_cast<FieldStaticValueFn>(IL2CPP::Functions.m_FieldStaticGetValue)(info.field, value);
+		}
+
+		void WriteStaticSlow(const StaticFieldInfo& info, const void* value)
+		{
+			// Указатель на значение и для ссылочных типов (SetValueRaw разыменует его сам)
+			if (info.field && IL2CPP::Functions.m_FieldStaticSetValue)
+				reinterpret_cast<FieldStaticValueFn>(IL2CPP::Functions.m_FieldStaticSetValue)(info.field, const_cast<void*>(value));
+		}
+
+		void WriteStaticReference(void** address, void* value)
+		{
+			if (g_StaticExports.writeBarrier)
+				g_StaticExports.writeBarrier(nullptr, address, value);
+			else
+				*address = value;
+		}
+	}
+}
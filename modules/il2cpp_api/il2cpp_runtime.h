@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * il2cpp_runtime.h
+ *
+ * Лёгкий интерфейс к IL2CPP без IL2CPP_Resolver в заголовке. IL2CPP_Resolver объявляет
+ * глобальные переменные и функции прямо в заголовках, поэтому IL2CPP_API.hpp включается
+ * только в il2cpp_runtime.cpp; остальной код (hook_render, modules/objects) идёт через
+ * эти функции. Указатели на классы и объекты - непрозрачные void*
+ */
+
+namespace IL2CPP_API
+{
+	namespace Runtime
+	{
+		/// Статистика GetComponent
+		struct ComponentStats
+		{
+			uint64_t queries = 0;
+			uint64_t listCalls = 0;       // GetComponentsInternal с переиспользуемым списком
+			uint64_t arrayCalls = 0;      // с новым массивом (списка нет)
+			int listCapacity = 0;         // ёмкость списка после последнего вызова
+		};
+
+		/// IL2CPP_API::Initialize + переиспользуемый List<Component> для GetComponentsInternal
+		bool Initialize();
+
+		bool IsInitialized();
+
+		/// IL2CPP_API::RegisterCommands
+		void RegisterCommands();
+
+		/// Класс по полному имени (il2cppClass*) или nullptr
+		void* FindClass(const char* fullName);
+
+		/// Указатель метода по имени и числу параметров или nullptr
+		void* FindMethodPointer(void* klass, const char* methodName, int paramCount);
+
+		/// Первый компонент типа klass на gameObject или nullptr. Без выделения управляемой
+		/// памяти: результат GetComponentsInternal пишется в один и тот же List<Component>.
+		/// Вызывать из одного потока (поток модулей)
+		void* GetComponent(void* gameObject, void* klass);
+
+		ComponentStats GetComponentStats();
+
+		/// Camera.main (Unity::CCamera*) или nullptr. Держится слабой ссылкой (modules/objects):
+		/// icall get_main только после смены сцены или уничтожения камеры
+		void* GetMainCamera();
+
+		/// Сколько раз GetMainCamera вызывал get_main (остальные обращения - из кэша)
+		uint64_t GetMainCameraLookups();
+
+		// ============================================================================
+		// СТАТИЧЕСКИЕ ПОЛЯ
+		// ============================================================================
+
+		/// Где лежит статическое поле. address - прямой адрес в m_pStaticFields класса
+		/// (блок выделяется один раз при инициализации класса и не переезжает).
+		/// Thread-static и const-поля своего адреса не имеют - только медленный путь
+		struct StaticFieldInfo
+		{
+			uint8_t* address = nullptr;
+			void* field = nullptr;        // il2cppFieldInfo* (nullptr - поле не найдено)
+			uint32_t size = 0;
+			bool reference = false;       // ссылочный тип: запись через барьер GC
+			bool threadStatic = false;
+		};
+
+		/// Находит поле, инициализирует класс (статический конструктор) и считает адрес.
+		/// size - sizeof типа, которым поле будут читать; при несовпадении поле не находится
+		StaticFieldInfo ResolveStaticField(const char* className, const char* fieldName, uint32_t size);
+
+		/// Медленный путь: il2cpp_field_static_get_value / set_value
+		void ReadStaticSlow(const StaticFieldInfo& info, void* value);
+		void WriteStaticSlow(const StaticFieldInfo& info, const void* value);
+
+		/// Запись ссылки в статическое поле (il2cpp_gc_wbarrier_set_field, если он есть)
+		void WriteStaticReference(void** address, void* value);
+
+		/// Типизированное статическое поле: имя разрешается при первом обращении, дальше
+		/// Get/Set - чтение и запись по адресу без вызовов в IL2CPP:
+		/// static StaticField<void*> g_Instance("GameManager", "Instance");
+		template<typename T>
+		class StaticField
+		{
+		public:
+			StaticField(const char* className, const char* fieldName)
+				: m_ClassName(className), m_FieldName(fieldName) {}
+
+			/// false - поля нет (или IL2CPP ещё не готов, тогда повторит при следующем вызове).
+			/// Неудача после инициализации запоминается: без повторного поиска и предупреждений
+			/// в каждом кадре
+			bool Resolve()
+			{
+				if (m_Info.field)
+					return true;
+				if (m_Failed || !IsInitialized())
+					return false;
+
+				m_Info = ResolveStaticField(m_ClassName, m_FieldName, sizeof(T));
+				m_Failed = m_Info.field == nullptr;
+				return !m_Failed;
+			}
+
+			T Get()
+			{
+				T value = {};
+				if (m_Info.address || Resolve())
+				{
+					if (m_Info.address)
+						memcpy(&value, m_Info.address, sizeof(T));
+					else
+						ReadStaticSlow(m_Info, &value);
+				}
+				return value;
+			}
+
+			void Set(const T& value)
+			{
+				if (!m_Info.address && !Resolve())
+					return;
+				if (!m_Info.address)
+					WriteStaticSlow(m_Info, &value);
+				else if (m_Info.reference)
+					WriteStaticReference(reinterpret_cast<void**>(m_Info.address), *reinterpret_cast<void* const*>(&value));
+				else
+					memcpy(m_Info.address, &value, sizeof(T));
+			}
+
+			bool IsThreadStatic() { return Resolve() && m_Info.threadStatic; }
+
+		private:
+			const char* m_ClassName;
+			const char* m_FieldName;
+			StaticFieldInfo m_Info;
+			bool m_Failed = false;
+		};
+	}
+}
@@ -0,0 +1,234 @@
+#include "input.h"
+#include "../common/spsc_queue.h"
+#include <atomic>
+
+namespace Input
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	struct BindingSlot
+	{
+		Binding binding;
+		bool used;
+		bool held;           // аккорд сработал и клавиша ещё зажата
+		double nextRepeat;
+		int nextForKey;      // следующая привязка с той же клавишей
+	};
+
+	static Common::SpscQueue<Event, 1024> g_Queue;
+	static std::atomic<uint64_t> g_Dropped(0);
+
+	static BindingSlot g_Bindings[MAX_BINDINGS];
+	static int16_t g_FirstForKey[KEY_COUNT];   // индекс первой привязки клавиши или -1
+	static bool g_KeyDown[KEY_COUNT];
+	static bool g_IndexReady = false;
+
+	// Привязки с автоповтором, у которых сейчас зажата клавиша
+	static int g_Repeating[MAX_BINDINGS];
+	static int g_RepeatingCount = 0;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static void RebuildIndex()
+	{
+		for (int k = 0; k < KEY_COUNT; k++)
+			g_FirstForKey[k] = -1;
+
+		for (int i = MAX_BINDINGS - 1; i >= 0; i--)
+		{
+			BindingSlot& slot = g_Bindings[i];
+			if (!slot.used)
+				continue;
+
+			uint16_t key = slot.binding.key;
+			slot.nextForKey = g_FirstForKey[key];
+			g_FirstForKey[key] = static_cast<int16_t>(i);
+		}
+
+		g_IndexReady = true;
+	}
+
+	static void RemoveRepeating(int id)
+	{
+		for (int i = 0; i < g_RepeatingCount; i++)
+		{
+			if (g_Repeating[i] == id)
+			{
+				g_Repeating[i] = g_Repeating[--g_RepeatingCount];
+				return;
+			}
+		}
+	}
+
+	static void OnKeyDown(uint16_t key, double now)
+	{
+		if (key >= KEY_COUNT)
+			return;
+
+		// Повторный WM_KEYDOWN от автоповтора ОС игнорируем: срабатываем по фронту
+		if (g_KeyDown[key])
+			return;
+		g_KeyDown[key] = true;
+
+		uint8_t mods = GetModifiers();
+		for (int id = g_FirstForKey[key]; id >= 0; id = g_Bindings[id].nextForKey)
+		{
+			BindingSlot& slot = g_Bindings[id];
+			if (slot.binding.mods != mods)
+				continue;
+
+			slot.binding.action(slot.binding.user);
+			slot.held = true;
+
+			if (slot.binding.repeatDelay > 0.0f)
+			{
+				slot.nextRepeat = now + slot.binding.repeatDelay;
+				g_Repeating[g_RepeatingCount++] = id;
+			}
+		}
+	}
+
+	static void OnKeyUp(uint16_t key)
+	{
+		if (key >= KEY_COUNT || !g_KeyDown[key])
+			return;
+		g_KeyDown[key] = false;
+
+		for (int id = g_FirstForKey[key]; id >= 0; id = g_Bindings[id].nextForKey)
+		{
+			BindingSlot& slot = g_Bindings[id];
+			if (!slot.held)
+				continue;
+
+			slot.held = false;
+			if (slot.binding.repeatDelay > 0.0f)
+				RemoveRepeating(id);
+		}
+	}
+
+	static void ReleaseAll()
+	{
+		for (int k = 0; k < KEY_COUNT; k++)
+		{
+			if (g_KeyDown[k])
+				OnKeyUp(static_cast<uint16_t>(k));
+		}
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	bool PushEvent(const Event& event)
+	{
+		if (g_Queue.TryPush(event))
+			return true;
+
+		g_Dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	int Bind(const Binding& binding)
+	{
+		if (!binding.action || binding.key >= KEY_COUNT)
+			return -1;
+
+		for (int i = 0; i < MAX_BINDINGS; i++)
+		{
+			if (g_Bindings[i].used)
+				continue;
+
+			g_Bindings[i] = BindingSlot();
+			g_Bindings[i].binding = binding;
+			g_Bindings[i].used = true;
+			RebuildIndex();
+			return i;
+		}
+
+		return -1;
+	}
+
+	void Unbind(int id)
+	{
+		if (id < 0 || id >= MAX_BINDINGS || !g_Bindings[id].used)
+			return;
+
+		RemoveRepeating(id);
+		g_Bindings[id].used = false;
+		RebuildIndex();
+	}
+
+	void ProcessEvents(double now)
+	{
+		if (!g_IndexReady)
+			RebuildIndex();
+
+		Event event;
+		while (g_Queue.TryPop(event))
+		{
+			switch (event.type)
+			{
+			case EventType::KeyDown:
+			case EventType::MouseDown:
+				OnKeyDown(event.code, now);
+				break;
+			case EventType::KeyUp:
+			case EventType::MouseUp:
+				OnKeyUp(event.code);
+				break;
+			case EventType::FocusLost:
+				ReleaseAll();
+				break;
+			case EventType::MouseWheel:
+				break;
+			}
+		}
+
+		// Автоповтор только для зажатых привязок - остальные ничего не стоят
+		for (int i = 0; i < g_RepeatingCount; i++)
+		{
+			BindingSlot& slot = g_Bindings[g_Repeating[i]];
+			if (now < slot.nextRepeat)
+				continue;
+
+			slot.binding.action(slot.binding.user);
+			slot.nextRepeat += slot.binding.repeatInterval > 0.0f ? slot.binding.repeatInterval : 0.1f;
+			if (slot.nextRepeat < now)
+				slot.nextRepeat = now;
+		}
+	}
+
+	bool IsKeyDown(uint16_t key)
+	{
+		return key < KEY_COUNT && g_KeyDown[key];
+	}
+
+	uint8_t GetModifiers()
+	{
+		uint8_t mods = Mod_None;
+		if (g_KeyDown[KEY_CONTROL]) mods |= Mod_Ctrl;
+		if (g_KeyDown[KEY_SHIFT])   mods |= Mod_Shift;
+		if (g_KeyDown[KEY_MENU])    mods |= Mod_Alt;
+		return mods;
+	}
+
+	uint64_t GetDroppedEvents()
+	{
+		return g_Dropped.load(std::memory_order_relaxed);
+	}
+
+	void Reset()
+	{
+		for (int i = 0; i < MAX_BINDINGS; i++)
+			g_Bindings[i].used = false;
+		for (int k = 0; k < KEY_COUNT; k++)
+			g_KeyDown[k] = false;
+
+		g_RepeatingCount = 0;
+		RebuildIndex();
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Input
+{
+	/// Тип события ввода
+	enum class EventType : uint8_t
+	{
+		KeyDown,
+		KeyUp,
+		MouseDown,
+		MouseUp,
+		MouseWheel,
+		FocusLost  // окно потеряло фокус: все клавиши считаются отпущенными
+	};
+
+	/// Событие ввода (производитель - HookedWndProc)
+	struct Event
+	{
+		EventType type;
+		uint16_t code;   // virtual-key код (для мыши - VK_LBUTTON/VK_RBUTTON/...)
+		int16_t wheel;   // для MouseWheel, в единицах WHEEL_DELTA
+	};
+
+	/// Модификаторы аккорда
+	enum Modifier : uint8_t
+	{
+		Mod_None  = 0,
+		Mod_Ctrl  = 1 << 0,
+		Mod_Shift = 1 << 1,
+		Mod_Alt   = 1 << 2
+	};
+
+	// Virtual-key коды (совпадают с WinAPI, чтобы модуль не зависел от windows.h)
+	constexpr uint16_t KEY_LBUTTON = 0x01;
+	constexpr uint16_t KEY_RBUTTON = 0x02;
+	constexpr uint16_t KEY_MBUTTON = 0x04;
+	constexpr uint16_t KEY_SHIFT   = 0x10;
+	constexpr uint16_t KEY_CONTROL = 0x11;
+	constexpr uint16_t KEY_MENU    = 0x12;  // Alt
+	constexpr uint16_t KEY_INSERT  = 0x2D;
+	constexpr uint16_t KEY_DELETE  = 0x2E;
+	constexpr uint16_t KEY_F1      = 0x70;
+	constexpr uint16_t KEY_COUNT   = 256;
+
+	/// Действие горячей клавиши
+	typedef void (*ActionFn)(void* user);
+
+	/// Привязка аккорда (key + модификаторы) к действию
+	struct Binding
+	{
+		uint16_t key = 0;
+		uint8_t mods = Mod_None;
+		ActionFn action = nullptr;
+		void* user = nullptr;
+		float repeatDelay = 0.0f;     // <= 0: без автоповтора
+		float repeatInterval = 0.1f;  // период автоповтора после задержки
+	};
+
+	/// Максимальное количество привязок
+	constexpr int MAX_BINDINGS = 64;
+
+	/// Кладёт событие в очередь (поток окна). false, если очередь переполнена
+	bool PushEvent(const Event& event);
+
+	/// Добавляет привязку, возвращает её id или -1
+	int Bind(const Binding& binding);
+
+	/// Удаляет привязку
+	void Unbind(int id);
+
+	/// Разбирает накопленные события и вызывает действия (render thread, раз в кадр)
+	void ProcessEvents(double now);
+
+	/// Нажата ли клавиша по состоянию после последнего ProcessEvents
+	bool IsKeyDown(uint16_t key);
+
+	/// Текущие модификаторы
+	uint8_t GetModifiers();
+
+	/// Количество событий, потерянных из-за переполнения очереди
+	uint64_t GetDroppedEvents();
+
+	/// Удаляет привязки и сбрасывает состояние клавиш
+	void Reset();
+}
@@ -0,0 +1,488 @@
+#include "job_system.h"
+#include "work_stealing_deque.h"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+
+namespace Jobs
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	struct alignas(64) Job
+	{
+		JobFn fn;
+		void* data;
+		Job* parent;
+		std::atomic<int32_t> unfinished;     // сама задача + незавершённые дочерние
+		std::atomic<int32_t> pendingDeps;    // незавершённые зависимости + 1 до Run
+		std::atomic<int32_t> continuationCount;
+		std::atomic<bool> active;            // слот занят: от Create до конца Finish
+		Job* continuations[MAX_CONTINUATIONS];
+		unsigned char payload[JOB_PAYLOAD_SIZE];
+	};
+
+	static constexpr int MAX_WORKERS = 64;
+	static constexpr size_t DEQUE_CAPACITY = 4096;
+
+	/// Сколько слотов пула просматривает Create в поисках свободного
+	static constexpr size_t ALLOC_PROBE = 64;
+
+	/// Пустых проходов Wait (yield) перед тем, как заснуть
+	static constexpr int WAIT_SPINS = 64;
+
+	typedef WorkStealingDeque<Job, DEQUE_CAPACITY> JobDeque;
+
+	struct Worker
+	{
+		JobDeque deque;
+		std::thread thread;
+	};
+
+	static std::unique_ptr<Worker> g_Workers[MAX_WORKERS];
+	static int g_WorkerCount = 0;
+	static std::atomic<bool> g_Running(false);
+	static std::atomic<int> g_ExitedWorkers(0);    // вышли из WorkerMain (Shutdown ждёт их, а не выхода потоков)
+
+	// Очередь задач от потоков вне пула (render thread, InitHookThread)
+	static std::mutex g_InjectMutex;
+	static std::deque<Job*> g_InjectQueue;
+	static std::atomic<int> g_InjectSize(0);
+
+	// Засыпание рабочих потоков, когда работы нет
+	static std::mutex g_SleepMutex;
+	static std::condition_variable g_SleepCv;
+	static std::atomic<int> g_Sleepers(0);
+	static std::atomic<int> g_Waiters(0);    // из них - в Wait
+
+	static std::atomic<uint64_t> g_Exhausted(0);
+	static std::atomic<uint64_t> g_BlockedWaits(0);
+
+	static thread_local int t_WorkerIndex = -1;
+	static thread_local uint32_t t_StealSeed = 0x9E3779B9u;
+
+	// Пул задач (кольцевой). Слот переиспользуется только после завершения его задачи.
+	// Пулы принадлежат Jobs, а не потокам: задачи рабочего потока (вложенный ParallelFor)
+	// могут остаться в его деке после выхода потока, и Shutdown выполняет их позже.
+	// Поток берёт свободный пул при первом Create и возвращает при выходе; память пулов
+	// живёт до выгрузки DLL
+	struct JobPool
+	{
+		std::unique_ptr<Job[]> jobs;
+		size_t next = 0;
+		bool leased = false;    // под g_PoolMutex
+	};
+
+	static std::mutex g_PoolMutex;
+	static std::vector<std::unique_ptr<JobPool>> g_Pools;
+
+	// Пул текущего потока; деструктор возвращает его при выходе потока
+	struct PoolLease
+	{
+		JobPool* pool = nullptr;
+
+		~PoolLease()
+		{
+			if (!pool)
+				return;
+			std::lock_guard<std::mutex> lock(g_PoolMutex);
+			pool->leased = false;
+		}
+	};
+	static thread_local PoolLease t_Pool;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	// Свободный пул вышедшего потока или новый. Задачи прежнего владельца могут быть ещё
+	// в полёте - их слоты заняты (active), пока задача не завершится
+	static JobPool* LeasePool()
+	{
+		std::lock_guard<std::mutex> lock(g_PoolMutex);
+		for (const std::unique_ptr<JobPool>& pool : g_Pools)
+		{
+			if (!pool->leased)
+			{
+				pool->leased = true;
+				return pool.get();
+			}
+		}
+
+		g_Pools.emplace_back(new JobPool());
+		JobPool* pool = g_Pools.back().get();
+		pool->jobs.reset(new Job[JOBS_PER_THREAD]());
+		pool->leased = true;
+		return pool;
+	}
+
+	// Задачи завершаются примерно в порядке создания, поэтому свободный слот почти всегда
+	// следующий. nullptr - пул исчерпан (больше JOBS_PER_THREAD задач в полёте)
+	static Job* AllocateJob()
+	{
+		if (!t_Pool.pool)
+			t_Pool.pool = LeasePool();
+
+		JobPool& pool = *t_Pool.pool;
+		for (size_t i = 0; i < ALLOC_PROBE; i++)
+		{
+			Job* job = &pool.jobs[pool.next++ & (JOBS_PER_THREAD - 1)];
+			if (!job->active.load(std::memory_order_acquire))
+				return job;
+		}
+
+		g_Exhausted.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	static uint32_t NextRandom()
+	{
+		// xorshift32
+		uint32_t x = t_StealSeed;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		t_StealSeed = x;
+		return x;
+	}
+
+	static void WakeWorkers()
+	{
+		if (g_Sleepers.load(std::memory_order_acquire) > 0)
+		{
+			std::lock_guard<std::mutex> lock(g_SleepMutex);
+			g_SleepCv.notify_one();
+		}
+	}
+
+	static void Execute(Job* job);
+
+	static void Enqueue(Job* job)
+	{
+		if (!g_Running.load(std::memory_order_acquire))
+		{
+			Execute(job);
+			return;
+		}
+
+		bool pushed = false;
+		if (t_WorkerIndex >= 0)
+			pushed = g_Workers[t_WorkerIndex]->deque.Push(job);
+
+		if (!pushed)
+		{
+			std::lock_guard<std::mutex> lock(g_InjectMutex);
+			g_InjectQueue.push_back(job);
+			g_InjectSize.fetch_add(1, std::memory_order_release);
+		}
+
+		WakeWorkers();
+	}
+
+	static Job* TakeInjected()
+	{
+		if (g_InjectSize.load(std::memory_order_acquire) == 0)
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(g_InjectMutex);
+		if (g_InjectQueue.empty())
+			return nullptr;
+
+		Job* job = g_InjectQueue.front();
+		g_InjectQueue.pop_front();
+		g_InjectSize.fetch_sub(1, std::memory_order_release);
+		return job;
+	}
+
+	static Job* FindJob()
+	{
+		if (t_WorkerIndex >= 0)
+		{
+			if (Job* job = g_Workers[t_WorkerIndex]->deque.Pop())
+				return job;
+		}
+
+		if (Job* job = TakeInjected())
+			return job;
+
+		if (g_WorkerCount == 0)
+			return nullptr;
+
+		// Кража у случайной жертвы, затем по кругу
+		int start = static_cast<int>(NextRandom() % static_cast<uint32_t>(g_WorkerCount));
+		for (int i = 0; i < g_WorkerCount; i++)
+		{
+			int victim = (start + i) % g_WorkerCount;
+			if (victim == t_WorkerIndex)
+				continue;
+
+			if (Job* job = g_Workers[victim]->deque.Steal())
+				return job;
+		}
+
+		return nullptr;
+	}
+
+	static void Finish(Job* job)
+	{
+		// seq_cst в паре с g_Waiters: Wait либо увидит завершение, либо будет разбужен
+		if (job->unfinished.fetch_sub(1, std::memory_order_seq_cst) != 1)
+			return;
+
+		// Задача и все дочерние завершены: запускаем ожидающих её
+		int count = job->continuationCount.load(std::memory_order_acquire);
+		for (int i = 0; i < count; i++)
+		{
+			Job* next = job->continuations[i];
+			if (next->pendingDeps.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Enqueue(next);
+		}
+
+		// После этого слот может занять новая задача потока-владельца
+		Job* parent = job->parent;
+		job->active.store(false, std::memory_order_release);
+
+		if (g_Waiters.load(std::memory_order_seq_cst) > 0)
+		{
+			std::lock_guard<std::mutex> lock(g_SleepMutex);
+			g_SleepCv.notify_all();
+		}
+
+		if (parent)
+			Finish(parent);
+	}
+
+	static void Execute(Job* job)
+	{
+		if (job->fn)
+			job->fn(job->data);
+		Finish(job);
+	}
+
+	static void WorkerMain(int index)
+	{
+		t_WorkerIndex = index;
+		t_StealSeed = 0x9E3779B9u * static_cast<uint32_t>(index + 1);
+
+		while (g_Running.load(std::memory_order_acquire))
+		{
+			if (Job* job = FindJob())
+			{
+				Execute(job);
+				continue;
+			}
+
+			// Короткое ожидание вместо активного вращения: DLL делит CPU с игрой
+			std::unique_lock<std::mutex> lock(g_SleepMutex);
+			g_Sleepers.fetch_add(1, std::memory_order_acq_rel);
+			g_SleepCv.wait_for(lock, std::chrono::milliseconds(1));
+			g_Sleepers.fetch_sub(1, std::memory_order_acq_rel);
+		}
+
+		t_WorkerIndex = -1;
+		g_ExitedWorkers.fetch_add(1, std::memory_order_release);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	bool Initialize(int workerCount)
+	{
+		if (g_Running.load())
+			return true;
+
+		if (workerCount <= 0)
+		{
+			int cores = static_cast<int>(std::thread::hardware_concurrency());
+			workerCount = cores > 1 ? cores - 1 : 1;
+		}
+		if (workerCount > MAX_WORKERS)
+			workerCount = MAX_WORKERS;
+
+		for (int i = 0; i < workerCount; i++)
+			g_Workers[i].reset(new Worker());
+
+		g_WorkerCount = workerCount;
+		g_ExitedWorkers.store(0, std::memory_order_relaxed);
+		g_Running.store(true, std::memory_order_release);
+
+		for (int i = 0; i < workerCount; i++)
+			g_Workers[i]->thread = std::thread(WorkerMain, i);
+
+		return true;
+	}
+
+	void Shutdown(bool processExit)
+	{
+		if (!g_Running.exchange(false))
+			return;
+
+		if (processExit)
+		{
+			// Система уже остановила рабочие потоки, возможно посреди задачи: оставшееся
+			// не выполняем - ждать его некому
+			for (int i = 0; i < g_WorkerCount; i++)
+			{
+				if (g_Workers[i]->thread.joinable())
+					g_Workers[i]->thread.detach();
+				g_Workers[i].reset();
+			}
+			g_WorkerCount = 0;
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(g_SleepMutex);
+			g_SleepCv.notify_all();
+		}
+
+		// Не join: выход потока ждёт loader lock, а FreeLibrary держит его на время DllMain
+		while (g_ExitedWorkers.load(std::memory_order_acquire) < g_WorkerCount)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		for (int i = 0; i < g_WorkerCount; i++)
+		{
+			if (g_Workers[i]->thread.joinable())
+				g_Workers[i]->thread.detach();
+		}
+
+		// Незапущенные задачи выполняем в текущем потоке, чтобы Wait не завис. Задачи
+		// рабочих потоков лежат в пулах Jobs, а не в памяти вышедших потоков
+		while (Job* job = TakeInjected())
+			Execute(job);
+		for (int i = 0; i < g_WorkerCount; i++)
+		{
+			while (Job* job = g_Workers[i]->deque.Steal())
+				Execute(job);
+			g_Workers[i].reset();
+		}
+
+		g_WorkerCount = 0;
+	}
+
+	bool IsRunning()
+	{
+		return g_Running.load(std::memory_order_acquire);
+	}
+
+	int GetWorkerCount()
+	{
+		return g_WorkerCount;
+	}
+
+	Job* Create(JobFn fn, void* data, Job* parent)
+	{
+		Job* job = AllocateJob();
+		if (!job)
+			return nullptr;
+
+		job->active.store(true, std::memory_order_relaxed);
+		job->fn = fn;
+		job->data = data;
+		job->parent = parent;
+		job->unfinished.store(1, std::memory_order_relaxed);
+		job->pendingDeps.store(1, std::memory_order_relaxed);
+		job->continuationCount.store(0, std::memory_order_relaxed);
+
+		if (parent)
+			parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+
+		return job;
+	}
+
+	Job* CreateInline(JobFn fn, const void* data, size_t size, Job* parent)
+	{
+		if (size > JOB_PAYLOAD_SIZE)
+			return nullptr;
+
+		Job* job = Create(fn, nullptr, parent);
+		if (!job)
+			return nullptr;
+		if (data && size)
+			memcpy(job->payload, data, size);
+		job->data = job->payload;
+		return job;
+	}
+
+	bool DependsOn(Job* job, Job* dependency)
+	{
+		if (!job || !dependency)
+			return false;
+
+		int slot = dependency->continuationCount.load(std::memory_order_relaxed);
+		if (slot >= MAX_CONTINUATIONS)
+			return false;
+
+		job->pendingDeps.fetch_add(1, std::memory_order_relaxed);
+		dependency->continuations[slot] = job;
+		dependency->continuationCount.store(slot + 1, std::memory_order_release);
+		return true;
+	}
+
+	void Run(Job* job)
+	{
+		if (!job)
+			return;
+
+		// Снимаем "токен запуска"; если зависимостей нет - задача готова
+		if (job->pendingDeps.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		Enqueue(job);
+	}
+
+	void Wait(Job* job)
+	{
+		if (!job)
+			return;
+
+		int idle = 0;
+		while (!IsDone(job))
+		{
+			if (Job* other = FindJob())
+			{
+				Execute(other);
+				idle = 0;
+				continue;
+			}
+
+			if (++idle < WAIT_SPINS)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// Помочь нечем: спим вместе с рабочими потоками до завершения любой задачи
+			// или новой работы (Enqueue будит одного из спящих)
+			std::unique_lock<std::mutex> lock(g_SleepMutex);
+			g_Waiters.fetch_add(1, std::memory_order_seq_cst);
+			g_Sleepers.fetch_add(1, std::memory_order_acq_rel);
+			if (!IsDone(job))
+			{
+				g_BlockedWaits.fetch_add(1, std::memory_order_relaxed);
+				g_SleepCv.wait_for(lock, std::chrono::milliseconds(1));
+			}
+			g_Sleepers.fetch_sub(1, std::memory_order_acq_rel);
+			g_Waiters.fetch_sub(1, std::memory_order_relaxed);
+			idle = 0;
+		}
+	}
+
+	bool IsDone(const Job* job)
+	{
+		return job->unfinished.load(std::memory_order_seq_cst) == 0;
+	}
+
+	Stats GetStats()
+	{
+		Stats stats;
+		stats.exhausted = g_Exhausted.load(std::memory_order_relaxed);
+		stats.blockedWaits = g_BlockedWaits.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
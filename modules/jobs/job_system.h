@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Jobs
+{
+	/// Функция задачи
+	typedef void (*JobFn)(void* data);
+
+	/// Задача. Память принадлежит пулу потока, создавшего задачу
+	struct Job;
+
+	/// Статистика
+	struct Stats
+	{
+		uint64_t exhausted = 0;      // Create вернул nullptr: пул потока занят целиком
+		uint64_t blockedWaits = 0;   // Wait засыпал, не найдя чужой работы
+	};
+
+	/// Размер встроенных данных задачи (см. CreateInline)
+	constexpr size_t JOB_PAYLOAD_SIZE = 64;
+
+	/// Количество задач в пуле одного потока (одновременно "в полёте"). Слот освобождается
+	/// после завершения задачи, указатель на неё остаётся действительным ещё минимум
+	/// JOBS_PER_THREAD созданий в том же потоке
+	constexpr size_t JOBS_PER_THREAD = 4096;
+
+	/// Максимум задач, ожидающих завершения одной задачи (DependsOn)
+	constexpr int MAX_CONTINUATIONS = 8;
+
+	/// Запускает рабочие потоки. workerCount = 0: по числу ядер минус один
+	bool Initialize(int workerCount = 0);
+
+	/// Останавливает рабочие потоки и выполняет оставшиеся задачи. Ждёт выхода из цикла
+	/// потоков, а не их завершения (можно из DllMain). processExit - DLL_PROCESS_DETACH при
+	/// завершении процесса: потоки уже убиты системой, оставшиеся задачи не выполняются
+	void Shutdown(bool processExit = false);
+
+	/// Запущена ли система
+	bool IsRunning();
+
+	/// Количество рабочих потоков
+	int GetWorkerCount();
+
+	/// Создаёт задачу. parent ждёт завершения всех дочерних задач.
+	/// nullptr - в пуле потока нет свободного слота: выполните работу сами
+	Job* Create(JobFn fn, void* data, Job* parent = nullptr);
+
+	/// Создаёт задачу и копирует size байт данных внутрь неё (nullptr - как у Create)
+	Job* CreateInline(JobFn fn, const void* data, size_t size, Job* parent = nullptr);
+
+	/// job не начнётся, пока не завершится dependency.
+	/// Граф строится до вызова Run для обеих задач
+	bool DependsOn(Job* job, Job* dependency);
+
+	/// Отправляет задачу на выполнение (после завершения её зависимостей)
+	void Run(Job* job);
+
+	/// Ждёт завершения задачи: выполняет чужие задачи, а без них засыпает
+	void Wait(Job* job);
+
+	/// Завершена ли задача вместе с дочерними
+	bool IsDone(const Job* job);
+
+	Stats GetStats();
+
+	// ============================================================================
+	// PARALLEL FOR
+	// ============================================================================
+
+	namespace Detail
+	{
+		template<typename F>
+		struct RangePayload
+		{
+			const F* body;
+			size_t begin;
+			size_t end;
+		};
+
+		template<typename F>
+		void RunRange(void* data)
+		{
+			RangePayload<F>* range = static_cast<RangePayload<F>*>(data);
+			(*range->body)(range->begin, range->end);
+		}
+	}
+
+	/// Вызывает body(begin, end) для кусков [0, count) размером не больше grain
+	/// и ждёт завершения. Без запущенной системы выполняется в текущем потоке, куски,
+	/// для которых не нашлось слота в пуле, - тоже
+	template<typename F>
+	void ParallelFor(size_t count, size_t grain, const F& body)
+	{
+		if (count == 0)
+			return;
+		if (grain == 0)
+			grain = 1;
+
+		// Не больше четверти пула потока на один вызов
+		const size_t maxChunks = JOBS_PER_THREAD / 4;
+		if ((count + grain - 1) / grain > maxChunks)
+			grain = (count + maxChunks - 1) / maxChunks;
+
+		if (!IsRunning() || count <= grain)
+		{
+			body(size_t(0), count);
+			return;
+		}
+
+		static_assert(sizeof(Detail::RangePayload<F>) <= JOB_PAYLOAD_SIZE, "range payload too large");
+
+		Job* root = Create(nullptr, nullptr);
+		if (!root)
+		{
+			body(size_t(0), count);
+			return;
+		}
+
+		for (size_t begin = 0; begin < count; begin += grain)
+		{
+			Detail::RangePayload<F> range = { &body, begin, (begin + grain < count) ? begin + grain : count };
+			if (Job* job = CreateInline(&Detail::RunRange<F>, &range, sizeof(range), root))
+				Run(job);
+			else
+				body(range.begin, range.end);
+		}
+		Run(root);
+		Wait(root);
+	}
+}
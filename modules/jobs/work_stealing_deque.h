@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Jobs
+{
+	/// Дек Chase-Lev фиксированной ёмкости (Lê, Pop, Cohen, Zappa Nardelli, 2013).
+	/// Push/Pop вызывает только поток-владелец, Steal - любой поток.
+	/// Capacity должна быть степенью двойки
+	template<typename T, size_t Capacity>
+	class WorkStealingDeque
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	public:
+		WorkStealingDeque() : m_Top(0), m_Bottom(0)
+		{
+			for (size_t i = 0; i < Capacity; i++)
+				m_Items[i].store(nullptr, std::memory_order_relaxed);
+		}
+
+		/// Кладёт элемент снизу. Возвращает false, если дек заполнен
+		bool Push(T* item)
+		{
+			int64_t b = m_Bottom.load(std::memory_order_relaxed);
+			int64_t t = m_Top.load(std::memory_order_acquire);
+			if (b - t >= static_cast<int64_t>(Capacity))
+				return false;
+
+			m_Items[b & (Capacity - 1)].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(b + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		/// Забирает элемент снизу (LIFO для владельца)
+		T* Pop()
+		{
+			int64_t b = m_Bottom.load(std::memory_order_relaxed) - 1;
+			m_Bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = m_Top.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				m_Bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T* item = m_Items[b & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (t == b)
+			{
+				// Последний элемент - соревнуемся с ворами
+				if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					item = nullptr;
+				m_Bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+		/// Крадёт элемент сверху (FIFO для воров)
+		T* Steal()
+		{
+			int64_t t = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t b = m_Bottom.load(std::memory_order_acquire);
+
+			if (t >= b)
+				return nullptr;
+
+			T* item = m_Items[t & (Capacity - 1)].load(std::memory_order_relaxed);
+			if (!m_Top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return item;
+		}
+
+		/// Приблизительный размер (для статистики)
+		size_t Size() const
+		{
+			int64_t b = m_Bottom.load(std::memory_order_relaxed);
+			int64_t t = m_Top.load(std::memory_order_relaxed);
+			return b > t ? static_cast<size_t>(b - t) : 0;
+		}
+
+	private:
+		alignas(64) std::atomic<int64_t> m_Top;
+		alignas(64) std::atomic<int64_t> m_Bottom;
+		alignas(64) std::atomic<T*> m_Items[Capacity];
+	};
+}
@@ -0,0 +1,203 @@
+#include "alloc_counters.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+// ============================================================================
+// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+// ============================================================================
+
+// Инициализируются нулями до любых конструкторов - operator new может быть
+// вызван раньше остальных статических объектов
+static std::atomic<uint64_t> g_Allocations(0);
+static std::atomic<uint64_t> g_Frees(0);
+static std::atomic<uint64_t> g_AllocatedBytes(0);
+
+// ============================================================================
+// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+// ============================================================================
+
+static void* CountedAlloc(size_t size)
+{
+	void* ptr = malloc(size ? size : 1);
+	if (ptr)
+	{
+		g_Allocations.fetch_add(1, std::memory_order_relaxed);
+		g_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+	return ptr;
+}
+
+static void CountedFree(void* ptr)
+{
+	if (!ptr)
+		return;
+
+	g_Frees.fetch_add(1, std::memory_order_relaxed);
+	free(ptr);
+}
+
+// Для типов с alignas больше alignof(max_align_t) (очереди, пулы задач).
+// Освобождать только через CountedAlignedFree: на Windows это _aligned_free
+static void* CountedAlignedAlloc(size_t size, std::align_val_t alignment)
+{
+	size_t align = static_cast<size_t>(alignment);
+	if (align < sizeof(void*))
+		align = sizeof(void*);
+
+#if defined(_WIN32)
+	void* ptr = _aligned_malloc(size ? size : 1, align);
+#else
+	void* ptr = nullptr;
+	if (posix_memalign(&ptr, align, size ? size : 1) != 0)
+		ptr = nullptr;
+#endif
+	if (ptr)
+	{
+		g_Allocations.fetch_add(1, std::memory_order_relaxed);
+		g_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+	}
+	return ptr;
+}
+
+static void CountedAlignedFree(void* ptr)
+{
+	if (!ptr)
+		return;
+
+	g_Frees.fetch_add(1, std::memory_order_relaxed);
+#if defined(_WIN32)
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+// ============================================================================
+// РЕАЛИЗАЦИЯ
+// ============================================================================
+
+namespace Memory
+{
+	Counters GetCounters()
+	{
+		Counters counters;
+		counters.allocations = g_Allocations.load(std::memory_order_relaxed);
+		counters.frees = g_Frees.load(std::memory_order_relaxed);
+		counters.allocatedBytes = g_AllocatedBytes.load(std::memory_order_relaxed);
+		return counters;
+	}
+}
+
+// Замена глобальных operator new/delete действует только внутри этой DLL
+
+void* operator new(size_t size)
+{
+	void* ptr = CountedAlloc(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAlloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	CountedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	CountedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+	CountedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	CountedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	CountedFree(ptr);
+}
+
+// Выровненные варианты (C++17): без них alignas-типы шли мимо счётчиков
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	void* ptr = CountedAlignedAlloc(size, alignment);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return operator new(size, alignment);
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return CountedAlignedAlloc(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return CountedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+	CountedAlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+	CountedAlignedFree(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+	CountedAlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+	CountedAlignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	CountedAlignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	CountedAlignedFree(ptr);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Memory
+{
+	/// Счётчики выделений через operator new/delete этого модуля (DLL).
+	/// Память игры и аллокации CRT напрямую (malloc) сюда не попадают
+	struct Counters
+	{
+		uint64_t allocations = 0;
+		uint64_t frees = 0;
+		uint64_t allocatedBytes = 0;  // суммарно запрошено с начала работы
+	};
+
+	/// Текущие значения счётчиков (можно вызывать из любого потока)
+	Counters GetCounters();
+}
@@ -0,0 +1,107 @@
+#include "frame_arena.h"
+#include <cstdlib>
+
+namespace Memory
+{
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static size_t AlignUp(size_t value, size_t align)
+	{
+		return (value + align - 1) & ~(align - 1);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	FrameArena::FrameArena(size_t capacity)
+	{
+		m_Base = static_cast<char*>(malloc(capacity));
+		if (m_Base)
+		{
+			m_Capacity = capacity;
+			m_HeapAllocations++;
+		}
+	}
+
+	FrameArena::~FrameArena()
+	{
+		Reset();
+		free(m_Base);
+	}
+
+	void* FrameArena::Allocate(size_t size, size_t align)
+	{
+		if (size == 0)
+			size = 1;
+
+		m_Allocations++;
+
+		// Адрес выравнивается, а не смещение: malloc гарантирует только max_align_t
+		uintptr_t base = reinterpret_cast<uintptr_t>(m_Base);
+		size_t offset = AlignUp(base + m_Used, align) - base;
+		if (m_Base && offset + size <= m_Capacity)
+		{
+			m_Used = offset + size;
+			if (GetUsed() > m_Peak)
+				m_Peak = GetUsed();
+			return m_Base + offset;
+		}
+
+		// Не уместилось: отдельный блок до конца кадра
+		char* block = static_cast<char*>(malloc(sizeof(Overflow) + size + align));
+		if (!block)
+			return nullptr;
+
+		m_HeapAllocations++;
+		Overflow* overflow = reinterpret_cast<Overflow*>(block);
+		overflow->next = m_Overflow;
+		m_Overflow = overflow;
+		m_OverflowBytes += size;
+		if (GetUsed() > m_Peak)
+			m_Peak = GetUsed();
+
+		uintptr_t data = AlignUp(reinterpret_cast<uintptr_t>(block) + sizeof(Overflow), align);
+		return reinterpret_cast<void*>(data);
+	}
+
+	void FrameArena::Reset()
+	{
+		size_t needed = GetUsed();
+		while (m_Overflow)
+		{
+			Overflow* next = m_Overflow->next;
+			free(m_Overflow);
+			m_Overflow = next;
+		}
+
+		// Рост основного блока (с запасом на выравнивание), чтобы переполнение не повторялось
+		if (m_OverflowBytes > 0)
+		{
+			size_t capacity = m_Capacity ? m_Capacity : 4096;
+			while (capacity < needed + needed / 4)
+				capacity *= 2;
+
+			char* base = static_cast<char*>(malloc(capacity));
+			if (base)
+			{
+				free(m_Base);
+				m_Base = base;
+				m_Capacity = capacity;
+				m_HeapAllocations++;
+			}
+		}
+
+		m_Used = 0;
+		m_OverflowBytes = 0;
+		m_Allocations = 0;
+	}
+
+	FrameArena& GetFrameArena()
+	{
+		static FrameArena arena;
+		return arena;
+	}
+}
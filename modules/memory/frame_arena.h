@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace Memory
+{
+	/// Линейный (bump) аллокатор для временных данных, живущих не дольше кадра.
+	/// Освобождение отдельных блоков не поддерживается: всё освобождается разом в Reset.
+	/// Не потокобезопасен - у арены один владелец
+	class FrameArena
+	{
+	public:
+		explicit FrameArena(size_t capacity = 64 * 1024);
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator=(const FrameArena&) = delete;
+
+		/// Выделяет size байт с выравниванием align (степень двойки).
+		/// Если основной блок закончился, берёт дополнительный из кучи до конца кадра
+		void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+		/// Освобождает всё выделенное. Если в прошлом кадре не хватило места,
+		/// основной блок увеличивается, чтобы следующий кадр уместился целиком
+		void Reset();
+
+		/// Занято в текущем кадре (включая дополнительные блоки)
+		size_t GetUsed() const { return m_Used + m_OverflowBytes; }
+
+		/// Размер основного блока
+		size_t GetCapacity() const { return m_Capacity; }
+
+		/// Максимум GetUsed за всё время
+		size_t GetPeak() const { return m_Peak; }
+
+		/// Выделений в текущем кадре
+		uint64_t GetAllocationCount() const { return m_Allocations; }
+
+		/// Обращений к куче с начала работы (основной блок + дополнительные)
+		uint64_t GetHeapAllocations() const { return m_HeapAllocations; }
+
+	private:
+		struct Overflow
+		{
+			Overflow* next;
+		};
+
+		char* m_Base = nullptr;
+		size_t m_Capacity = 0;
+		size_t m_Used = 0;
+		Overflow* m_Overflow = nullptr;
+		size_t m_OverflowBytes = 0;
+		size_t m_Peak = 0;
+		uint64_t m_Allocations = 0;
+		uint64_t m_HeapAllocations = 0;
+	};
+
+	/// Арена render thread. Сбрасывается в Memory::BeginFrame (начало hkPresent),
+	/// поэтому указатели из неё нельзя хранить между кадрами и отдавать другим потокам
+	FrameArena& GetFrameArena();
+
+	/// STL-аллокатор поверх арены render thread (deallocate ничего не делает)
+	template<typename T>
+	struct FrameAllocator
+	{
+		typedef T value_type;
+
+		FrameAllocator() noexcept {}
+		template<typename U> FrameAllocator(const FrameAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count)
+		{
+			void* ptr = GetFrameArena().Allocate(count * sizeof(T), alignof(T));
+			if (!ptr)
+				throw std::bad_alloc();
+			return static_cast<T*>(ptr);
+		}
+
+		void deallocate(T*, size_t) noexcept {}
+
+		template<typename U> bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+		template<typename U> bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+	};
+
+	/// Вектор временных данных кадра
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
@@ -0,0 +1,69 @@
+#include "memory.h"
+#include "../../deps/imgui/imgui.h"
+
+namespace Memory
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	static FrameStats g_Frame;
+	static Counters g_LastCounters;
+	static PoolStats g_LastPool;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static void* ImGuiAlloc(size_t size, void*)
+	{
+		return PoolAlloc(size);
+	}
+
+	static void ImGuiFree(void* ptr, void*)
+	{
+		PoolFree(ptr);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	void InstallImGuiAllocator()
+	{
+		ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+	}
+
+	void BeginFrame()
+	{
+		FrameArena& arena = GetFrameArena();
+		Counters counters = GetCounters();
+		PoolStats pool = GetPoolStats();
+
+		// Первый вызов только запоминает исходные значения
+		if (g_Frame.frames++ > 0)
+		{
+			g_Frame.heapAllocations = counters.allocations - g_LastCounters.allocations;
+			g_Frame.heapBytes = counters.allocatedBytes - g_LastCounters.allocatedBytes;
+			g_Frame.poolAllocations = pool.allocations - g_LastPool.allocations;
+			g_Frame.poolBytes = pool.allocatedBytes - g_LastPool.allocatedBytes;
+			g_Frame.poolHeapAllocations = pool.heapAllocations - g_LastPool.heapAllocations;
+			g_Frame.arenaAllocations = arena.GetAllocationCount();
+			g_Frame.arenaBytes = arena.GetUsed();
+		}
+
+		g_LastCounters = counters;
+		g_LastPool = pool;
+		arena.Reset();
+
+		g_Frame.arenaCapacity = arena.GetCapacity();
+		g_Frame.arenaPeak = arena.GetPeak();
+		g_Frame.poolInUse = pool.bytesInUse;
+		g_Frame.poolReserved = pool.bytesReserved;
+	}
+
+	const FrameStats& GetFrameStats()
+	{
+		return g_Frame;
+	}
+}
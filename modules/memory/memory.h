@@ -0,0 +1,36 @@
+#pragma once
+
+#include "alloc_counters.h"
+#include "pool_allocator.h"
+#include "frame_arena.h"
+
+namespace Memory
+{
+	/// Выделения памяти за кадр (между двумя вызовами BeginFrame)
+	struct FrameStats
+	{
+		uint64_t frames = 0;
+
+		uint64_t heapAllocations = 0;   // operator new этого модуля
+		uint64_t heapBytes = 0;
+		uint64_t poolAllocations = 0;   // пулы (ImGui)
+		uint64_t poolBytes = 0;
+		uint64_t poolHeapAllocations = 0;  // из них дошло до malloc
+		uint64_t arenaAllocations = 0;  // арена кадра
+		size_t arenaBytes = 0;
+
+		size_t arenaCapacity = 0;
+		size_t arenaPeak = 0;
+		size_t poolInUse = 0;
+		size_t poolReserved = 0;
+	};
+
+	/// Направляет выделения ImGui в пулы. Вызывать до ImGui::CreateContext
+	void InstallImGuiAllocator();
+
+	/// Начало кадра на render thread: подводит итоги прошлого кадра и сбрасывает арену
+	void BeginFrame();
+
+	/// Итоги последнего завершённого кадра
+	const FrameStats& GetFrameStats();
+}
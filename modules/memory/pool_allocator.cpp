@@ -0,0 +1,167 @@
+#include "pool_allocator.h"
+#include <atomic>
+#include <cstdlib>
+
+namespace Memory
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	// Заголовок перед каждым блоком: класс и запрошенный размер.
+	// 16 байт, чтобы сам блок оставался выровнен на 16
+	struct alignas(16) BlockHeader
+	{
+		uint32_t sizeClass;
+		uint32_t reserved;
+		size_t size;
+	};
+
+	static_assert(sizeof(BlockHeader) == 16, "BlockHeader must keep 16-byte alignment");
+
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	static const size_t g_ClassSizes[] = {
+		16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, POOL_MAX_SIZE
+	};
+
+	static const uint32_t CLASS_COUNT = sizeof(g_ClassSizes) / sizeof(g_ClassSizes[0]);
+	static const uint32_t LARGE_CLASS = 0xFFFFFFFFu;
+	static const size_t PAGE_SIZE = 64 * 1024;
+
+	struct SizeClass
+	{
+		FreeBlock* freeList;
+		char* bump;      // нарезка текущей страницы
+		char* bumpEnd;
+	};
+
+	// Нули до любых конструкторов: ImGui может выделять память из статических объектов
+	static SizeClass g_Classes[CLASS_COUNT];
+	static std::atomic_flag g_Lock = ATOMIC_FLAG_INIT;
+	static PoolStats g_Stats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	// Захваты короткие (несколько указателей), поэтому спин-блокировка
+	struct PoolLock
+	{
+		PoolLock() { while (g_Lock.test_and_set(std::memory_order_acquire)) {} }
+		~PoolLock() { g_Lock.clear(std::memory_order_release); }
+	};
+
+	static uint32_t FindClass(size_t size)
+	{
+		for (uint32_t i = 0; i < CLASS_COUNT; i++)
+		{
+			if (size <= g_ClassSizes[i])
+				return i;
+		}
+		return LARGE_CLASS;
+	}
+
+	// Берёт блок (с заголовком) из класса, при необходимости заводит новую страницу
+	static char* TakeBlock(uint32_t index)
+	{
+		SizeClass& sizeClass = g_Classes[index];
+		if (sizeClass.freeList)
+		{
+			FreeBlock* block = sizeClass.freeList;
+			sizeClass.freeList = block->next;
+			return reinterpret_cast<char*>(block);
+		}
+
+		size_t stride = sizeof(BlockHeader) + g_ClassSizes[index];
+		if (!sizeClass.bump || sizeClass.bump + stride > sizeClass.bumpEnd)
+		{
+			char* page = static_cast<char*>(malloc(PAGE_SIZE));
+			if (!page)
+				return nullptr;
+
+			g_Stats.heapAllocations++;
+			g_Stats.bytesReserved += PAGE_SIZE;
+			sizeClass.bump = page;
+			sizeClass.bumpEnd = page + PAGE_SIZE;
+		}
+
+		char* block = sizeClass.bump;
+		sizeClass.bump += stride;
+		return block;
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	void* PoolAlloc(size_t size)
+	{
+		uint32_t index = FindClass(size);
+
+		char* block;
+		{
+			PoolLock lock;
+			if (index == LARGE_CLASS)
+			{
+				block = static_cast<char*>(malloc(sizeof(BlockHeader) + size));
+				if (block)
+				{
+					g_Stats.heapAllocations++;
+					g_Stats.bytesReserved += size;
+				}
+			}
+			else
+			{
+				block = TakeBlock(index);
+			}
+
+			if (!block)
+				return nullptr;
+
+			g_Stats.allocations++;
+			g_Stats.allocatedBytes += size;
+			g_Stats.bytesInUse += index == LARGE_CLASS ? size : g_ClassSizes[index];
+		}
+
+		BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+		header->sizeClass = index;
+		header->reserved = 0;
+		header->size = size;
+		return block + sizeof(BlockHeader);
+	}
+
+	void PoolFree(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		char* block = static_cast<char*>(ptr) - sizeof(BlockHeader);
+		BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+		uint32_t index = header->sizeClass;
+
+		PoolLock lock;
+		g_Stats.frees++;
+		if (index == LARGE_CLASS)
+		{
+			g_Stats.bytesInUse -= header->size;
+			g_Stats.bytesReserved -= header->size;
+			free(block);
+			return;
+		}
+
+		g_Stats.bytesInUse -= g_ClassSizes[index];
+		FreeBlock* freeBlock = reinterpret_cast<FreeBlock*>(block);
+		freeBlock->next = g_Classes[index].freeList;
+		g_Classes[index].freeList = freeBlock;
+	}
+
+	PoolStats GetPoolStats()
+	{
+		PoolLock lock;
+		return g_Stats;
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Memory
+{
+	/// Самый большой размер, который обслуживают пулы. Всё больше уходит в malloc
+	constexpr size_t POOL_MAX_SIZE = 4096;
+
+	/// Счётчики пулов размерных классов
+	struct PoolStats
+	{
+		uint64_t allocations = 0;     // с начала работы
+		uint64_t frees = 0;
+		uint64_t allocatedBytes = 0;  // суммарно запрошено с начала работы
+		uint64_t heapAllocations = 0; // обращений к malloc (новые страницы + крупные блоки)
+		size_t bytesInUse = 0;        // занято блоками (по размеру класса)
+		size_t bytesReserved = 0;     // страницы пулов + крупные блоки
+	};
+
+	/// Выделяет блок из пула подходящего размерного класса (выравнивание 16 байт).
+	/// Освобождённые блоки возвращаются в список своего класса, страницы
+	/// не отдаются системе - в установившемся режиме malloc не вызывается
+	void* PoolAlloc(size_t size);
+
+	/// Возвращает блок в пул. nullptr допустим
+	void PoolFree(void* ptr);
+
+	/// Текущие значения счётчиков (можно вызывать из любого потока)
+	PoolStats GetPoolStats();
+}
@@ -0,0 +1,99 @@
+#include "object_components.h"
+
+// Из потока модулей, как и Acquire/Get
+
+namespace Objects
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	// Ключ - (ссылка на объект, тип). Ссылка уже несёт поколение, поэтому объект,
+	// занявший тот же слот после освобождения, не совпадёт с записью
+	struct ComponentEntry
+	{
+		Handle gameObject;
+		const void* type = nullptr;
+		Handle component;
+	};
+
+	static ComponentEntry g_Components[COMPONENT_CACHE_SIZE];
+	static ComponentCacheStats g_ComponentStats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static ComponentEntry& EntryFor(Handle gameObject, const void* type)
+	{
+		uint64_t key = (static_cast<uint64_t>(gameObject.index) << 32 | gameObject.generation) ^ reinterpret_cast<uintptr_t>(type);
+		key *= 0x9E3779B97F4A7C15ull;
+		return g_Components[(key >> 32) & (COMPONENT_CACHE_SIZE - 1)];
+	}
+
+	static bool SameKey(const ComponentEntry& entry, Handle gameObject, const void* type)
+	{
+		return entry.type == type && entry.gameObject.index == gameObject.index && entry.gameObject.generation == gameObject.generation;
+	}
+
+	static void ResetEntry(ComponentEntry& entry)
+	{
+		Release(entry.component);
+		entry = ComponentEntry();
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	void* FindCachedComponent(Handle gameObject, const void* type)
+	{
+		if (gameObject.IsNull() || !type)
+			return nullptr;
+
+		ComponentEntry& entry = EntryFor(gameObject, type);
+		if (SameKey(entry, gameObject, type))
+		{
+			void* component = Get(gameObject) ? Get(entry.component) : nullptr;
+			if (component)
+			{
+				g_ComponentStats.hits++;
+				return component;
+			}
+			g_ComponentStats.stale++;
+			ResetEntry(entry);
+		}
+		g_ComponentStats.misses++;
+		return nullptr;
+	}
+
+	void CacheComponent(Handle gameObject, const void* type, void* component)
+	{
+		g_ComponentStats.lookups++;
+		if (gameObject.IsNull() || !type || !component)
+			return;
+
+		ComponentEntry& entry = EntryFor(gameObject, type);
+		if (entry.type && !SameKey(entry, gameObject, type))
+			g_ComponentStats.evictions++;
+		ResetEntry(entry);
+
+		Handle handle = Acquire(component);
+		if (handle.IsNull())
+			return;
+		entry.gameObject = gameObject;
+		entry.type = type;
+		entry.component = handle;
+	}
+
+	void ClearComponentCache()
+	{
+		for (ComponentEntry& entry : g_Components)
+			ResetEntry(entry);
+	}
+
+	ComponentCacheStats GetComponentCacheStats()
+	{
+		return g_ComponentStats;
+	}
+}
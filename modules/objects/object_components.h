@@ -0,0 +1,49 @@
+#pragma once
+
+#include "object_handles.h"
+
+namespace Objects
+{
+	/// Записей в кэше компонентов (степень двойки, прямое отображение)
+	constexpr uint32_t COMPONENT_CACHE_SIZE = 1024;
+
+	/// Статистика кэша
+	struct ComponentCacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t stale = 0;         // запись была, но объект, компонент или сцена уже не те
+		uint64_t evictions = 0;     // запись другого (объект, тип) вытеснена
+		uint64_t lookups = 0;       // вызовов lookup (GetComponentsInternal)
+	};
+
+	/// Закэшированный компонент типа type на объекте gameObject или nullptr.
+	/// Запись действительна, пока разрешаются обе слабые ссылки: поколение слота объекта
+	/// и компонента, эпоха сцены и m_CachedPtr компонента (Destroy(component))
+	void* FindCachedComponent(Handle gameObject, const void* type);
+
+	/// Запоминает компонент (nullptr не кэшируется: компонент могут добавить позже)
+	void CacheComponent(Handle gameObject, const void* type, void* component);
+
+	/// Забывает все записи и освобождает их ссылки
+	void ClearComponentCache();
+
+	ComponentCacheStats GetComponentCacheStats();
+
+	/// Компонент из кэша, а при промахе - lookup(gameObject, type) и запись в кэш:
+	/// CachedComponent(g_Player.handle, healthClass, IL2CPP_API::Runtime::GetComponent)
+	template<typename Lookup>
+	inline void* CachedComponent(Handle gameObject, void* type, Lookup lookup)
+	{
+		if (void* component = FindCachedComponent(gameObject, type))
+			return component;
+
+		void* object = Get(gameObject);
+		if (!object)
+			return nullptr;
+
+		void* component = lookup(object, type);
+		CacheComponent(gameObject, type, component);
+		return component;
+	}
+}
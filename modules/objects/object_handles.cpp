@@ -0,0 +1,145 @@
+#include "object_handles.h"
+#include <atomic>
+#include <cstring>
+
+// Acquire/Release/Get - из одного потока (потока модулей), InvalidateAll - из любого
+
+namespace Objects
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	struct HandleSlot
+	{
+		void* object = nullptr;        // управляемый объект
+		void* native = nullptr;        // его m_CachedPtr при Acquire
+		uint32_t generation = 1;       // растёт при каждом освобождении
+		uint32_t epoch = 0;            // эпоха сцены при Acquire
+		uint32_t nextFree = 0;
+		bool used = false;
+	};
+
+	constexpr uint32_t NO_SLOT = ~0u;
+
+	static HandleSlot g_Handles[MAX_HANDLES];
+	static uint32_t g_FreeHead = NO_SLOT;
+	static uint32_t g_Used = 0;          // слотов, которые хоть раз выдавались (остальные свободны)
+	static uint32_t g_TableEpoch = 0;    // эпоха, для которой собран список свободных
+
+	static std::atomic<uint32_t> g_Epoch{ 0 };
+	static HandleStats g_HandleStats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static void* ReadCachedPtr(const void* object)
+	{
+		void* native;
+		memcpy(&native, static_cast<const uint8_t*>(object) + CACHED_PTR_OFFSET, sizeof(native));
+		return native;
+	}
+
+	static void FreeSlot(uint32_t index)
+	{
+		HandleSlot& slot = g_Handles[index];
+		slot = HandleSlot{ nullptr, nullptr, slot.generation + 1 == 0 ? 1 : slot.generation + 1, 0, g_FreeHead, false };
+		g_FreeHead = index;
+		g_HandleStats.live--;
+	}
+
+	// После смены сцены все занятые слоты устарели: освобождаем их одним проходом
+	static void CollectStale()
+	{
+		uint32_t epoch = g_Epoch.load(std::memory_order_acquire);
+		if (epoch == g_TableEpoch)
+			return;
+
+		g_TableEpoch = epoch;
+		for (uint32_t i = 0; i < g_Used; i++)
+		{
+			if (g_Handles[i].used && g_Handles[i].epoch != epoch)
+				FreeSlot(i);
+		}
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	Handle Acquire(void* object)
+	{
+		CollectStale();
+
+		void* native = object ? ReadCachedPtr(object) : nullptr;
+		uint32_t index = NO_SLOT;
+		if (native)
+		{
+			if (g_FreeHead != NO_SLOT)
+			{
+				index = g_FreeHead;
+				g_FreeHead = g_Handles[index].nextFree;
+			}
+			else if (g_Used < MAX_HANDLES)
+			{
+				index = g_Used++;
+			}
+		}
+		if (index == NO_SLOT)
+		{
+			g_HandleStats.rejected++;
+			return Handle();
+		}
+
+		HandleSlot& slot = g_Handles[index];
+		slot.object = object;
+		slot.native = native;
+		slot.epoch = g_TableEpoch;
+		slot.used = true;
+
+		g_HandleStats.acquired++;
+		g_HandleStats.live++;
+		if (g_HandleStats.live > g_HandleStats.peak)
+			g_HandleStats.peak = g_HandleStats.live;
+		return Handle{ index, slot.generation };
+	}
+
+	void Release(Handle handle)
+	{
+		if (handle.IsNull() || handle.index >= g_Used)
+			return;
+
+		HandleSlot& slot = g_Handles[handle.index];
+		if (slot.used && slot.generation == handle.generation)
+			FreeSlot(handle.index);
+	}
+
+	void* Get(Handle handle)
+	{
+		if (handle.IsNull())
+			return nullptr;
+
+		g_HandleStats.checks++;
+		const HandleSlot* slot = handle.index < g_Used ? &g_Handles[handle.index] : nullptr;
+		if (!slot || !slot->used || slot->generation != handle.generation ||
+			slot->epoch != g_Epoch.load(std::memory_order_acquire) || ReadCachedPtr(slot->object) != slot->native)
+		{
+			g_HandleStats.expired++;
+			return nullptr;
+		}
+		return slot->object;
+	}
+
+	void InvalidateAll()
+	{
+		g_Epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	HandleStats GetHandleStats()
+	{
+		HandleStats stats = g_HandleStats;
+		stats.invalidations = g_Epoch.load(std::memory_order_relaxed);
+		return stats;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Objects
+{
+	/// Размер таблицы слабых ссылок
+	constexpr uint32_t MAX_HANDLES = 4096;
+
+	/// Смещение m_CachedPtr в UnityEngine.Object: после заголовка il2cppObject (класс + монитор),
+	/// как в IL2CPP::CClass. Unity обнуляет его при Destroy
+	constexpr size_t CACHED_PTR_OFFSET = 2 * sizeof(void*);
+
+	/// Слабая ссылка: слот + поколение. generation 0 - пустая ссылка
+	struct Handle
+	{
+		uint32_t index = 0;
+		uint32_t generation = 0;
+
+		bool IsNull() const { return generation == 0; }
+	};
+
+	/// Статистика таблицы
+	struct HandleStats
+	{
+		uint32_t live = 0;            // занятых слотов текущей сцены
+		uint32_t peak = 0;
+		uint64_t acquired = 0;
+		uint64_t rejected = 0;        // Acquire без объекта, уничтоженного или при полной таблице
+		uint64_t checks = 0;          // Get
+		uint64_t expired = 0;         // Get вернул nullptr для непустой ссылки
+		uint32_t invalidations = 0;   // смен сцены
+	};
+
+	/// Запоминает управляемый объект и его m_CachedPtr. Пустая ссылка, если объект
+	/// уже уничтожен (m_CachedPtr == nullptr) или таблица заполнена
+	Handle Acquire(void* object);
+
+	/// Освобождает слот (ссылка и её копии становятся пустыми)
+	void Release(Handle handle);
+
+	/// Объект или nullptr, если слот переиспользован, сцена сменилась или объект уничтожен.
+	/// Без icall: сравнение поколения, эпохи сцены и m_CachedPtr с запомненным
+	void* Get(Handle handle);
+
+	/// Все ссылки устаревают разом (смена сцены). Можно вызывать из любого потока,
+	/// слоты освободит следующий Acquire
+	void InvalidateAll();
+
+	HandleStats GetHandleStats();
+
+	/// Типизированная ссылка для полей модулей: Ref<Unity::CGameObject>, Ref<Unity::CTransform>
+	template<typename T>
+	struct Ref
+	{
+		Handle handle;
+
+		Ref() = default;
+		explicit Ref(T* object) : handle(Acquire(object)) {}
+
+		T* Get() const { return static_cast<T*>(Objects::Get(handle)); }
+		explicit operator bool() const { return Get() != nullptr; }
+
+		/// Заменяет объект, освобождая прежний слот
+		void Reset(T* object = nullptr)
+		{
+			Release(handle);
+			handle = object ? Acquire(object) : Handle();
+		}
+	};
+
+	/// Закэшированный объект или результат lookup, если кэш устарел:
+	/// CachedOr(g_Player, [] { return FindPlayer(); })
+	template<typename T, typename Lookup>
+	inline T* CachedOr(Ref<T>& ref, Lookup lookup)
+	{
+		if (T* object = ref.Get())
+			return object;
+		T* object = lookup();
+		ref.Reset(object);
+		return ref.Get();
+	}
+}
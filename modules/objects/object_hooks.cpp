@@ -0,0 +1,203 @@
+#include "object_registry.h"
+#include "object_handles.h"
+#include "../hooks/hooks.h"
+#include "../il2cpp_api/il2cpp_runtime.h"
+#include "../console/console.h"
+#include <utility>
+
+// Windows: хуки на методы жизненного цикла отслеживаемых классов. Детуры - шаблонные
+// функции, по одной на (класс, событие): указатель метода IL2CPP не несёт класс,
+// поэтому слот детура хранит id класса и оригинал
+
+namespace Objects
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	constexpr int EVENT_COUNT = 4;
+	constexpr int SLOT_COUNT = MAX_CLASSES * EVENT_COUNT;
+
+	/// Методы жизненного цикла в порядке Event
+	static const char* const EVENT_METHODS[EVENT_COUNT] = { "Awake", "OnEnable", "OnDisable", "OnDestroy" };
+
+	typedef void(__fastcall* LifecycleFn)(void* instance, const void* method);
+
+	struct HookSlot
+	{
+		void* target = nullptr;        // указатель метода (nullptr - слот свободен)
+		LifecycleFn original = nullptr;
+		ClassId classId = INVALID_CLASS;
+		Event event = Event::Awake;
+	};
+
+	static HookSlot g_Slots[SLOT_COUNT];
+
+	// SceneManager.Internal_ActiveSceneChanged(Scene, Scene): Scene - структура из одного int
+	typedef void(__fastcall* SceneChangedFn)(int previous, int next, const void* method);
+	static SceneChangedFn g_OriginalSceneChanged = nullptr;
+	static void* g_SceneChangedTarget = nullptr;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	// Появление отмечается после исходного метода (объект уже инициализирован),
+	// исчезновение - до (потребители не увидят объект в середине OnDestroy)
+	template<int SLOT>
+	static void Detour(void* instance, const void* method)
+	{
+		const HookSlot& slot = g_Slots[SLOT];
+		bool appears = slot.event == Event::Awake || slot.event == Event::OnEnable;
+		if (!appears)
+			OnEvent(slot.classId, instance, slot.event);
+		slot.original(instance, method);
+		if (appears)
+			OnEvent(slot.classId, instance, slot.event);
+	}
+
+	template<size_t... SLOTS>
+	static void* const* MakeDetours(std::index_sequence<SLOTS...>)
+	{
+		static void* const detours[] = { reinterpret_cast<void*>(&Detour<static_cast<int>(SLOTS)>)... };
+		return detours;
+	}
+
+	static void* const* Detours()
+	{
+		return MakeDetours(std::make_index_sequence<SLOT_COUNT>());
+	}
+
+	// Объекты прежней сцены уничтожены: все слабые ссылки устаревают
+	static void SceneChangedDetour(int previous, int next, const void* method)
+	{
+		InvalidateAll();
+		g_OriginalSceneChanged(previous, next, method);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	ClassId Track(const char* className)
+	{
+		void* klass = IL2CPP_API::Runtime::FindClass(className);
+		if (!klass)
+		{
+			CONSOLE_WARNING("[Objects] class %s not found", className);
+			return INVALID_CLASS;
+		}
+
+		// Повторный вызов после неудачи пробует поставить хуки ещё раз
+		ClassId id = FindClass(className);
+		if (id != INVALID_CLASS && GetClassStats(id).events)
+			return id;
+
+		// Сначала хуки, затем регистрация с маской поставленных
+		void* methods[EVENT_COUNT] = {};
+		for (int e = 0; e < EVENT_COUNT; e++)
+			methods[e] = IL2CPP_API::Runtime::FindMethodPointer(klass, EVENT_METHODS[e], 0);
+
+		id = RegisterClass(className, 0);
+		if (id == INVALID_CLASS)
+		{
+			CONSOLE_WARNING("[Objects] %s: limit of %d tracked classes reached", className, MAX_CLASSES);
+			return INVALID_CLASS;
+		}
+
+		// Все хуки класса включаются за одну остановку потоков
+		int created[EVENT_COUNT];
+		int createdCount = 0;
+		for (int e = 0; e < EVENT_COUNT; e++)
+		{
+			if (!methods[e])
+				continue;
+
+			int index = id * EVENT_COUNT + e;
+			HookSlot& slot = g_Slots[index];
+			slot.classId = id;
+			slot.event = static_cast<Event>(e);
+
+			// Общий код generic-методов может делить один указатель между классами
+			Hooks::Status status = Hooks::Create(methods[e], Detours()[index], reinterpret_cast<void**>(&slot.original));
+			if (status != Hooks::Status::Ok)
+			{
+				CONSOLE_WARNING("[Objects] %s.%s: %s", className, EVENT_METHODS[e], Hooks::StatusText(status));
+				continue;
+			}
+			slot.target = methods[e];
+			Hooks::QueueEnable(slot.target);
+			created[createdCount++] = index;
+		}
+
+		uint32_t events = 0;
+		Hooks::Status status = createdCount ? Hooks::ApplyQueued() : Hooks::Status::Ok;
+		for (int i = 0; i < createdCount; i++)
+		{
+			HookSlot& slot = g_Slots[created[i]];
+			if (status == Hooks::Status::Ok)
+			{
+				events |= EventBit(slot.event);
+				continue;
+			}
+			Hooks::Remove(slot.target);
+			slot = HookSlot();
+		}
+		if (status != Hooks::Status::Ok)
+			CONSOLE_WARNING("[Objects] %s: %s", className, Hooks::StatusText(status));
+
+		RegisterClass(className, events);
+		if (!events)
+		{
+			CONSOLE_WARNING("[Objects] %s: no lifecycle methods hooked", className);
+			return INVALID_CLASS;
+		}
+
+		CONSOLE_LOG("[Objects] tracking %s:%s%s%s%s", className,
+			events & EventBit(Event::Awake) ? " Awake" : "",
+			events & EventBit(Event::OnEnable) ? " OnEnable" : "",
+			events & EventBit(Event::OnDisable) ? " OnDisable" : "",
+			events & EventBit(Event::OnDestroy) ? " OnDestroy" : "");
+		return id;
+	}
+
+	bool WatchScenes()
+	{
+		if (g_SceneChangedTarget)
+			return true;
+
+		void* klass = IL2CPP_API::Runtime::FindClass("UnityEngine.SceneManagement.SceneManager");
+		void* target = klass ? IL2CPP_API::Runtime::FindMethodPointer(klass, "Internal_ActiveSceneChanged", 2) : nullptr;
+		if (!target)
+		{
+			CONSOLE_WARNING("[Objects] SceneManager.Internal_ActiveSceneChanged not found, handles live until released");
+			return false;
+		}
+
+		Hooks::Status status = Hooks::Create(target, reinterpret_cast<void*>(&SceneChangedDetour), reinterpret_cast<void**>(&g_OriginalSceneChanged));
+		if (status == Hooks::Status::Ok)
+			status = Hooks::Enable(target);
+		if (status != Hooks::Status::Ok)
+		{
+			CONSOLE_WARNING("[Objects] scene change hook: %s", Hooks::StatusText(status));
+			return false;
+		}
+		g_SceneChangedTarget = target;
+		return true;
+	}
+
+	void Untrack()
+	{
+		for (HookSlot& slot : g_Slots)
+		{
+			if (slot.target)
+				Hooks::Remove(slot.target);
+			slot = HookSlot();
+		}
+		if (g_SceneChangedTarget)
+			Hooks::Remove(g_SceneChangedTarget);
+		g_SceneChangedTarget = nullptr;
+		InvalidateAll();
+		Reset();
+	}
+}
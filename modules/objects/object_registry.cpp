@@ -0,0 +1,373 @@
+#include "object_registry.h"
+#include "object_handles.h"
+#include "object_components.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace Objects
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	/// Начальный размер индекса экземпляров (степень двойки, растёт вдвое при заполнении 1/2)
+	constexpr uint32_t INITIAL_INDEX_SIZE = 1024;
+
+	// Плотный массив класса: [0, enabled) - включённые, [enabled, size) - выключенные
+	struct ClassEntry
+	{
+		char name[64] = {};
+		uint32_t events = 0;
+		uint32_t enabled = 0;
+		std::vector<void*> instances;
+		uint64_t received = 0;
+		uint64_t ignored = 0;
+	};
+
+	// Ячейка индекса: (экземпляр, класс) -> позиция в плотном массиве.
+	// Экземпляр может быть в двух классах (хуки базового и производного)
+	struct Slot
+	{
+		void* instance;            // nullptr - пусто
+		int32_t classId;
+		uint32_t position;
+	};
+
+	static ClassEntry g_Classes[MAX_CLASSES];
+	static int g_ClassCount = 0;
+
+	// Открытая адресация, линейное пробирование, удаление сдвигом назад (без надгробий)
+	static std::vector<Slot> g_Index;
+	static uint32_t g_IndexUsed = 0;
+
+	static std::mutex g_Mutex;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static uint32_t HashKey(const void* instance, int classId)
+	{
+		// Объекты выровнены на 8-16 байт: перемешиваем всё значение (финализатор splitmix64)
+		uint64_t key = reinterpret_cast<uintptr_t>(instance) ^ (static_cast<uint64_t>(classId) << 58);
+		key ^= key >> 30;
+		key *= 0xBF58476D1CE4E5B9ull;
+		key ^= key >> 27;
+		key *= 0x94D049BB133111EBull;
+		key ^= key >> 31;
+		return static_cast<uint32_t>(key);
+	}
+
+	// Ячейка ключа или пустая ячейка, куда он встанет
+	static uint32_t Probe(const void* instance, int classId)
+	{
+		uint32_t mask = static_cast<uint32_t>(g_Index.size()) - 1;
+		uint32_t i = HashKey(instance, classId) & mask;
+		while (g_Index[i].instance && (g_Index[i].instance != instance || g_Index[i].classId != classId))
+			i = (i + 1) & mask;
+		return i;
+	}
+
+	static void Grow()
+	{
+		std::vector<Slot> old;
+		old.swap(g_Index);
+		g_Index.assign(old.empty() ? INITIAL_INDEX_SIZE : old.size() * 2, Slot{ nullptr, 0, 0 });
+		for (const Slot& slot : old)
+		{
+			if (slot.instance)
+				g_Index[Probe(slot.instance, slot.classId)] = slot;
+		}
+	}
+
+	static void EraseSlot(uint32_t i)
+	{
+		uint32_t mask = static_cast<uint32_t>(g_Index.size()) - 1;
+		uint32_t hole = i;
+		for (uint32_t j = (i + 1) & mask; g_Index[j].instance; j = (j + 1) & mask)
+		{
+			// Ячейку j можно сдвинуть в дыру, если её исходная позиция не между дырой и j
+			uint32_t home = HashKey(g_Index[j].instance, g_Index[j].classId) & mask;
+			if (((j - home) & mask) >= ((j - hole) & mask))
+			{
+				g_Index[hole] = g_Index[j];
+				hole = j;
+			}
+		}
+		g_Index[hole].instance = nullptr;
+		g_IndexUsed--;
+	}
+
+	// Меняет местами две позиции плотного массива и их ячейки в индексе
+	static void SwapPositions(ClassEntry& entry, int classId, uint32_t a, uint32_t b)
+	{
+		if (a == b)
+			return;
+		void* first = entry.instances[a];
+		void* second = entry.instances[b];
+		entry.instances[a] = second;
+		entry.instances[b] = first;
+		g_Index[Probe(first, classId)].position = b;
+		g_Index[Probe(second, classId)].position = a;
+	}
+
+	static void Insert(ClassEntry& entry, int classId, void* instance, uint32_t slot, bool enabled)
+	{
+		if ((g_IndexUsed + 1) * 2 > g_Index.size())
+		{
+			Grow();
+			slot = Probe(instance, classId);
+		}
+
+		uint32_t position = static_cast<uint32_t>(entry.instances.size());
+		entry.instances.push_back(instance);
+		g_Index[slot] = Slot{ instance, classId, position };
+		g_IndexUsed++;
+
+		if (enabled)
+		{
+			SwapPositions(entry, classId, position, entry.enabled);
+			entry.enabled++;
+		}
+	}
+
+	static void SetEnabled(ClassEntry& entry, int classId, uint32_t position, bool enabled)
+	{
+		bool isEnabled = position < entry.enabled;
+		if (isEnabled == enabled)
+			return;
+
+		if (enabled)
+		{
+			// Первый выключенный становится последним включённым
+			SwapPositions(entry, classId, position, entry.enabled);
+			entry.enabled++;
+		}
+		else
+		{
+			entry.enabled--;
+			SwapPositions(entry, classId, position, entry.enabled);
+		}
+	}
+
+	static void Remove(ClassEntry& entry, int classId, uint32_t slot)
+	{
+		uint32_t position = g_Index[slot].position;
+		if (position < entry.enabled)
+		{
+			// Сначала на границу включённых, затем в конец
+			entry.enabled--;
+			SwapPositions(entry, classId, position, entry.enabled);
+			position = entry.enabled;
+		}
+
+		uint32_t last = static_cast<uint32_t>(entry.instances.size()) - 1;
+		SwapPositions(entry, classId, position, last);
+		entry.instances.pop_back();
+
+		// Перестановки меняют только position, ячейка экземпляра та же
+		EraseSlot(slot);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	ClassId RegisterClass(const char* name, uint32_t events)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		for (int i = 0; i < g_ClassCount; i++)
+		{
+			if (strcmp(g_Classes[i].name, name) == 0)
+			{
+				g_Classes[i].events = events;
+				return i;
+			}
+		}
+		if (g_ClassCount == MAX_CLASSES)
+			return INVALID_CLASS;
+
+		ClassEntry& entry = g_Classes[g_ClassCount];
+		strncpy(entry.name, name, sizeof(entry.name) - 1);
+		entry.events = events;
+		return g_ClassCount++;
+	}
+
+	ClassId FindClass(const char* name)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		for (int i = 0; i < g_ClassCount; i++)
+		{
+			if (strcmp(g_Classes[i].name, name) == 0)
+				return i;
+		}
+		return INVALID_CLASS;
+	}
+
+	void OnEvent(ClassId id, void* instance, Event event)
+	{
+		if (id < 0 || !instance)
+			return;
+
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		if (id >= g_ClassCount)
+			return;
+
+		ClassEntry& entry = g_Classes[id];
+		entry.received++;
+		if (g_Index.empty())
+			Grow();
+
+		uint32_t slot = Probe(instance, id);
+		bool known = g_Index[slot].instance != nullptr;
+		switch (event)
+		{
+		case Event::Awake:
+			if (known)
+				entry.ignored++;
+			else
+				Insert(entry, id, instance, slot, !(entry.events & EventBit(Event::OnEnable)));
+			break;
+
+		case Event::OnEnable:
+			// Без хука Awake (у класса его нет) экземпляр появляется здесь
+			if (known)
+				SetEnabled(entry, id, g_Index[slot].position, true);
+			else
+				Insert(entry, id, instance, slot, true);
+			break;
+
+		case Event::OnDisable:
+			if (!known)
+				entry.ignored++;
+			else if (entry.events & EventBit(Event::OnDestroy))
+				SetEnabled(entry, id, g_Index[slot].position, false);
+			else
+				Remove(entry, id, slot);   // без OnDestroy выключение - последнее, что мы увидим
+			break;
+
+		case Event::OnDestroy:
+			if (known)
+				Remove(entry, id, slot);
+			else
+				entry.ignored++;
+			break;
+		}
+	}
+
+	void Lock()
+	{
+		g_Mutex.lock();
+	}
+
+	void Unlock()
+	{
+		g_Mutex.unlock();
+	}
+
+	Span GetEnabled(ClassId id)
+	{
+		Span span;
+		if (id >= 0 && id < g_ClassCount)
+		{
+			span.data = g_Classes[id].instances.data();
+			span.count = g_Classes[id].enabled;
+		}
+		return span;
+	}
+
+	Span GetAll(ClassId id)
+	{
+		Span span;
+		if (id >= 0 && id < g_ClassCount)
+		{
+			span.data = g_Classes[id].instances.data();
+			span.count = static_cast<uint32_t>(g_Classes[id].instances.size());
+		}
+		return span;
+	}
+
+	ClassStats GetClassStats(ClassId id)
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		ClassStats stats;
+		if (id < 0 || id >= g_ClassCount)
+			return stats;
+
+		const ClassEntry& entry = g_Classes[id];
+		stats.name = entry.name;
+		stats.events = entry.events;
+		stats.live = static_cast<uint32_t>(entry.instances.size());
+		stats.enabled = entry.enabled;
+		stats.received = entry.received;
+		stats.ignored = entry.ignored;
+		return stats;
+	}
+
+	int GetClassCount()
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		return g_ClassCount;
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		for (int i = 0; i < g_ClassCount; i++)
+		{
+			g_Classes[i].instances.clear();
+			g_Classes[i].enabled = 0;
+		}
+		g_Index.clear();
+		g_IndexUsed = 0;
+	}
+
+	void Reset()
+	{
+		Clear();
+		std::lock_guard<std::mutex> lock(g_Mutex);
+		for (int i = 0; i < g_ClassCount; i++)
+			g_Classes[i] = ClassEntry();
+		g_ClassCount = 0;
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void ObjectsCommand(const Console::Commands::Args&, void*)
+	{
+		HandleStats handles = GetHandleStats();
+		Console::Log("Handles: %u live (peak %u of %u), %llu acquired, %llu rejected; %llu checks, %llu expired; %u scene change(s)",
+			handles.live, handles.peak, MAX_HANDLES,
+			static_cast<unsigned long long>(handles.acquired), static_cast<unsigned long long>(handles.rejected),
+			static_cast<unsigned long long>(handles.checks), static_cast<unsigned long long>(handles.expired), handles.invalidations);
+		ComponentCacheStats components = GetComponentCacheStats();
+		Console::Log("Components: %llu hits, %llu misses (%llu stale), %llu evictions, %llu lookups",
+			static_cast<unsigned long long>(components.hits), static_cast<unsigned long long>(components.misses),
+			static_cast<unsigned long long>(components.stale), static_cast<unsigned long long>(components.evictions),
+			static_cast<unsigned long long>(components.lookups));
+
+		int count = GetClassCount();
+		if (!count)
+		{
+			Console::Log("Objects: no tracked classes");
+			return;
+		}
+		Console::Log("Objects: %d tracked class(es)", count);
+		for (ClassId id = 0; id < count; id++)
+		{
+			ClassStats stats = GetClassStats(id);
+			Console::Log("  %-24s live %u, enabled %u, events %llu (ignored %llu)", stats.name, stats.live, stats.enabled,
+				static_cast<unsigned long long>(stats.received), static_cast<unsigned long long>(stats.ignored));
+		}
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "objects", "", "object handles, component cache and the live object registry", ObjectsCommand });
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Objects
+{
+	/// Сколько классов можно отслеживать одновременно (по 4 детура на класс)
+	constexpr int MAX_CLASSES = 32;
+
+	/// Идентификатор отслеживаемого класса (индекс в реестре)
+	using ClassId = int;
+	constexpr ClassId INVALID_CLASS = -1;
+
+	/// События жизненного цикла MonoBehaviour
+	enum class Event : uint8_t
+	{
+		Awake,
+		OnEnable,
+		OnDisable,
+		OnDestroy
+	};
+
+	/// Маска событий, на которые у класса есть хуки
+	constexpr uint32_t EventBit(Event event) { return 1u << static_cast<uint32_t>(event); }
+	constexpr uint32_t ALL_EVENTS = 0xF;
+
+	/// Непрерывный массив экземпляров. Действителен, пока держится Lock
+	struct Span
+	{
+		void* const* data = nullptr;
+		uint32_t count = 0;
+
+		void* const* begin() const { return data; }
+		void* const* end() const { return data + count; }
+		void* operator[](uint32_t i) const { return data[i]; }
+	};
+
+	/// Статистика класса
+	struct ClassStats
+	{
+		const char* name = nullptr;
+		uint32_t events = 0;       // маска хуков
+		uint32_t live = 0;         // между Awake (или OnEnable) и OnDestroy
+		uint32_t enabled = 0;
+		uint64_t received = 0;     // событий всего
+		uint64_t ignored = 0;      // OnDisable/OnDestroy неизвестного экземпляра, повторный Awake
+	};
+
+	/// Регистрирует класс (то же имя - тот же id). events - события, которые будут приходить:
+	/// без OnEnable в маске экземпляр считается включённым сразу после Awake
+	ClassId RegisterClass(const char* name, uint32_t events = ALL_EVENTS);
+
+	/// id по имени класса или INVALID_CLASS
+	ClassId FindClass(const char* name);
+
+	/// Событие от хука. Awake/OnEnable - вставка в конец плотного массива,
+	/// OnDisable/OnDestroy - перестановка с последним, всё O(1)
+	void OnEvent(ClassId id, void* instance, Event event);
+
+	/// Блокировка для чтения массивов (события из главного потока Unity ждут её)
+	void Lock();
+	void Unlock();
+
+	struct ScopedLock
+	{
+		ScopedLock() { Lock(); }
+		~ScopedLock() { Unlock(); }
+		ScopedLock(const ScopedLock&) = delete;
+		ScopedLock& operator=(const ScopedLock&) = delete;
+	};
+
+	/// Включённые экземпляры (OnEnable без OnDisable). Только под Lock
+	Span GetEnabled(ClassId id);
+
+	/// Все живые экземпляры: сначала включённые, затем выключенные. Только под Lock
+	Span GetAll(ClassId id);
+
+	ClassStats GetClassStats(ClassId id);
+	int GetClassCount();
+
+	/// Забывает все экземпляры (выгрузка сцены без OnDestroy, отключение хуков); классы остаются
+	void Clear();
+
+	/// Забывает классы и экземпляры
+	void Reset();
+
+	// ============================================================================
+	// ХУКИ IL2CPP (object_hooks.cpp, только Windows)
+	// ============================================================================
+
+	/// Находит Awake/OnEnable/OnDisable/OnDestroy класса через IL2CPP_API и ставит на них хуки.
+	/// Методы, которых у класса нет, пропускаются. INVALID_CLASS - класс не найден, лимит
+	/// MAX_CLASSES исчерпан или не поставился ни один хук
+	ClassId Track(const char* className);
+
+	/// Хук SceneManager.Internal_ActiveSceneChanged: при смене сцены InvalidateAll
+	/// (object_handles.h). false - метод не найден или хук не поставился
+	bool WatchScenes();
+
+	/// Снимает хуки всех классов и смены сцены, очищает реестр и ссылки
+	void Untrack();
+
+	/// Регистрирует команду консоли objects (ссылки, кэш компонентов, реестр)
+	void RegisterCommands();
+}
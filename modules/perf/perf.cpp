@@ -0,0 +1,254 @@
+#include "perf.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include "../memory/memory.h"
+#include "../scheduler/scheduler.h"
+#include "../watermark/watermark.h"
+#include "../../hud/hud.h"
+#include <chrono>
+#include <algorithm>
+
+namespace Perf
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	typedef std::chrono::steady_clock Clock;
+
+	static const char* const g_StageNames[STAGE_COUNT] = {
+		"NewFrame",
+		"Input",
+		"ConsoleUpdate",
+		"Animation",
+		"Modules",
+		"Watermark",
+		"HUD",
+		"ConsoleRender",
+		"ImGuiRender",
+		"Draw"
+	};
+
+	static StageStats g_Stages[STAGE_COUNT];
+	static FrameStats g_Frame;
+
+	static Clock::time_point g_FrameStart;
+	static Clock::time_point g_LastMark;
+	static Memory::Counters g_FrameCounters;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static float ToMs(Clock::duration duration)
+	{
+		return std::chrono::duration<float, std::milli>(duration).count();
+	}
+
+	static void Accumulate(StageStats& stats, float ms)
+	{
+		stats.lastMs = ms;
+		stats.avgMs = g_Frame.frames <= 1 ? ms : stats.avgMs + (ms - stats.avgMs) * 0.05f;
+		stats.maxMs = (std::max)(stats.maxMs, ms);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	void BeginFrame()
+	{
+		Clock::time_point now = Clock::now();
+		if (g_Frame.frames > 0)
+			g_Frame.frameIntervalMs = ToMs(now - g_FrameStart);
+
+		g_Frame.frames++;
+		g_FrameStart = now;
+		g_LastMark = now;
+		g_FrameCounters = Memory::GetCounters();
+	}
+
+	void EndStage(Stage stage)
+	{
+		int index = static_cast<int>(stage);
+		if (index < 0 || index >= STAGE_COUNT)
+			return;
+
+		Clock::time_point now = Clock::now();
+		Accumulate(g_Stages[index], ToMs(now - g_LastMark));
+		g_LastMark = now;
+	}
+
+	void EndFrame()
+	{
+		Accumulate(g_Frame.total, ToMs(Clock::now() - g_FrameStart));
+
+		// Счётчики общие для всех потоков: сюда попадают и выделения воркеров за кадр
+		Memory::Counters counters = Memory::GetCounters();
+		g_Frame.allocations = counters.allocations - g_FrameCounters.allocations;
+		g_Frame.allocatedBytes = counters.allocatedBytes - g_FrameCounters.allocatedBytes;
+	}
+
+	const StageStats& GetStageStats(Stage stage)
+	{
+		static const StageStats empty;
+		int index = static_cast<int>(stage);
+		if (index < 0 || index >= STAGE_COUNT)
+			return empty;
+
+		return g_Stages[index];
+	}
+
+	const char* GetStageName(Stage stage)
+	{
+		int index = static_cast<int>(stage);
+		if (index < 0 || index >= STAGE_COUNT)
+			return "?";
+
+		return g_StageNames[index];
+	}
+
+	const FrameStats& GetFrameStats()
+	{
+		return g_Frame;
+	}
+
+	void ResetStats()
+	{
+		for (int i = 0; i < STAGE_COUNT; i++)
+			g_Stages[i] = StageStats();
+		g_Frame.total = StageStats();
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	using Console::Commands::Args;
+
+	static void PerfCommand(const Args&, void*)
+	{
+		Console::Log("Present: frame %llu, interval %.2f ms, overlay avg %.3f ms (last %.3f, max %.3f)",
+			static_cast<unsigned long long>(g_Frame.frames), g_Frame.frameIntervalMs,
+			g_Frame.total.avgMs, g_Frame.total.lastMs, g_Frame.total.maxMs);
+
+		for (int i = 0; i < STAGE_COUNT; i++)
+		{
+			const StageStats& stats = g_Stages[i];
+			Console::Log("  %-14s avg %.3f  last %.3f  max %.3f ms",
+				g_StageNames[i], stats.avgMs, stats.lastMs, stats.maxMs);
+		}
+	}
+
+	static void PerfResetCommand(const Args&, void*)
+	{
+		ResetStats();
+		Console::Log("Present timings reset");
+	}
+
+	static void AllocCommand(const Args&, void*)
+	{
+		Memory::Counters counters = Memory::GetCounters();
+		Console::Log("Heap: last frame %llu alloc(s), %llu bytes",
+			static_cast<unsigned long long>(g_Frame.allocations),
+			static_cast<unsigned long long>(g_Frame.allocatedBytes));
+		Console::Log("Heap: total %llu alloc(s), %llu free(s), %llu live, %llu bytes requested",
+			static_cast<unsigned long long>(counters.allocations),
+			static_cast<unsigned long long>(counters.frees),
+			static_cast<unsigned long long>(counters.allocations - counters.frees),
+			static_cast<unsigned long long>(counters.allocatedBytes));
+
+		const Memory::FrameStats& frame = Memory::GetFrameStats();
+		Memory::PoolStats pool = Memory::GetPoolStats();
+		Console::Log("ImGui pools: last frame %llu alloc(s), %llu bytes, %llu malloc call(s)",
+			static_cast<unsigned long long>(frame.poolAllocations),
+			static_cast<unsigned long long>(frame.poolBytes),
+			static_cast<unsigned long long>(frame.poolHeapAllocations));
+		Console::Log("ImGui pools: %zu KB in use, %zu KB reserved, %llu malloc call(s) total",
+			pool.bytesInUse / 1024, pool.bytesReserved / 1024,
+			static_cast<unsigned long long>(pool.heapAllocations));
+		Console::Log("Frame arena: last frame %llu alloc(s), %zu bytes; capacity %zu KB, peak %zu KB",
+			static_cast<unsigned long long>(frame.arenaAllocations), frame.arenaBytes,
+			frame.arenaCapacity / 1024, frame.arenaPeak / 1024);
+	}
+
+	static void SchedCommand(const Args&, void*)
+	{
+		const Scheduler::FrameStats& frame = Scheduler::GetFrameStats();
+		Console::Log("Scheduler: %.3f / %.2f ms, run %d, deferred %d",
+			frame.spentMs, frame.budgetMs, frame.executed, frame.deferred);
+
+		int count = Scheduler::GetTaskCount();
+		if (count == 0)
+			Console::Log("  no module tasks registered");
+
+		for (int i = 0; i < count; i++)
+		{
+			const Scheduler::TaskStats& stats = Scheduler::GetTaskStats(i);
+			Console::Log("  [%2d] %-14s %s avg %.3f  max %.3f ms  runs %llu  deferred %llu",
+				i, stats.name, stats.enabled ? "on " : "off", stats.avgMs, stats.maxMs,
+				static_cast<unsigned long long>(stats.runs), static_cast<unsigned long long>(stats.deferrals));
+		}
+	}
+
+	static void SchedBudgetCommand(const Args& args, void*)
+	{
+		float budget = (std::max)(0.0f, static_cast<float>(args.GetFloat(0)));
+		Scheduler::SetFrameBudget(budget);
+		if (budget > 0.0f)
+			Console::Log("Scheduler budget: %.2f ms", budget);
+		else
+			Console::Log("Scheduler budget: unlimited");
+	}
+
+	static void SchedEnableCommand(const Args& args, void*)
+	{
+		int id = static_cast<int>(args.GetInt(0));
+		if (id < 0 || id >= Scheduler::GetTaskCount())
+		{
+			Console::Error("sched.enable: no task with id %d", id);
+			return;
+		}
+
+		Scheduler::SetEnabled(id, args.GetBool(1));
+		Console::Log("%s: %s", Scheduler::GetTaskStats(id).name, args.GetBool(1) ? "enabled" : "disabled");
+	}
+
+	// Переключатели дорогих частей оверлея
+	struct Toggle
+	{
+		const char* name;
+		const char* help;
+		bool* flag;
+	};
+
+	// Без аргумента показывает значение, с аргументом - устанавливает
+	static void ToggleCommand(const Args& args, void* user)
+	{
+		Toggle* toggle = static_cast<Toggle*>(user);
+		if (args.Has(0))
+			*toggle->flag = args.GetBool(0);
+		Console::Log("%s: %s", toggle->name, *toggle->flag ? "on" : "off");
+	}
+
+	void RegisterCommands()
+	{
+		using Console::Commands::Register;
+
+		Register({ "perf", "", "Present stage timings", PerfCommand });
+		Register({ "perf.reset", "", "reset Present timing averages and maximums", PerfResetCommand });
+		Register({ "alloc", "", "heap, ImGui pool and frame arena counters", AllocCommand });
+		Register({ "sched", "", "module update costs", SchedCommand });
+		Register({ "sched.budget", "f", "module CPU budget per frame, ms (0 = unlimited)", SchedBudgetCommand });
+		Register({ "sched.enable", "ib", "enable/disable a module task by id", SchedEnableCommand });
+
+		static Toggle toggles[] = {
+			{ "overlay.watermark", "draw the watermark", &GetWatermarkSettings().enabled },
+			{ "overlay.fps", "FPS counter in the watermark", &GetWatermarkSettings().showFPS },
+			{ "overlay.schedstats", "scheduler statistics panel in the HUD", &GetHUDSettings().showSchedulerStats },
+			{ "overlay.memstats", "per-frame allocation counters in the HUD", &GetHUDSettings().showMemoryStats }
+		};
+		for (Toggle& toggle : toggles)
+			Register({ toggle.name, "|b", toggle.help, ToggleCommand, &toggle });
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Perf
+{
+	/// Этапы hkPresent в порядке выполнения
+	enum class Stage : uint8_t
+	{
+		NewFrame,       // ImGui_ImplDX11/Win32_NewFrame + ImGui::NewFrame
+		Input,          // Input::ProcessEvents
+		ConsoleUpdate,  // Console::Update
+		Animation,      // Anim::Update
+		Modules,        // Scheduler::RunFrame
+		Watermark,      // RenderWatermark
+		HUD,            // RenderHUD
+		ConsoleRender,  // Console::Render
+		ImGuiRender,    // ImGui::Render
+		Draw,           // ImGui_ImplDX11_RenderDrawData + смена render target
+		Count
+	};
+
+	constexpr int STAGE_COUNT = static_cast<int>(Stage::Count);
+
+	/// Время этапа в миллисекундах
+	struct StageStats
+	{
+		float lastMs = 0.0f;
+		float avgMs = 0.0f;   // экспоненциальное среднее
+		float maxMs = 0.0f;
+	};
+
+	/// Итоги кадра: время нашего кода внутри Present и выделения памяти за кадр
+	struct FrameStats
+	{
+		uint64_t frames = 0;
+		StageStats total;
+		float frameIntervalMs = 0.0f;   // между началами кадров (включая игру)
+		uint64_t allocations = 0;       // за последний кадр
+		uint64_t allocatedBytes = 0;
+	};
+
+	/// Начало кадра (первая строка hkPresent после инициализации)
+	void BeginFrame();
+
+	/// Завершает этап: время с предыдущей отметки записывается в stage
+	void EndStage(Stage stage);
+
+	/// Конец кадра (перед вызовом оригинального Present)
+	void EndFrame();
+
+	/// Статистика этапа
+	const StageStats& GetStageStats(Stage stage);
+
+	/// Имя этапа
+	const char* GetStageName(Stage stage);
+
+	/// Статистика кадров
+	const FrameStats& GetFrameStats();
+
+	/// Сбрасывает средние и максимумы
+	void ResetStats();
+
+	/// Регистрирует команды консоли perf.*, sched.*, alloc и переключатели оверлея
+	/// (команды остальных модулей регистрируют сами модули: Anim::RegisterCommands и т.д.)
+	void RegisterCommands();
+}
@@ -0,0 +1,804 @@
+#include "raster.h"
+#include "../jobs/job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Raster
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	/// Копия ImTextureData в RGBA8; её адрес - ImTextureID
+	struct Texture
+	{
+		int width;
+		int height;
+		std::vector<uint32_t> pixels;
+	};
+
+	enum class Shade : uint8_t
+	{
+		Flat,       // один цвет на весь треугольник (заливки ImGui: белый пиксель атласа)
+		Gouraud,    // цвет интерполируется, текстура постоянна
+		Textured    // цвет и UV интерполируются, выборка на пиксель (глифы)
+	};
+
+	/// Треугольник после отсечения: w_i = a*x + b*y + c в единицах 1/16 пикселя,
+	/// w_i / площадь - барицентрическая координата вершины i
+	struct Triangle
+	{
+		int minX, minY, maxX, maxY;     // [min, max): bbox ∩ scissor ∩ изображение
+		int32_t a[3];
+		int32_t b[3];
+		int64_t c[3];
+		int32_t threshold[3];           // пиксель покрыт, если w > threshold (правило top-left)
+		double invStep[3];              // 1 / (a * 16): пересечение ребра со строкой
+		bool wide;                      // w не помещается в int32 - скалярный путь
+		Shade shade;
+		const Texture* texture;
+		float base[6];                  // r, g, b, a (0..255), u, v в вершине 0
+		float d1[6];                    // приращение на единицу w1
+		float d2[6];                    // приращение на единицу w2
+		float premul[4];                // Flat: src * srcA (альфа - src), смешивание = premul + dst * inv
+		float inv;                      // Flat: 1 - srcA
+		uint32_t opaqueColor;           // Flat с inv == 0: итоговый цвет без чтения dst
+		bool opaque;
+	};
+
+	/// Вершины дальше миллиона пикселей от экрана отбрасываются: иначе a, b не в int32
+	constexpr float MAX_COORD = 1048576.0f;
+	/// Граница |w| для 32-битного SIMD-пути
+	constexpr int64_t MAX_NARROW = int64_t(1) << 30;
+
+	static std::vector<Texture*> g_Textures;
+	static std::vector<Triangle> g_Triangles;
+	static std::vector<std::vector<uint32_t>> g_Bins;
+	static int g_TilesX = 0;
+	static int g_TilesY = 0;
+
+	static Stats g_Stats;
+	static uint64_t g_TextureUploads = 0;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static int Wrap(int i, int size)
+	{
+		i %= size;
+		return i < 0 ? i + size : i;
+	}
+
+	// Деление с округлением вниз (для отрицательных координат тоже)
+	static int FloorDiv(int64_t value, int divisor)
+	{
+		int64_t q = value / divisor;
+		return static_cast<int>((value % divisor != 0 && value < 0) ? q - 1 : q);
+	}
+
+	// Пиксели строки sy, где могут быть все три w > threshold: [xs, xe) внутри [x0, x1).
+	// Веера ImGui (скруглённые прямоугольники) - узкие клинья через всю панель, без этого
+	// строка проверялась бы целиком. Граница считается через обратную величину с запасом
+	// в пиксель (деление int64 на строку дороже самой строки), точная проверка - по w
+	static bool RowSpan(const Triangle& t, int64_t sy, int x0, int x1, int& xs, int& xe)
+	{
+		const int half = 1 << (SUBPIXEL_BITS - 1);
+		double first = x0, last = x1;
+		for (int i = 0; i < 3; i++)
+		{
+			// a * (16x + 8) + r > threshold  =>  x > или < (threshold - r - 8a) / 16a
+			int64_t r = t.b[i] * sy + t.c[i];
+			if (t.a[i] == 0)
+			{
+				if (r <= t.threshold[i])
+					return false;
+				continue;
+			}
+			double cross = static_cast<double>(t.threshold[i] - r - int64_t(t.a[i]) * half) * t.invStep[i];
+			if (t.a[i] > 0)
+				first = (std::max)(first, cross);
+			else
+				last = (std::min)(last, cross + 2.0);
+		}
+		if (first >= last)
+			return false;
+		xs = static_cast<int>(first);
+		xe = static_cast<int>(last);
+		return xs < xe;
+	}
+
+	// Билинейная выборка с повтором (сэмплер imgui_impl_dx11), каналы 0..1
+	static void Sample(const Texture& texture, float u, float v, float out[4])
+	{
+		float fx = u * texture.width - 0.5f;
+		float fy = v * texture.height - 0.5f;
+		float flx = floorf(fx);
+		float fly = floorf(fy);
+		float ax = fx - flx;
+		float ay = fy - fly;
+		int x0 = Wrap(static_cast<int>(flx), texture.width);
+		int y0 = Wrap(static_cast<int>(fly), texture.height);
+		int x1 = x0 + 1 < texture.width ? x0 + 1 : 0;
+		int y1 = y0 + 1 < texture.height ? y0 + 1 : 0;
+
+		const uint32_t* row0 = texture.pixels.data() + static_cast<size_t>(y0) * texture.width;
+		const uint32_t* row1 = texture.pixels.data() + static_cast<size_t>(y1) * texture.width;
+		uint32_t c00 = row0[x0], c10 = row0[x1], c01 = row1[x0], c11 = row1[x1];
+		for (int ch = 0; ch < 4; ch++)
+		{
+			int shift = ch * 8;
+			float top = ((c00 >> shift) & 0xFF) + ax * (float(((c10 >> shift) & 0xFF)) - float((c00 >> shift) & 0xFF));
+			float bottom = ((c01 >> shift) & 0xFF) + ax * (float(((c11 >> shift) & 0xFF)) - float((c01 >> shift) & 0xFF));
+			out[ch] = (top + ay * (bottom - top)) * (1.0f / 255.0f);
+		}
+	}
+
+	static void DestroyTexture(ImTextureData* tex)
+	{
+		if (Texture* texture = static_cast<Texture*>(tex->BackendUserData))
+		{
+			g_Textures.erase(std::remove(g_Textures.begin(), g_Textures.end(), texture), g_Textures.end());
+			delete texture;
+			tex->SetTexID(ImTextureID_Invalid);
+			tex->BackendUserData = nullptr;
+		}
+		tex->SetStatus(ImTextureStatus_Destroyed);
+	}
+
+	static void CopyRect(Texture& texture, ImTextureData* tex, int x, int y, int w, int h)
+	{
+		for (int row = y; row < y + h; row++)
+		{
+			uint32_t* dst = texture.pixels.data() + static_cast<size_t>(row) * texture.width + x;
+			if (tex->Format == ImTextureFormat_RGBA32)
+			{
+				memcpy(dst, tex->GetPixelsAt(x, row), w * sizeof(uint32_t));
+			}
+			else
+			{
+				const uint8_t* src = static_cast<const uint8_t*>(tex->GetPixelsAt(x, row));
+				for (int i = 0; i < w; i++)
+					dst[i] = IM_COL32(255, 255, 255, src[i]);
+			}
+		}
+	}
+
+	// Отсечение, ориентация, рёбра и атрибуты. false - треугольник ничего не закрасит
+	static bool SetupTriangle(Triangle& t, const ImDrawVert* v[3], const ImVec2& offset, const ImVec2& scale,
+		const int clip[4], const Texture* texture)
+	{
+		int32_t x[3], y[3];
+		for (int i = 0; i < 3; i++)
+		{
+			float px = (v[i]->pos.x - offset.x) * scale.x;
+			float py = (v[i]->pos.y - offset.y) * scale.y;
+			if (!(fabsf(px) < MAX_COORD && fabsf(py) < MAX_COORD))
+				return false;
+			x[i] = static_cast<int32_t>(lrintf(px * (1 << SUBPIXEL_BITS)));
+			y[i] = static_cast<int32_t>(lrintf(py * (1 << SUBPIXEL_BITS)));
+		}
+
+		// Отсечения по обходу нет (CullMode NONE): обратный обход разворачиваем
+		int64_t area = int64_t(x[1] - x[0]) * (y[2] - y[0]) - int64_t(y[1] - y[0]) * (x[2] - x[0]);
+		if (area == 0)
+			return false;
+		if (area < 0)
+		{
+			std::swap(x[1], x[2]);
+			std::swap(y[1], y[2]);
+			std::swap(v[1], v[2]);
+			area = -area;
+		}
+
+		// Центр пикселя px: px * 16 + 8
+		const int half = 1 << (SUBPIXEL_BITS - 1);
+		int minXs = (std::min)({ x[0], x[1], x[2] }), maxXs = (std::max)({ x[0], x[1], x[2] });
+		int minYs = (std::min)({ y[0], y[1], y[2] }), maxYs = (std::max)({ y[0], y[1], y[2] });
+		t.minX = (std::max)(clip[0], FloorDiv(int64_t(minXs) - half + (1 << SUBPIXEL_BITS) - 1, 1 << SUBPIXEL_BITS));
+		t.minY = (std::max)(clip[1], FloorDiv(int64_t(minYs) - half + (1 << SUBPIXEL_BITS) - 1, 1 << SUBPIXEL_BITS));
+		t.maxX = (std::min)(clip[2], FloorDiv(int64_t(maxXs) - half, 1 << SUBPIXEL_BITS) + 1);
+		t.maxY = (std::min)(clip[3], FloorDiv(int64_t(maxYs) - half, 1 << SUBPIXEL_BITS) + 1);
+		if (t.minX >= t.maxX || t.minY >= t.maxY)
+			return false;
+
+		int64_t maxW = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			int from = (i + 1) % 3, to = (i + 2) % 3;
+			t.a[i] = y[from] - y[to];
+			t.b[i] = x[to] - x[from];
+			t.c[i] = -int64_t(t.a[i]) * x[from] - int64_t(t.b[i]) * y[from];
+			bool topLeft = t.a[i] > 0 || (t.a[i] == 0 && t.b[i] > 0);
+			t.threshold[i] = topLeft ? -1 : 0;
+			t.invStep[i] = t.a[i] ? 1.0 / (static_cast<double>(t.a[i]) * (1 << SUBPIXEL_BITS)) : 0.0;
+
+			// Линейная функция: максимум модуля - в углах bbox (с запасом на 4 SIMD-дорожки)
+			int64_t sx[2] = { (int64_t(t.minX) << SUBPIXEL_BITS) + half, (int64_t(t.maxX + 3) << SUBPIXEL_BITS) + half };
+			int64_t sy[2] = { (int64_t(t.minY) << SUBPIXEL_BITS) + half, (int64_t(t.maxY - 1) << SUBPIXEL_BITS) + half };
+			for (int cx = 0; cx < 2; cx++)
+			{
+				for (int cy = 0; cy < 2; cy++)
+				{
+					int64_t w = t.a[i] * sx[cx] + t.b[i] * sy[cy] + t.c[i];
+					maxW = (std::max)(maxW, w < 0 ? -w : w);
+				}
+			}
+		}
+		t.wide = maxW >= MAX_NARROW;
+
+		float attr[3][6];
+		for (int i = 0; i < 3; i++)
+		{
+			ImU32 col = v[i]->col;
+			attr[i][0] = float((col >> IM_COL32_R_SHIFT) & 0xFF);
+			attr[i][1] = float((col >> IM_COL32_G_SHIFT) & 0xFF);
+			attr[i][2] = float((col >> IM_COL32_B_SHIFT) & 0xFF);
+			attr[i][3] = float((col >> IM_COL32_A_SHIFT) & 0xFF);
+			attr[i][4] = v[i]->uv.x;
+			attr[i][5] = v[i]->uv.y;
+		}
+
+		// Одинаковые UV (белый пиксель атласа) - текстура читается один раз и входит в цвет
+		bool solidUV = !texture || (v[0]->uv.x == v[1]->uv.x && v[0]->uv.x == v[2]->uv.x &&
+			v[0]->uv.y == v[1]->uv.y && v[0]->uv.y == v[2]->uv.y);
+		t.texture = texture;
+		if (solidUV)
+		{
+			float texel[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			if (texture)
+				Sample(*texture, v[0]->uv.x, v[0]->uv.y, texel);
+			for (int i = 0; i < 3; i++)
+				for (int ch = 0; ch < 4; ch++)
+					attr[i][ch] *= texel[ch];
+			t.shade = v[0]->col == v[1]->col && v[0]->col == v[2]->col ? Shade::Flat : Shade::Gouraud;
+		}
+		else
+		{
+			t.shade = Shade::Textured;
+		}
+
+		float invArea = 1.0f / static_cast<float>(area);
+		for (int k = 0; k < 6; k++)
+		{
+			t.base[k] = attr[0][k];
+			t.d1[k] = (attr[1][k] - attr[0][k]) * invArea;
+			t.d2[k] = (attr[2][k] - attr[0][k]) * invArea;
+		}
+
+		// Те же операции, что в Blend, - результат совпадает побитово
+		float srcA = t.base[3] * (1.0f / 255.0f);
+		t.inv = 1.0f - srcA;
+		t.opaque = t.shade == Shade::Flat && t.inv == 0.0f;
+		t.opaqueColor = 0;
+		for (int ch = 0; ch < 4; ch++)
+		{
+			t.premul[ch] = ch < 3 ? t.base[ch] * srcA : t.base[3];
+			float value = (std::min)((std::max)(t.premul[ch], 0.0f), 255.0f);
+			t.opaqueColor |= static_cast<uint32_t>(lrintf(value)) << (ch * 8);
+		}
+		return true;
+	}
+
+	// Цвет фрагмента (0..255) по w1, w2
+	static void ShadeFragment(const Triangle& t, float w1, float w2, float src[4])
+	{
+		if (t.shade == Shade::Flat)
+		{
+			for (int ch = 0; ch < 4; ch++)
+				src[ch] = t.base[ch];
+			return;
+		}
+
+		for (int ch = 0; ch < 4; ch++)
+			src[ch] = t.base[ch] + w1 * t.d1[ch] + w2 * t.d2[ch];
+		if (t.shade == Shade::Textured)
+		{
+			float texel[4];
+			Sample(*t.texture, t.base[4] + w1 * t.d1[4] + w2 * t.d2[4], t.base[5] + w1 * t.d1[5] + w2 * t.d2[5], texel);
+			for (int ch = 0; ch < 4; ch++)
+				src[ch] *= texel[ch];
+		}
+	}
+
+	static uint32_t Blend(const float src[4], uint32_t dst)
+	{
+		float srcA = src[3] * (1.0f / 255.0f);
+		float inv = 1.0f - srcA;
+		uint32_t out = 0;
+		for (int ch = 0; ch < 4; ch++)
+		{
+			float d = float((dst >> (ch * 8)) & 0xFF);
+			float value = ch < 3 ? src[ch] * srcA + d * inv : src[3] + d * inv;
+			value = (std::min)((std::max)(value, 0.0f), 255.0f);
+			out |= static_cast<uint32_t>(lrintf(value)) << (ch * 8);
+		}
+		return out;
+	}
+
+	static void CountOverdraw(uint8_t* overdraw, int count)
+	{
+		for (int i = 0; i < count; i++)
+			overdraw[i] += overdraw[i] < 255;
+	}
+
+	// Скалярный путь: w в int64 (большие треугольники и сборки без SSE2)
+	static uint64_t RasterScalar(const Triangle& t, int x0, int y0, int x1, int y1, Target& target)
+	{
+		const int half = 1 << (SUBPIXEL_BITS - 1);
+		uint64_t fragments = 0;
+		for (int y = y0; y < y1; y++)
+		{
+			int64_t sy = (int64_t(y) << SUBPIXEL_BITS) + half;
+			int xs, xe;
+			if (!RowSpan(t, sy, x0, x1, xs, xe))
+				continue;
+			int64_t sx = (int64_t(xs) << SUBPIXEL_BITS) + half;
+			int64_t w[3];
+			for (int i = 0; i < 3; i++)
+				w[i] = t.a[i] * sx + t.b[i] * sy + t.c[i];
+
+			uint32_t* row = target.pixels.data() + static_cast<size_t>(y) * target.width;
+			uint8_t* overdraw = target.overdraw.empty() ? nullptr : target.overdraw.data() + static_cast<size_t>(y) * target.width;
+			for (int x = xs; x < xe; x++)
+			{
+				if (w[0] > t.threshold[0] && w[1] > t.threshold[1] && w[2] > t.threshold[2])
+				{
+					float src[4];
+					ShadeFragment(t, static_cast<float>(w[1]), static_cast<float>(w[2]), src);
+					row[x] = Blend(src, row[x]);
+					if (overdraw)
+						CountOverdraw(overdraw + x, 1);
+					fragments++;
+				}
+				for (int i = 0; i < 3; i++)
+					w[i] += int64_t(t.a[i]) << SUBPIXEL_BITS;
+			}
+		}
+		return fragments;
+	}
+
+#ifdef RASTER_SSE2
+	// SSE2: 4 пикселя строки за раз - рёбра в int32, атрибуты и смешивание во float
+	static uint64_t RasterSSE2(const Triangle& t, int x0, int y0, int x1, int y1, Target& target)
+	{
+		const int half = 1 << (SUBPIXEL_BITS - 1);
+		static const int LANE_COUNT[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+		const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+		const __m128i byteMask = _mm_set1_epi32(0xFF);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 max255 = _mm_set1_ps(255.0f);
+		const __m128 inv255 = _mm_set1_ps(1.0f / 255.0f);
+		const __m128 one = _mm_set1_ps(1.0f);
+
+		__m128i step[3], threshold[3];
+		for (int i = 0; i < 3; i++)
+		{
+			step[i] = _mm_set1_epi32(t.a[i] << (SUBPIXEL_BITS + 2));
+			threshold[i] = _mm_set1_epi32(t.threshold[i]);
+		}
+
+		uint64_t fragments = 0;
+		for (int y = y0; y < y1; y++)
+		{
+			int64_t sy = (int64_t(y) << SUBPIXEL_BITS) + half;
+			int xs, xe;
+			if (!RowSpan(t, sy, x0, x1, xs, xe))
+				continue;
+			int64_t sx = (int64_t(xs) << SUBPIXEL_BITS) + half;
+			__m128i w[3];
+			for (int i = 0; i < 3; i++)
+			{
+				int32_t start = static_cast<int32_t>(t.a[i] * sx + t.b[i] * sy + t.c[i]);
+				int32_t a16 = t.a[i] << SUBPIXEL_BITS;
+				w[i] = _mm_add_epi32(_mm_set1_epi32(start), _mm_set_epi32(3 * a16, 2 * a16, a16, 0));
+			}
+
+			uint32_t* row = target.pixels.data() + static_cast<size_t>(y) * target.width;
+			uint8_t* overdraw = target.overdraw.empty() ? nullptr : target.overdraw.data() + static_cast<size_t>(y) * target.width;
+			for (int x = xs; x < xe; x += 4)
+			{
+				__m128i inside = _mm_and_si128(_mm_and_si128(
+					_mm_cmpgt_epi32(w[0], threshold[0]), _mm_cmpgt_epi32(w[1], threshold[1])), _mm_cmpgt_epi32(w[2], threshold[2]));
+				int count = (std::min)(4, xe - x);
+				if (count < 4)
+					inside = _mm_and_si128(inside, _mm_cmplt_epi32(lanes, _mm_set1_epi32(count)));
+				int mask = _mm_movemask_ps(_mm_castsi128_ps(inside));
+
+				if (mask)
+				{
+					alignas(16) uint32_t partial[4] = {};
+					uint32_t* dstPtr = count == 4 ? row + x : partial;
+					if (count < 4)
+						memcpy(partial, row + x, count * sizeof(uint32_t));
+					__m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dstPtr));
+
+					__m128i out;
+					if (t.opaque)
+					{
+						// Непрозрачная заливка: dst не нужен
+						out = _mm_set1_epi32(static_cast<int>(t.opaqueColor));
+					}
+					else
+					{
+						__m128 premul[4], inv;
+						if (t.shade == Shade::Flat)
+						{
+							for (int ch = 0; ch < 4; ch++)
+								premul[ch] = _mm_set1_ps(t.premul[ch]);
+							inv = _mm_set1_ps(t.inv);
+						}
+						else
+						{
+							__m128 fw1 = _mm_cvtepi32_ps(w[1]);
+							__m128 fw2 = _mm_cvtepi32_ps(w[2]);
+							__m128 src[4];
+							for (int ch = 0; ch < 4; ch++)
+								src[ch] = _mm_add_ps(_mm_add_ps(_mm_set1_ps(t.base[ch]), _mm_mul_ps(fw1, _mm_set1_ps(t.d1[ch]))), _mm_mul_ps(fw2, _mm_set1_ps(t.d2[ch])));
+							if (t.shade == Shade::Textured)
+							{
+								// Выборка скалярная: у SSE2 нет gather
+								alignas(16) float u[4], v[4], texel[4][4];
+								_mm_store_ps(u, _mm_add_ps(_mm_add_ps(_mm_set1_ps(t.base[4]), _mm_mul_ps(fw1, _mm_set1_ps(t.d1[4]))), _mm_mul_ps(fw2, _mm_set1_ps(t.d2[4]))));
+								_mm_store_ps(v, _mm_add_ps(_mm_add_ps(_mm_set1_ps(t.base[5]), _mm_mul_ps(fw1, _mm_set1_ps(t.d1[5]))), _mm_mul_ps(fw2, _mm_set1_ps(t.d2[5]))));
+								for (int lane = 0; lane < 4; lane++)
+								{
+									if (mask & (1 << lane))
+										Sample(*t.texture, u[lane], v[lane], texel[lane]);
+									else
+										texel[lane][0] = texel[lane][1] = texel[lane][2] = texel[lane][3] = 0.0f;
+								}
+								for (int ch = 0; ch < 4; ch++)
+									src[ch] = _mm_mul_ps(src[ch], _mm_set_ps(texel[3][ch], texel[2][ch], texel[1][ch], texel[0][ch]));
+							}
+							__m128 srcA = _mm_mul_ps(src[3], inv255);
+							inv = _mm_sub_ps(one, srcA);
+							for (int ch = 0; ch < 3; ch++)
+								premul[ch] = _mm_mul_ps(src[ch], srcA);
+							premul[3] = src[3];
+						}
+
+						out = _mm_setzero_si128();
+						for (int ch = 0; ch < 4; ch++)
+						{
+							__m128 d = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(dst, ch * 8), byteMask));
+							__m128 value = _mm_add_ps(premul[ch], _mm_mul_ps(d, inv));
+							value = _mm_min_ps(_mm_max_ps(value, zero), max255);
+							out = _mm_or_si128(out, _mm_slli_epi32(_mm_cvtps_epi32(value), ch * 8));
+						}
+					}
+					out = _mm_or_si128(_mm_and_si128(inside, out), _mm_andnot_si128(inside, dst));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dstPtr), out);
+					if (count < 4)
+						memcpy(row + x, partial, count * sizeof(uint32_t));
+
+					if (overdraw)
+					{
+						for (int lane = 0; lane < count; lane++)
+							if (mask & (1 << lane))
+								CountOverdraw(overdraw + x + lane, 1);
+					}
+					fragments += LANE_COUNT[mask];
+				}
+
+				for (int i = 0; i < 3; i++)
+					w[i] = _mm_add_epi32(w[i], step[i]);
+			}
+		}
+		return fragments;
+	}
+#endif
+
+	static uint64_t RasterTile(const Triangle& t, int tileX, int tileY, Target& target)
+	{
+		int x0 = (std::max)(t.minX, tileX * TILE_SIZE);
+		int y0 = (std::max)(t.minY, tileY * TILE_SIZE);
+		int x1 = (std::min)(t.maxX, (tileX + 1) * TILE_SIZE);
+		int y1 = (std::min)(t.maxY, (tileY + 1) * TILE_SIZE);
+		if (x0 >= x1 || y0 >= y1)
+			return 0;
+#ifdef RASTER_SSE2
+		if (!t.wide)
+			return RasterSSE2(t, x0, y0, x1, y1, target);
+#endif
+		return RasterScalar(t, x0, y0, x1, y1, target);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	void Resize(Target& target, int width, int height, bool overdraw)
+	{
+		target.width = width;
+		target.height = height;
+		target.pixels.assign(static_cast<size_t>(width) * height, 0);
+		target.overdraw.assign(overdraw ? static_cast<size_t>(width) * height : 0, 0);
+	}
+
+	void Clear(Target& target, uint32_t color)
+	{
+		std::fill(target.pixels.begin(), target.pixels.end(), color);
+		std::fill(target.overdraw.begin(), target.overdraw.end(), 0);
+	}
+
+	void UpdateTexture(ImTextureData* tex)
+	{
+		if (tex->Status == ImTextureStatus_WantCreate)
+		{
+			Texture* texture = new Texture();
+			texture->width = tex->Width;
+			texture->height = tex->Height;
+			texture->pixels.resize(static_cast<size_t>(tex->Width) * tex->Height);
+			CopyRect(*texture, tex, 0, 0, tex->Width, tex->Height);
+			g_Textures.push_back(texture);
+			g_TextureUploads++;
+
+			tex->SetTexID(static_cast<ImTextureID>(reinterpret_cast<intptr_t>(texture)));
+			tex->BackendUserData = texture;
+			tex->SetStatus(ImTextureStatus_OK);
+		}
+		else if (tex->Status == ImTextureStatus_WantUpdates)
+		{
+			Texture* texture = static_cast<Texture*>(tex->BackendUserData);
+			for (const ImTextureRect& r : tex->Updates)
+				CopyRect(*texture, tex, r.x, r.y, r.w, r.h);
+			g_TextureUploads++;
+			tex->SetStatus(ImTextureStatus_OK);
+		}
+		if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+			DestroyTexture(tex);
+	}
+
+	void RenderDrawData(ImDrawData* drawData, Target& target)
+	{
+		if (drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f || target.pixels.empty())
+			return;
+
+		if (drawData->Textures != nullptr)
+		{
+			for (ImTextureData* tex : *drawData->Textures)
+				if (tex->Status != ImTextureStatus_OK)
+					UpdateTexture(tex);
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		Stats stats;
+		stats.textures = static_cast<int>(g_Textures.size());
+		stats.textureUploads = g_TextureUploads;
+
+		// Тайлы: списки треугольников сохраняют порядок отрисовки внутри тайла
+		int tilesX = (target.width + TILE_SIZE - 1) / TILE_SIZE;
+		int tilesY = (target.height + TILE_SIZE - 1) / TILE_SIZE;
+		if (tilesX != g_TilesX || tilesY != g_TilesY)
+		{
+			g_Bins.assign(static_cast<size_t>(tilesX) * tilesY, std::vector<uint32_t>());
+			g_TilesX = tilesX;
+			g_TilesY = tilesY;
+		}
+		for (std::vector<uint32_t>& bin : g_Bins)
+			bin.clear();
+		g_Triangles.clear();
+
+		ImVec2 offset = drawData->DisplayPos;
+		ImVec2 scale = drawData->FramebufferScale;
+		for (ImDrawList* list : drawData->CmdLists)
+		{
+			for (const ImDrawCmd& cmd : list->CmdBuffer)
+			{
+				if (cmd.UserCallback)
+				{
+					if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+						cmd.UserCallback(list, &cmd);
+					continue;
+				}
+
+				// Как D3D11_RECT в imgui_impl_dx11: отбрасывание дробной части
+				ImVec2 clipMin((cmd.ClipRect.x - offset.x) * scale.x, (cmd.ClipRect.y - offset.y) * scale.y);
+				ImVec2 clipMax((cmd.ClipRect.z - offset.x) * scale.x, (cmd.ClipRect.w - offset.y) * scale.y);
+				stats.triangles += cmd.ElemCount / 3;
+				if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+				{
+					stats.culled += cmd.ElemCount / 3;
+					continue;
+				}
+				int clip[4] = {
+					(std::max)(0, static_cast<int>(clipMin.x)), (std::max)(0, static_cast<int>(clipMin.y)),
+					(std::min)(target.width, static_cast<int>(clipMax.x)), (std::min)(target.height, static_cast<int>(clipMax.y))
+				};
+
+				const Texture* texture = reinterpret_cast<const Texture*>(static_cast<intptr_t>(cmd.GetTexID()));
+				const ImDrawIdx* indices = list->IdxBuffer.Data + cmd.IdxOffset;
+				const ImDrawVert* vertices = list->VtxBuffer.Data + cmd.VtxOffset;
+				for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+				{
+					const ImDrawVert* v[3] = { &vertices[indices[i]], &vertices[indices[i + 1]], &vertices[indices[i + 2]] };
+					Triangle t;
+					if (!SetupTriangle(t, v, offset, scale, clip, texture))
+					{
+						stats.culled++;
+						continue;
+					}
+
+					uint32_t index = static_cast<uint32_t>(g_Triangles.size());
+					g_Triangles.push_back(t);
+					for (int ty = t.minY / TILE_SIZE; ty <= (t.maxY - 1) / TILE_SIZE; ty++)
+					{
+						for (int tx = t.minX / TILE_SIZE; tx <= (t.maxX - 1) / TILE_SIZE; tx++)
+						{
+							g_Bins[static_cast<size_t>(ty) * tilesX + tx].push_back(index);
+							stats.binned++;
+						}
+					}
+				}
+			}
+		}
+
+		auto setupEnd = std::chrono::steady_clock::now();
+
+		// Тайлы не пересекаются - потоки пишут в разные пиксели, порядок внутри тайла сохранён
+		std::atomic<uint64_t> fragments{ 0 };
+		Jobs::ParallelFor(g_Bins.size(), 1, [&](size_t begin, size_t end)
+		{
+			uint64_t local = 0;
+			for (size_t tile = begin; tile < end; tile++)
+			{
+				int tileX = static_cast<int>(tile % tilesX);
+				int tileY = static_cast<int>(tile / tilesX);
+				for (uint32_t index : g_Bins[tile])
+					local += RasterTile(g_Triangles[index], tileX, tileY, target);
+			}
+			fragments.fetch_add(local, std::memory_order_relaxed);
+		});
+
+		auto end = std::chrono::steady_clock::now();
+
+		stats.tiles = tilesX * tilesY;
+		for (const std::vector<uint32_t>& bin : g_Bins)
+			stats.tilesTouched += !bin.empty();
+		stats.fragments = fragments.load();
+		for (uint8_t count : target.overdraw)
+			stats.covered += count != 0;
+		stats.setupMs = std::chrono::duration<double, std::milli>(setupEnd - start).count();
+		stats.rasterMs = std::chrono::duration<double, std::milli>(end - setupEnd).count();
+		g_Stats = stats;
+	}
+
+	void Shutdown()
+	{
+		if (ImGui::GetCurrentContext())
+		{
+			for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+				if (tex->BackendUserData && g_Textures.end() != std::find(g_Textures.begin(), g_Textures.end(), tex->BackendUserData))
+					DestroyTexture(tex);
+		}
+		for (Texture* texture : g_Textures)
+			delete texture;
+		g_Textures.clear();
+		g_Triangles = std::vector<Triangle>();
+		g_Bins = std::vector<std::vector<uint32_t>>();
+		g_TilesX = g_TilesY = 0;
+	}
+
+	Stats GetStats()
+	{
+		return g_Stats;
+	}
+
+	uint32_t Hash(const Target& target)
+	{
+		uint32_t hash = 2166136261u;
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(target.pixels.data());
+		for (size_t i = 0; i < target.pixels.size() * sizeof(uint32_t); i++)
+			hash = (hash ^ bytes[i]) * 16777619u;
+		return hash;
+	}
+
+	int64_t Compare(const Target& a, const Target& b, int tolerance)
+	{
+		if (a.width != b.width || a.height != b.height)
+			return -1;
+		int64_t different = 0;
+		for (size_t i = 0; i < a.pixels.size(); i++)
+		{
+			uint32_t pa = a.pixels[i], pb = b.pixels[i];
+			for (int ch = 0; ch < 4; ch++)
+			{
+				int delta = static_cast<int>((pa >> (ch * 8)) & 0xFF) - static_cast<int>((pb >> (ch * 8)) & 0xFF);
+				if (delta > tolerance || delta < -tolerance)
+				{
+					different++;
+					break;
+				}
+			}
+		}
+		return different;
+	}
+
+	// TGA: 18-байтовый заголовок, BGRA, строки сверху вниз (бит 5 дескриптора)
+	static bool WritePixels(const char* path, int width, int height, const uint32_t* rgba)
+	{
+		FILE* file = fopen(path, "wb");
+		if (!file)
+			return false;
+		uint8_t header[18] = {};
+		header[2] = 2;
+		header[12] = static_cast<uint8_t>(width & 0xFF);
+		header[13] = static_cast<uint8_t>(width >> 8);
+		header[14] = static_cast<uint8_t>(height & 0xFF);
+		header[15] = static_cast<uint8_t>(height >> 8);
+		header[16] = 32;
+		header[17] = 0x28;
+		bool ok = fwrite(header, 1, sizeof(header), file) == sizeof(header);
+
+		std::vector<uint8_t> row(static_cast<size_t>(width) * 4);
+		for (int y = 0; y < height && ok; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				uint32_t c = rgba[static_cast<size_t>(y) * width + x];
+				row[x * 4 + 0] = static_cast<uint8_t>(c >> 16);
+				row[x * 4 + 1] = static_cast<uint8_t>(c >> 8);
+				row[x * 4 + 2] = static_cast<uint8_t>(c);
+				row[x * 4 + 3] = static_cast<uint8_t>(c >> 24);
+			}
+			ok = fwrite(row.data(), 1, row.size(), file) == row.size();
+		}
+		return fclose(file) == 0 && ok;
+	}
+
+	bool WriteTGA(const Target& target, const char* path)
+	{
+		return WritePixels(path, target.width, target.height, target.pixels.data());
+	}
+
+	bool ReadTGA(Target& target, const char* path)
+	{
+		FILE* file = fopen(path, "rb");
+		if (!file)
+			return false;
+		uint8_t header[18];
+		bool ok = fread(header, 1, sizeof(header), file) == sizeof(header) && header[2] == 2 && header[16] == 32 &&
+			header[0] == 0 && header[1] == 0;
+		int width = header[12] | (header[13] << 8);
+		int height = header[14] | (header[15] << 8);
+		if (ok)
+		{
+			Resize(target, width, height);
+			bool topDown = (header[17] & 0x20) != 0;
+			std::vector<uint8_t> row(static_cast<size_t>(width) * 4);
+			for (int y = 0; y < height && ok; y++)
+			{
+				ok = fread(row.data(), 1, row.size(), file) == row.size();
+				uint32_t* dst = target.pixels.data() + static_cast<size_t>(topDown ? y : height - 1 - y) * width;
+				for (int x = 0; x < width && ok; x++)
+					dst[x] = IM_COL32(row[x * 4 + 2], row[x * 4 + 1], row[x * 4 + 0], row[x * 4 + 3]);
+			}
+		}
+		fclose(file);
+		return ok;
+	}
+
+	bool WriteOverdrawTGA(const Target& target, const char* path)
+	{
+		if (target.overdraw.empty())
+			return false;
+		static const uint32_t HEAT[] = {
+			IM_COL32(0, 0, 0, 255), IM_COL32(0, 0, 255, 255), IM_COL32(0, 255, 0, 255),
+			IM_COL32(255, 255, 0, 255), IM_COL32(255, 0, 0, 255)
+		};
+		std::vector<uint32_t> heat(target.overdraw.size());
+		for (size_t i = 0; i < heat.size(); i++)
+			heat[i] = HEAT[(std::min)(static_cast<int>(target.overdraw[i]), 4)];
+		return WritePixels(path, target.width, target.height, heat.data());
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../deps/imgui/imgui.h"
+#include <cstdint>
+#include <vector>
+
+namespace Raster
+{
+	/// Сторона тайла в пикселях: тайлы растеризуются параллельно (Jobs::ParallelFor)
+	constexpr int TILE_SIZE = 64;
+
+	/// Субпиксельная точность вершин: 1/16 пикселя, как в 28.4 у GPU
+	constexpr int SUBPIXEL_BITS = 4;
+
+	/// Изображение RGBA8 в раскладке ImU32 (IM_COL32: R в младшем байте)
+	struct Target
+	{
+		int width = 0;
+		int height = 0;
+		std::vector<uint32_t> pixels;
+		std::vector<uint8_t> overdraw;   // фрагментов на пиксель (до 255), если включено в Resize
+	};
+
+	/// Статистика последнего RenderDrawData
+	struct Stats
+	{
+		uint64_t triangles = 0;       // треугольников в ImDrawData
+		uint64_t culled = 0;          // вырожденные или целиком вне scissor/экрана
+		uint64_t binned = 0;          // пар треугольник-тайл
+		int tiles = 0;
+		int tilesTouched = 0;
+		uint64_t fragments = 0;       // пикселей, прошедших покрытие (смешиваний)
+		uint64_t covered = 0;         // разных пикселей (только с overdraw)
+		int textures = 0;
+		uint64_t textureUploads = 0;  // WantCreate + WantUpdates за всё время
+		double setupMs = 0.0;         // вершины, scissor, раскладка по тайлам
+		double rasterMs = 0.0;        // тайлы
+	};
+
+	/// Размер изображения. overdraw - вести счётчик фрагментов на пиксель
+	void Resize(Target& target, int width, int height, bool overdraw = false);
+
+	/// Заливка цветом и обнуление счётчиков перерисовки
+	void Clear(Target& target, uint32_t color);
+
+	/// Создание/обновление/удаление копии текстуры ImGui (как ImGui_ImplDX11_UpdateTexture)
+	void UpdateTexture(ImTextureData* texture);
+
+	/// Рисует ImDrawData поверх target так же, как ImGui_ImplDX11_RenderDrawData:
+	/// scissor, линейная выборка с повтором, смешивание SRC_ALPHA / INV_SRC_ALPHA
+	/// (альфа: ONE / INV_SRC_ALPHA), без отсечения по обходу. Сначала обрабатывает Textures
+	void RenderDrawData(ImDrawData* drawData, Target& target);
+
+	/// Освобождает копии текстур (ImTextureStatus_Destroyed)
+	void Shutdown();
+
+	Stats GetStats();
+
+	/// FNV-1a пикселей: одинаковый кадр - одинаковый хэш при любом числе потоков
+	uint32_t Hash(const Target& target);
+
+	/// Пикселей, у которых хоть один канал отличается больше чем на tolerance
+	/// (-1 - разный размер)
+	int64_t Compare(const Target& a, const Target& b, int tolerance);
+
+	/// Несжатый 32-битный TGA (эталоны для сравнения)
+	bool WriteTGA(const Target& target, const char* path);
+	bool ReadTGA(Target& target, const char* path);
+
+	/// Тепловая карта overdraw: 0 - чёрный, 1 - синий, 2 - зелёный, 3 - жёлтый, 4+ - красный
+	bool WriteOverdrawTGA(const Target& target, const char* path);
+}
@@ -0,0 +1,251 @@
+#include "scheduler.h"
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+namespace Scheduler
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	struct Task
+	{
+		TaskFn fn;
+		double period;      // секунды, 0 для EveryFrame/OnEvent
+		double phase;       // смещение первого запуска внутри периода
+		double nextRun;     // время следующего запуска (FixedRate)
+		bool pending;       // сигнал для OnEvent
+		bool started;       // nextRun уже привязан к часам
+		int deferredFrames; // сколько кадров подряд задача откладывалась
+	};
+
+	static Task g_Tasks[MAX_TASKS];
+	static TaskStats g_Stats[MAX_TASKS];
+	static int g_TaskCount = 0;
+	static ClockFn g_Clock = nullptr;
+	static float g_BudgetMs = 2.0f;
+	static FrameStats g_FrameStats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static double SteadyClock()
+	{
+		using namespace std::chrono;
+		return duration<double>(steady_clock::now().time_since_epoch()).count();
+	}
+
+	static double Now()
+	{
+		return g_Clock ? g_Clock() : SteadyClock();
+	}
+
+	// Фаза по последовательности золотого сечения: задачи с одинаковым периодом
+	// равномерно разносятся по кадрам и не выполняются одновременно
+	static double StaggerPhase(int index, double period)
+	{
+		double frac = std::fmod(index * 0.6180339887498949, 1.0);
+		return frac * period;
+	}
+
+	static bool IsDue(const Task& task, const TaskStats& stats, double now)
+	{
+		if (!stats.enabled)
+			return false;
+
+		switch (stats.mode)
+		{
+		case TickMode::EveryFrame:
+			return true;
+		case TickMode::FixedRate:
+			return now >= task.nextRun;
+		case TickMode::OnEvent:
+			return task.pending;
+		}
+		return false;
+	}
+
+	// Чем больше значение, тем раньше задача выполняется в кадре
+	static double Urgency(const Task& task, const TaskStats& stats, double now)
+	{
+		if (stats.mode == TickMode::EveryFrame)
+			return 1e9 + task.deferredFrames;
+
+		double lateness = 0.0;
+		if (stats.mode == TickMode::FixedRate && task.period > 0.0)
+			lateness = (now - task.nextRun) / task.period;
+
+		return task.deferredFrames + lateness;
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	int Register(const TaskDesc& desc)
+	{
+		if (!desc.fn || g_TaskCount >= MAX_TASKS)
+			return -1;
+		if (desc.mode == TickMode::FixedRate && desc.rateHz <= 0.0f)
+			return -1;
+
+		int id = g_TaskCount++;
+
+		Task& task = g_Tasks[id];
+		task = Task();
+		task.fn = desc.fn;
+		task.period = desc.mode == TickMode::FixedRate ? 1.0 / desc.rateHz : 0.0;
+		task.phase = StaggerPhase(id, task.period);
+
+		TaskStats& stats = g_Stats[id];
+		stats = TaskStats();
+		stats.name = desc.name ? desc.name : "";
+		stats.mode = desc.mode;
+		stats.rateHz = desc.rateHz;
+
+		return id;
+	}
+
+	void SetEnabled(int id, bool enabled)
+	{
+		if (id < 0 || id >= g_TaskCount)
+			return;
+
+		g_Stats[id].enabled = enabled;
+		g_Tasks[id].started = false;  // при повторном включении фаза пересчитывается
+		g_Tasks[id].deferredFrames = 0;
+	}
+
+	void Signal(int id)
+	{
+		if (id < 0 || id >= g_TaskCount)
+			return;
+
+		g_Tasks[id].pending = true;
+	}
+
+	void SetClock(ClockFn clock)
+	{
+		g_Clock = clock;
+	}
+
+	void SetFrameBudget(float ms)
+	{
+		g_BudgetMs = (std::max)(0.0f, ms);
+	}
+
+	void RunFrame()
+	{
+		double frameStart = Now();
+
+		// Собираем задачи, которым пора выполняться
+		int due[MAX_TASKS];
+		double urgency[MAX_TASKS];
+		int dueCount = 0;
+
+		for (int i = 0; i < g_TaskCount; i++)
+		{
+			Task& task = g_Tasks[i];
+			if (g_Stats[i].mode == TickMode::FixedRate && !task.started)
+			{
+				task.nextRun = frameStart + task.phase;
+				task.started = true;
+			}
+
+			if (IsDue(task, g_Stats[i], frameStart))
+			{
+				urgency[i] = Urgency(task, g_Stats[i], frameStart);
+				due[dueCount++] = i;
+			}
+		}
+
+		// Детерминированный порядок: по срочности, затем по id
+		std::sort(due, due + dueCount, [&](int a, int b) {
+			if (urgency[a] != urgency[b])
+				return urgency[a] > urgency[b];
+			return a < b;
+		});
+
+		FrameStats frame;
+		frame.frame = g_FrameStats.frame + 1;
+		frame.budgetMs = g_BudgetMs;
+
+		double spentMs = 0.0;
+		for (int n = 0; n < dueCount; n++)
+		{
+			int id = due[n];
+			Task& task = g_Tasks[id];
+			TaskStats& stats = g_Stats[id];
+
+			// Откладываем, если прогноз по средней стоимости не укладывается в бюджет.
+			// Первую задачу кадра и слишком долго ждущие задачи выполняем всегда
+			bool overBudget = g_BudgetMs > 0.0f && frame.executed > 0 &&
+				spentMs + stats.avgMs > g_BudgetMs;
+			if (overBudget && task.deferredFrames < MAX_DEFER_FRAMES)
+			{
+				task.deferredFrames++;
+				stats.deferrals++;
+				frame.deferred++;
+				continue;
+			}
+
+			double start = Now();
+			task.fn();
+			double end = Now();
+
+			float ms = static_cast<float>((end - start) * 1000.0);
+			spentMs += ms;
+
+			stats.runs++;
+			stats.lastMs = ms;
+			stats.avgMs = stats.runs == 1 ? ms : stats.avgMs + (ms - stats.avgMs) * 0.1f;
+			stats.maxMs = (std::max)(stats.maxMs, ms);
+
+			task.deferredFrames = 0;
+			task.pending = false;
+
+			if (stats.mode == TickMode::FixedRate)
+			{
+				// Сохраняем фазу: после долгой паузы пропущенные тики не догоняются
+				task.nextRun += task.period;
+				if (task.nextRun <= frameStart)
+				{
+					double missed = std::floor((frameStart - task.nextRun) / task.period) + 1.0;
+					task.nextRun += missed * task.period;
+				}
+			}
+
+			frame.executed++;
+		}
+
+		frame.spentMs = static_cast<float>(spentMs);
+		g_FrameStats = frame;
+	}
+
+	int GetTaskCount()
+	{
+		return g_TaskCount;
+	}
+
+	const TaskStats& GetTaskStats(int id)
+	{
+		static const TaskStats empty;
+		if (id < 0 || id >= g_TaskCount)
+			return empty;
+
+		return g_Stats[id];
+	}
+
+	const FrameStats& GetFrameStats()
+	{
+		return g_FrameStats;
+	}
+
+	void Reset()
+	{
+		g_TaskCount = 0;
+		g_FrameStats = FrameStats();
+	}
+}
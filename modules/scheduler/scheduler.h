@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Scheduler
+{
+	/// Функция обновления модуля
+	typedef void (*TaskFn)();
+
+	/// Источник времени в секундах (в тестах подменяется симулированными часами)
+	typedef double (*ClockFn)();
+
+	/// Режим тактирования задачи
+	enum class TickMode : uint8_t
+	{
+		EveryFrame,  // каждый кадр
+		FixedRate,   // с заданной частотой (rateHz)
+		OnEvent      // только после Signal()
+	};
+
+	/// Описание задачи модуля
+	struct TaskDesc
+	{
+		const char* name = "";
+		TaskFn fn = nullptr;
+		TickMode mode = TickMode::EveryFrame;
+		float rateHz = 0.0f;  // используется только для FixedRate
+	};
+
+	/// Статистика выполнения задачи
+	struct TaskStats
+	{
+		const char* name = "";
+		TickMode mode = TickMode::EveryFrame;
+		float rateHz = 0.0f;
+		bool enabled = true;
+		uint64_t runs = 0;
+		uint64_t deferrals = 0;
+		float lastMs = 0.0f;
+		float avgMs = 0.0f;   // экспоненциальное среднее
+		float maxMs = 0.0f;
+	};
+
+	/// Статистика последнего кадра
+	struct FrameStats
+	{
+		uint64_t frame = 0;
+		float spentMs = 0.0f;
+		float budgetMs = 0.0f;
+		int executed = 0;
+		int deferred = 0;
+	};
+
+	/// Максимальное количество задач
+	constexpr int MAX_TASKS = 64;
+
+	/// Кадров подряд, после которых отложенная задача выполняется вне бюджета
+	constexpr int MAX_DEFER_FRAMES = 8;
+
+	/// Регистрирует задачу, возвращает её id или -1
+	int Register(const TaskDesc& desc);
+
+	/// Включает/выключает задачу
+	void SetEnabled(int id, bool enabled);
+
+	/// Помечает OnEvent задачу к выполнению в ближайшем кадре
+	void Signal(int id);
+
+	/// Устанавливает источник времени (nullptr = steady_clock)
+	void SetClock(ClockFn clock);
+
+	/// Устанавливает бюджет CPU на кадр в миллисекундах (0 = без ограничения)
+	void SetFrameBudget(float ms);
+
+	/// Выполняет задачи, которым пора работать в этом кадре
+	void RunFrame();
+
+	/// Количество зарегистрированных задач
+	int GetTaskCount();
+
+	/// Статистика задачи по id
+	const TaskStats& GetTaskStats(int id);
+
+	/// Статистика последнего кадра
+	const FrameStats& GetFrameStats();
+
+	/// Удаляет все задачи и сбрасывает состояние
+	void Reset();
+}
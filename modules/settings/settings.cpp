@@ -0,0 +1,348 @@
+#include "settings.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include "../../platform/platform.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Settings
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	static std::string g_Path;
+	static LoadResult g_LoadResult = LoadResult::Missing;
+
+	// Render thread: последнее увиденное состояние и момент его изменения
+	static Snapshot g_Last = {};
+	static bool g_HasLast = false;
+	static bool g_Dirty = false;
+	static double g_ChangedAt = 0.0;
+
+	// Передача потоку записи (g_WriterMutex)
+	static std::thread g_WriterThread;
+	static std::mutex g_WriterMutex;
+	static std::condition_variable g_WriterCv;
+	static Snapshot g_Pending = {};
+	static bool g_HasPending = false;
+	static bool g_WriterStop = false;
+	static std::atomic<bool> g_WriterRunning{ false };
+	static std::atomic<bool> g_WriterExited{ false };   // вышел из WriterMain (Shutdown ждёт его, а не выхода потока)
+
+	// Только поток записи (и Shutdown после его остановки)
+	static uint8_t g_FileBuffer[MAX_FILE_SIZE];
+	static uint32_t g_Sequence = 0;
+
+	static std::atomic<uint64_t> g_Saves{ 0 };
+	static std::atomic<uint64_t> g_Failures{ 0 };
+	static std::atomic<uint32_t> g_SavedSequence{ 0 };
+	static std::atomic<double> g_LastSaveMs{ 0.0 };
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	// Запись длины size поверх значения по умолчанию: общий префикс копируется,
+	// недостающие поля остаются, лишние (новая версия) пропускаются
+	template<typename T>
+	static void ReadRecord(const uint8_t* src, size_t size, T& record)
+	{
+		memcpy(&record, src, (std::min)(size, sizeof(T)));
+	}
+
+	static void Save(const Snapshot& snapshot)
+	{
+		auto start = std::chrono::steady_clock::now();
+		size_t size = Encode(snapshot, g_Sequence + 1, g_FileBuffer);
+		if (WriteFileAtomic(g_Path.c_str(), g_FileBuffer, size))
+		{
+			g_Sequence++;
+			g_SavedSequence.store(g_Sequence, std::memory_order_relaxed);
+			g_Saves.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			g_Failures.fetch_add(1, std::memory_order_relaxed);
+		}
+		g_LastSaveMs.store(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+			std::memory_order_relaxed);
+	}
+
+	static void WriterMain()
+	{
+		Snapshot snapshot;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(g_WriterMutex);
+				g_WriterCv.wait(lock, [] { return g_HasPending || g_WriterStop; });
+				if (!g_HasPending)
+					break;
+				snapshot = g_Pending;
+				g_HasPending = false;
+			}
+			Save(snapshot);
+		}
+		g_WriterExited.store(true, std::memory_order_release);
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	LoadResult Decode(const void* data, size_t size, Snapshot& snapshot, uint32_t* sequence)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		if (!bytes || size < sizeof(FileHeader))
+			return LoadResult::Corrupt;
+
+		FileHeader header;
+		memcpy(&header, bytes, sizeof(header));
+		if (header.magic != FILE_MAGIC || header.version == 0 || header.fileSize != size)
+			return LoadResult::Corrupt;
+		if (header.version > FILE_VERSION)
+			return LoadResult::Unsupported;
+
+		size_t expected = sizeof(FileHeader) + header.overlaySize +
+			static_cast<size_t>(header.panelCount) * header.panelSize +
+			static_cast<size_t>(header.moduleCount) * header.moduleSize;
+		if (expected != size || header.panelCount > MAX_PANELS || header.moduleCount > MAX_MODULES ||
+			(header.panelCount && header.panelSize < MIN_PANEL_SIZE) ||
+			(header.moduleCount && header.moduleSize < MIN_MODULE_SIZE))
+			return LoadResult::Corrupt;
+
+		if (HashBytes(bytes + sizeof(FileHeader), size - sizeof(FileHeader)) != header.checksum)
+			return LoadResult::Corrupt;
+
+		// Версия 1 - первая; шаги миграции со старых версий добавляются здесь
+		const uint8_t* p = bytes + sizeof(FileHeader);
+		bool sameLayout = header.overlaySize == sizeof(OverlayRecord) &&
+			header.panelSize == sizeof(PanelRecord) && header.moduleSize == sizeof(ModuleRecord);
+
+		if (sameLayout)
+		{
+			// Текущий формат: записи лежат в файле ровно как в Snapshot
+			memcpy(&snapshot.overlay, p, sizeof(OverlayRecord));
+			p += sizeof(OverlayRecord);
+			memcpy(snapshot.panels, p, header.panelCount * sizeof(PanelRecord));
+			p += header.panelCount * sizeof(PanelRecord);
+			memcpy(snapshot.modules, p, header.moduleCount * sizeof(ModuleRecord));
+		}
+		else
+		{
+			ReadRecord(p, header.overlaySize, snapshot.overlay);
+			p += header.overlaySize;
+			for (int i = 0; i < header.panelCount; i++, p += header.panelSize)
+			{
+				snapshot.panels[i] = PanelRecord();
+				ReadRecord(p, header.panelSize, snapshot.panels[i]);
+			}
+			for (int i = 0; i < header.moduleCount; i++, p += header.moduleSize)
+			{
+				snapshot.modules[i] = ModuleRecord();
+				ReadRecord(p, header.moduleSize, snapshot.modules[i]);
+			}
+		}
+		snapshot.panelCount = header.panelCount;
+		snapshot.moduleCount = header.moduleCount;
+
+		if (sequence)
+			*sequence = header.sequence;
+		return sameLayout && header.version == FILE_VERSION ? LoadResult::Loaded : LoadResult::Migrated;
+	}
+
+	size_t Encode(const Snapshot& snapshot, uint32_t sequence, uint8_t* out)
+	{
+		int panelCount = (std::max)(0, (std::min)(snapshot.panelCount, MAX_PANELS));
+		int moduleCount = (std::max)(0, (std::min)(snapshot.moduleCount, MAX_MODULES));
+
+		uint8_t* p = out + sizeof(FileHeader);
+		memcpy(p, &snapshot.overlay, sizeof(OverlayRecord));
+		p += sizeof(OverlayRecord);
+		memcpy(p, snapshot.panels, panelCount * sizeof(PanelRecord));
+		p += panelCount * sizeof(PanelRecord);
+		memcpy(p, snapshot.modules, moduleCount * sizeof(ModuleRecord));
+		p += moduleCount * sizeof(ModuleRecord);
+
+		FileHeader header = {};
+		header.magic = FILE_MAGIC;
+		header.version = FILE_VERSION;
+		header.fileSize = static_cast<uint32_t>(p - out);
+		header.checksum = HashBytes(out + sizeof(FileHeader), header.fileSize - sizeof(FileHeader));
+		header.sequence = sequence;
+		header.overlaySize = sizeof(OverlayRecord);
+		header.panelSize = sizeof(PanelRecord);
+		header.moduleSize = sizeof(ModuleRecord);
+		header.panelCount = static_cast<uint16_t>(panelCount);
+		header.moduleCount = static_cast<uint16_t>(moduleCount);
+		memcpy(out, &header, sizeof(header));
+		return header.fileSize;
+	}
+
+	LoadResult Load(const char* path, Snapshot& snapshot)
+	{
+		Shutdown();
+		g_Path = path;
+
+		MappedFile file;
+		if (MapFile(path, &file))
+		{
+			g_LoadResult = Decode(file.data, file.size, snapshot, &g_Sequence);
+			UnmapFile(&file);
+		}
+		else
+		{
+			g_LoadResult = LoadResult::Missing;
+		}
+
+		// Неподходящий файл будет перезаписан: нумерация сохранений начинается заново
+		if (g_LoadResult != LoadResult::Loaded && g_LoadResult != LoadResult::Migrated)
+			g_Sequence = 0;
+		g_SavedSequence.store(g_Sequence, std::memory_order_relaxed);
+
+		// Загруженное состояние уже на диске - записывать его снова не нужно
+		g_Last = snapshot;
+		g_HasLast = true;
+		g_Dirty = false;
+
+		// Файл новой сборки не перезаписываем старым форматом - работаем без сохранения
+		if (g_LoadResult == LoadResult::Unsupported)
+			return g_LoadResult;
+
+		g_WriterStop = false;
+		g_WriterExited.store(false, std::memory_order_relaxed);
+		g_WriterRunning.store(true, std::memory_order_release);
+		g_WriterThread = std::thread(WriterMain);
+		return g_LoadResult;
+	}
+
+	void Update(const Snapshot& current, double now)
+	{
+		if (!g_HasLast || memcmp(&current, &g_Last, sizeof(Snapshot)) != 0)
+		{
+			g_Last = current;
+			g_HasLast = true;
+			g_Dirty = true;
+			g_ChangedAt = now;
+			return;
+		}
+
+		if (!g_Dirty || now - g_ChangedAt < SAVE_DELAY || !g_WriterRunning.load(std::memory_order_acquire))
+			return;
+
+		// Поток записи держит мьютекс только на время копирования - если занят, попробуем в следующем кадре
+		std::unique_lock<std::mutex> lock(g_WriterMutex, std::try_to_lock);
+		if (!lock.owns_lock())
+			return;
+		g_Pending = g_Last;
+		g_HasPending = true;
+		g_Dirty = false;
+		lock.unlock();
+		g_WriterCv.notify_one();
+	}
+
+	void Shutdown(bool processExit)
+	{
+		if (g_WriterRunning.exchange(false))
+		{
+			if (processExit)
+			{
+				// Система уже остановила поток записи, возможно с копией на руках.
+				// Мьютекс не трогаем - его мог держать убитый поток
+				if (g_HasPending)
+					g_Dirty = true;
+			}
+			else
+			{
+				{
+					std::lock_guard<std::mutex> lock(g_WriterMutex);
+					g_WriterStop = true;
+				}
+				g_WriterCv.notify_one();
+
+				// Не join: выход потока ждёт loader lock, а FreeLibrary держит его на время DllMain
+				while (!g_WriterExited.load(std::memory_order_acquire))
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+			if (g_WriterThread.joinable())
+				g_WriterThread.detach();
+
+			// Изменения, которые не дождались SAVE_DELAY (или записи убитым потоком)
+			if (g_Dirty)
+				Save(g_Last);
+		}
+
+		g_HasLast = false;
+		g_Dirty = false;
+		g_HasPending = false;
+	}
+
+	const PanelRecord* FindPanel(const Snapshot& snapshot, uint32_t nameHash)
+	{
+		for (int i = 0; i < snapshot.panelCount; i++)
+		{
+			if (snapshot.panels[i].nameHash == nameHash)
+				return &snapshot.panels[i];
+		}
+		return nullptr;
+	}
+
+	const ModuleRecord* FindModule(const Snapshot& snapshot, uint32_t nameHash)
+	{
+		for (int i = 0; i < snapshot.moduleCount; i++)
+		{
+			if (snapshot.modules[i].nameHash == nameHash)
+				return &snapshot.modules[i];
+		}
+		return nullptr;
+	}
+
+	const char* GetPath()
+	{
+		return g_Path.c_str();
+	}
+
+	Stats GetStats()
+	{
+		Stats stats;
+		stats.load = g_LoadResult;
+		stats.writer = g_WriterRunning.load(std::memory_order_relaxed);
+		stats.pending = g_Dirty;
+		stats.sequence = g_SavedSequence.load(std::memory_order_relaxed);
+		stats.saves = g_Saves.load(std::memory_order_relaxed);
+		stats.failures = g_Failures.load(std::memory_order_relaxed);
+		stats.lastSaveMs = g_LastSaveMs.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void SettingsCommand(const Console::Commands::Args&, void*)
+	{
+		static const char* const LOAD_RESULTS[] = { "loaded", "migrated", "missing", "damaged", "newer version" };
+		Stats stats = GetStats();
+		if (!stats.writer && stats.load != LoadResult::Unsupported)
+		{
+			Console::Log("Settings: not loaded, changes are not saved");
+			return;
+		}
+		Console::Log("Settings: %s (%s)", GetPath(), LOAD_RESULTS[static_cast<int>(stats.load)]);
+		Console::Log("  save #%u, %llu saved, %llu failed, last %.2f ms%s",
+			stats.sequence, static_cast<unsigned long long>(stats.saves), static_cast<unsigned long long>(stats.failures),
+			stats.lastSaveMs, stats.pending ? ", changes pending" : "");
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "settings", "", "settings file: load result and background saves", SettingsCommand });
+	}
+}
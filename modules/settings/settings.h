@@ -0,0 +1,78 @@
+#pragma once
+
+#include "settings_format.h"
+#include <cstdint>
+
+namespace Settings
+{
+	/// Сколько настройки должны не меняться, прежде чем попасть на диск, секунд
+	constexpr double SAVE_DELAY = 1.0;
+
+	/// Состояние оверлея в формате файла. Сравнивается memcmp, поэтому заполнять
+	/// всегда с нуля (Snapshot snapshot = {}) и только через запись полей
+	struct Snapshot
+	{
+		OverlayRecord overlay;
+		int panelCount;
+		int moduleCount;
+		PanelRecord panels[MAX_PANELS];
+		ModuleRecord modules[MAX_MODULES];
+	};
+
+	/// Результат чтения файла
+	enum class LoadResult : uint8_t
+	{
+		Loaded,        // текущий формат
+		Migrated,      // записи другой длины или старая версия - дополнены умолчаниями
+		Missing,       // файла нет (первый запуск)
+		Corrupt,       // обрезан, испорчен, не тот формат
+		Unsupported    // FILE_VERSION новее этой сборки
+	};
+
+	/// Статистика
+	struct Stats
+	{
+		LoadResult load = LoadResult::Missing;
+		bool writer = false;        // поток записи запущен (Load с путём)
+		bool pending = false;       // изменения ждут SAVE_DELAY или записи
+		uint32_t sequence = 0;      // номер последнего сохранения
+		uint64_t saves = 0;
+		uint64_t failures = 0;      // WriteFileAtomic вернул false
+		double lastSaveMs = 0.0;    // кодирование + запись, поток записи
+	};
+
+	/// Разбирает файл из памяти поверх snapshot (в нём уже умолчания): заголовок, размер,
+	/// контрольная сумма, затем записи. При ошибке snapshot не меняется
+	LoadResult Decode(const void* data, size_t size, Snapshot& snapshot, uint32_t* sequence = nullptr);
+
+	/// Кодирует snapshot в out (не меньше MAX_FILE_SIZE байт), возвращает размер файла
+	size_t Encode(const Snapshot& snapshot, uint32_t sequence, uint8_t* out);
+
+	/// Отображает файл в память и читает его поверх snapshot. Запоминает путь и запускает
+	/// поток записи: Corrupt/Missing файл будет записан при первом изменении, Unsupported
+	/// не трогается (настройки этой сессии не сохраняются)
+	LoadResult Load(const char* path, Snapshot& snapshot);
+
+	/// Текущее состояние (render thread, задача планировщика). Если оно отличается от прошлого -
+	/// отсчёт SAVE_DELAY начинается заново; по истечении копия уходит потоку записи.
+	/// Диска и ожидания на render thread нет
+	void Update(const Snapshot& current, double now);
+
+	/// Записывает несохранённые изменения сразу и останавливает поток записи. Ждёт выхода
+	/// из цикла потока, а не его завершения (можно из DllMain). processExit -
+	/// DLL_PROCESS_DETACH при завершении процесса: поток уже убит, запись - на вызывающем
+	void Shutdown(bool processExit = false);
+
+	/// Поиск записи по хэшу имени
+	const PanelRecord* FindPanel(const Snapshot& snapshot, uint32_t nameHash);
+	const ModuleRecord* FindModule(const Snapshot& snapshot, uint32_t nameHash);
+
+	/// Путь файла ("" до Load)
+	const char* GetPath();
+
+	/// Статистика
+	Stats GetStats();
+
+	/// Регистрирует команду консоли settings
+	void RegisterCommands();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Формат файла настроек оверлея (cubixdlc.settings рядом с DLL). Пишет и читает modules/settings.
+//
+//   FileHeader
+//   OverlayRecord                 - overlaySize байт
+//   PanelRecord[panelCount]       - по panelSize байт
+//   ModuleRecord[moduleCount]     - по moduleSize байт
+//
+// Все поля little-endian, записи читаются из отображения файла как есть.
+//
+// Эволюция формата: новые поля добавляются только в конец записи. Файл с записями короче
+// текущих (старая сборка) читается, недостающие поля берут значения по умолчанию; с записями
+// длиннее (новая сборка) - лишние поля пропускаются. Если меняется смысл существующего поля,
+// растёт FILE_VERSION и в settings.cpp добавляется шаг миграции со старой версии.
+
+namespace Settings
+{
+	constexpr uint32_t FILE_MAGIC = 0x54535843;   // "CXST"
+	constexpr uint32_t FILE_VERSION = 1;
+
+	/// Записей панелей и модулей в файле
+	constexpr int MAX_PANELS = 16;
+	constexpr int MAX_MODULES = 64;
+
+	struct FileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t fileSize;       // весь файл: обрезанный файл не принимается
+		uint32_t checksum;       // FNV-1a всего, что после заголовка
+		uint32_t sequence;       // номер сохранения
+		uint16_t overlaySize;    // размеры записей в этом файле
+		uint16_t panelSize;
+		uint16_t moduleSize;
+		uint16_t panelCount;
+		uint16_t moduleCount;
+		uint16_t reserved;
+	};
+
+	/// Настройки оверлея вне панелей (WatermarkSettings, HUDSettings)
+	struct OverlayRecord
+	{
+		uint8_t watermark;
+		uint8_t watermarkFPS;
+		uint8_t schedulerStats;
+		uint8_t memoryStats;
+		uint16_t menuKey;        // аккорд меню: virtual-key + Input::Modifier
+		uint8_t menuMods;
+		uint8_t reserved;
+	};
+
+	/// Панель ClickGUI. nameHash - HashName(имя категории)
+	struct PanelRecord
+	{
+		uint32_t nameHash;
+		float posX;
+		float posY;
+		float scroll;            // цель прокрутки
+	};
+
+	/// Модуль. nameHash - HashName(имя модуля, HashName(имя категории))
+	struct ModuleRecord
+	{
+		uint32_t nameHash;
+		uint8_t enabled;
+		uint8_t expanded;        // настройки раскрыты
+		uint16_t reserved;
+	};
+
+	/// Минимальные размеры записей: без nameHash запись не сопоставить
+	constexpr size_t MIN_PANEL_SIZE = sizeof(uint32_t);
+	constexpr size_t MIN_MODULE_SIZE = sizeof(uint32_t);
+
+	/// Максимальный размер файла текущей версии
+	constexpr size_t MAX_FILE_SIZE = sizeof(FileHeader) + sizeof(OverlayRecord) +
+		MAX_PANELS * sizeof(PanelRecord) + MAX_MODULES * sizeof(ModuleRecord);
+
+	/// FNV-1a. seed - продолжение хэша (имя модуля после имени категории)
+	inline uint32_t HashBytes(const void* data, size_t size, uint32_t seed = 2166136261u)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint32_t hash = seed;
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	inline uint32_t HashName(const char* name, uint32_t seed = 2166136261u)
+	{
+		uint32_t hash = seed;
+		for (; *name; name++)
+		{
+			hash ^= static_cast<uint8_t>(*name);
+			hash *= 16777619u;
+		}
+		// Разделитель, чтобы "ab" + "c" и "a" + "bc" не совпадали
+		hash ^= '/';
+		return hash * 16777619u;
+	}
+}
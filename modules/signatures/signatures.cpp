@@ -0,0 +1,819 @@
+#include "signatures.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include "../jobs/job_system.h"
+#include "../../platform/platform.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SIGNATURES_AVX2 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SIGNATURES_AVX2_TARGET
+#else
+#define SIGNATURES_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Signatures
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	constexpr uint32_t CACHE_MAGIC = 0x47495343;   // "CSIG"
+	constexpr uint32_t CACHE_VERSION = 1;
+
+	/// Поля PE-заголовка (без <windows.h>: образ разбирается и в бенчмарке)
+	constexpr uint16_t PE_DOS_MAGIC = 0x5A4D;            // "MZ"
+	constexpr uint32_t PE_NT_SIGNATURE = 0x00004550;     // "PE\0\0"
+	constexpr uint32_t PE_MAX_HEADER_OFFSET = 4096;
+	constexpr uint32_t PE_SECTION_HEADER_SIZE = 40;
+	constexpr uint32_t PE_SCN_MEM_EXECUTE = 0x20000000;
+
+	struct CacheFileHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t count;
+		uint32_t checksum;     // FNV-1a записей
+	};
+
+	struct CacheEntry
+	{
+		uint64_t fingerprint;  // 0 - пустая запись
+		uint64_t hash;
+		int64_t offset;
+		uint32_t count;
+		uint32_t reserved;
+	};
+
+	/// Кусок участка: позиции начала шаблонов [begin, end), чтение - до regionEnd
+	struct Chunk
+	{
+		size_t begin;
+		size_t end;
+		size_t regionEnd;
+	};
+
+	/// Группы для шаблонов, в отпечатке которых есть "??": такой байт проходит таблицы
+	/// группы всегда, поэтому эти шаблоны не смешиваются с остальными
+	constexpr int WILDCARD_BUCKETS = 2;
+
+	/// Открытая адресация, вдвое больше записей
+	constexpr uint32_t CACHE_TABLE_SIZE = MAX_CACHE_ENTRIES * 2;
+
+	static std::mutex g_Lock;   // кэш и статистика
+	static CacheEntry g_Cache[CACHE_TABLE_SIZE];
+	static int g_CacheCount = 0;
+	static Stats g_Stats;
+
+	static Backend g_Backend = HasAVX2() ? Backend::AVX2 : Backend::Scalar;
+
+	static const void* g_DefaultImage = nullptr;
+	static const char* g_DefaultImageName = "";
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	static uint64_t Hash64(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static int HexDigit(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+
+	// Насколько часто байт встречается в коде x64: чем меньше, тем реже срабатывает фильтр
+	static int ByteCost(uint8_t value, uint8_t mask)
+	{
+		if (!mask)
+			return 4;
+		switch (value)
+		{
+		case 0x00: case 0xFF: case 0xCC:
+			return 3;
+		case 0x48: case 0x8B: case 0x89: case 0x0F: case 0xE8: case 0x24: case 0x44:
+		case 0x4C: case 0x83: case 0x8D: case 0x85: case 0xC0: case 0x01: case 0x10:
+			return 2;
+		default:
+			return 0;
+		}
+	}
+
+	static int CountTrailingZeros(uint32_t value)
+	{
+#ifdef _MSC_VER
+		unsigned long index;
+		_BitScanForward(&index, value);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(value);
+#endif
+	}
+
+	static uint32_t Read32(const uint8_t* p)
+	{
+		uint32_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static uint16_t Read16(const uint8_t* p)
+	{
+		uint16_t value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	// Начало PE-заголовка (сигнатура "PE\0\0") или nullptr
+	static const uint8_t* FindNtHeaders(const void* image)
+	{
+		const uint8_t* base = static_cast<const uint8_t*>(image);
+		if (!base || Read16(base) != PE_DOS_MAGIC)
+			return nullptr;
+
+		uint32_t offset = Read32(base + 0x3C);
+		if (offset == 0 || offset > PE_MAX_HEADER_OFFSET || Read32(base + offset) != PE_NT_SIGNATURE)
+			return nullptr;
+		return base + offset;
+	}
+
+	static bool Equal(const uint8_t* data, const Pattern& pattern, size_t available)
+	{
+		// Байты за длиной шаблона имеют маску 0: сравниваем словами, если их можно прочитать
+		size_t words = (static_cast<size_t>(pattern.length) + 7) / 8;
+		if (available >= words * 8)
+		{
+			for (size_t w = 0; w < words; w++)
+			{
+				uint64_t value, bytes, mask;
+				memcpy(&value, data + w * 8, 8);
+				memcpy(&bytes, pattern.bytes + w * 8, 8);
+				memcpy(&mask, pattern.mask + w * 8, 8);
+				if ((value ^ bytes) & mask)
+					return false;
+			}
+			return true;
+		}
+
+		for (int i = 0; i < pattern.length; i++)
+		{
+			if ((data[i] ^ pattern.bytes[i]) & pattern.mask[i])
+				return false;
+		}
+		return true;
+	}
+
+	// Фильтр пропустил позицию q опорной пары: проверяем шаблоны отмеченных групп
+	static void Verify(const PatternSet& set, const uint8_t* base, size_t q, uint32_t bits, const Chunk& chunk, Match* results)
+	{
+		while (bits)
+		{
+			int bucket = CountTrailingZeros(bits);
+			bits &= bits - 1;
+			for (int index : set.buckets[bucket])
+			{
+				const Pattern& pattern = set.patterns[index];
+				if (q < static_cast<size_t>(pattern.anchor))
+					continue;
+
+				size_t start = q - pattern.anchor;
+				if (start < chunk.begin || start >= chunk.end || start + pattern.length > chunk.regionEnd)
+					continue;
+				if (!Equal(base + start, pattern, chunk.regionEnd - start))
+					continue;
+
+				Match& match = results[index];
+				if (match.offset < 0 || static_cast<int64_t>(start) < match.offset)
+					match.offset = static_cast<int64_t>(start);
+				match.count++;
+			}
+		}
+	}
+
+	// Позиции опорной пары, которые может дать кусок: [begin, end + maxAnchor), пара целиком в участке
+	static size_t AnchorEnd(const PatternSet& set, const Chunk& chunk)
+	{
+		return std::min(chunk.end + set.maxAnchor, chunk.regionEnd - 1);
+	}
+
+	static uint64_t ScanScalar(const PatternSet& set, const uint8_t* base, const Chunk& chunk, size_t q, Match* results)
+	{
+		uint64_t candidates = 0;
+		const uint16_t* pairs = set.pairs.data();
+		for (size_t end = AnchorEnd(set, chunk); q < end; q++)
+		{
+			uint16_t bits = pairs[base[q] | (base[q + 1] << 8)];
+			if (bits)
+			{
+				candidates++;
+				Verify(set, base, q, bits, chunk, results);
+			}
+		}
+		return candidates;
+	}
+
+#ifdef SIGNATURES_AVX2
+	// Маска групп для 32 позиций: полубайты байта отпечатка через vpshufb (как фильтр Teddy)
+	SIGNATURES_AVX2_TARGET static inline __m256i FingerprintByte(const uint8_t* data, __m256i loTable, __m256i hiTable, __m256i nibble)
+	{
+		__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+		return _mm256_and_si256(
+			_mm256_shuffle_epi8(loTable, _mm256_and_si256(v, nibble)),
+			_mm256_shuffle_epi8(hiTable, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+	}
+
+	SIGNATURES_AVX2_TARGET static inline __m256i LoadTable(const uint8_t* table)
+	{
+		return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+	}
+
+	// 32 позиции за шаг по FINGERPRINT_LENGTH байтам в каждом слое групп; прошедшие фильтр
+	// позиции подтверждаются точной парой и проверяются целиком. Таблицы загружаются до цикла:
+	// на слой - 8 vpshufb на 32 позиции, поэтому набор до 8 групп просматривает один слой
+	template<int PLANES>
+	SIGNATURES_AVX2_TARGET static uint64_t ScanAVX2(const PatternSet& set, const uint8_t* base, const Chunk& chunk, Match* results)
+	{
+		static_assert(FINGERPRINT_LENGTH == 4, "ScanAVX2 combines four fingerprint bytes");
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+		const __m256i zero = _mm256_setzero_si256();
+		const uint16_t* pairs = set.pairs.data();
+
+		__m256i lo[PLANES][FINGERPRINT_LENGTH], hi[PLANES][FINGERPRINT_LENGTH];
+		for (int plane = 0; plane < PLANES; plane++)
+		{
+			for (int k = 0; k < FINGERPRINT_LENGTH; k++)
+			{
+				lo[plane][k] = LoadTable(set.lo[plane][k]);
+				hi[plane][k] = LoadTable(set.hi[plane][k]);
+			}
+		}
+
+		uint64_t candidates = 0;
+		size_t q = chunk.begin;
+		for (size_t end = AnchorEnd(set, chunk); q + 32 <= end && q + 32 + FINGERPRINT_LENGTH - 1 <= chunk.regionEnd; q += 32)
+		{
+			const uint8_t* data = base + q;
+			__m256i masks[PLANES];
+			__m256i any = zero;
+			for (int plane = 0; plane < PLANES; plane++)
+			{
+				masks[plane] = _mm256_and_si256(
+					_mm256_and_si256(FingerprintByte(data, lo[plane][0], hi[plane][0], nibble),
+						FingerprintByte(data + 1, lo[plane][1], hi[plane][1], nibble)),
+					_mm256_and_si256(FingerprintByte(data + 2, lo[plane][2], hi[plane][2], nibble),
+						FingerprintByte(data + 3, lo[plane][3], hi[plane][3], nibble)));
+				any = _mm256_or_si256(any, masks[plane]);
+			}
+
+			uint32_t hits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(any, zero)));
+			if (!hits)
+				continue;
+
+			alignas(32) uint8_t bits[PLANES][32];
+			for (int plane = 0; plane < PLANES; plane++)
+				_mm256_store_si256(reinterpret_cast<__m256i*>(bits[plane]), masks[plane]);
+			while (hits)
+			{
+				int i = CountTrailingZeros(hits);
+				hits &= hits - 1;
+				uint32_t found = bits[0][i];
+				if (PLANES > 1)
+					found |= bits[PLANES - 1][i] << 8;
+				uint32_t confirmed = found & pairs[data[i] | (data[i + 1] << 8)];
+				if (confirmed)
+				{
+					candidates++;
+					Verify(set, base, q + i, confirmed, chunk, results);
+				}
+			}
+		}
+
+		return candidates + ScanScalar(set, base, chunk, q, results);
+	}
+#endif
+
+	static uint64_t ScanChunk(const PatternSet& set, const uint8_t* base, const Chunk& chunk, Backend backend, Match* results)
+	{
+#ifdef SIGNATURES_AVX2
+		if (backend == Backend::AVX2)
+			return set.planes > 1 ? ScanAVX2<2>(set, base, chunk, results) : ScanAVX2<1>(set, base, chunk, results);
+#endif
+		return ScanScalar(set, base, chunk, chunk.begin, results);
+	}
+
+	static uint32_t CacheSlot(uint64_t fingerprint, uint64_t hash)
+	{
+		uint64_t key = (fingerprint ^ (hash * 0x9E3779B97F4A7C15ull)) * 0xFF51AFD7ED558CCDull;
+		return static_cast<uint32_t>(key >> 32) & (CACHE_TABLE_SIZE - 1);
+	}
+
+	// Под g_Lock. Запись с ключом или пустая, куда его можно положить (nullptr - таблица полна)
+	static CacheEntry* FindEntry(uint64_t fingerprint, uint64_t hash, bool insert)
+	{
+		for (uint32_t i = CacheSlot(fingerprint, hash), probes = 0; probes < CACHE_TABLE_SIZE; i = (i + 1) & (CACHE_TABLE_SIZE - 1), probes++)
+		{
+			CacheEntry& entry = g_Cache[i];
+			if (entry.fingerprint == fingerprint && entry.hash == hash)
+				return &entry;
+			if (entry.fingerprint == 0)
+			{
+				if (!insert || g_CacheCount >= MAX_CACHE_ENTRIES)
+					return nullptr;
+				entry.fingerprint = fingerprint;
+				entry.hash = hash;
+				g_CacheCount++;
+				return &entry;
+			}
+		}
+		return nullptr;
+	}
+
+	static void SetAll(uint8_t* table, uint8_t bit)
+	{
+		for (int i = 0; i < 16; i++)
+			table[i] |= bit;
+	}
+
+	// Опорная пара шаблона; "??" - 0x100
+	static uint32_t PairKey(const Pattern& pattern)
+	{
+		uint32_t b0 = pattern.mask[pattern.anchor] ? pattern.bytes[pattern.anchor] : 0x100u;
+		uint32_t b1 = pattern.mask[pattern.anchor + 1] ? pattern.bytes[pattern.anchor + 1] : 0x100u;
+		return b0 | (b1 << 9);
+	}
+
+	// Раскладывает шаблоны по группам заново: число слоёв зависит от размера набора.
+	// Одна и та же пара - одна группа, разные пары - по кругу, чтобы группы были поровну
+	static void Rebuild(PatternSet& set)
+	{
+		set.planes = set.patterns.size() > 8 ? 2 : 1;
+		set.maxAnchor = 0;
+		for (auto& bucket : set.buckets)
+			bucket.clear();
+		memset(set.lo, 0, sizeof(set.lo));
+		memset(set.hi, 0, sizeof(set.hi));
+		set.pairs.assign(65536, 0);
+
+		bool anyWildcard = false;
+		std::vector<bool> exact(set.patterns.size());
+		for (size_t index = 0; index < set.patterns.size(); index++)
+		{
+			const Pattern& pattern = set.patterns[index];
+			bool fixed = pattern.anchor + FINGERPRINT_LENGTH <= pattern.length;
+			for (int k = 0; k < FINGERPRINT_LENGTH && fixed; k++)
+				fixed = pattern.mask[pattern.anchor + k] != 0;
+			exact[index] = fixed;
+			anyWildcard |= !fixed;
+		}
+
+		const int bucketCount = set.planes * 8;
+		const int wildcardBuckets = anyWildcard ? std::min(WILDCARD_BUCKETS, set.planes) : 0;
+		std::vector<uint32_t> keys[2];   // различные пары точных и неточных отпечатков
+		for (size_t index = 0; index < set.patterns.size(); index++)
+		{
+			const Pattern& pattern = set.patterns[index];
+			const uint32_t key = PairKey(pattern);
+			std::vector<uint32_t>& seen = keys[exact[index] ? 0 : 1];
+			size_t order = std::find(seen.begin(), seen.end(), key) - seen.begin();
+			if (order == seen.size())
+				seen.push_back(key);
+
+			int bucket = exact[index] ? static_cast<int>(order % (bucketCount - wildcardBuckets))
+				: bucketCount - wildcardBuckets + static_cast<int>(order % wildcardBuckets);
+			const int plane = bucket >> 3;
+			const uint8_t bit = static_cast<uint8_t>(1u << (bucket & 7));
+
+			for (int k = 0; k < FINGERPRINT_LENGTH; k++)
+			{
+				int i = pattern.anchor + k;
+				if (i < pattern.length && pattern.mask[i])
+				{
+					set.lo[plane][k][pattern.bytes[i] & 15] |= bit;
+					set.hi[plane][k][pattern.bytes[i] >> 4] |= bit;
+				}
+				else
+				{
+					SetAll(set.lo[plane][k], bit);
+					SetAll(set.hi[plane][k], bit);
+				}
+			}
+
+			const uint8_t b0 = pattern.bytes[pattern.anchor], m0 = pattern.mask[pattern.anchor];
+			const uint8_t b1 = pattern.bytes[pattern.anchor + 1], m1 = pattern.mask[pattern.anchor + 1];
+			for (int x = m0 ? b0 : 0; x <= (m0 ? b0 : 255); x++)
+				for (int y = m1 ? b1 : 0; y <= (m1 ? b1 : 255); y++)
+					set.pairs[x | (y << 8)] |= static_cast<uint16_t>(1u << bucket);
+
+			set.maxAnchor = std::max(set.maxAnchor, pattern.anchor);
+			set.buckets[bucket].push_back(static_cast<int>(index));
+		}
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	bool Compile(const char* ida, Pattern& out)
+	{
+		Pattern pattern;
+		bool fixed = false;
+		const char* p = ida ? ida : "";
+		while (*p)
+		{
+			if (*p == ' ' || *p == '\t')
+			{
+				p++;
+				continue;
+			}
+			if (pattern.length >= MAX_PATTERN_LENGTH)
+				return false;
+
+			if (*p == '?')
+			{
+				p += (p[1] == '?') ? 2 : 1;
+			}
+			else
+			{
+				int high = HexDigit(p[0]);
+				int low = high >= 0 ? HexDigit(p[1]) : -1;
+				if (low < 0)
+					return false;
+				pattern.bytes[pattern.length] = static_cast<uint8_t>(high << 4 | low);
+				pattern.mask[pattern.length] = 0xFF;
+				fixed = true;
+				p += 2;
+			}
+			if (*p && *p != ' ' && *p != '\t')
+				return false;
+			pattern.length++;
+		}
+		if (!fixed || pattern.length < 2)
+			return false;
+
+		// Отпечаток - самые редкие FINGERPRINT_LENGTH байт подряд (за концом шаблона - "??"),
+		// при равенстве - с более редкой опорной парой. Пара из двух "??" не выбирается
+		int bestCost = 1 << 30;
+		for (int i = 0; i + 1 < pattern.length; i++)
+		{
+			int pairCost = ByteCost(pattern.bytes[i], pattern.mask[i]) + ByteCost(pattern.bytes[i + 1], pattern.mask[i + 1]);
+			if (pairCost == 8)
+				continue;
+			int cost = pairCost * 2;
+			for (int k = 2; k < FINGERPRINT_LENGTH; k++)
+				cost += i + k < pattern.length ? ByteCost(pattern.bytes[i + k], pattern.mask[i + k]) : 4;
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				pattern.anchor = i;
+			}
+		}
+
+		pattern.hash = Hash64(pattern.bytes, pattern.length, Hash64(pattern.mask, pattern.length));
+		out = pattern;
+		return true;
+	}
+
+	int Add(PatternSet& set, const char* ida)
+	{
+		Pattern pattern;
+		if (!Compile(ida, pattern))
+			return -1;
+
+		set.patterns.push_back(pattern);
+		Rebuild(set);
+		return static_cast<int>(set.patterns.size()) - 1;
+	}
+
+	bool HasAVX2()
+	{
+#if defined(SIGNATURES_AVX2) && defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		const int OSXSAVE = 1 << 27, AVX = 1 << 28;
+		if ((info[2] & (OSXSAVE | AVX)) != (OSXSAVE | AVX) || (_xgetbv(0) & 6) != 6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#elif defined(SIGNATURES_AVX2)
+		__builtin_cpu_init();   // вызывается и из статической инициализации g_Backend
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+
+	bool SetBackend(Backend backend)
+	{
+		if (backend == Backend::AVX2 && !HasAVX2())
+			return false;
+		g_Backend = backend;
+		return true;
+	}
+
+	Backend GetBackend()
+	{
+		return g_Backend;
+	}
+
+	void Scan(const PatternSet& set, const uint8_t* base, const Region* regions, int regionCount, Match* results)
+	{
+		const size_t patternCount = set.patterns.size();
+		for (size_t i = 0; i < patternCount; i++)
+			results[i] = Match();
+
+		std::vector<Chunk> chunks;
+		uint64_t bytes = 0;
+		for (int r = 0; r < regionCount; r++)
+		{
+			size_t regionEnd = regions[r].offset + regions[r].size;
+			for (size_t begin = regions[r].offset; begin < regionEnd; begin += CHUNK_SIZE)
+				chunks.push_back({ begin, std::min(begin + CHUNK_SIZE, regionEnd), regionEnd });
+			bytes += regions[r].size;
+		}
+		if (patternCount == 0 || chunks.empty())
+			return;
+
+		// Совпадения и кандидаты - по куску, сводятся после ParallelFor
+		std::vector<Match> local(chunks.size() * patternCount);
+		std::vector<uint64_t> candidates(chunks.size());
+		const Backend backend = g_Backend;
+
+		auto start = std::chrono::steady_clock::now();
+		Jobs::ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+		{
+			for (size_t c = begin; c < end; c++)
+				candidates[c] = ScanChunk(set, base, chunks[c], backend, &local[c * patternCount]);
+		});
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		uint64_t totalCandidates = 0, totalMatches = 0;
+		for (size_t c = 0; c < chunks.size(); c++)
+		{
+			totalCandidates += candidates[c];
+			for (size_t i = 0; i < patternCount; i++)
+			{
+				const Match& match = local[c * patternCount + i];
+				if (!match.count)
+					continue;
+				if (results[i].offset < 0 || match.offset < results[i].offset)
+					results[i].offset = match.offset;
+				results[i].count += match.count;
+				totalMatches += match.count;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(g_Lock);
+		g_Stats.scans++;
+		g_Stats.bytes += bytes;
+		g_Stats.candidates += totalCandidates;
+		g_Stats.matches += totalMatches;
+		g_Stats.lastMs = ms;
+		g_Stats.lastGBps = ms > 0.0 ? bytes / (ms * 1e6) : 0.0;
+	}
+
+	uint64_t ImageFingerprint(const void* image)
+	{
+		const uint8_t* nt = FindNtHeaders(image);
+		if (!nt)
+			return 0;
+
+		// FileHeader: Machine, NumberOfSections, TimeDateStamp; OptionalHeader: SizeOfImage, CheckSum
+		const uint8_t* fileHeader = nt + 4;
+		const uint8_t* optionalHeader = fileHeader + 20;
+		uint32_t fields[5] = { Read16(fileHeader), Read16(fileHeader + 2), Read32(fileHeader + 4),
+			Read32(optionalHeader + 56), Read32(optionalHeader + 64) };
+		uint64_t fingerprint = Hash64(fields, sizeof(fields));
+		return fingerprint ? fingerprint : 1;
+	}
+
+	bool ScanImage(const PatternSet& set, const void* image, Match* results)
+	{
+		uint64_t fingerprint = ImageFingerprint(image);
+		if (!fingerprint)
+			return false;
+
+		{
+			std::lock_guard<std::mutex> lock(g_Lock);
+			bool cached = !set.patterns.empty();
+			for (size_t i = 0; i < set.patterns.size() && cached; i++)
+			{
+				const CacheEntry* entry = FindEntry(fingerprint, set.patterns[i].hash, false);
+				cached = entry != nullptr;
+				if (entry)
+					results[i] = Match{ entry->offset, entry->count };
+			}
+			if (cached)
+			{
+				g_Stats.cacheHits++;
+				return true;
+			}
+			g_Stats.cacheMisses++;
+		}
+
+		// Исполняемые секции в пределах SizeOfImage
+		const uint8_t* nt = FindNtHeaders(image);
+		const uint8_t* optionalHeader = nt + 24;
+		uint32_t sizeOfImage = Read32(optionalHeader + 56);
+		uint16_t sectionCount = Read16(nt + 6);
+		const uint8_t* section = optionalHeader + Read16(nt + 20);
+
+		std::vector<Region> regions;
+		for (uint16_t s = 0; s < sectionCount; s++, section += PE_SECTION_HEADER_SIZE)
+		{
+			uint32_t virtualSize = Read32(section + 8);
+			uint32_t virtualAddress = Read32(section + 12);
+			uint32_t characteristics = Read32(section + 36);
+			if (!(characteristics & PE_SCN_MEM_EXECUTE) || virtualAddress >= sizeOfImage)
+				continue;
+			if (!virtualSize)
+				virtualSize = Read32(section + 16);   // SizeOfRawData
+			regions.push_back({ virtualAddress, std::min<size_t>(virtualSize, sizeOfImage - virtualAddress) });
+		}
+
+		Scan(set, static_cast<const uint8_t*>(image), regions.data(), static_cast<int>(regions.size()), results);
+
+		// Ненайденные шаблоны тоже запоминаются: у того же модуля их не будет и дальше
+		std::lock_guard<std::mutex> lock(g_Lock);
+		for (size_t i = 0; i < set.patterns.size(); i++)
+		{
+			if (CacheEntry* entry = FindEntry(fingerprint, set.patterns[i].hash, true))
+			{
+				entry->offset = results[i].offset;
+				entry->count = results[i].count;
+			}
+		}
+		return true;
+	}
+
+	bool LoadCache(const char* path)
+	{
+		MappedFile file;
+		if (!MapFile(path, &file))
+			return false;
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(file.data);
+		CacheFileHeader header;
+		bool valid = file.size >= sizeof(header);
+		if (valid)
+		{
+			memcpy(&header, bytes, sizeof(header));
+			size_t payload = static_cast<size_t>(header.count) * sizeof(CacheEntry);
+			valid = header.magic == CACHE_MAGIC && header.version == CACHE_VERSION &&
+				header.count <= MAX_CACHE_ENTRIES && file.size == sizeof(header) + payload &&
+				static_cast<uint32_t>(Hash64(bytes + sizeof(header), payload)) == header.checksum;
+		}
+
+		if (valid)
+		{
+			std::lock_guard<std::mutex> lock(g_Lock);
+			for (uint32_t i = 0; i < header.count; i++)
+			{
+				CacheEntry record;
+				memcpy(&record, bytes + sizeof(header) + i * sizeof(CacheEntry), sizeof(record));
+				if (!record.fingerprint)
+					continue;
+				if (CacheEntry* entry = FindEntry(record.fingerprint, record.hash, true))
+					*entry = record;
+			}
+		}
+
+		UnmapFile(&file);
+		return valid;
+	}
+
+	bool SaveCache(const char* path)
+	{
+		std::vector<uint8_t> bytes(sizeof(CacheFileHeader));
+		{
+			std::lock_guard<std::mutex> lock(g_Lock);
+			bytes.reserve(sizeof(CacheFileHeader) + g_CacheCount * sizeof(CacheEntry));
+			for (const CacheEntry& entry : g_Cache)
+			{
+				if (!entry.fingerprint)
+					continue;
+				const uint8_t* record = reinterpret_cast<const uint8_t*>(&entry);
+				bytes.insert(bytes.end(), record, record + sizeof(entry));
+			}
+		}
+
+		CacheFileHeader header;
+		header.magic = CACHE_MAGIC;
+		header.version = CACHE_VERSION;
+		header.count = static_cast<uint32_t>((bytes.size() - sizeof(header)) / sizeof(CacheEntry));
+		header.checksum = static_cast<uint32_t>(Hash64(bytes.data() + sizeof(header), bytes.size() - sizeof(header)));
+		memcpy(bytes.data(), &header, sizeof(header));
+		return WriteFileAtomic(path, bytes.data(), bytes.size());
+	}
+
+	void ClearCache()
+	{
+		std::lock_guard<std::mutex> lock(g_Lock);
+		memset(g_Cache, 0, sizeof(g_Cache));
+		g_CacheCount = 0;
+	}
+
+	int GetCacheSize()
+	{
+		std::lock_guard<std::mutex> lock(g_Lock);
+		return g_CacheCount;
+	}
+
+	void SetDefaultImage(const void* image, const char* name)
+	{
+		g_DefaultImage = image;
+		g_DefaultImageName = name ? name : "";
+	}
+
+	const void* GetDefaultImage()
+	{
+		return g_DefaultImage;
+	}
+
+	const char* GetDefaultImageName()
+	{
+		return g_DefaultImageName;
+	}
+
+	Stats GetStats()
+	{
+		std::lock_guard<std::mutex> lock(g_Lock);
+		return g_Stats;
+	}
+
+	void ResetStats()
+	{
+		std::lock_guard<std::mutex> lock(g_Lock);
+		g_Stats = Stats();
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void SigCommand(const Console::Commands::Args&, void*)
+	{
+		Stats stats = GetStats();
+		Console::Log("Signatures: %s, %llu scan(s), %.1f MB, last %.2f ms (%.2f GB/s); %llu candidates, %llu matches",
+			GetBackend() == Backend::AVX2 ? "AVX2" : "scalar",
+			static_cast<unsigned long long>(stats.scans), stats.bytes / (1024.0 * 1024.0), stats.lastMs, stats.lastGBps,
+			static_cast<unsigned long long>(stats.candidates), static_cast<unsigned long long>(stats.matches));
+		Console::Log("Cache: %d of %d entries, %llu hits, %llu misses", GetCacheSize(), MAX_CACHE_ENTRIES,
+			static_cast<unsigned long long>(stats.cacheHits), static_cast<unsigned long long>(stats.cacheMisses));
+	}
+
+	static void SigScanCommand(const Console::Commands::Args& args, void*)
+	{
+		const void* image = GetDefaultImage();
+		if (!image)
+		{
+			Console::Error("sig.scan: no module to scan");
+			return;
+		}
+
+		PatternSet set;
+		if (Add(set, args.GetString(0)) < 0)
+		{
+			Console::Error("sig.scan: bad pattern (hex bytes and ??, 2 to %d bytes)", MAX_PATTERN_LENGTH);
+			return;
+		}
+
+		Match match;
+		if (!ScanImage(set, image, &match))
+		{
+			Console::Error("sig.scan: %s is not a PE image", GetDefaultImageName());
+			return;
+		}
+		if (match.offset < 0)
+			Console::Log("%s: not found", GetDefaultImageName());
+		else
+			Console::Log("%s+0x%llX (%u match%s)", GetDefaultImageName(),
+				static_cast<unsigned long long>(match.offset), match.count, match.count == 1 ? "" : "es");
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "sig", "", "signature scanner: throughput and result cache", SigCommand });
+		Console::Commands::Register({ "sig.scan", "s", "find an IDA-style byte pattern (quoted, ?? - any byte) in the game module", SigScanCommand });
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Signatures
+{
+	/// Максимальная длина шаблона в байтах
+	constexpr int MAX_PATTERN_LENGTH = 64;
+
+	/// Групп в общем фильтре: шаблоны с одной опорной парой байт попадают в одну группу.
+	/// До двух слоёв по 8 групп (байт маски на слой для vpshufb): чем меньше шаблонов в группе,
+	/// тем реже случайные байты проходят её полубайтовые таблицы. Второй слой - только
+	/// для наборов больше 8 шаблонов: каждый слой удваивает работу фильтра
+	constexpr int BUCKET_COUNT = 16;
+
+	/// Байт от опорной пары, которые проверяет фильтр AVX2 (за концом шаблона - любые)
+	constexpr int FINGERPRINT_LENGTH = 4;
+
+	/// Кусок секции на одну задачу Jobs::ParallelFor
+	constexpr size_t CHUNK_SIZE = 1 << 20;
+
+	/// Записей в кэше результатов (на все модули и шаблоны)
+	constexpr int MAX_CACHE_ENTRIES = 4096;
+
+	/// Скомпилированный шаблон в стиле IDA: "48 8B 05 ?? ?? ?? ?? E8 ? ? ? ?"
+	struct Pattern
+	{
+		uint8_t bytes[MAX_PATTERN_LENGTH] = {};
+		uint8_t mask[MAX_PATTERN_LENGTH] = {};   // 0xFF - байт проверяется, 0 - "??"
+		int length = 0;
+		int anchor = 0;          // смещение опорной пары байт (с неё начинается отпечаток фильтра)
+		uint64_t hash = 0;       // ключ кэша: байты и маска
+	};
+
+	/// Набор шаблонов, собранный в один фильтр: модуль просматривается один раз для всех
+	struct PatternSet
+	{
+		std::vector<Pattern> patterns;
+		std::vector<int> buckets[BUCKET_COUNT];   // индексы шаблонов группы
+		int maxAnchor = 0;
+		int planes = 1;                           // слоёв групп в фильтре AVX2
+
+		// Бит группы, если байты с этой позиции могут быть отпечатком её шаблона.
+		// Полубайты каждого байта отпечатка - для vpshufb (AVX2), точные пары - для
+		// скалярного пути и подтверждения кандидатов AVX2
+		uint8_t lo[2][FINGERPRINT_LENGTH][16] = {};   // [слой][байт отпечатка][полубайт]
+		uint8_t hi[2][FINGERPRINT_LENGTH][16] = {};
+		std::vector<uint16_t> pairs;
+	};
+
+	/// Первое (наименьшее) совпадение шаблона и число всех совпадений
+	struct Match
+	{
+		int64_t offset = -1;     // от начала просмотренной памяти, -1 - не найден
+		uint32_t count = 0;
+	};
+
+	/// Участок памяти [offset, offset + size) относительно base
+	struct Region
+	{
+		size_t offset = 0;
+		size_t size = 0;
+	};
+
+	enum class Backend
+	{
+		Scalar,
+		AVX2
+	};
+
+	/// Статистика
+	struct Stats
+	{
+		uint64_t scans = 0;
+		uint64_t bytes = 0;          // просмотрено всего
+		uint64_t candidates = 0;     // позиций, прошедших фильтр (проверены целиком)
+		uint64_t matches = 0;
+		uint64_t cacheHits = 0;      // ScanImage без просмотра
+		uint64_t cacheMisses = 0;
+		double lastMs = 0.0;
+		double lastGBps = 0.0;
+	};
+
+	/// Разбирает шаблон. Нужен хотя бы один проверяемый байт; "?" и "??" - любой байт
+	bool Compile(const char* ida, Pattern& out);
+
+	/// Добавляет шаблон в набор. Индекс шаблона или -1 (шаблон не разобрался)
+	int Add(PatternSet& set, const char* ida);
+
+	/// Поддерживает ли процессор AVX2
+	bool HasAVX2();
+
+	/// По умолчанию - AVX2, если он есть. false - бэкенд недоступен
+	bool SetBackend(Backend backend);
+	Backend GetBackend();
+
+	/// Просматривает участки один раз для всех шаблонов набора, куски по CHUNK_SIZE
+	/// раздаются Jobs::ParallelFor. results - по одному на шаблон
+	void Scan(const PatternSet& set, const uint8_t* base, const Region* regions, int regionCount, Match* results);
+
+	/// Отпечаток PE-образа в памяти (TimeDateStamp, SizeOfImage, CheckSum); 0 - не PE
+	uint64_t ImageFingerprint(const void* image);
+
+	/// Исполняемые секции загруженного PE-образа; смещения - от начала образа.
+	/// Результаты кэшируются по отпечатку модуля и хэшу шаблона
+	bool ScanImage(const PatternSet& set, const void* image, Match* results);
+
+	/// Кэш на диске: между запусками игры тот же GameAssembly не просматривается заново
+	bool LoadCache(const char* path);
+	bool SaveCache(const char* path);
+	void ClearCache();
+	int GetCacheSize();
+
+	/// Образ для команды sig.scan (GameAssembly в DLL; в бенчмарке не задан)
+	void SetDefaultImage(const void* image, const char* name);
+	const void* GetDefaultImage();
+	const char* GetDefaultImageName();
+
+	Stats GetStats();
+	void ResetStats();
+
+	/// Регистрирует команды консоли sig и sig.scan
+	void RegisterCommands();
+}
@@ -0,0 +1,275 @@
+#include "text_cache.h"
+#include "../console/console.h"
+#include "../console/commands.h"
+#include "../../deps/imgui/imgui_internal.h"
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+
+namespace Text
+{
+	// ============================================================================
+	// ВНУТРЕННИЕ ПЕРЕМЕННЫЕ
+	// ============================================================================
+
+	static const int PROBE_LENGTH = 8;
+
+	// Глиф относительно точки начала строки
+	struct Quad
+	{
+		float x1, y1, x2, y2;
+		float u1, v1, u2, v2;
+		bool colored;   // цветной глиф рисуется без тонирования
+	};
+
+	struct Entry
+	{
+		uint64_t hash = 0;
+		ImFont* font = nullptr;
+		float size = 0.0f;
+		size_t length = 0;
+		int lastUsedFrame = 0;
+
+		bool measured = false;
+		ImVec2 extent;
+
+		// Квады действительны, пока не сменились запечённый шрифт и текстура атласа
+		bool built = false;
+		ImFontBaked* baked = nullptr;
+		int textureId = 0;
+		ImVector<Quad> quads;
+	};
+
+	static Entry g_Entries[CACHE_SIZE];
+	static CacheStats g_Stats;
+
+	// ============================================================================
+	// ВСПОМОГАТЕЛЬНЫЕ ФУНКЦИИ
+	// ============================================================================
+
+	// FNV-1a, заодно считает длину
+	static uint64_t HashString(const char* text, size_t& length)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		const char* p = text;
+		for (; *p; p++)
+		{
+			hash ^= static_cast<unsigned char>(*p);
+			hash *= 1099511628211ull;
+		}
+		length = static_cast<size_t>(p - text);
+		return hash;
+	}
+
+	// Запись для строки. Если строки нет, под неё отдаётся самая старая запись окна
+	static Entry& FindEntry(ImFont* font, float size, const char* text)
+	{
+		size_t length;
+		uint64_t hash = HashString(text, length);
+		uint64_t mixed = hash ^ (reinterpret_cast<uintptr_t>(font) * 0x9E3779B97F4A7C15ull);
+		int frame = ImGui::GetFrameCount();
+
+		size_t start = static_cast<size_t>(mixed ^ (mixed >> 29)) % CACHE_SIZE;
+		Entry* victim = nullptr;
+		for (int i = 0; i < PROBE_LENGTH; i++)
+		{
+			Entry& entry = g_Entries[(start + i) % CACHE_SIZE];
+			if (entry.font == font && entry.hash == hash && entry.size == size && entry.length == length)
+			{
+				g_Stats.hits++;
+				entry.lastUsedFrame = frame;
+				return entry;
+			}
+
+			if (!victim || !entry.font || (victim->font && entry.lastUsedFrame < victim->lastUsedFrame))
+				victim = &entry;
+		}
+
+		g_Stats.misses++;
+		if (victim->font)
+			g_Stats.evictions++;
+		else
+			g_Stats.entries++;
+
+		victim->hash = hash;
+		victim->font = font;
+		victim->size = size;
+		victim->length = length;
+		victim->lastUsedFrame = frame;
+		victim->measured = false;
+		victim->built = false;
+		victim->quads.resize(0);
+		return *victim;
+	}
+
+	// Раскладка глифов - та же, что в ImFont::RenderText (без переноса и обрезки)
+	static void BuildQuads(Entry& entry, ImFontBaked* baked, const char* text)
+	{
+		entry.quads.resize(0);
+		const float scale = entry.size / baked->Size;
+		const char* end = text + entry.length;
+		float x = 0.0f;
+		float y = 0.0f;
+
+		for (const char* s = text; s < end;)
+		{
+			unsigned int c = static_cast<unsigned char>(*s);
+			if (c < 0x80)
+				s += 1;
+			else
+				s += ImTextCharFromUtf8(&c, s, end);
+
+			if (c == '\n')
+			{
+				x = 0.0f;
+				y += entry.size;
+				continue;
+			}
+			if (c == '\r')
+				continue;
+
+			const ImFontGlyph* glyph = baked->FindGlyph(static_cast<ImWchar>(c));
+			if (glyph->Visible)
+			{
+				Quad quad;
+				quad.x1 = x + glyph->X0 * scale;
+				quad.x2 = x + glyph->X1 * scale;
+				quad.y1 = y + glyph->Y0 * scale;
+				quad.y2 = y + glyph->Y1 * scale;
+				quad.u1 = glyph->U0;
+				quad.v1 = glyph->V0;
+				quad.u2 = glyph->U1;
+				quad.v2 = glyph->V1;
+				quad.colored = glyph->Colored != 0;
+				entry.quads.push_back(quad);
+			}
+			x += glyph->AdvanceX * scale;
+		}
+	}
+
+	// ============================================================================
+	// РЕАЛИЗАЦИЯ
+	// ============================================================================
+
+	ImVec2 Measure(ImFont* font, float size, const char* text)
+	{
+		if (!font || !text)
+			return ImVec2(0.0f, 0.0f);
+
+		Entry& entry = FindEntry(font, size, text);
+		if (!entry.measured)
+		{
+			entry.extent = font->CalcTextSizeA(size, FLT_MAX, 0.0f, text);
+			entry.measured = true;
+		}
+		return entry.extent;
+	}
+
+	void Draw(ImDrawList* drawList, ImFont* font, float size, const ImVec2& pos, ImU32 col, const char* text)
+	{
+		if ((col & IM_COL32_A_MASK) == 0 || !drawList || !font || !text || !text[0])
+			return;
+
+		Entry& entry = FindEntry(font, size, text);
+
+		// GetFontBaked заодно отмечает размер как используемый, иначе атлас может его выгрузить
+		ImFontBaked* baked = font->GetFontBaked(size);
+		if (!baked)
+			return;
+
+		ImFontAtlas* atlas = font->OwnerAtlas;
+		if (!entry.built || entry.baked != baked || entry.textureId != atlas->TexData->UniqueID)
+		{
+			if (entry.built)
+				g_Stats.rebuilds++;
+
+			// Загрузка новых глифов может пересоздать текстуру - штамп берётся после
+			BuildQuads(entry, baked, text);
+			entry.built = true;
+			entry.baked = baked;
+			entry.textureId = atlas->TexData->UniqueID;
+		}
+
+		int count = entry.quads.Size;
+		if (count == 0)
+			return;
+
+		// Выравнивание по пикселям, как в RenderText
+		const float x = IM_TRUNC(pos.x);
+		const float y = IM_TRUNC(pos.y);
+		const ImU32 colUntinted = col | ~IM_COL32_A_MASK;
+
+		drawList->PrimReserve(count * 6, count * 4);
+		ImDrawVert* vtx = drawList->_VtxWritePtr;
+		ImDrawIdx* idx = drawList->_IdxWritePtr;
+		unsigned int index = drawList->_VtxCurrentIdx;
+
+		for (int i = 0; i < count; i++)
+		{
+			const Quad& quad = entry.quads[i];
+			ImU32 glyphCol = quad.colored ? colUntinted : col;
+
+			vtx[0].pos.x = x + quad.x1; vtx[0].pos.y = y + quad.y1; vtx[0].col = glyphCol; vtx[0].uv.x = quad.u1; vtx[0].uv.y = quad.v1;
+			vtx[1].pos.x = x + quad.x2; vtx[1].pos.y = y + quad.y1; vtx[1].col = glyphCol; vtx[1].uv.x = quad.u2; vtx[1].uv.y = quad.v1;
+			vtx[2].pos.x = x + quad.x2; vtx[2].pos.y = y + quad.y2; vtx[2].col = glyphCol; vtx[2].uv.x = quad.u2; vtx[2].uv.y = quad.v2;
+			vtx[3].pos.x = x + quad.x1; vtx[3].pos.y = y + quad.y2; vtx[3].col = glyphCol; vtx[3].uv.x = quad.u1; vtx[3].uv.y = quad.v2;
+			idx[0] = static_cast<ImDrawIdx>(index); idx[1] = static_cast<ImDrawIdx>(index + 1); idx[2] = static_cast<ImDrawIdx>(index + 2);
+			idx[3] = static_cast<ImDrawIdx>(index); idx[4] = static_cast<ImDrawIdx>(index + 2); idx[5] = static_cast<ImDrawIdx>(index + 3);
+			vtx += 4;
+			idx += 6;
+			index += 4;
+		}
+
+		drawList->_VtxWritePtr = vtx;
+		drawList->_IdxWritePtr = idx;
+		drawList->_VtxCurrentIdx = index;
+	}
+
+	const char* NumberField::Set(int newValue)
+	{
+		if (!valid || newValue != value)
+		{
+			value = newValue;
+			valid = true;
+			snprintf(text, sizeof(text), format, newValue);
+		}
+		return text;
+	}
+
+	CacheStats GetCacheStats()
+	{
+		return g_Stats;
+	}
+
+	void Reset()
+	{
+		for (Entry& entry : g_Entries)
+		{
+			entry.font = nullptr;
+			entry.built = false;
+			entry.measured = false;
+			entry.quads.clear();
+		}
+		g_Stats = CacheStats();
+	}
+
+	// ============================================================================
+	// КОМАНДЫ КОНСОЛИ
+	// ============================================================================
+
+	static void TextCacheCommand(const Console::Commands::Args&, void*)
+	{
+		CacheStats stats = GetCacheStats();
+		uint64_t lookups = stats.hits + stats.misses;
+		Console::Log("Text cache: %d / %d entries, %llu hit(s), %llu miss(es) (%.1f%% hit), %llu rebuild(s), %llu eviction(s)",
+			stats.entries, CACHE_SIZE,
+			static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+			lookups ? 100.0 * stats.hits / lookups : 0.0,
+			static_cast<unsigned long long>(stats.rebuilds), static_cast<unsigned long long>(stats.evictions));
+	}
+
+	void RegisterCommands()
+	{
+		Console::Commands::Register({ "text.cache", "", "overlay text measurement/glyph cache", TextCacheCommand });
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../deps/imgui/imgui.h"
+#include <cstdint>
+
+namespace Text
+{
+	/// Записей в кэше (строка + шрифт + размер)
+	constexpr int CACHE_SIZE = 256;
+
+	/// Статистика кэша
+	struct CacheStats
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;       // новая строка
+		uint64_t rebuilds = 0;     // глифы перестроены после смены текстуры атласа
+		uint64_t evictions = 0;
+		int entries = 0;
+	};
+
+	/// Размер строки. Для одной и той же (шрифт, размер, строка) считается один раз
+	ImVec2 Measure(ImFont* font, float size, const char* text);
+
+	/// Рисует строку (как ImDrawList::AddText без переноса и обрезки по CPU).
+	/// Квады глифов строятся один раз, дальше вершины копируются со сдвигом и цветом
+	void Draw(ImDrawList* drawList, ImFont* font, float size, const ImVec2& pos, ImU32 col, const char* text);
+
+	/// Строка с целым числом: форматируется заново, только когда значение изменилось.
+	/// format - printf-формат с одним %d
+	struct NumberField
+	{
+		const char* format;
+		int value = 0;
+		bool valid = false;
+		char text[64] = {};
+
+		explicit NumberField(const char* format) : format(format) {}
+
+		/// Текст для value
+		const char* Set(int newValue);
+	};
+
+	/// Статистика
+	CacheStats GetCacheStats();
+
+	/// Очищает кэш (например, при пересоздании контекста ImGui)
+	void Reset();
+
+	/// Регистрирует команду консоли text.cache
+	void RegisterCommands();
+}
@@ -1,12 +1,57 @@
 #include "watermark.h"
 #include "../../deps/imgui/imgui.h"
-#include <cmath>
-#include <float.h>
-#include <stdio.h>
+#include "../anim/anim.h"
+#include "../text/text_cache.h"
 
 // Watermark settings
 static WatermarkSettings g_WatermarkSettings;
 
+// Color cycling: sin(speed * t + phase), advanced by Anim::Update
+enum WatermarkWave {
+    WAVE_BORDER_R,
+    WAVE_BORDER_G,
+    WAVE_TEXT1_R,
+    WAVE_TEXT1_G,
+    WAVE_TEXT2_R,
+    WAVE_TEXT2_G,
+    WAVE_DOT,
+    WAVE_COUNT
+};
+
+static const float g_WaveParams[WAVE_COUNT][2] = {
+    { 2.0f, 0.0f },  // border red
+    { 2.0f, 1.0f },  // border green
+    { 1.5f, 0.0f },  // "cubixDLC" red
+    { 1.5f, 2.0f },  // "cubixDLC" green
+    { 1.5f, 1.0f },  // info red
+    { 1.5f, 3.0f },  // info green
+    { 3.0f, 0.0f },  // status dot alpha
+};
+
+static Anim::Handle g_Waves[WAVE_COUNT];
+static bool g_WavesCreated = false;
+static bool g_WavesRunning = false;
+
+// Oscillators run only while the watermark is drawn
+static void SetWavesRunning(bool running)
+{
+    if (!g_WavesCreated)
+    {
+        if (!running)
+            return;
+        for (int i = 0; i < WAVE_COUNT; i++)
+            g_Waves[i] = Anim::CreateOscillator(g_WaveParams[i][0], g_WaveParams[i][1]);
+        g_WavesCreated = true;
+        g_WavesRunning = true;
+    }
+    
+    if (g_WavesRunning == running)
+        return;
+    for (int i = 0; i < WAVE_COUNT; i++)
+        Anim::SetRunning(g_Waves[i], running);
+    g_WavesRunning = running;
+}
+
 WatermarkSettings& GetWatermarkSettings()
 {
     return g_WatermarkSettings;
@@ -14,13 +59,10 @@ WatermarkSettings& GetWatermarkSettings()
 
 void RenderWatermark()
 {
+    SetWavesRunning(g_WatermarkSettings.enabled);
     if (!g_WatermarkSettings.enabled)
         return;
 
-    static float time = 0.0f;
-    time += ImGui::GetIO().DeltaTime;
-    if (time > 100.0f) time = 0.0f; // Reset to avoid overflow
-
     ImDrawList* draw_list = ImGui::GetForegroundDrawList();
 
     const float padding = 12.0f;
@@ -31,25 +73,21 @@ void RenderWatermark()
     ImFont* font = ImGui::GetFont();
     float font_size = ImGui::GetFontSize();
 
-    float text1_width = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, "cubixDLC").x;
+    float text1_width = Text::Measure(font, font_size, "cubixDLC").x;
     
-    // Build watermark text
-    char watermark_text[64];
+    // Build watermark text (reformatted only when the rounded FPS changes)
+    static Text::NumberField fpsText("| 0.1v | dll | %d FPS");
+    const char* watermark_text = "| 0.1v | dll";
     if (g_WatermarkSettings.showFPS)
     {
-        float fps = ImGui::GetIO().Framerate;
-        _snprintf_s(watermark_text, sizeof(watermark_text), _TRUNCATE, "| 0.1v | dll | %.0f FPS", fps);
-    }
-    else
-    {
-        strcpy_s(watermark_text, sizeof(watermark_text), "| 0.1v | dll");
+        watermark_text = fpsText.Set((int)(ImGui::GetIO().Framerate + 0.5f));
     }
     
     // Calculate width with max FPS value for consistency
-    float text2_width = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, "| 0.1v | dll | 9999 FPS").x;
+    float text2_width = Text::Measure(font, font_size, "| 0.1v | dll | 9999 FPS").x;
     if (!g_WatermarkSettings.showFPS)
     {
-        text2_width = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, "| 0.1v | dll").x;
+        text2_width = Text::Measure(font, font_size, "| 0.1v | dll").x;
     }
 
     float total_content_width = text1_width + 5.0f + text2_width;
@@ -61,8 +99,8 @@ void RenderWatermark()
     ImU32 bg_color = IM_COL32(5, 5, 5, 217);
     draw_list->AddRectFilled(bg_min, bg_max, bg_color, 6.0f);
 
-    float border_r = 0.3f + 0.2f * sinf(time * 2.0f);
-    float border_g = 0.5f + 0.3f * sinf(time * 2.0f + 1.0f);
+    float border_r = 0.3f + 0.2f * Anim::Get(g_Waves[WAVE_BORDER_R]);
+    float border_g = 0.5f + 0.3f * Anim::Get(g_Waves[WAVE_BORDER_G]);
     float border_b = 0.9f;
     border_r = (border_r < 0.0f) ? 0.0f : (border_r > 1.0f) ? 1.0f : border_r;
     border_g = (border_g < 0.0f) ? 0.0f : (border_g > 1.0f) ? 1.0f : border_g;
@@ -74,14 +112,14 @@ void RenderWatermark()
     ImVec2 text2_pos = ImVec2(text_pos.x + text1_width + 5.0f, text_y);
 
     ImVec2 shadow_offset = ImVec2(1.0f, 1.0f);
-    draw_list->AddText(font, font_size, ImVec2(text_pos.x + shadow_offset.x, text_pos.y + shadow_offset.y), IM_COL32(0, 0, 0, 180), "cubixDLC");
-    draw_list->AddText(font, font_size, ImVec2(text2_pos.x + shadow_offset.x, text2_pos.y + shadow_offset.y), IM_COL32(0, 0, 0, 180), watermark_text);
+    Text::Draw(draw_list, font, font_size, ImVec2(text_pos.x + shadow_offset.x, text_pos.y + shadow_offset.y), IM_COL32(0, 0, 0, 180), "cubixDLC");
+    Text::Draw(draw_list, font, font_size, ImVec2(text2_pos.x + shadow_offset.x, text2_pos.y + shadow_offset.y), IM_COL32(0, 0, 0, 180), watermark_text);
 
-    float r1 = 0.4f + 0.3f * sinf(time * 1.5f);
-    float g1 = 0.6f + 0.3f * sinf(time * 1.5f + 2.0f);
+    float r1 = 0.4f + 0.3f * Anim::Get(g_Waves[WAVE_TEXT1_R]);
+    float g1 = 0.6f + 0.3f * Anim::Get(g_Waves[WAVE_TEXT1_G]);
     float b1 = 1.0f;
-    float r2 = 0.8f + 0.2f * sinf(time * 1.5f + 1.0f);
-    float g2 = 0.9f + 0.1f * sinf(time * 1.5f + 3.0f);
+    float r2 = 0.8f + 0.2f * Anim::Get(g_Waves[WAVE_TEXT2_R]);
+    float g2 = 0.9f + 0.1f * Anim::Get(g_Waves[WAVE_TEXT2_G]);
     float b2 = 1.0f;
 
     r1 = (r1 < 0.0f) ? 0.0f : (r1 > 1.0f) ? 1.0f : r1;
@@ -92,10 +130,10 @@ void RenderWatermark()
     ImU32 color1 = IM_COL32((int)(r1 * 255), (int)(g1 * 255), (int)(b1 * 255), 255);
     ImU32 color2 = IM_COL32((int)(r2 * 255), (int)(g2 * 255), (int)(b2 * 255), 200);
 
-    draw_list->AddText(font, font_size, text_pos, color1, "cubixDLC");
-    draw_list->AddText(font, font_size, text2_pos, color2, watermark_text);
+    Text::Draw(draw_list, font, font_size, text_pos, color1, "cubixDLC");
+    Text::Draw(draw_list, font, font_size, text2_pos, color2, watermark_text);
 
-    float dot_alpha = 0.5f + 0.5f * sinf(time * 3.0f);
+    float dot_alpha = 0.5f + 0.5f * Anim::Get(g_Waves[WAVE_DOT]);
     dot_alpha = (dot_alpha < 0.0f) ? 0.0f : (dot_alpha > 1.0f) ? 1.0f : dot_alpha;
     ImU32 dot_color = IM_COL32(100, 200, 255, (int)(dot_alpha * 255));
     draw_list->AddCircleFilled(ImVec2(bg_max.x - 10.0f, bg_max.y - 10.0f), 3.0f, dot_color);
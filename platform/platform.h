@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+// Thin OS layer used by the overlay (HUD, watermark, console, audio, settings).
+// dx11_hook links platform_win32.cpp, the headless benchmark links platform_null.cpp.
+
+// Embedded RCDATA resource (mapped with the module, no copy). Returns false if missing
+bool LoadResourceData(int resourceId, const void** data, size_t* size);
+
+// Read-only view of a whole file (memory-mapped where the platform supports it)
+struct MappedFile
+{
+    const void* data = nullptr;
+    size_t size = 0;
+    void* handle = nullptr;
+};
+
+// Returns false if the file is missing or empty
+bool MapFile(const char* path, MappedFile* file);
+void UnmapFile(MappedFile* file);
+
+// Writes <path>.tmp, flushes it to disk and renames it over path, so readers
+// see either the old file or the complete new one
+bool WriteFileAtomic(const char* path, const void* data, size_t size);
+
+// Audio output: the callback fills interleaved stereo float frames on the device thread
+typedef void (*AudioRenderCallback)(float* frames, int frameCount);
+
+// Opens the default output device (shared mode) and starts pulling from the callback
+bool StartAudioOutput(AudioRenderCallback callback, int* sampleRate);
+
+// Stops the device thread (no callback runs after this returns). Waits for the thread to
+// leave its loop, not for it to exit, so it can run inside DllMain. processExit: called from
+// DLL_PROCESS_DETACH at process exit - the thread is already gone and nothing is released
+void StopAudioOutput(bool processExit = false);
@@ -0,0 +1,108 @@
+#include "platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+// Headless build: no embedded resources
+bool LoadResourceData(int, const void** data, size_t* size)
+{
+    *data = nullptr;
+    *size = 0;
+    return false;
+}
+
+// Files: plain stdio, the "mapping" is a heap copy of the file
+bool MapFile(const char* path, MappedFile* file)
+{
+    *file = MappedFile();
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void* data = size > 0 ? malloc((size_t)size) : nullptr;
+    bool ok = data && fread(data, 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    if (!ok)
+    {
+        free(data);
+        return false;
+    }
+
+    file->data = data;
+    file->size = (size_t)size;
+    file->handle = data;
+    return true;
+}
+
+void UnmapFile(MappedFile* file)
+{
+    free(file->handle);
+    *file = MappedFile();
+}
+
+// rename() replaces the target atomically on POSIX
+bool WriteFileAtomic(const char* path, const void* data, size_t size)
+{
+    std::string tmpPath = std::string(path) + ".tmp";
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (!f)
+        return false;
+
+    bool ok = fwrite(data, 1, size, f) == size;
+    ok = fflush(f) == 0 && ok;
+    ok = fclose(f) == 0 && ok;
+    if (ok)
+        ok = rename(tmpPath.c_str(), path) == 0;
+    if (!ok)
+        remove(tmpPath.c_str());
+    return ok;
+}
+
+// Null sink: pulls 10 ms blocks in real time and drops them, so the mixer
+// runs on its own thread exactly like with a device
+static const int NULL_SINK_RATE = 48000;
+static const int NULL_SINK_PERIOD_FRAMES = NULL_SINK_RATE / 100;
+
+static std::thread g_SinkThread;
+static std::atomic<bool> g_SinkRunning{ false };
+
+static void NullSinkMain(AudioRenderCallback callback)
+{
+    static float buffer[NULL_SINK_PERIOD_FRAMES * 2];
+    auto next = std::chrono::steady_clock::now();
+    while (g_SinkRunning.load(std::memory_order_acquire))
+    {
+        callback(buffer, NULL_SINK_PERIOD_FRAMES);
+        next += std::chrono::milliseconds(10);
+        std::this_thread::sleep_until(next);
+    }
+}
+
+bool StartAudioOutput(AudioRenderCallback callback, int* sampleRate)
+{
+    if (g_SinkRunning.exchange(true))
+        return false;
+    *sampleRate = NULL_SINK_RATE;
+    g_SinkThread = std::thread(NullSinkMain, callback);
+    return true;
+}
+
+void StopAudioOutput(bool processExit)
+{
+    if (!g_SinkRunning.exchange(false))
+        return;
+    if (g_SinkThread.joinable())
+    {
+        // No loader lock here; at process exit the thread may already be gone
+        if (processExit)
+            g_SinkThread.detach();
+        else
+            g_SinkThread.join();
+    }
+}
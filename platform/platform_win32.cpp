@@ -0,0 +1,329 @@
+#include "platform.h"
+#include <windows.h>
+#include <mmdeviceapi.h>
+#include <audioclient.h>
+#include <mmreg.h>
+#include <ksmedia.h>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#pragma comment(lib, "ole32.lib")
+
+// Module that holds the resources (the DLL, not the game executable)
+static HMODULE GetResourceModule()
+{
+    HMODULE hModule = GetModuleHandleA("cubixdlc.dll");
+    if (!hModule)
+    {
+        // Fallback: get module from current address
+        GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+            (LPCSTR)&GetResourceModule, &hModule);
+    }
+    return hModule;
+}
+
+// Embedded RCDATA resource (stays mapped while the DLL is loaded)
+bool LoadResourceData(int resourceId, const void** data, size_t* size)
+{
+    *data = nullptr;
+    *size = 0;
+
+    HMODULE hModule = GetResourceModule();
+    if (!hModule)
+        return false;
+
+    HRSRC hResource = FindResourceA(hModule, MAKEINTRESOURCEA(resourceId), MAKEINTRESOURCEA(10));  // RT_RCDATA
+    if (!hResource)
+        return false;
+
+    HGLOBAL hData = LoadResource(hModule, hResource);
+    if (!hData)
+        return false;
+
+    *data = LockResource(hData);
+    *size = SizeofResource(hModule, hResource);
+    return *data != nullptr;
+}
+
+// ============================================================================
+// Files
+// ============================================================================
+
+bool MapFile(const char* path, MappedFile* file)
+{
+    *file = MappedFile();
+    HANDLE hFile = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size = {};
+    HANDLE hMapping = nullptr;
+    if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0)
+        hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(hFile);   // the mapping keeps the file open
+    if (!hMapping)
+        return false;
+
+    const void* view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(hMapping);
+        return false;
+    }
+
+    file->data = view;
+    file->size = (size_t)size.QuadPart;
+    file->handle = hMapping;
+    return true;
+}
+
+void UnmapFile(MappedFile* file)
+{
+    if (file->data)
+        UnmapViewOfFile(file->data);
+    if (file->handle)
+        CloseHandle((HANDLE)file->handle);
+    *file = MappedFile();
+}
+
+bool WriteFileAtomic(const char* path, const void* data, size_t size)
+{
+    char tmpPath[MAX_PATH];
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path) >= (int)sizeof(tmpPath))
+        return false;
+
+    HANDLE hFile = CreateFileA(tmpPath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    DWORD written = 0;
+    bool ok = WriteFile(hFile, data, (DWORD)size, &written, nullptr) && written == size &&
+        FlushFileBuffers(hFile);
+    CloseHandle(hFile);
+
+    if (ok)
+        ok = MoveFileExA(tmpPath, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    if (!ok)
+        DeleteFileA(tmpPath);
+    return ok;
+}
+
+// ============================================================================
+// Audio output (WASAPI, shared mode, event-driven)
+// ============================================================================
+
+static IAudioClient* g_AudioClient = nullptr;
+static IAudioRenderClient* g_RenderClient = nullptr;
+static HANDLE g_AudioEvent = nullptr;
+static std::thread g_AudioThread;
+static std::atomic<bool> g_AudioRunning{ false };
+static std::atomic<bool> g_AudioExited{ false };   // left AudioThreadMain (StopAudioOutput waits for this, not for the thread)
+static AudioRenderCallback g_AudioCallback = nullptr;
+static UINT32 g_AudioBufferFrames = 0;
+static int g_AudioChannels = 2;   // device channels; the mixer always renders stereo
+
+template<typename T>
+static void SafeRelease(T*& p)
+{
+    if (p)
+    {
+        p->Release();
+        p = nullptr;
+    }
+}
+
+static bool IsFloatFormat(const WAVEFORMATEX* format)
+{
+    if (format->wFormatTag == WAVE_FORMAT_IEEE_FLOAT)
+        return format->wBitsPerSample == 32;
+    if (format->wFormatTag == WAVE_FORMAT_EXTENSIBLE)
+    {
+        const WAVEFORMATEXTENSIBLE* ext = reinterpret_cast<const WAVEFORMATEXTENSIBLE*>(format);
+        return ext->SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT && format->wBitsPerSample == 32;
+    }
+    return false;
+}
+
+// Fills frameCount device frames: stereo straight from the mixer, wider layouts get L/R
+// in the first two channels and silence elsewhere
+static void RenderFrames(float* out, UINT32 frameCount)
+{
+    if (g_AudioChannels == 2)
+    {
+        g_AudioCallback(out, (int)frameCount);
+        return;
+    }
+
+    static float stereo[2 * 1024];
+    while (frameCount > 0)
+    {
+        UINT32 count = frameCount < 1024 ? frameCount : 1024;
+        g_AudioCallback(stereo, (int)count);
+        for (UINT32 i = 0; i < count; i++)
+        {
+            float* frame = out + i * g_AudioChannels;
+            for (int c = 0; c < g_AudioChannels; c++)
+                frame[c] = c < 2 ? stereo[i * 2 + c] : 0.0f;
+        }
+        out += count * g_AudioChannels;
+        frameCount -= count;
+    }
+}
+
+static void AudioThreadMain()
+{
+    CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+    while (g_AudioRunning.load(std::memory_order_acquire))
+    {
+        if (WaitForSingleObject(g_AudioEvent, 200) != WAIT_OBJECT_0)
+            continue;
+
+        UINT32 padding = 0;
+        if (FAILED(g_AudioClient->GetCurrentPadding(&padding)))
+            continue;   // device lost: stay silent until StopAudioOutput
+
+        UINT32 frames = g_AudioBufferFrames - padding;
+        BYTE* data = nullptr;
+        if (frames == 0 || FAILED(g_RenderClient->GetBuffer(frames, &data)))
+            continue;
+
+        RenderFrames(reinterpret_cast<float*>(data), frames);
+        g_RenderClient->ReleaseBuffer(frames, 0);
+    }
+
+    CoUninitialize();
+    g_AudioExited.store(true, std::memory_order_release);
+}
+
+// Low-latency path (Windows 10+): smallest engine period, device mix format (float only)
+static bool InitializeLowLatency(IAudioClient* client, WAVEFORMATEX* mixFormat)
+{
+    IAudioClient3* client3 = nullptr;
+    if (!IsFloatFormat(mixFormat) || mixFormat->nChannels < 2 ||
+        FAILED(client->QueryInterface(__uuidof(IAudioClient3), (void**)&client3)))
+        return false;
+
+    UINT32 defaultPeriod = 0, fundamentalPeriod = 0, minPeriod = 0, maxPeriod = 0;
+    bool ok = SUCCEEDED(client3->GetSharedModeEnginePeriod(mixFormat, &defaultPeriod, &fundamentalPeriod, &minPeriod, &maxPeriod)) &&
+        SUCCEEDED(client3->InitializeSharedAudioStream(AUDCLNT_STREAMFLAGS_EVENTCALLBACK, minPeriod, mixFormat, nullptr));
+    client3->Release();
+    return ok;
+}
+
+bool StartAudioOutput(AudioRenderCallback callback, int* sampleRate)
+{
+    if (g_AudioRunning.load())
+        return false;
+
+    // The calling thread may already be in an STA (RPC_E_CHANGED_MODE) - WASAPI works either way.
+    // COM is not uninitialized here: the audio objects outlive this call
+    CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    IMMDeviceEnumerator* enumerator = nullptr;
+    IMMDevice* device = nullptr;
+    WAVEFORMATEX* mixFormat = nullptr;
+    bool ok = SUCCEEDED(CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL,
+            __uuidof(IMMDeviceEnumerator), (void**)&enumerator)) &&
+        SUCCEEDED(enumerator->GetDefaultAudioEndpoint(eRender, eConsole, &device)) &&
+        SUCCEEDED(device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&g_AudioClient)) &&
+        SUCCEEDED(g_AudioClient->GetMixFormat(&mixFormat));
+
+    if (ok)
+    {
+        if (InitializeLowLatency(g_AudioClient, mixFormat))
+        {
+            g_AudioChannels = mixFormat->nChannels;
+        }
+        else
+        {
+            // Default period; the engine converts our float stereo to the device format
+            WAVEFORMATEX format = {};
+            format.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+            format.nChannels = 2;
+            format.nSamplesPerSec = mixFormat->nSamplesPerSec;
+            format.wBitsPerSample = 32;
+            format.nBlockAlign = format.nChannels * format.wBitsPerSample / 8;
+            format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+            ok = SUCCEEDED(g_AudioClient->Initialize(AUDCLNT_SHAREMODE_SHARED,
+                AUDCLNT_STREAMFLAGS_EVENTCALLBACK | AUDCLNT_STREAMFLAGS_AUTOCONVERTPCM | AUDCLNT_STREAMFLAGS_SRC_DEFAULT_QUALITY,
+                0, 0, &format, nullptr));
+            g_AudioChannels = 2;
+        }
+        *sampleRate = (int)mixFormat->nSamplesPerSec;
+    }
+
+    if (ok)
+    {
+        g_AudioEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+        ok = g_AudioEvent &&
+            SUCCEEDED(g_AudioClient->SetEventHandle(g_AudioEvent)) &&
+            SUCCEEDED(g_AudioClient->GetBufferSize(&g_AudioBufferFrames)) &&
+            SUCCEEDED(g_AudioClient->GetService(__uuidof(IAudioRenderClient), (void**)&g_RenderClient));
+    }
+
+    // Start with a silent buffer so the first period does not glitch
+    BYTE* data = nullptr;
+    if (ok && SUCCEEDED(g_RenderClient->GetBuffer(g_AudioBufferFrames, &data)))
+        g_RenderClient->ReleaseBuffer(g_AudioBufferFrames, AUDCLNT_BUFFERFLAGS_SILENT);
+
+    if (mixFormat)
+        CoTaskMemFree(mixFormat);
+    SafeRelease(device);
+    SafeRelease(enumerator);
+
+    if (ok)
+    {
+        g_AudioCallback = callback;
+        g_AudioExited.store(false, std::memory_order_relaxed);
+        g_AudioRunning.store(true, std::memory_order_release);
+        ok = SUCCEEDED(g_AudioClient->Start());
+        if (ok)
+            g_AudioThread = std::thread(AudioThreadMain);
+        else
+            g_AudioRunning.store(false);
+    }
+
+    if (!ok)
+    {
+        SafeRelease(g_RenderClient);
+        SafeRelease(g_AudioClient);
+        if (g_AudioEvent)
+        {
+            CloseHandle(g_AudioEvent);
+            g_AudioEvent = nullptr;
+        }
+    }
+    return ok;
+}
+
+void StopAudioOutput(bool processExit)
+{
+    if (!g_AudioRunning.exchange(false))
+        return;
+
+    // At process exit the thread is already terminated; the OS tears down the device,
+    // and COM must not be called this late
+    if (processExit)
+    {
+        if (g_AudioThread.joinable())
+            g_AudioThread.detach();
+        return;
+    }
+
+    // Not join: thread exit needs the loader lock, which FreeLibrary holds during DllMain
+    SetEvent(g_AudioEvent);
+    while (!g_AudioExited.load(std::memory_order_acquire))
+        Sleep(1);
+    if (g_AudioThread.joinable())
+        g_AudioThread.detach();
+
+    g_AudioClient->Stop();
+    SafeRelease(g_RenderClient);
+    SafeRelease(g_AudioClient);
+    CloseHandle(g_AudioEvent);
+    g_AudioEvent = nullptr;
+    g_AudioCallback = nullptr;
+}
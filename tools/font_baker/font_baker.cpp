@@ -0,0 +1,301 @@
+// Font atlas baker.
+// Rasterizes the overlay font (ProggyClean + Cyrillic from a TTF) at the sizes the overlay
+// draws with, using ImGui's own stb_truetype loader, and writes the glyph metrics and
+// compressed alpha masks to a blob (modules/fonts/font_blob.h) that resources.rc
+// embeds into the DLL. The blob is then loaded back through Fonts::AddOverlayFont and every
+// glyph is compared against the rasterized one, so a bad blob fails the build.
+//
+// Usage: font_baker <output.bin> <cyrillic-font.ttf>
+
+#include "../../deps/imgui/imgui.h"
+#include "../../deps/imgui/imgui_internal.h"
+#include "../../modules/fonts/font_blob.h"
+#include "../../modules/fonts/fonts.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace Fonts;
+
+struct BakedGlyph
+{
+    BlobGlyph glyph;
+    std::vector<uint8_t> mask;
+};
+
+struct BakedSet
+{
+    uint16_t source;
+    uint16_t size;
+    std::vector<BakedGlyph> glyphs;
+};
+
+// Headless context with a dynamic Alpha8 atlas (no renderer, textures are never uploaded)
+static void CreateContext()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+}
+
+static std::vector<uint8_t> CopyMask(ImFontAtlas* atlas, const ImFontGlyph* glyph)
+{
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+    ImTextureData* tex = atlas->TexData;
+    std::vector<uint8_t> mask(r->w * r->h);
+    for (int y = 0; y < r->h; y++)
+        memcpy(&mask[y * r->w], tex->GetPixelsAt(r->x, r->y + y), r->w);
+    return mask;
+}
+
+// PackBits: runs of 3+ equal bytes become (count + 125, value), everything else is copied
+// in literal chunks of up to 128 bytes (count - 1, bytes...)
+static void PackBits(const std::vector<uint8_t>& src, std::vector<uint8_t>& dst)
+{
+    size_t i = 0;
+    while (i < src.size())
+    {
+        size_t run = 1;
+        while (i + run < src.size() && src[i + run] == src[i] && run < 130)
+            run++;
+
+        if (run >= 3)
+        {
+            dst.push_back((uint8_t)(run + 125));
+            dst.push_back(src[i]);
+            i += run;
+            continue;
+        }
+
+        size_t start = i;
+        while (i < src.size() && i - start < 128)
+        {
+            if (i + 2 < src.size() && src[i] == src[i + 1] && src[i] == src[i + 2])
+                break;
+            i++;
+        }
+        dst.push_back((uint8_t)(i - start - 1));
+        dst.insert(dst.end(), src.begin() + start, src.begin() + i);
+    }
+}
+
+// ProggyClean is a bitmap font: its masks are only 0 and 255 and pack to 1 bit per pixel
+static void PackMask(BlobGlyph& glyph, const std::vector<uint8_t>& mask, std::vector<uint8_t>& dst)
+{
+    bool binary = std::all_of(mask.begin(), mask.end(), [](uint8_t a) { return a == 0 || a == 255; });
+    if (!binary)
+    {
+        glyph.encoding = ENCODING_PACKBITS;
+        PackBits(mask, dst);
+        return;
+    }
+
+    glyph.encoding = ENCODING_BITS;
+    size_t start = dst.size();
+    dst.resize(start + (mask.size() + 7) / 8, 0);
+    for (size_t i = 0; i < mask.size(); i++)
+        if (mask[i])
+            dst[start + (i >> 3)] |= (uint8_t)(0x80 >> (i & 7));
+}
+
+static bool Bake(const char* cyrillicPath, std::vector<BakedSet>& sets)
+{
+    CreateContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+
+    // Must match Fonts::AddOverlayFont
+    ImFontConfig latin;
+    latin.OversampleH = latin.OversampleV = 1;
+    latin.PixelSnapH = true;
+    ImFont* font = atlas->AddFontDefaultBitmap(&latin);
+
+    ImFontConfig cyrillic;
+    cyrillic.MergeMode = true;
+    if (!font || !atlas->AddFontFromFileTTF(cyrillicPath, 0.0f, &cyrillic))
+    {
+        fprintf(stderr, "font_baker: cannot load %s\n", cyrillicPath);
+        ImGui::DestroyContext();
+        return false;
+    }
+
+    ImGui::NewFrame();
+    for (float size : BAKED_SIZES)
+    {
+        BakedSet bySource[SOURCE_COUNT];
+        for (int source = 0; source < SOURCE_COUNT; source++)
+        {
+            bySource[source].source = (uint16_t)source;
+            bySource[source].size = (uint16_t)size;
+        }
+
+        ImFontBaked* baked = font->GetFontBaked(size);
+        for (const ImWchar* range : { LATIN_RANGE, CYRILLIC_RANGE })
+        {
+            for (unsigned int c = range[0]; c <= range[1]; c++)
+            {
+                ImFontGlyph* glyph = baked->FindGlyphNoFallback((ImWchar)c);
+                if (!glyph)
+                    continue;
+
+                BakedGlyph out = {};
+                out.glyph.codepoint = c;
+                out.glyph.advanceX = glyph->AdvanceX;
+                if (glyph->Visible)
+                {
+                    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+                    out.glyph.x0 = glyph->X0;
+                    out.glyph.y0 = glyph->Y0;
+                    out.glyph.x1 = glyph->X1;
+                    out.glyph.y1 = glyph->Y1;
+                    out.glyph.width = r->w;
+                    out.glyph.height = r->h;
+                    out.mask = CopyMask(atlas, glyph);
+                }
+                bySource[glyph->SourceIdx].glyphs.push_back(out);
+            }
+        }
+
+        for (BakedSet& set : bySource)
+            if (!set.glyphs.empty())
+                sets.push_back(set);
+    }
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return true;
+}
+
+static std::vector<uint8_t> Serialize(std::vector<BakedSet>& sets, size_t& rawBytes)
+{
+    std::vector<BlobSet> blobSets;
+    std::vector<BlobGlyph> blobGlyphs;
+    std::vector<uint8_t> pixels;
+    rawBytes = 0;
+
+    for (BakedSet& set : sets)
+    {
+        BlobSet blobSet = {};
+        blobSet.source = set.source;
+        blobSet.size = set.size;
+        blobSet.firstGlyph = (uint32_t)blobGlyphs.size();
+        blobSet.glyphCount = (uint32_t)set.glyphs.size();
+        blobSets.push_back(blobSet);
+
+        for (BakedGlyph& glyph : set.glyphs)
+        {
+            glyph.glyph.offset = (uint32_t)pixels.size();
+            PackMask(glyph.glyph, glyph.mask, pixels);
+            glyph.glyph.packedSize = (uint32_t)pixels.size() - glyph.glyph.offset;
+            rawBytes += glyph.mask.size();
+            blobGlyphs.push_back(glyph.glyph);
+        }
+    }
+
+    BlobHeader header = {};
+    header.magic = BLOB_MAGIC;
+    header.version = BLOB_VERSION;
+    header.setCount = (uint32_t)blobSets.size();
+    header.glyphCount = (uint32_t)blobGlyphs.size();
+    header.pixelBytes = (uint32_t)pixels.size();
+
+    std::vector<uint8_t> blob;
+    auto append = [&blob](const void* data, size_t size) {
+        blob.insert(blob.end(), (const uint8_t*)data, (const uint8_t*)data + size);
+    };
+    append(&header, sizeof(header));
+    append(blobSets.data(), blobSets.size() * sizeof(BlobSet));
+    append(blobGlyphs.data(), blobGlyphs.size() * sizeof(BlobGlyph));
+    append(pixels.data(), pixels.size());
+    return blob;
+}
+
+// Loads the blob the way the DLL does and checks that every glyph comes out of the blob
+// with the same metrics and mask as the stb_truetype one
+static bool Verify(const std::vector<uint8_t>& blob, const std::vector<BakedSet>& sets)
+{
+    CreateContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    ImFont* font = AddOverlayFont(atlas, blob.data(), blob.size());
+    int errors = GetStats().prebaked ? 0 : 1;
+    if (errors)
+        fprintf(stderr, "font_baker: blob rejected by Fonts::AddOverlayFont\n");
+
+    ImGui::NewFrame();
+    for (const BakedSet& set : sets)
+    {
+        if (errors)
+            break;
+
+        ImFontBaked* baked = font->GetFontBaked(set.size);
+        for (const BakedGlyph& expected : set.glyphs)
+        {
+            const ImFontGlyph* glyph = baked->FindGlyphNoFallback((ImWchar)expected.glyph.codepoint);
+            bool same = glyph && glyph->SourceIdx == set.source && glyph->AdvanceX == expected.glyph.advanceX &&
+                (glyph->Visible != 0) == !expected.mask.empty();
+            if (same && glyph->Visible)
+            {
+                same = glyph->X0 == expected.glyph.x0 && glyph->Y0 == expected.glyph.y0 &&
+                    glyph->X1 == expected.glyph.x1 && glyph->Y1 == expected.glyph.y1 &&
+                    CopyMask(atlas, glyph) == expected.mask;
+            }
+            if (!same)
+            {
+                fprintf(stderr, "font_baker: U+%04X at %dpx differs after loading the blob\n",
+                    expected.glyph.codepoint, set.size);
+                errors++;
+            }
+        }
+    }
+
+    Stats stats = GetStats();
+    if (!errors && stats.rasterized != 0)
+    {
+        fprintf(stderr, "font_baker: %llu glyphs were rasterized instead of loaded from the blob\n",
+            (unsigned long long)stats.rasterized);
+        errors++;
+    }
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return errors == 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: font_baker <output.bin> <cyrillic-font.ttf>\n");
+        return 2;
+    }
+
+    IMGUI_CHECKVERSION();
+    std::vector<BakedSet> sets;
+    if (!Bake(argv[2], sets))
+        return 1;
+
+    size_t rawBytes = 0;
+    std::vector<uint8_t> blob = Serialize(sets, rawBytes);
+    if (!Verify(blob, sets))
+        return 1;
+
+    FILE* file = fopen(argv[1], "wb");
+    if (!file || fwrite(blob.data(), 1, blob.size(), file) != blob.size())
+    {
+        fprintf(stderr, "font_baker: cannot write %s\n", argv[1]);
+        if (file)
+            fclose(file);
+        return 1;
+    }
+    fclose(file);
+
+    size_t glyphs = 0;
+    for (const BakedSet& set : sets)
+        glyphs += set.glyphs.size();
+    printf("font_baker: %zu glyphs in %zu sets, masks %zu -> %zu bytes, blob %zu bytes -> %s\n",
+        glyphs, sets.size(), rawBytes, blob.size() - sizeof(BlobHeader) - sets.size() * sizeof(BlobSet) - glyphs * sizeof(BlobGlyph),
+        blob.size(), argv[1]);
+    return 0;
+}
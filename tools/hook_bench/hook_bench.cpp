@@ -0,0 +1,361 @@
+// Hook manager benchmark (Linux x86-64 backend of modules/hooks).
+// Checks that trampolines built by MinHook's trampoline.c run the relocated prologue
+// correctly (RIP-relative operands, jcc/call/jmp, patch-above), then measures install
+// latency, one batched freeze versus one freeze per hook while other threads call the
+// hooked functions, and the cost of a call through detour + trampoline.
+//
+// Usage: hook_bench [hooks] [caller-threads]
+
+#include "../../modules/hooks/hooks.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+
+typedef int (*IntFn)(int);
+
+static const size_t CODE_SIZE = 1 << 20;
+static const int MAX_HOOKS = 4096;
+static const int DETOUR_ADD = 1000;
+static const int CALL_LOOPS = 10000000;
+
+// Originals returned by Hooks::Create, read by the assembled detours
+static void* g_Originals[MAX_HOOKS + 16];
+static int g_Failures = 0;
+static volatile int g_Sink = 0;
+
+static double NowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void Check(const char* what, bool ok)
+{
+    printf("  %-44s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok)
+        g_Failures++;
+}
+
+// Writes machine code into the RW code buffer (made RX before anything runs)
+struct Emitter
+{
+    uint8_t* base;
+    size_t pos;
+
+    uint8_t* Here() { return base + pos; }
+
+    void Bytes(std::initializer_list<uint8_t> bytes)
+    {
+        for (uint8_t b : bytes)
+            base[pos++] = b;
+    }
+
+    void U32(uint32_t value)
+    {
+        memcpy(base + pos, &value, 4);
+        pos += 4;
+    }
+
+    void U64(uint64_t value)
+    {
+        memcpy(base + pos, &value, 8);
+        pos += 8;
+    }
+
+    // disp32 of an instruction that ends right after it
+    void Rel32To(const uint8_t* target)
+    {
+        U32(static_cast<uint32_t>(target - (base + pos + 4)));
+    }
+
+    void Align(size_t alignment)
+    {
+        while (pos % alignment)
+            base[pos++] = 0xCC;
+    }
+};
+
+// Detour for hook `slot`: return original(x) + DETOUR_ADD
+static uint8_t* EmitDetour(Emitter& e, int slot)
+{
+    e.Align(16);
+    uint8_t* fn = e.Here();
+    e.Bytes({ 0x48, 0x83, 0xEC, 0x08 });                       // sub rsp, 8
+    e.Bytes({ 0x48, 0xB8 });                                   // mov rax, &g_Originals[slot]
+    e.U64(reinterpret_cast<uint64_t>(&g_Originals[slot]));
+    e.Bytes({ 0xFF, 0x10 });                                   // call [rax]
+    e.Bytes({ 0x05 }); e.U32(DETOUR_ADD);                      // add eax, DETOUR_ADD
+    e.Bytes({ 0x48, 0x83, 0xC4, 0x08 });                       // add rsp, 8
+    e.Bytes({ 0xC3 });                                         // ret
+    return fn;
+}
+
+// Compiled target: the text segment is a file-backed private mapping
+__attribute__((noinline)) static int CompiledTarget(int x)
+{
+    volatile int scale = 3;
+    return x * scale + 1;
+}
+
+struct Case
+{
+    const char* name;
+    uint8_t* fn;
+    int args[2];
+    int expected[2];
+    uint8_t* neighbour;   // code right after the function, must keep returning 1
+};
+
+static bool ReturnsAll(IntFn fn, const Case& c, int add)
+{
+    return fn(c.args[0]) == c.expected[0] + add && fn(c.args[1]) == c.expected[1] + add;
+}
+
+static void RunCorrectness(Emitter& e, std::vector<Case>& cases)
+{
+    int slot = MAX_HOOKS;
+    std::vector<uint8_t*> detours;
+    for (size_t i = 0; i < cases.size(); i++)
+        detours.push_back(EmitDetour(e, slot + static_cast<int>(i)));
+    mprotect(e.base, CODE_SIZE, PROT_READ | PROT_EXEC);
+
+    printf("trampolines:\n");
+    for (size_t i = 0; i < cases.size(); i++)
+    {
+        const Case& c = cases[i];
+        IntFn fn = reinterpret_cast<IntFn>(c.fn);
+        uint8_t pristine[16];
+        memcpy(pristine, c.fn - 5, sizeof(pristine));
+
+        char what[96];
+        Hooks::Status status = Hooks::Create(c.fn, detours[i], &g_Originals[slot + i]);
+        snprintf(what, sizeof(what), "%s: create (%s)", c.name, Hooks::StatusText(status));
+        Check(what, status == Hooks::Status::Ok);
+        if (status != Hooks::Status::Ok)
+            continue;
+
+        IntFn original = reinterpret_cast<IntFn>(g_Originals[slot + i]);
+        bool ok = ReturnsAll(fn, c, 0);
+        ok &= Hooks::Enable(c.fn) == Hooks::Status::Ok;
+        ok &= ReturnsAll(fn, c, DETOUR_ADD) && ReturnsAll(original, c, 0);
+        ok &= !c.neighbour || reinterpret_cast<IntFn>(c.neighbour)(0) == 1;
+        ok &= Hooks::Disable(c.fn) == Hooks::Status::Ok;
+        ok &= ReturnsAll(fn, c, 0);
+        ok &= Hooks::Remove(c.fn) == Hooks::Status::Ok;
+        ok &= memcmp(pristine, c.fn - 5, sizeof(pristine)) == 0;
+        snprintf(what, sizeof(what), "%s: detour, trampoline, restore", c.name);
+        Check(what, ok);
+    }
+}
+
+// Caller threads: every hooked function must return either its own value or the detour's
+struct Callers
+{
+    std::vector<std::thread> threads;
+    std::atomic<bool> stop{ false };
+    std::atomic<uint64_t> calls{ 0 };
+    std::atomic<uint64_t> wrong{ 0 };
+
+    void Start(int count, const std::vector<uint8_t*>& fns)
+    {
+        for (int t = 0; t < count; t++)
+        {
+            threads.emplace_back([this, &fns, t] {
+                uint64_t localCalls = 0, localWrong = 0;
+                size_t i = static_cast<size_t>(t) * 7;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    i = (i + 1) % fns.size();
+                    int result = reinterpret_cast<IntFn>(fns[i])(1);
+                    int expected = 1 + static_cast<int>(i);
+                    localWrong += result != expected && result != expected + DETOUR_ADD;
+                    localCalls++;
+                }
+                calls += localCalls;
+                wrong += localWrong;
+            });
+        }
+    }
+
+    void Stop()
+    {
+        stop = true;
+        for (std::thread& thread : threads)
+            thread.join();
+        threads.clear();
+    }
+};
+
+static double MeasureCalls(IntFn fn)
+{
+    volatile IntFn call = fn;
+    int sum = 0;
+    double start = NowMs();
+    for (int i = 0; i < CALL_LOOPS; i++)
+        sum += call(i);
+    double ns = (NowMs() - start) * 1e6 / CALL_LOOPS;
+    g_Sink = g_Sink + sum;
+    return ns;
+}
+
+static void RunBatch(Emitter& e, int hooks, int callerThreads)
+{
+    // hooks x "mov eax, edi; add eax, i; ret" and their detours
+    mprotect(e.base, CODE_SIZE, PROT_READ | PROT_WRITE);
+    std::vector<uint8_t*> fns, detours;
+    for (int i = 0; i < hooks; i++)
+    {
+        e.Align(16);
+        fns.push_back(e.Here());
+        e.Bytes({ 0x89, 0xF8, 0x05 }); e.U32(static_cast<uint32_t>(i)); e.Bytes({ 0xC3 });
+    }
+    for (int i = 0; i < hooks; i++)
+        detours.push_back(EmitDetour(e, i));
+    mprotect(e.base, CODE_SIZE, PROT_READ | PROT_EXEC);
+
+    printf("\n%d hooks, %d caller threads:\n", hooks, callerThreads);
+
+    double start = NowMs();
+    bool created = true;
+    for (int i = 0; i < hooks; i++)
+        created &= Hooks::Create(fns[i], detours[i], &g_Originals[i]) == Hooks::Status::Ok;
+    double createMs = NowMs() - start;
+    Check("create all", created);
+    if (!created)
+        return;
+
+    Callers callers;
+    callers.Start(callerThreads, fns);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // One freeze per hook
+    uint64_t freezes = Hooks::GetStats().freezes;
+    start = NowMs();
+    bool enabled = true;
+    for (int i = 0; i < hooks; i++)
+        enabled &= Hooks::Enable(fns[i]) == Hooks::Status::Ok;
+    double perHookMs = NowMs() - start;
+    uint64_t perHookFreezes = Hooks::GetStats().freezes - freezes;
+
+    Hooks::QueueDisable(Hooks::ALL_HOOKS);
+    start = NowMs();
+    bool disabled = Hooks::ApplyQueued() == Hooks::Status::Ok;
+    double disableMs = NowMs() - start;
+
+    // One freeze for the whole batch
+    freezes = Hooks::GetStats().freezes;
+    Hooks::QueueEnable(Hooks::ALL_HOOKS);
+    start = NowMs();
+    bool batched = Hooks::ApplyQueued() == Hooks::Status::Ok;
+    double batchMs = NowMs() - start;
+    Hooks::Stats stats = Hooks::GetStats();
+    uint64_t batchFreezes = stats.freezes - freezes;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    callers.Stop();
+
+    printf("  create           %9.3f us per hook\n", createMs * 1000.0 / hooks);
+    printf("  enable one by one %8.3f ms total, %llu freezes\n", perHookMs, (unsigned long long)perHookFreezes);
+    printf("  disable batched  %9.3f ms\n", disableMs);
+    printf("  enable batched   %9.3f ms total, %llu freeze of %d threads, %.3f ms frozen\n",
+        batchMs, (unsigned long long)batchFreezes, stats.lastFrozenThreads, stats.lastFreezeMs);
+    printf("  callers          %llu calls, %llu wrong results\n",
+        (unsigned long long)callers.calls.load(), (unsigned long long)callers.wrong.load());
+    Check("enable/disable under load", enabled && disabled && batched && callers.wrong.load() == 0);
+    Check("batched enable is one freeze", batchFreezes == 1 && perHookFreezes == static_cast<uint64_t>(hooks));
+    Check("all hooks enabled", stats.enabled == hooks);
+
+    // Call overhead: hook 0 enabled, hook 1 disabled (same code shape)
+    Hooks::Disable(fns[1]);
+    double direct = MeasureCalls(reinterpret_cast<IntFn>(fns[1]));
+    double hooked = MeasureCalls(reinterpret_cast<IntFn>(fns[0]));
+    printf("  call direct      %9.3f ns\n", direct);
+    printf("  call hooked      %9.3f ns (+%.3f ns: jmp rel32, detour, trampoline)\n", hooked, hooked - direct);
+
+    start = NowMs();
+    bool removed = true;
+    for (int i = 0; i < hooks; i++)
+        removed &= Hooks::Remove(fns[i]) == Hooks::Status::Ok;
+    double removeMs = NowMs() - start;
+    printf("  remove           %9.3f us per hook\n", removeMs * 1000.0 / hooks);
+    Check("remove all", removed && Hooks::GetStats().hooks == 0);
+}
+
+int main(int argc, char** argv)
+{
+    int hooks = argc > 1 ? atoi(argv[1]) : 256;
+    int callerThreads = argc > 2 ? atoi(argv[2]) : 4;
+    hooks = std::max(2, std::min(hooks, MAX_HOOKS));
+    callerThreads = std::max(0, callerThreads);
+
+    void* code = mmap(nullptr, CODE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED || Hooks::Initialize() != Hooks::Status::Ok)
+    {
+        printf("hook_bench: cannot map code or initialize hooks\n");
+        return 1;
+    }
+    Emitter e = { static_cast<uint8_t*>(code), 0 };
+
+    // Data read through RIP-relative operands
+    e.Align(16);
+    uint8_t* constant = e.Here();
+    e.U32(7);
+
+    std::vector<Case> cases;
+
+    // mov eax, edi; add eax, 1; ret
+    e.Align(16);
+    cases.push_back({ "simple prologue", e.Here(), { 1, 5 }, { 2, 6 }, nullptr });
+    e.Bytes({ 0x89, 0xF8, 0x83, 0xC0, 0x01, 0xC3 });
+
+    // mov eax, [rip+constant]; add eax, edi; ret
+    e.Align(16);
+    cases.push_back({ "rip-relative mov", e.Here(), { 1, 5 }, { 8, 12 }, nullptr });
+    e.Bytes({ 0x8B, 0x05 }); e.Rel32To(constant); e.Bytes({ 0x01, 0xF8, 0xC3 });
+
+    // test edi, edi; jz L; lea eax, [rdi+5]; ret; L: mov eax, 42; ret
+    e.Align(16);
+    cases.push_back({ "jcc out of the patch", e.Here(), { 0, 3 }, { 42, 8 }, nullptr });
+    e.Bytes({ 0x85, 0xFF, 0x74, 0x04, 0x8D, 0x47, 0x05, 0xC3, 0xB8, 0x2A, 0x00, 0x00, 0x00, 0xC3 });
+
+    // call H; add eax, edi; ret; H: mov eax, 100; ret
+    e.Align(16);
+    cases.push_back({ "call rel32", e.Here(), { 1, 5 }, { 101, 105 }, nullptr });
+    e.Bytes({ 0xE8 }); e.U32(4); e.Bytes({ 0x01, 0xF8, 0xC3, 0xCC, 0xB8, 0x64, 0x00, 0x00, 0x00, 0xC3 });
+
+    // jmp +3 over padding; lea eax, [rdi+9]; ret
+    e.Align(16);
+    cases.push_back({ "jmp rel8 over padding", e.Here(), { 1, 5 }, { 10, 14 }, nullptr });
+    e.Bytes({ 0xEB, 0x03, 0xCC, 0xCC, 0xCC, 0x8D, 0x47, 0x09, 0xC3 });
+
+    // push rbp; lea rax, [rip+constant]; mov eax, [rax]; add eax, edi; pop rbp; ret
+    e.Align(16);
+    cases.push_back({ "push rbp + rip-relative lea", e.Here(), { 1, 5 }, { 8, 12 }, nullptr });
+    e.Bytes({ 0x55, 0x48, 0x8D, 0x05 }); e.Rel32To(constant); e.Bytes({ 0x8B, 0x00, 0x01, 0xF8, 0x5D, 0xC3 });
+
+    // lea eax, [rdi]; ret - 3 bytes followed by code: jmp rel32 goes into the padding above
+    e.Align(16);
+    e.Bytes({ 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC });
+    cases.push_back({ "patch above (3-byte function)", e.Here(), { 1, 5 }, { 1, 5 }, e.Here() + 3 });
+    e.Bytes({ 0x8D, 0x07, 0xC3 });
+    e.Bytes({ 0xB8, 0x01, 0x00, 0x00, 0x00, 0xC3 });   // neighbour: mov eax, 1; ret
+
+    cases.push_back({ "compiled function", reinterpret_cast<uint8_t*>(&CompiledTarget), { 1, 5 }, { 4, 16 }, nullptr });
+
+    RunCorrectness(e, cases);
+
+    RunBatch(e, hooks, callerThreads);
+
+    Check("shutdown", Hooks::Shutdown() == Hooks::Status::Ok);
+    munmap(code, CODE_SIZE);
+
+    printf("\n%s\n", g_Failures ? "HOOK CHECKS FAILED" : "all hook checks passed");
+    return g_Failures ? 1 : 0;
+}
@@ -0,0 +1,2781 @@
+// Headless overlay benchmark.
+// Runs RenderWatermark / RenderHUD / Console::Render against ImGui with no platform or
+// renderer backend (synthetic DisplaySize, DeltaTime and input) and reports per-frame
+// CPU time, draw data size and heap allocations for scripted interaction scenarios.
+// The objects section drives the live-object registry (modules/objects) with simulated
+// MonoBehaviour lifecycle events and checks it against a reference model.
+// The jobs section stresses the job system (pool exhaustion, nesting, dependencies, several
+// submitting threads, blocking Wait) and measures ParallelFor scaling from 1 to N threads.
+// The raster section renders each scenario's last frame with the software rasterizer
+// (modules/raster) to an image: fill cost, overdraw and golden-image comparison.
+// The commands section checks the console command tokenizer, argument parser and completion.
+// The console-scale section renders the console with 1k, 10k and 100k lines of history.
+// The scheduler section runs module tasks on a simulated clock (rates, stagger, frame budget).
+// The input section feeds synthetic window events to the hotkey dispatcher (modules/input).
+// The log section stresses the multi-producer log ring and measures messages per second,
+// Console::Log against deferred CONSOLE_LOG. The log-sink section checks the background file
+// writer: order on disk, a crash right after an error, window queue overflow, throughput.
+// The signatures section checks the byte-signature scanner (modules/signatures) against a
+// per-pattern reference and measures its throughput over a large synthetic buffer.
+//
+// Usage: overlay_bench [frames] [scenario-name-filter]
+
+#include "../../deps/imgui/imgui.h"
+#include "../../hud/hud.h"
+#include "../../modules/watermark/watermark.h"
+#include "../../modules/console/console.h"
+#include "../../modules/console/log_sink.h"
+#include "../../modules/console/log_index.h"
+#include "../../modules/console/commands.h"
+#include "../../modules/perf/perf.h"
+#include "../../modules/memory/memory.h"
+#include "../../modules/anim/anim.h"
+#include "../../modules/text/text_cache.h"
+#include "../../modules/fonts/fonts.h"
+#include "../../modules/audio/audio.h"
+#include "../../modules/settings/settings.h"
+#include "../../modules/scheduler/scheduler.h"
+#include "../../modules/input/input.h"
+#include "../../modules/raster/raster.h"
+#include "../../modules/objects/object_registry.h"
+#include "../../modules/objects/object_handles.h"
+#include "../../modules/objects/object_components.h"
+#include "../../modules/signatures/signatures.h"
+#include "../../modules/jobs/job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <utility>
+#include <vector>
+#if !defined(_WIN32)
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Synthetic display (matches a common game resolution)
+static const float DISPLAY_W = 1920.0f;
+static const float DISPLAY_H = 1080.0f;
+static const float DELTA_TIME = 1.0f / 144.0f;
+static const int WARMUP_FRAMES = 120;
+
+// HUD layout constants (mirror hud.cpp, used only to aim the scripted mouse)
+static const float PANEL_WIDTH = 234.375f;
+static const float PANEL_HEIGHT = 525.0f;
+static const float PANEL_MARGIN = 12.0f;
+static const float ROWS_Y_OFFSET = 37.5f;
+static const float ROW_HEIGHT = 30.0f;
+
+// Panel origin as placed by InitializeCategories on the synthetic display
+static ImVec2 PanelPos(int panel)
+{
+    float totalWidth = 5 * (PANEL_WIDTH + PANEL_MARGIN) - PANEL_MARGIN;
+    float startX = (DISPLAY_W - totalWidth) * 0.5f;
+    float startY = (DISPLAY_H - PANEL_HEIGHT) * 0.5f;
+    return ImVec2(startX + panel * (PANEL_WIDTH + PANEL_MARGIN), startY);
+}
+
+static ImVec2 RowPos(int panel, int row)
+{
+    ImVec2 pos = PanelPos(panel);
+    return ImVec2(pos.x + PANEL_WIDTH * 0.5f, pos.y + ROWS_Y_OFFSET + ROW_HEIGHT * (row + 0.5f));
+}
+
+static void Click(ImGuiIO& io, ImVec2 pos, int button)
+{
+    io.AddMousePosEvent(pos.x, pos.y);
+    io.AddMouseButtonEvent(button, true);
+}
+
+static void ReleaseButtons(ImGuiIO& io)
+{
+    io.AddMouseButtonEvent(0, false);
+    io.AddMouseButtonEvent(1, false);
+}
+
+static void FillConsole(int count)
+{
+    Console::Clear();
+    for (int i = 0; i < count; )
+    {
+        // The ring holds 4096 entries: drain it in batches
+        for (int k = 0; k < 2048 && i < count; k++, i++)
+        {
+            if (i % 13 == 0)
+                CONSOLE_WARNING("[Bench] slow frame %d: %.2f ms", i, i * 0.01);
+            else
+                CONSOLE_LOG("[Bench] entity %d at (%.1f, %.1f, %.1f)", i, i * 0.5, i * 0.25, i * 0.125);
+        }
+        Console::Update();
+    }
+
+    // Deferred lines enter the search index INDEX_BUDGET per Update: let it catch up,
+    // so the frames that follow measure the window rather than the backlog
+    for (size_t k = 0; k <= (size_t)count / Console::INDEX_BUDGET; k++)
+        Console::Update();
+}
+
+// ============================================================================
+// Scenarios
+// ============================================================================
+
+struct Scenario
+{
+    const char* name;
+    const char* description;
+    void (*setup)();
+    void (*frame)(ImGuiIO& io, int frame);
+};
+
+static void SetupWatermarkOnly()
+{
+    g_ShowMenu = false;
+    if (Console::IsOpen())
+        Console::Toggle();
+}
+
+static void SetupMenu()
+{
+    g_ShowMenu = true;
+    if (Console::IsOpen())
+        Console::Toggle();
+}
+
+static void SetupConsole()
+{
+    g_ShowMenu = false;
+    if (!Console::IsOpen())
+        Console::Toggle();
+    FillConsole(10000);
+}
+
+static void SetupEverything()
+{
+    g_ShowMenu = true;
+    if (!Console::IsOpen())
+        Console::Toggle();
+    FillConsole(10000);
+}
+
+static void IdleFrame(ImGuiIO& io, int)
+{
+    io.AddMousePosEvent(5.0f, DISPLAY_H - 5.0f);
+}
+
+// Sweep over the panels, toggle modules, expand settings, scroll and drag a panel
+static void InteractFrame(ImGuiIO& io, int frame)
+{
+    ReleaseButtons(io);
+
+    int phase = frame % 240;
+    int panel = (frame / 240) % 5;
+    if (phase < 120)
+    {
+        ImVec2 from = RowPos(0, 0);
+        ImVec2 to = RowPos(4, 5);
+        float t = phase / 120.0f;
+        io.AddMousePosEvent(from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t);
+    }
+    else if (phase == 130 || phase == 150)
+    {
+        Click(io, RowPos(panel, 1), 0);
+    }
+    else if (phase == 170)
+    {
+        Click(io, RowPos(4, 0), 1);  // Misc/Watermark has settings
+    }
+    else if (phase >= 180 && phase < 200)
+    {
+        ImVec2 row = RowPos(panel, 2);
+        io.AddMousePosEvent(row.x, row.y);
+        io.AddMouseWheelEvent(0.0f, (phase & 1) ? -1.0f : 1.0f);
+    }
+    else if (phase >= 200 && phase < 236)
+    {
+        // Drag the panel by its title bar and bring it back
+        ImVec2 title = PanelPos(panel);
+        title.x += PANEL_WIDTH * 0.5f;
+        title.y += 15.0f;
+        float dx = (phase < 218 ? (phase - 200) : (236 - phase)) * 4.0f;
+        io.AddMousePosEvent(title.x + dx, title.y + dx * 0.5f);
+        io.AddMouseButtonEvent(0, true);
+    }
+}
+
+// Console open with streaming output and wheel scrolling through the history
+static void ConsoleFrame(ImGuiIO& io, int frame)
+{
+    io.AddMousePosEvent(400.0f, 200.0f);
+    if (frame % 60 < 30)
+        io.AddMouseWheelEvent(0.0f, (frame % 60 < 15) ? 3.0f : -3.0f);
+
+    for (int i = 0; i < 20; i++)
+        CONSOLE_LOG("[Bench] frame %d event %d", frame, i);
+    if (frame % 50 == 0)
+        CONSOLE_ERROR("[Bench] periodic error %d", frame);
+}
+
+static void EverythingFrame(ImGuiIO& io, int frame)
+{
+    ConsoleFrame(io, frame);
+    InteractFrame(io, frame);
+}
+
+static const Scenario g_Scenarios[] = {
+    { "watermark", "menu and console closed", SetupWatermarkOnly, IdleFrame },
+    { "hud-idle", "ClickGUI open, mouse outside panels", SetupMenu, IdleFrame },
+    { "hud-interact", "hover sweep, toggles, expand, wheel, drag", SetupMenu, InteractFrame },
+    { "console", "10k entries, 20 new per frame, wheel scrolling", SetupConsole, ConsoleFrame },
+    { "everything", "ClickGUI interaction + streaming console", SetupEverything, EverythingFrame },
+};
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+struct FrameSample
+{
+    double ms;
+    int vertices;
+    int indices;
+    int commands;
+    uint64_t allocations;  // operator new + ImGui pools
+    uint64_t bytes;
+    uint64_t mallocs;      // calls that reached malloc (operator new + pool pages + arena growth)
+};
+
+static FrameSample RunFrame(const Scenario& scenario, int frame)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(DISPLAY_W, DISPLAY_H);
+    io.DeltaTime = DELTA_TIME;
+    scenario.frame(io, frame);
+
+    Memory::Counters before = Memory::GetCounters();
+    Memory::PoolStats poolBefore = Memory::GetPoolStats();
+    uint64_t arenaBefore = Memory::GetFrameArena().GetHeapAllocations();
+    auto start = std::chrono::steady_clock::now();
+
+    // Same order as hkPresent
+    Memory::BeginFrame();
+    ImGui::NewFrame();
+    Console::Update();
+    Anim::Update(io.DeltaTime);
+    Scheduler::RunFrame();
+    RenderWatermark();
+    RenderHUD();
+    Console::Render();
+    ImGui::Render();
+
+    auto end = std::chrono::steady_clock::now();
+    Memory::Counters after = Memory::GetCounters();
+    Memory::PoolStats poolAfter = Memory::GetPoolStats();
+    uint64_t arenaAfter = Memory::GetFrameArena().GetHeapAllocations();
+
+    // Textures go to the software renderer (copies only when the atlas changes)
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
+    {
+        if (tex->Status != ImTextureStatus_OK)
+            Raster::UpdateTexture(tex);
+    }
+
+    FrameSample sample = {};
+    sample.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    ImDrawData* drawData = ImGui::GetDrawData();
+    sample.vertices = drawData->TotalVtxCount;
+    sample.indices = drawData->TotalIdxCount;
+    for (ImDrawList* list : drawData->CmdLists)
+        sample.commands += list->CmdBuffer.Size;
+    sample.allocations = (after.allocations - before.allocations) + (poolAfter.allocations - poolBefore.allocations);
+    sample.bytes = (after.allocatedBytes - before.allocatedBytes) + (poolAfter.allocatedBytes - poolBefore.allocatedBytes);
+    sample.mallocs = (after.allocations - before.allocations) + (poolAfter.heapAllocations - poolBefore.heapAllocations) +
+        (arenaAfter - arenaBefore);
+    return sample;
+}
+
+static std::vector<char> ReadFile(const char* path)
+{
+    std::vector<char> data;
+    if (FILE* file = fopen(path, "rb"))
+    {
+        fseek(file, 0, SEEK_END);
+        data.resize((size_t)ftell(file));
+        fseek(file, 0, SEEK_SET);
+        if (fread(data.data(), 1, data.size(), file) != data.size())
+            data.clear();
+        fclose(file);
+    }
+    return data;
+}
+
+// Same font setup as hkPresent; the baked atlas is read from the build tree instead of resources
+static std::vector<char> g_FontAtlas;
+
+static void LoadFontAtlas(ImFontAtlas* atlas)
+{
+    g_FontAtlas = ReadFile(FONT_ATLAS_BLOB);
+    Fonts::AddOverlayFont(atlas, g_FontAtlas.data(), g_FontAtlas.size());
+}
+
+// UI sound cues: decode cost, mixer cost per device period and the trigger path
+// through the null sink (a real-time 10 ms device thread)
+static void RunAudio(int frames)
+{
+    static const int CUE_ON = 1, CUE_OFF = 2;
+    static const int PERIOD = 480;   // 10 ms at 48 kHz
+    std::vector<char> on = ReadFile(AUDIO_ASSETS_DIR "/func_on.wav");
+    std::vector<char> off = ReadFile(AUDIO_ASSETS_DIR "/func_off.wav");
+
+    Audio::InitializeHeadless(Audio::DEFAULT_SAMPLE_RATE);
+    auto start = std::chrono::high_resolution_clock::now();
+    bool loaded = Audio::LoadCue(CUE_ON, on.data(), on.size()) && Audio::LoadCue(CUE_OFF, off.data(), off.size());
+    double decodeMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    if (!loaded)
+    {
+        printf("\naudio: cannot decode " AUDIO_ASSETS_DIR "/func_on.wav / func_off.wav\n");
+        Audio::Shutdown();
+        return;
+    }
+
+    Audio::Stats stats = Audio::GetStats();
+    printf("\naudio: %d cues decoded in %.3f ms, %zu KB PCM at %d Hz\n",
+        stats.cues, decodeMs, stats.pcmBytes / 1024, stats.sampleRate);
+
+    // Mixer cost per period with N overlapping voices (topped up as they finish)
+    static float buffer[PERIOD * 2];
+    for (int voices : { 0, 2, 8, 16 })
+    {
+        double total = 0.0;
+        for (int i = 0; i < frames; i++)
+        {
+            for (int v = Audio::GetStats().voices; v < voices; v++)
+                Audio::Play(v & 1 ? CUE_OFF : CUE_ON);
+            auto t0 = std::chrono::high_resolution_clock::now();
+            Audio::Mix(buffer, PERIOD);
+            total += std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - t0).count();
+        }
+        printf("  mix %2d voices  %7.3f us per %d-frame period\n", voices, total / frames, PERIOD);
+    }
+
+    // Trigger latency path: Play from this thread, mixing on the device thread
+    Audio::Shutdown();
+    if (!Audio::Initialize() || !Audio::LoadCue(CUE_ON, on.data(), on.size()))
+    {
+        printf("  no audio device\n");
+        Audio::Shutdown();
+        return;
+    }
+    for (int i = 0; i < 50; i++)
+    {
+        Audio::Play(CUE_ON);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    stats = Audio::GetStats();
+    printf("  device: %llu triggered, %llu dropped, %llu stolen, peak %d voices, %llu frames mixed\n",
+        (unsigned long long)stats.triggered, (unsigned long long)stats.dropped, (unsigned long long)stats.stolen,
+        stats.peakVoices, (unsigned long long)stats.mixedFrames);
+    Audio::Shutdown();
+}
+
+// Settings file: encode/decode cost, debounced background save and recovery from
+// damaged, newer and older-layout files
+static Settings::Snapshot MakeSettings()
+{
+    Settings::Snapshot snapshot = {};
+    snapshot.overlay.watermark = 1;
+    snapshot.overlay.menuKey = 0x2D;
+    snapshot.panelCount = 6;
+    snapshot.moduleCount = 20;
+    for (int i = 0; i < snapshot.panelCount; i++)
+        snapshot.panels[i] = { 1000u + i, 100.0f * i, 50.0f, 7.5f * i };
+    for (int i = 0; i < snapshot.moduleCount; i++)
+        snapshot.modules[i] = { 2000u + i, (uint8_t)(i & 1), (uint8_t)(i % 3 == 0), 0 };
+    return snapshot;
+}
+
+// The file an older/newer build would write: same records, other record sizes
+static std::vector<uint8_t> EncodeWithRecordSizes(const Settings::Snapshot& snapshot, size_t overlaySize, size_t panelSize, size_t moduleSize)
+{
+    std::vector<uint8_t> file(sizeof(Settings::FileHeader));
+    auto append = [&file](const void* record, size_t recordSize, size_t size) {
+        size_t start = file.size();
+        file.resize(start + size, 0xAB);   // fields unknown to this build
+        memcpy(&file[start], record, (std::min)(recordSize, size));
+    };
+    append(&snapshot.overlay, sizeof(snapshot.overlay), overlaySize);
+    for (int i = 0; i < snapshot.panelCount; i++)
+        append(&snapshot.panels[i], sizeof(Settings::PanelRecord), panelSize);
+    for (int i = 0; i < snapshot.moduleCount; i++)
+        append(&snapshot.modules[i], sizeof(Settings::ModuleRecord), moduleSize);
+
+    Settings::FileHeader header = {};
+    header.magic = Settings::FILE_MAGIC;
+    header.version = Settings::FILE_VERSION;
+    header.fileSize = (uint32_t)file.size();
+    header.checksum = Settings::HashBytes(file.data() + sizeof(header), file.size() - sizeof(header));
+    header.overlaySize = (uint16_t)overlaySize;
+    header.panelSize = (uint16_t)panelSize;
+    header.moduleSize = (uint16_t)moduleSize;
+    header.panelCount = (uint16_t)snapshot.panelCount;
+    header.moduleCount = (uint16_t)snapshot.moduleCount;
+    memcpy(file.data(), &header, sizeof(header));
+    return file;
+}
+
+static void RunSettings(int frames)
+{
+    using Settings::LoadResult;
+    static const char* const RESULTS[] = { "loaded", "migrated", "missing", "corrupt", "unsupported" };
+    const Settings::Snapshot saved = MakeSettings();
+    static uint8_t file[Settings::MAX_FILE_SIZE];
+    size_t size = Settings::Encode(saved, 1, file);
+
+    Settings::Snapshot snapshot = {};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < frames; i++)
+        Settings::Decode(file, size, snapshot);
+    double decodeUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / frames;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < frames; i++)
+        Settings::Encode(snapshot, 1, file);
+    double encodeUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / frames;
+    printf("\nsettings: %zu-byte file, decode %.3f us, encode %.3f us\n", size, decodeUs, encodeUs);
+
+    int failures = 0;
+    auto check = [&failures](const char* name, LoadResult result, LoadResult expected, bool valuesOk) {
+        bool ok = result == expected && valuesOk;
+        failures += ok ? 0 : 1;
+        printf("  %-28s %-12s %s\n", name, RESULTS[(int)result], ok ? "ok" : "FAIL");
+    };
+
+    // Damaged files must leave the defaults untouched
+    const Settings::Snapshot defaults = {};
+    auto decodeDamaged = [&](const char* name, std::vector<uint8_t> bytes, LoadResult expected) {
+        Settings::Snapshot out = defaults;
+        LoadResult result = Settings::Decode(bytes.data(), bytes.size(), out);
+        check(name, result, expected, memcmp(&out, &defaults, sizeof(out)) == 0);
+    };
+    std::vector<uint8_t> good(file, file + size);
+    std::vector<uint8_t> bytes = good;
+    bytes[size / 2] ^= 0x10;
+    decodeDamaged("flipped bit", bytes, LoadResult::Corrupt);
+    decodeDamaged("truncated", std::vector<uint8_t>(good.begin(), good.end() - 5), LoadResult::Corrupt);
+    decodeDamaged("empty header", std::vector<uint8_t>(good.begin(), good.begin() + 8), LoadResult::Corrupt);
+    bytes = good;
+    bytes[0] = 'X';
+    decodeDamaged("bad magic", bytes, LoadResult::Corrupt);
+    bytes = good;
+    bytes[4] = (uint8_t)(Settings::FILE_VERSION + 1);
+    decodeDamaged("newer version", bytes, LoadResult::Unsupported);
+
+    // Older layout (records without scroll / expanded): the new fields keep their defaults
+    std::vector<uint8_t> older = EncodeWithRecordSizes(saved, 4, 12, 5);
+    Settings::Snapshot migrated = {};
+    migrated.overlay.menuKey = 0x2E;
+    LoadResult result = Settings::Decode(older.data(), older.size(), migrated);
+    check("older record layout", result, LoadResult::Migrated,
+        migrated.overlay.menuKey == 0x2E && migrated.panels[3].posX == saved.panels[3].posX &&
+        migrated.panels[3].scroll == 0.0f && migrated.modules[1].enabled == 1 && migrated.modules[3].expanded == 0);
+
+    // Newer layout (extra fields at the end of each record) are skipped
+    std::vector<uint8_t> newer = EncodeWithRecordSizes(saved, 12, 24, 16);
+    migrated = {};
+    result = Settings::Decode(newer.data(), newer.size(), migrated);
+    check("newer record layout", result, LoadResult::Migrated, memcmp(&migrated, &saved, sizeof(saved)) == 0);
+
+    // Debounced save through the writer thread, then a clean reload
+    std::string path = std::string(BENCH_OUTPUT_DIR) + "/overlay_bench.settings";
+    remove(path.c_str());
+    snapshot = {};
+    result = Settings::Load(path.c_str(), snapshot);
+    check("first run", result, LoadResult::Missing, true);
+
+    Settings::Snapshot live = saved;
+    double now = 0.0;
+    for (int i = 0; i < 60; i++, now += DELTA_TIME)
+    {
+        live.panels[0].posX = (float)i;   // dragging: no write while it keeps changing
+        Settings::Update(live, now);
+    }
+    uint64_t savesWhileDragging = Settings::GetStats().saves;
+    for (; now < 60 * DELTA_TIME + Settings::SAVE_DELAY + 0.1; now += DELTA_TIME)
+        Settings::Update(live, now);
+    Settings::Shutdown();
+    Settings::Stats stats = Settings::GetStats();
+    printf("  debounce: %llu saves while dragging, %llu after %.1f s idle, last save %.3f ms\n",
+        (unsigned long long)savesWhileDragging, (unsigned long long)stats.saves, Settings::SAVE_DELAY, stats.lastSaveMs);
+
+    snapshot = {};
+    result = Settings::Load(path.c_str(), snapshot);
+    check("reload", result, LoadResult::Loaded, memcmp(&snapshot, &live, sizeof(live)) == 0 && stats.saves == 1);
+    Settings::Shutdown();
+
+    FILE* damaged = fopen(path.c_str(), "r+b");
+    if (damaged)
+    {
+        fseek(damaged, -3, SEEK_END);
+        fputc(0x5A, damaged);
+        fclose(damaged);
+    }
+    snapshot = defaults;
+    result = Settings::Load(path.c_str(), snapshot);
+    check("reload damaged file", result, LoadResult::Corrupt, memcmp(&snapshot, &defaults, sizeof(snapshot)) == 0);
+    Settings::Shutdown();
+    remove(path.c_str());
+
+    printf("  %s\n", failures ? "RECOVERY CHECKS FAILED" : "all recovery checks passed");
+}
+
+// Scheduler on a simulated clock: each task advances the clock by its configured cost,
+// so rates, phase stagger, budget deferral and MAX_DEFER_FRAMES are checked exactly;
+// then the real cost of RunFrame with a full task table
+static const int SIM_TASKS = 16;
+static double g_SimTime = 0.0;
+static double g_SimCostMs[SIM_TASKS];
+static uint64_t g_SimRuns[SIM_TASKS];
+static uint64_t g_SimTrace = 0;
+
+static double SimClock()
+{
+    return g_SimTime;
+}
+
+template<int N>
+static void SimTask()
+{
+    g_SimRuns[N]++;
+    g_SimTime += g_SimCostMs[N] / 1000.0;
+    g_SimTrace = (g_SimTrace ^ (uint64_t)(N + 1)) * 1099511628211ull;
+}
+
+template<int... N>
+static const Scheduler::TaskFn* MakeSimTasks(std::integer_sequence<int, N...>)
+{
+    static const Scheduler::TaskFn tasks[] = { &SimTask<N>... };
+    return tasks;
+}
+
+static const Scheduler::TaskFn* SimTasks()
+{
+    return MakeSimTasks(std::make_integer_sequence<int, SIM_TASKS>());
+}
+
+static void EmptyTask()
+{
+}
+
+static void SimReset(float budgetMs)
+{
+    Scheduler::Reset();
+    Scheduler::SetClock(SimClock);
+    Scheduler::SetFrameBudget(budgetMs);
+    g_SimTime = 1000.0;
+    g_SimTrace = 14695981039346656037ull;
+    memset(g_SimCostMs, 0, sizeof(g_SimCostMs));
+    memset(g_SimRuns, 0, sizeof(g_SimRuns));
+}
+
+static int SimRegister(int n, Scheduler::TickMode mode, float rateHz = 0.0f, double costMs = 0.0)
+{
+    g_SimCostMs[n] = costMs;
+    return Scheduler::Register({ "sim", SimTasks()[n], mode, rateHz });
+}
+
+// Fixed frame rate: the next frame starts one period after this one, or when the tasks end
+static void SimFrame(double frameSeconds)
+{
+    double start = g_SimTime;
+    Scheduler::RunFrame();
+    g_SimTime = std::max(g_SimTime, start + frameSeconds);
+}
+
+static void RunScheduler(int frames)
+{
+    using Scheduler::TickMode;
+    const double FRAME_60 = 1.0 / 60.0;
+    printf("\nscheduler: simulated clock, %d-task table\n", Scheduler::MAX_TASKS);
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+    auto near = [](uint64_t value, uint64_t expected) {
+        return value + 1 >= expected && value <= expected + 1;
+    };
+
+    // 10 s at 60 fps
+    SimReset(0.0f);
+    SimRegister(0, TickMode::EveryFrame);
+    SimRegister(1, TickMode::FixedRate, 10.0f);
+    SimRegister(2, TickMode::FixedRate, 30.0f);
+    SimRegister(3, TickMode::FixedRate, 144.0f);
+    for (int i = 0; i < 600; i++)
+        SimFrame(FRAME_60);
+    check("every frame", g_SimRuns[0] == 600);
+    check("fixed rate 10 / 30 Hz", near(g_SimRuns[1], 100) && near(g_SimRuns[2], 300));
+    check("rate above frame rate", near(g_SimRuns[3], 600));
+
+    // Same rate, different phases: never all four in one frame
+    SimReset(0.0f);
+    for (int n = 0; n < 4; n++)
+        SimRegister(n, TickMode::FixedRate, 10.0f);
+    int maxPerFrame = 0;
+    for (int i = 0; i < 600; i++)
+    {
+        SimFrame(FRAME_60);
+        maxPerFrame = std::max(maxPerFrame, Scheduler::GetFrameStats().executed);
+    }
+    printf("  stagger: 4 tasks at 10 Hz, at most %d in one frame\n", maxPerFrame);
+    check("phase stagger", maxPerFrame <= 2 && g_SimRuns[0] + g_SimRuns[1] + g_SimRuns[2] + g_SimRuns[3] >= 398);
+
+    // Signals: one run per frame however often it was signalled, none without a signal
+    SimReset(0.0f);
+    int event = SimRegister(0, TickMode::OnEvent);
+    bool eventOk = true;
+    for (int i = 0; i < 100; i++)
+    {
+        if (i == 10 || i == 50 || i == 90)
+            Scheduler::Signal(event);
+        if (i == 50)
+            Scheduler::Signal(event);
+        uint64_t before = g_SimRuns[0];
+        SimFrame(FRAME_60);
+        bool signalled = i == 10 || i == 50 || i == 90;
+        eventOk &= g_SimRuns[0] - before == (signalled ? 1u : 0u);
+    }
+    check("on event", eventOk && g_SimRuns[0] == 3);
+
+    // Disabled tasks are skipped; a re-enabled fixed-rate task gets a fresh phase
+    SimReset(0.0f);
+    int every = SimRegister(0, TickMode::EveryFrame);
+    int fixed = SimRegister(1, TickMode::FixedRate, 10.0f);
+    Scheduler::SetEnabled(every, false);
+    Scheduler::SetEnabled(fixed, false);
+    for (int i = 0; i < 120; i++)
+        SimFrame(FRAME_60);
+    bool disabledOk = g_SimRuns[0] == 0 && g_SimRuns[1] == 0 && !Scheduler::GetTaskStats(every).enabled;
+    Scheduler::SetEnabled(every, true);
+    Scheduler::SetEnabled(fixed, true);
+    for (int i = 0; i < 120; i++)
+        SimFrame(FRAME_60);
+    check("disable / enable", disabledOk && g_SimRuns[0] == 120 && near(g_SimRuns[1], 20));
+
+    // A 5 s stall (breakpoint, loading screen) runs a fixed-rate task once, not 50 times
+    SimReset(0.0f);
+    SimRegister(0, TickMode::FixedRate, 10.0f);
+    for (int i = 0; i < 60; i++)
+        SimFrame(FRAME_60);
+    uint64_t beforeStall = g_SimRuns[0];
+    g_SimTime += 5.0;
+    SimFrame(FRAME_60);
+    uint64_t afterStall = g_SimRuns[0];
+    for (int i = 0; i < 60; i++)
+        SimFrame(FRAME_60);
+    check("stall without catch-up", afterStall - beforeStall == 1 && near(g_SimRuns[0] - afterStall, 10));
+
+    // Over budget: 2 ms per frame, 1.5 ms tasks. Every frame runs at least one task and
+    // no task waits more than MAX_DEFER_FRAMES frames in a row
+    for (int taskCount : { 4, 12 })
+    {
+        SimReset(2.0f);
+        for (int n = 0; n < taskCount; n++)
+            SimRegister(n, TickMode::EveryFrame, 0.0f, 1.5);
+        int waiting[SIM_TASKS] = {};
+        int longestWait = 0;
+        bool progress = true;
+        uint64_t executed = 0;
+        for (int i = 0; i < 600; i++)
+        {
+            uint64_t before[SIM_TASKS];
+            memcpy(before, g_SimRuns, sizeof(before));
+            SimFrame(FRAME_60);
+            const Scheduler::FrameStats& frame = Scheduler::GetFrameStats();
+            progress &= frame.executed >= 1 && frame.executed + frame.deferred == taskCount;
+            executed += frame.executed;
+            for (int n = 0; n < taskCount; n++)
+            {
+                waiting[n] = g_SimRuns[n] == before[n] ? waiting[n] + 1 : 0;
+                longestWait = std::max(longestWait, waiting[n]);
+            }
+        }
+        printf("  budget: %2d x 1.5 ms tasks, %.2f run per frame, longest wait %d frames\n",
+            taskCount, (double)executed / 600, longestWait);
+        check(taskCount == 4 ? "budget deferral" : "budget MAX_DEFER_FRAMES", progress && longestWait <= Scheduler::MAX_DEFER_FRAMES);
+    }
+
+    // Same script, same clock: same order of task runs
+    uint64_t traces[2];
+    for (uint64_t& trace : traces)
+    {
+        SimReset(2.0f);
+        SimRegister(0, TickMode::EveryFrame, 0.0f, 0.4);
+        SimRegister(1, TickMode::FixedRate, 10.0f, 1.2);
+        SimRegister(2, TickMode::FixedRate, 30.0f, 0.7);
+        int signalled = SimRegister(3, TickMode::OnEvent, 0.0f, 0.9);
+        SimRegister(4, TickMode::FixedRate, 60.0f, 0.5);
+        for (int i = 0; i < 600; i++)
+        {
+            if (i % 7 == 0)
+                Scheduler::Signal(signalled);
+            SimFrame(FRAME_60);
+        }
+        trace = g_SimTrace;
+    }
+    check("deterministic order", traces[0] == traces[1]);
+
+    // Real clock: bookkeeping cost of a full table
+    for (TickMode mode : { TickMode::EveryFrame, TickMode::FixedRate })
+    {
+        Scheduler::Reset();
+        Scheduler::SetClock(nullptr);
+        Scheduler::SetFrameBudget(0.0f);
+        for (int n = 0; n < Scheduler::MAX_TASKS; n++)
+            Scheduler::Register({ "empty", EmptyTask, mode, 10.0f });
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < frames; i++)
+            Scheduler::RunFrame();
+        double us = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / frames;
+        printf("  RunFrame, %d %s tasks: %.3f us\n", Scheduler::MAX_TASKS, mode == TickMode::EveryFrame ? "every-frame" : "10 Hz", us);
+    }
+
+    Scheduler::Reset();
+    Scheduler::SetClock(nullptr);
+    Scheduler::SetFrameBudget(2.0f);
+    RegisterHUDTasks();
+
+    printf("  %s\n", failures ? "SCHEDULER CHECKS FAILED" : "all scheduler checks passed");
+}
+
+// Hotkeys on synthetic window events: edge detection (OS key repeat ignored), exact
+// modifier chords, auto-repeat timing, focus loss, queue overflow, a window thread feeding
+// the queue while frames drain it, and the cost per event
+static void CountAction(void* user)
+{
+    (*static_cast<int*>(user))++;
+}
+
+static void PushKey(Input::EventType type, uint16_t code)
+{
+    Input::Event event = {};
+    event.type = type;
+    event.code = code;
+    Input::PushEvent(event);
+}
+
+static void KeyDown(uint16_t code) { PushKey(Input::EventType::KeyDown, code); }
+static void KeyUp(uint16_t code) { PushKey(Input::EventType::KeyUp, code); }
+
+static int BindCounter(uint16_t key, uint8_t mods, int* counter, float repeatDelay = 0.0f, float repeatInterval = 0.1f)
+{
+    Input::Binding binding;
+    binding.key = key;
+    binding.mods = mods;
+    binding.action = CountAction;
+    binding.user = counter;
+    binding.repeatDelay = repeatDelay;
+    binding.repeatInterval = repeatInterval;
+    return Input::Bind(binding);
+}
+
+static void RunInput(int frames)
+{
+    using namespace Input;
+    const double FRAME = 1.0 / 60.0;
+    printf("\ninput: synthetic window events, %d bindings max\n", MAX_BINDINGS);
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+    double now = 0.0;
+    auto frame = [&now, FRAME]() {
+        ProcessEvents(now);
+        now += FRAME;
+    };
+
+    // Edge: held key with OS auto-repeat (repeated WM_KEYDOWN) fires once per press
+    Reset();
+    int del = 0;
+    BindCounter(KEY_DELETE, Mod_None, &del);
+    KeyDown(KEY_DELETE);
+    for (int i = 0; i < 5; i++)
+        KeyDown(KEY_DELETE);
+    frame();
+    bool heldOnce = del == 1 && IsKeyDown(KEY_DELETE);
+    KeyUp(KEY_DELETE);
+    KeyUp(KEY_DELETE);   // stray key-up
+    KeyDown(KEY_DELETE);
+    KeyUp(KEY_DELETE);   // press and release within one frame still counts
+    frame();
+    check("edge trigger", heldOnce && del == 2 && !IsKeyDown(KEY_DELETE));
+
+    // Chords match modifiers exactly
+    Reset();
+    int plain = 0, ctrl = 0, ctrlShift = 0;
+    BindCounter(KEY_F1, Mod_None, &plain);
+    BindCounter(KEY_F1, Mod_Ctrl, &ctrl);
+    BindCounter(KEY_F1, Mod_Ctrl | Mod_Shift, &ctrlShift);
+    KeyDown(KEY_F1); KeyUp(KEY_F1);
+    KeyDown(KEY_CONTROL); KeyDown(KEY_F1); KeyUp(KEY_F1);
+    KeyDown(KEY_SHIFT); KeyDown(KEY_F1); KeyUp(KEY_F1);
+    KeyDown(KEY_MENU); KeyDown(KEY_F1); KeyUp(KEY_F1);   // Ctrl+Shift+Alt: nothing
+    KeyUp(KEY_MENU); KeyUp(KEY_SHIFT); KeyUp(KEY_CONTROL);
+    frame();
+    check("exact modifiers", plain == 1 && ctrl == 1 && ctrlShift == 1 && GetModifiers() == Mod_None);
+
+    // Modifiers count at the moment the key goes down
+    KeyDown(KEY_F1); KeyDown(KEY_CONTROL); KeyUp(KEY_F1); KeyUp(KEY_CONTROL);
+    frame();
+    check("modifier after key", plain == 2 && ctrl == 1);
+
+    // Mouse buttons bind like keys
+    int click = 0;
+    BindCounter(KEY_RBUTTON, Mod_Shift, &click);
+    PushKey(EventType::MouseDown, KEY_RBUTTON); PushKey(EventType::MouseUp, KEY_RBUTTON);
+    KeyDown(KEY_SHIFT);
+    PushKey(EventType::MouseDown, KEY_RBUTTON); PushKey(EventType::MouseUp, KEY_RBUTTON);
+    KeyUp(KEY_SHIFT);
+    frame();
+    check("mouse chord", click == 1);
+
+    // Auto-repeat: first action on press, then every interval after the delay, none after release
+    Reset();
+    int repeat = 0;
+    BindCounter(KEY_INSERT, Mod_None, &repeat, 0.5f, 0.1f);
+    now = 0.0;
+    KeyDown(KEY_INSERT);
+    while (now < 1.0 + FRAME / 2)
+    {
+        frame();
+        if (now < 1.0)
+            KeyDown(KEY_INSERT);   // OS repeat while held
+    }
+    int whileHeld = repeat;
+    KeyUp(KEY_INSERT);
+    for (int i = 0; i < 60; i++)
+        frame();
+    printf("  auto-repeat: %d actions in 1 s held (delay 0.5 s, interval 0.1 s)\n", whileHeld);
+    check("auto-repeat", whileHeld >= 6 && whileHeld <= 7 && repeat == whileHeld);
+
+    // Focus loss releases everything: no stuck modifier, no endless repeat
+    KeyDown(KEY_CONTROL);
+    KeyDown(KEY_INSERT);   // Ctrl+Insert: not bound
+    KeyUp(KEY_CONTROL);
+    KeyDown(KEY_INSERT);   // still held from before: no edge
+    frame();
+    int beforeFocus = repeat;
+    Event lost = {};
+    lost.type = EventType::FocusLost;
+    PushEvent(lost);
+    frame();
+    bool released = !IsKeyDown(KEY_INSERT) && GetModifiers() == Mod_None;
+    KeyDown(KEY_INSERT);
+    frame();
+    KeyUp(KEY_INSERT);
+    frame();
+    check("focus lost", beforeFocus == whileHeld && released && repeat == whileHeld + 1);
+
+    // Unbind keeps the other chords of the key
+    Reset();
+    int a = 0, b = 0;
+    int idA = BindCounter(KEY_F1, Mod_None, &a);
+    BindCounter(KEY_F1, Mod_Alt, &b);
+    Unbind(idA);
+    KeyDown(KEY_F1); KeyUp(KEY_F1);
+    KeyDown(KEY_MENU); KeyDown(KEY_F1); KeyUp(KEY_F1); KeyUp(KEY_MENU);
+    frame();
+    check("unbind", a == 0 && b == 1);
+
+    // Overflow: events past the queue capacity are dropped and counted, the rest still apply
+    uint64_t droppedBefore = GetDroppedEvents();
+    int accepted = 0;
+    Event down = {};
+    down.type = EventType::KeyDown;
+    down.code = KEY_F1;
+    Event up = down;
+    up.type = EventType::KeyUp;
+    for (int i = 0; i < 1500; i++)
+        accepted += PushEvent(i % 2 ? up : down) ? 1 : 0;
+    frame();
+    uint64_t dropped = GetDroppedEvents() - droppedBefore;
+    printf("  overflow: %d of 1500 queued, %llu dropped\n", accepted, (unsigned long long)dropped);
+    check("queue overflow", dropped == (uint64_t)(1500 - accepted) && b == 1 && a == 0 && !IsKeyDown(KEY_F1));
+
+    // Window thread pushing while the render thread drains once per "frame"
+    Reset();
+    int presses = 0;
+    BindCounter(KEY_DELETE, Mod_Ctrl, &presses);
+    const int PRESSES = 20000;
+    std::atomic<bool> producing(true);
+    std::thread window([&]() {
+        auto push = [](EventType type, uint16_t code) {
+            Event event = {};
+            event.type = type;
+            event.code = code;
+            while (!PushEvent(event))
+                std::this_thread::yield();
+        };
+        push(EventType::KeyDown, KEY_CONTROL);
+        for (int i = 0; i < PRESSES; i++)
+        {
+            push(EventType::KeyDown, KEY_DELETE);
+            push(EventType::KeyDown, KEY_DELETE);
+            push(EventType::KeyUp, KEY_DELETE);
+        }
+        push(EventType::KeyUp, KEY_CONTROL);
+        producing.store(false, std::memory_order_release);
+    });
+    while (producing.load(std::memory_order_acquire))
+    {
+        frame();
+        std::this_thread::yield();
+    }
+    window.join();
+    frame();
+    check("window thread", presses == PRESSES && GetModifiers() == Mod_None);
+
+    // Cost: full binding table, a frame's worth of mixed events
+    Reset();
+    int sink = 0;
+    for (int i = 0; i < MAX_BINDINGS; i++)
+        BindCounter((uint16_t)(0x41 + i % 26), (uint8_t)(i / 26), &sink, i % 4 == 0 ? 0.3f : 0.0f);
+    const int EVENTS_PER_FRAME = 256;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++)
+    {
+        for (int i = 0; i < EVENTS_PER_FRAME / 2; i++)
+        {
+            uint16_t key = (uint16_t)(0x41 + (f * 7 + i) % 26);
+            KeyDown(key);
+            KeyUp(key);
+        }
+        frame();
+    }
+    double eventNs = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() /
+        ((double)frames * EVENTS_PER_FRAME);
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++)
+        frame();
+    double idleNs = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / frames;
+    printf("  push + process: %.1f ns per event (%d bindings), idle ProcessEvents %.1f ns\n", eventNs, MAX_BINDINGS, idleNs);
+    Reset();
+
+    printf("  %s\n", failures ? "INPUT CHECKS FAILED" : "all input checks passed");
+}
+
+// Log ring under contention: several producer threads and one consumer, checked for loss,
+// duplicates and per-producer order (with retry on a full ring, then with drops), then
+// messages per second into the ring and through Console::Log -> Console::Update
+static const int LOG_PRODUCERS = 4;
+static Console::LogRing<4096> g_BenchRing;
+
+struct RingMessage
+{
+    uint32_t producer;
+    uint32_t index;
+};
+
+struct RingRun
+{
+    uint64_t produced = 0;
+    uint64_t received = 0;
+    uint64_t dropped = 0;
+    bool ordered = true;     // per producer: strictly increasing, no duplicates
+    bool complete = true;    // every message of every producer arrived
+    double ms = 0.0;
+};
+
+// retry: producers spin on a full ring instead of dropping; consumerDelay: the consumer
+// sleeps between batches (sink thread busy with disk)
+static RingRun RunRing(int producers, uint32_t perProducer, bool retry, int consumerDelayUs)
+{
+    RingRun run;
+    uint64_t droppedBefore = g_BenchRing.GetDropped();
+    std::atomic<int> running(producers);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([p, perProducer, retry, &running]() {
+            for (uint32_t i = 0; i < perProducer; i++)
+            {
+                uint64_t ticket = 0;
+                Console::LogSlot* slot = g_BenchRing.Reserve(ticket);
+                while (!slot && retry)
+                {
+                    std::this_thread::yield();
+                    slot = g_BenchRing.Reserve(ticket);
+                }
+                if (!slot)
+                    continue;
+                RingMessage message = { (uint32_t)p, i };
+                memcpy(slot->text, &message, sizeof(message));
+                slot->length = sizeof(message);
+                slot->formatter = nullptr;
+                slot->type = 0;
+                g_BenchRing.Commit(slot, ticket);
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    std::vector<int64_t> last(producers, -1);
+    std::vector<uint32_t> counts(producers, 0);
+    for (;;)
+    {
+        bool done = running.load(std::memory_order_acquire) == 0;
+        int batch = 0;
+        while (Console::LogSlot* slot = g_BenchRing.Peek())
+        {
+            RingMessage message;
+            memcpy(&message, slot->text, sizeof(message));
+            g_BenchRing.Release(slot);
+            if (message.producer >= (uint32_t)producers || (int64_t)message.index <= last[message.producer])
+            {
+                run.ordered = false;
+                continue;
+            }
+            last[message.producer] = message.index;
+            counts[message.producer]++;
+            run.received++;
+            batch++;
+        }
+        if (done && !batch)
+            break;
+        if (consumerDelayUs > 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(consumerDelayUs));
+        else if (!batch)
+            std::this_thread::yield();
+    }
+    run.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    for (std::thread& thread : threads)
+        thread.join();
+
+    run.produced = (uint64_t)producers * perProducer;
+    run.dropped = g_BenchRing.GetDropped() - droppedBefore;
+    for (int p = 0; p < producers; p++)
+        run.complete &= counts[p] == perProducer;
+    return run;
+}
+
+// Window messages for the search index check: numbering starts just below 2^32
+static const uint64_t INDEX_BASE = (1ull << 32) - 8;
+static const char* const INDEX_TEXT[] = { "player spawned", "enemy spawned", "player died" };
+
+static bool IndexLookup(uint64_t seq, Console::LogView& out)
+{
+    out.text = INDEX_TEXT[seq % 3];
+    out.length = strlen(out.text);
+    out.lines = 1;
+    out.type = (uint8_t)(seq % 3 == 2 ? 2 : 0);
+    return true;
+}
+
+// A full console window of distinct lines for the first-query timing
+static std::vector<std::string> g_WindowTexts;
+
+static bool WindowLookup(uint64_t seq, Console::LogView& out)
+{
+    const std::string& text = g_WindowTexts[seq % g_WindowTexts.size()];
+    out.text = text.c_str();
+    out.length = text.size();
+    out.lines = 1;
+    out.type = 0;
+    return true;
+}
+
+// Time of the first text query over a full window. textOnAppend: Add gets the formatted
+// text; otherwise the text comes through lookup, batch per frame (0 - all in the query)
+static double FirstQueryMs(bool textOnAppend, size_t batch, double& addNs, int& batches, double& batchMs)
+{
+    Console::LogIndex index(Console::MAX_LOGS, WindowLookup);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (uint64_t seq = 0; seq < Console::MAX_LOGS; seq++)
+    {
+        const std::string& text = g_WindowTexts[seq];
+        if (textOnAppend)
+            index.Add(seq, 0, text.c_str(), text.size());
+        else
+            index.Add(seq, 0);
+        index.SetOldest(0);
+    }
+    addNs = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / Console::MAX_LOGS;
+
+    batches = 0;
+    batchMs = 0.0;
+    if (!textOnAppend && batch)
+    {
+        start = std::chrono::high_resolution_clock::now();
+        for (uint64_t done = 0; done < Console::MAX_LOGS; done += batch)
+        {
+            index.IndexPending(batch);
+            batches++;
+        }
+        batchMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / batches;
+    }
+
+    index.SetQuery("unit 4242 ", false, Console::Severity_All);
+    return index.GetResultCount() == 1 ? index.GetLastQueryMs() : -1.0;
+}
+
+static void RunLog(int frames)
+{
+    printf("\nlog: ring of 4096 slots, %d producers\n", LOG_PRODUCERS);
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+
+    RingRun lossless = RunRing(LOG_PRODUCERS, 200000, true, 0);
+    check("MPSC: no loss, in order", lossless.ordered && lossless.complete && lossless.received == lossless.produced);
+
+    // Slow consumer, producers never wait: every message either arrives or is counted
+    RingRun dropping = RunRing(LOG_PRODUCERS, 50000, false, 200);
+    printf("  overflow: %llu of %llu delivered, %llu dropped\n", (unsigned long long)dropping.received,
+        (unsigned long long)dropping.produced, (unsigned long long)dropping.dropped);
+    check("MPSC: drops accounted", dropping.ordered && dropping.dropped > 0 &&
+        dropping.received + dropping.dropped == dropping.produced);
+
+    // Throughput into the ring with a consumer keeping up
+    printf("  %-28s %12s\n", "producers", "msgs/s");
+    for (int producers : { 1, 2, LOG_PRODUCERS })
+    {
+        RingRun run = RunRing(producers, 400000 / producers, true, 0);
+        printf("  %-28d %12.0f%s\n", producers, run.received / (run.ms / 1000.0),
+            run.ordered && run.complete ? "" : "  FAIL");
+        failures += run.ordered && run.complete ? 0 : 1;
+    }
+
+    // Deferred text is identical to what snprintf builds on the calling thread
+    unsigned char payload[Console::LOG_TEXT_SIZE];
+    char deferred[Console::LOG_TEXT_SIZE], direct[Console::LOG_TEXT_SIZE];
+    Console::Deferred::EncodeArgs(payload, sizeof(payload), 42, 0.5, "player");
+    Console::Deferred::Format<int, double, const char*>("[Bench] %d %.2f %s", payload, deferred, sizeof(deferred));
+    snprintf(direct, sizeof(direct), "[Bench] %d %.2f %s", 42, 0.5, "player");
+    check("deferred: same text", strcmp(deferred, direct) == 0);
+
+    // Search index: sequence numbers crossing 2^32, a bad regex stays reported every frame
+    Console::LogIndex index(64, IndexLookup);
+    size_t players = 0;
+    for (uint64_t seq = INDEX_BASE; seq < INDEX_BASE + 48; seq++)
+    {
+        index.Add(seq, (uint8_t)(seq % 3 == 2 ? 2 : 0));
+        index.SetOldest(INDEX_BASE);
+        players += seq % 3 != 1;
+    }
+    index.SetQuery("player", false, Console::Severity_All);
+    check("index: past 2^32", index.GetResultCount() == players &&
+        index.GetResult(players - 1) > (1ull << 32));
+    bool firstBad = index.SetQuery("pla(yer", true, Console::Severity_All);
+    bool stillBad = index.SetQuery("pla(yer", true, Console::Severity_All);
+    size_t badResults = index.GetResultCount();
+    bool fixed = index.SetQuery("pla.er", true, Console::Severity_All);
+    check("index: bad regex remembered", !firstBad && !stillBad && badResults == 0 &&
+        fixed && index.GetResultCount() == players);
+
+    // Literals inside groups are not required: the trigram prefilter must not take them
+    size_t died = 0;
+    for (uint64_t seq = INDEX_BASE; seq < INDEX_BASE + 48; seq++)
+        died += seq % 3 == 2;
+    index.SetQuery("(enemy )?died", true, Console::Severity_All);
+    size_t optional = index.GetResultCount();
+    index.SetQuery("(?!enemy)pl", true, Console::Severity_All);
+    size_t negated = index.GetResultCount();
+    index.SetQuery("(spawned)*player", true, Console::Severity_All);
+    size_t repeated = index.GetResultCount();
+    printf("  regex groups: optional %zu/%zu, negated %zu/%zu, repeated %zu/%zu\n",
+        optional, died, negated, players, repeated, players);
+    check("index: groups not required", optional == died && negated == players && repeated == players);
+
+    // First text query over a full window: formatted lines are indexed as they arrive,
+    // deferred ones in per-frame batches; without that the query parses the whole history
+    g_WindowTexts.resize(Console::MAX_LOGS);
+    for (size_t i = 0; i < Console::MAX_LOGS; i++)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "[Objects] unit %zu moved to cell %zu", i, (i * 7919) % 1000);
+        g_WindowTexts[i] = text;
+    }
+    double appendNs = 0.0, lazyNs = 0.0, batchNs = 0.0, frameMs = 0.0, unusedMs = 0.0;
+    int batches = 0, unused = 0;
+    double appendMs = FirstQueryMs(true, 0, appendNs, unused, unusedMs);
+    double lazyMs = FirstQueryMs(false, 0, lazyNs, unused, unusedMs);
+    double batchMs = FirstQueryMs(false, Console::INDEX_BUDGET, batchNs, batches, frameMs);
+    printf("  first query over %zu lines: text on append %.0f ns/line added, query %.3f ms\n",
+        Console::MAX_LOGS, appendNs, appendMs);
+    printf("    deferred, all in the query: %.1f ms\n", lazyMs);
+    printf("    deferred, %zu per frame: %d frames of %.3f ms, then query %.3f ms\n",
+        Console::INDEX_BUDGET, batches, frameMs, batchMs);
+    check("index: first query < 1 ms", appendMs >= 0.0 && appendMs < 1.0 && batchMs >= 0.0 && batchMs < 1.0);
+    g_WindowTexts.clear();
+    g_WindowTexts.shrink_to_fit();
+
+    // Console::Log formats on the calling thread; CONSOLE_LOG only copies the arguments,
+    // and Update keeps them as arguments until the line is shown (mirror off, no sink).
+    // Both go ring -> Console::Update (window buffer + search index), one thread
+    const int BATCH = 2048;
+    int rounds = std::max(20, frames / 20);
+    printf("  %-28s %12s %12s %12s\n", "caller", "log ns/msg", "update ns", "msgs/s");
+    for (int deferredLog = 0; deferredLog < 2; deferredLog++)
+    {
+        Console::Clear();
+        uint64_t droppedBefore = Console::GetDroppedCount();
+        double logSeconds = 0.0, updateSeconds = 0.0;
+        for (int r = 0; r < rounds; r++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (deferredLog)
+            {
+                for (int i = 0; i < BATCH; i++)
+                    CONSOLE_LOG("[Bench] entity %d at (%.1f, %.1f)", i, i * 0.5, i * 0.25);
+            }
+            else
+            {
+                for (int i = 0; i < BATCH; i++)
+                    Console::Log("[Bench] entity %d at (%.1f, %.1f)", i, i * 0.5, i * 0.25);
+            }
+            auto logged = std::chrono::steady_clock::now();
+            Console::Update();
+            auto updated = std::chrono::steady_clock::now();
+            logSeconds += std::chrono::duration<double>(logged - start).count();
+            updateSeconds += std::chrono::duration<double>(updated - logged).count();
+        }
+        double messages = (double)rounds * BATCH;
+        printf("  %-28s %12.1f %12.1f %12.0f\n", deferredLog ? "CONSOLE_LOG" : "Console::Log",
+            logSeconds * 1e9 / messages, updateSeconds * 1e9 / messages, messages / (logSeconds + updateSeconds));
+        check(deferredLog ? "deferred: nothing dropped" : "direct: nothing dropped",
+            Console::GetDroppedCount() == droppedBefore);
+    }
+    Console::Clear();
+
+    printf("  %s\n", failures ? "LOG CHECKS FAILED" : "all log checks passed");
+}
+
+// Lines "[   t] [Sink] <n>" / "[   t] [ERROR] [Sink] <n>" of a sink file, in file order
+static std::vector<int> ReadSinkLines(const std::string& path)
+{
+    std::vector<int> numbers;
+    std::vector<char> data = ReadFile(path.c_str());
+    data.push_back('\0');
+    for (const char* line = data.data(); *line; )
+    {
+        const char* tag = strstr(line, "[Sink] ");
+        const char* end = strchr(line, '\n');
+        if (tag && (!end || tag < end))
+            numbers.push_back(atoi(tag + 7));
+        if (!end)
+            break;
+        line = end + 1;
+    }
+    return numbers;
+}
+
+static bool IsSequence(const std::vector<int>& numbers, int first, size_t count)
+{
+    if (numbers.size() < count)
+        return false;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (numbers[i] != first + (int)i)
+            return false;
+    }
+    return true;
+}
+
+static void RemoveSinkFiles(const std::string& path)
+{
+    remove(path.c_str());
+    for (int i = 1; i <= 3; i++)
+        remove((path + "." + std::to_string(i)).c_str());
+}
+
+// Waits for the sink thread (it polls the ring every 5 ms)
+static bool WaitFor(bool (*done)(uint64_t), uint64_t arg)
+{
+    for (int i = 0; i < 200 && !done(arg); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    return done(arg);
+}
+
+// File sink (Console::StartFileSink): order on disk, what survives a crash, window queue
+// overflow accounting, and throughput of the file writer and of the logging thread
+static void RunLogSink(int frames)
+{
+    printf("\nlog-sink: background file writer (%s)\n", BENCH_OUTPUT_DIR);
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+
+    std::string path = std::string(BENCH_OUTPUT_DIR) + "/overlay_bench.log";
+    RemoveSinkFiles(path);
+    Console::Update();
+
+    // Order: batches paced like frames, the render thread drains the window queue
+    const int BATCH = 1024;
+    int rounds = std::max(20, frames / 20);
+    uint64_t ringBefore = Console::GetDroppedCount();
+    uint64_t windowBefore = Console::GetWindowDroppedCount();
+    double logSeconds = 0.0, worstBatch = 0.0;
+    check("sink: started", Console::StartFileSink(path.c_str(), 64 * 1024 * 1024, 0));
+    for (int r = 0; r < rounds; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < BATCH; i++)
+            Console::Log("[Sink] %d entity at (%.1f, %.1f)", r * BATCH + i, i * 0.5, i * 0.25);
+        double batch = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        logSeconds += batch;
+        worstBatch = std::max(worstBatch, batch);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(8));
+        Console::Update();
+    }
+    Console::StopFileSink();
+    Console::Update();
+
+    int produced = rounds * BATCH;
+    uint64_t ringDropped = Console::GetDroppedCount() - ringBefore;
+    std::vector<int> lines = ReadSinkLines(path);
+    printf("  %d logged, %zu in the file, %llu dropped on ring overflow\n", produced, lines.size(),
+        (unsigned long long)ringDropped);
+    bool ordered = std::is_sorted(lines.begin(), lines.end()) &&
+        std::adjacent_find(lines.begin(), lines.end()) == lines.end();
+    check("file: in order", ordered);
+    check("file: drops accounted", lines.size() + ringDropped == (uint64_t)produced);
+    check("window: kept up", Console::GetWindowDroppedCount() == windowBefore);
+    printf("  caller while the sink writes: %.1f ns/msg avg, %.1f ns/msg worst batch\n",
+        logSeconds * 1e9 / produced, worstBatch * 1e9 / BATCH);
+
+    // Window queue overflow: the render thread does not drain it, the file gets everything
+    RemoveSinkFiles(path);
+    const int BURST = 3000;  // fits the ring (4096), not the window queue (2048)
+    windowBefore = Console::GetWindowDroppedCount();
+    Console::StartFileSink(path.c_str());
+    for (int i = 0; i < BURST; i++)
+        Console::Log("[Sink] %d", i);
+    bool counted = WaitFor([](uint64_t before) {
+        return Console::GetWindowDroppedCount() - before >= (uint64_t)(BURST - 2048);
+    }, windowBefore);
+    Console::StopFileSink();
+    uint64_t windowDropped = Console::GetWindowDroppedCount() - windowBefore;
+    Console::Update();
+    printf("  window queue overflow: %llu of %d not shown, %zu in the file\n",
+        (unsigned long long)windowDropped, BURST, ReadSinkLines(path).size());
+    check("window: drops counted", counted && windowDropped == (uint64_t)(BURST - 2048));
+    check("window: file complete", IsSequence(ReadSinkLines(path), 0, BURST));
+
+#if !defined(_WIN32)
+    // Crash: the child logs, an error forces a flush, then it is killed with more lines
+    // still in the stdio buffer. Everything up to the error must be on disk
+    RemoveSinkFiles(path);
+    const int BEFORE_ERROR = 1000;
+    fflush(stdout);
+    pid_t child = fork();
+    if (child == 0)
+    {
+        if (!Console::StartFileSink(path.c_str()))
+            _exit(2);
+        for (int i = 0; i < BEFORE_ERROR; i++)
+            Console::Log("[Sink] %d", i);
+        Console::Error("[Sink] %d", BEFORE_ERROR);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        for (int i = BEFORE_ERROR + 1; i < BEFORE_ERROR + 100; i++)
+            Console::Log("[Sink] %d", i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        raise(SIGKILL);
+        _exit(3);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    lines = ReadSinkLines(path);
+    printf("  crash: %zu lines on disk, %d logged up to the error\n", lines.size(), BEFORE_ERROR + 1);
+    check("crash: child killed", WIFSIGNALED(status) && WTERMSIG(status) == SIGKILL);
+    check("crash: error flushed", IsSequence(lines, 0, BEFORE_ERROR + 1));
+#endif
+
+    // The writer alone: formatted lines through the 256 KB buffer, rotation every 8 MB
+    RemoveSinkFiles(path);
+    Console::LogFile file;
+    const int LINES = 500000;
+    char line[Console::LOG_TEXT_SIZE + 32];
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    if (file.Open(path.c_str(), 8 * 1024 * 1024, 1))
+    {
+        for (int i = 0; i < LINES; i++)
+        {
+            int length = snprintf(line, sizeof(line), "[%10.3f] [Sink] %d entity at (%.1f, %.1f)\n",
+                i * 0.001, i, i * 0.5, i * 0.25);
+            file.Write(line, (size_t)length);
+            bytes += (size_t)length;
+        }
+        file.Flush();
+        file.Close();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("  file writer: %.0f lines/s, %.1f MB/s\n", LINES / seconds, bytes / seconds / (1024.0 * 1024.0));
+    std::vector<int> current = ReadSinkLines(path);
+    std::vector<int> backup = ReadSinkLines(path + ".1");
+    check("rotation: newest kept", !current.empty() && !backup.empty() && current.back() == LINES - 1 &&
+        backup.back() + 1 == current.front());
+    RemoveSinkFiles(path);
+
+    printf("  %s\n", failures ? "LOG-SINK CHECKS FAILED" : "all log-sink checks passed");
+}
+
+// Simulated MonoBehaviour lifecycle against the live-object registry: spawn / toggle /
+// destroy churn, checked every frame against a reference model, plus the cost of walking
+// one class through the registry vs a FindObjectsOfType-style scan of every object
+static volatile uintptr_t g_ObjectSink;
+
+static void RunObjects(int frames)
+{
+    using Objects::Event;
+    struct SimClass
+    {
+        const char* name;
+        uint32_t events;
+        Objects::ClassId id;
+    };
+    SimClass classes[] = {
+        { "Player", Objects::ALL_EVENTS, 0 },
+        { "Projectile", Objects::ALL_EVENTS, 0 },
+        { "Pickup", Objects::EventBit(Event::Awake) | Objects::EventBit(Event::OnDestroy), 0 },
+        { "Door", Objects::EventBit(Event::OnEnable) | Objects::EventBit(Event::OnDisable), 0 },
+    };
+    const int classCount = (int)(sizeof(classes) / sizeof(classes[0]));
+    Objects::Reset();
+    for (SimClass& cls : classes)
+        cls.id = Objects::RegisterClass(cls.name, cls.events);
+
+    // Object storage: real addresses, the slot index doubles as the model key
+    struct SimObject
+    {
+        int cls;
+        bool alive;
+        bool enabled;
+        bool visible;   // what the registry should report for the class's hooks
+    };
+    const int OBJECT_SLOTS = 20000;
+    const size_t OBJECT_SIZE = 64;
+    std::vector<uint8_t> arena(OBJECT_SLOTS * OBJECT_SIZE);
+    std::vector<SimObject> objects(OBJECT_SLOTS, SimObject{ 0, false, false, false });
+    auto address = [&](int i) { return (void*)(arena.data() + i * OBJECT_SIZE); };
+    auto indexOf = [&](void* p) { return (int)(((uint8_t*)p - arena.data()) / OBJECT_SIZE); };
+
+    uint64_t events = 0;
+    auto send = [&](int i, Event event) {
+        const SimClass& cls = classes[objects[i].cls];
+        if (cls.events & Objects::EventBit(event))
+        {
+            Objects::OnEvent(cls.id, address(i), event);
+            events++;
+        }
+    };
+    auto has = [&](const SimClass& cls, Event event) { return (cls.events & Objects::EventBit(event)) != 0; };
+
+    uint32_t rng = 0x9E3779B9u;
+    auto next = [&rng]() { rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; };
+
+    int failures = 0;
+    int badFrames = 0;
+    double eventMs = 0.0;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int op = 0; op < 200; op++)
+        {
+            int i = (int)(next() % OBJECT_SLOTS);
+            SimObject& obj = objects[i];
+            const uint32_t roll = next() % 100;
+            if (!obj.alive)
+            {
+                // Instantiate: Awake, then OnEnable unless spawned inactive
+                obj.cls = (int)(next() % classCount);
+                obj.alive = true;
+                obj.enabled = roll < 80;
+                send(i, Event::Awake);
+                if (obj.enabled)
+                    send(i, Event::OnEnable);
+            }
+            else if (roll < 40)
+            {
+                // Destroy: OnDisable first when active
+                if (obj.enabled)
+                    send(i, Event::OnDisable);
+                send(i, Event::OnDestroy);
+                obj.alive = obj.enabled = false;
+            }
+            else
+            {
+                obj.enabled = !obj.enabled;
+                send(i, obj.enabled ? Event::OnEnable : Event::OnDisable);
+            }
+
+            // What the registry can know through the hooks this class has
+            const SimClass& cls = classes[obj.cls];
+            if (!has(cls, Event::OnEnable))
+                obj.visible = obj.alive;                  // Awake/OnDestroy only: live = enabled
+            else if (!has(cls, Event::OnDestroy))
+                obj.visible = obj.alive && obj.enabled;   // OnEnable/OnDisable only
+            else
+                obj.visible = obj.alive;
+        }
+        // Stray events for objects the registry never saw are ignored
+        if (frame % 16 == 0)
+            Objects::OnEvent(classes[0].id, &rng, Event::OnDestroy);
+        eventMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        // Registry vs model
+        bool ok = true;
+        Objects::ScopedLock lock;
+        for (int c = 0; c < classCount; c++)
+        {
+            uint32_t live = 0, enabled = 0;
+            for (int i = 0; i < OBJECT_SLOTS; i++)
+            {
+                if (objects[i].cls != c || !objects[i].visible)
+                    continue;
+                live++;
+                bool reportsEnabled = !has(classes[c], Event::OnEnable) || objects[i].enabled;
+                enabled += reportsEnabled ? 1 : 0;
+            }
+            Objects::Span all = Objects::GetAll(classes[c].id);
+            Objects::Span active = Objects::GetEnabled(classes[c].id);
+            ok &= all.count == live && active.count == enabled;
+            for (uint32_t k = 0; ok && k < all.count; k++)
+            {
+                const SimObject& obj = objects[indexOf(all[k])];
+                bool shouldBeEnabled = !has(classes[c], Event::OnEnable) || obj.enabled;
+                ok &= obj.cls == c && obj.visible && (k < active.count) == shouldBeEnabled;
+            }
+        }
+        badFrames += ok ? 0 : 1;
+    }
+    printf("\nobjects: %d classes, %llu events over %d frames, %.1f ns/event (with the simulation)\n", classCount,
+        (unsigned long long)events, frames, events ? eventMs * 1e6 / (double)events : 0.0);
+    for (const SimClass& cls : classes)
+    {
+        Objects::ClassStats stats = Objects::GetClassStats(cls.id);
+        printf("  %-12s live %5u  enabled %5u  events %8llu  ignored %llu\n", stats.name, stats.live, stats.enabled,
+            (unsigned long long)stats.received, (unsigned long long)stats.ignored);
+    }
+    failures += badFrames ? 1 : 0;
+    printf("  %-28s %d bad frame(s) %s\n", "registry matches model", badFrames, badFrames ? "FAIL" : "ok");
+
+    // Walking the enabled projectiles: dense array vs scan of every object into a new array
+    const int WALKS = 2000;
+    uintptr_t sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int w = 0; w < WALKS; w++)
+    {
+        Objects::ScopedLock lock;
+        for (void* instance : Objects::GetEnabled(classes[1].id))
+            sink += (uintptr_t)instance;
+    }
+    double registryUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / WALKS;
+    start = std::chrono::high_resolution_clock::now();
+    for (int w = 0; w < WALKS; w++)
+    {
+        std::vector<void*> found;
+        for (int i = 0; i < OBJECT_SLOTS; i++)
+        {
+            if (objects[i].alive && objects[i].enabled && objects[i].cls == 1)
+                found.push_back(address(i));
+        }
+        for (void* instance : found)
+            sink -= (uintptr_t)instance;
+    }
+    double scanUs = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start).count() / WALKS;
+    Objects::ClassStats projectiles = Objects::GetClassStats(classes[1].id);
+    g_ObjectSink = sink;
+    printf("  walk %u enabled %s: registry %.2f us, scan of %d objects %.2f us\n", projectiles.enabled,
+        classes[1].name, registryUs, OBJECT_SLOTS, scanUs);
+
+    // Scene unload without OnDestroy
+    Objects::Clear();
+    bool cleared = true;
+    for (const SimClass& cls : classes)
+        cleared &= Objects::GetClassStats(cls.id).live == 0;
+    failures += cleared ? 0 : 1;
+    printf("  %-28s %s\n", "clear", cleared ? "ok" : "FAIL");
+    Objects::Reset();
+
+    // Weak handles: the arena objects get a fake native pointer at m_CachedPtr
+    auto setNative = [&](int i, uintptr_t native) { memcpy(arena.data() + i * OBJECT_SIZE + Objects::CACHED_PTR_OFFSET, &native, sizeof(native)); };
+    auto checkHandles = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+    const int HANDLES = 1000;
+    std::vector<Objects::Handle> handles(HANDLES);
+    for (int i = 0; i < HANDLES; i++)
+    {
+        setNative(i, 0x10000 + (uintptr_t)i * 0x100);
+        handles[i] = Objects::Acquire(address(i));
+    }
+    bool resolved = true;
+    for (int i = 0; i < HANDLES; i++)
+        resolved &= Objects::Get(handles[i]) == address(i);
+    checkHandles("handle resolves", resolved);
+
+    setNative(7, 0);   // Object.Destroy clears m_CachedPtr
+    setNative(8, 0xDEAD00);   // another native object at the same managed address
+    checkHandles("destroyed object", !Objects::Get(handles[7]) && !Objects::Get(handles[8]) && Objects::Get(handles[9]));
+    checkHandles("acquire destroyed object", Objects::Acquire(address(7)).IsNull() && Objects::Acquire(nullptr).IsNull());
+
+    Objects::Release(handles[10]);
+    setNative(HANDLES, 0x20000);
+    Objects::Handle reused = Objects::Acquire(address(HANDLES));
+    checkHandles("released slot reused", !Objects::Get(handles[10]) && Objects::Get(reused) == address(HANDLES));
+
+    const int GETS = 1000000;
+    start = std::chrono::high_resolution_clock::now();
+    for (int g = 0; g < GETS; g++)
+        sink += (uintptr_t)Objects::Get(handles[g % HANDLES]);
+    double getNs = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / GETS;
+    g_ObjectSink = sink;
+
+    Objects::InvalidateAll();   // scene change
+    bool expired = true;
+    for (int i = 0; i < HANDLES; i++)
+        expired &= Objects::Get(handles[i]) == nullptr;
+    Objects::Handle after = Objects::Acquire(address(0));
+    Objects::HandleStats handleStats = Objects::GetHandleStats();
+    checkHandles("scene change", expired && Objects::Get(after) == address(0) && handleStats.live == 1);
+    Objects::Release(after);
+    printf("  handle check %.1f ns, peak %u of %u slots\n", getNs, handleStats.peak, Objects::MAX_HANDLES);
+
+    // Component cache: 10 game objects with two component types each. The lookup stands in
+    // for GetComponentsInternal and, like Unity, finds nothing for a destroyed component
+    const int GAME_OBJECTS = 10;
+    void* const types[2] = { &classes[0], &classes[1] };
+    auto componentOf = [&](int gameObject, int type) { return 100 + gameObject * 2 + type; };
+    int lookups = 0;
+    auto lookup = [&](void* gameObject, void* type) -> void* {
+        lookups++;
+        int index = componentOf(indexOf(gameObject), type == types[0] ? 0 : 1);
+        uintptr_t native;
+        memcpy(&native, arena.data() + index * OBJECT_SIZE + Objects::CACHED_PTR_OFFSET, sizeof(native));
+        return native ? address(index) : nullptr;
+    };
+    std::vector<Objects::Handle> gameObjects(GAME_OBJECTS);
+    for (int i = 0; i < GAME_OBJECTS; i++)
+    {
+        setNative(i, 0x30000 + (uintptr_t)i * 0x100);
+        setNative(componentOf(i, 0), 0x40000 + (uintptr_t)i * 0x100);
+        setNative(componentOf(i, 1), 0x50000 + (uintptr_t)i * 0x100);
+        gameObjects[i] = Objects::Acquire(address(i));
+    }
+    auto queryAll = [&]() {
+        bool found = true;
+        for (int i = 0; i < GAME_OBJECTS; i++)
+            for (int t = 0; t < 2; t++)
+                found &= Objects::CachedComponent(gameObjects[i], types[t], lookup) == address(componentOf(i, t));
+        return found;
+    };
+    bool found = queryAll() && queryAll() && queryAll();
+    checkHandles("component cache hit", found && lookups == GAME_OBJECTS * 2);
+
+    setNative(componentOf(3, 1), 0);   // Destroy(component)
+    lookups = 0;
+    void* destroyed = Objects::CachedComponent(gameObjects[3], types[1], lookup);
+    setNative(componentOf(3, 1), 0x60000);   // AddComponent: a new native object at the same address
+    void* added = Objects::CachedComponent(gameObjects[3], types[1], lookup);
+    checkHandles("destroyed component", !destroyed && added == address(componentOf(3, 1)) && lookups == 2);
+
+    Objects::Release(gameObjects[5]);   // another game object takes the slot
+    Objects::Handle old = gameObjects[5];
+    gameObjects[5] = Objects::Acquire(address(5));
+    lookups = 0;
+    checkHandles("game object slot reused", gameObjects[5].index == old.index &&
+        !Objects::CachedComponent(old, types[0], lookup) && queryAll() && lookups == 2);
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int g = 0; g < GETS; g++)
+        sink += (uintptr_t)Objects::CachedComponent(gameObjects[g % GAME_OBJECTS], types[g & 1], lookup);
+    double hitNs = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / GETS;
+    g_ObjectSink = sink;
+
+    Objects::InvalidateAll();
+    bool sceneChange = true;
+    for (int i = 0; i < GAME_OBJECTS; i++)
+        sceneChange &= !Objects::CachedComponent(gameObjects[i], types[0], lookup);
+    for (int i = 0; i < GAME_OBJECTS; i++)
+        gameObjects[i] = Objects::Acquire(address(i));
+    lookups = 0;
+    checkHandles("component cache scene change", sceneChange && queryAll() && lookups == GAME_OBJECTS * 2);
+    Objects::ComponentCacheStats cacheStats = Objects::GetComponentCacheStats();
+    printf("  cached component %.1f ns; %llu hits, %llu misses (%llu stale)\n", hitNs,
+        (unsigned long long)cacheStats.hits, (unsigned long long)cacheStats.misses, (unsigned long long)cacheStats.stale);
+    Objects::ClearComponentCache();
+
+    printf("  %s\n", failures ? "REGISTRY CHECKS FAILED" : "all registry checks passed");
+}
+
+// Code-like bytes: half from the opcodes and operands that dominate x64 code, half uniform,
+// so the anchor filter sees realistic pair frequencies
+static uint64_t g_SigRandom = 0x9E3779B97F4A7C15ull;
+
+static uint64_t NextRandom()
+{
+    g_SigRandom ^= g_SigRandom << 13;
+    g_SigRandom ^= g_SigRandom >> 7;
+    g_SigRandom ^= g_SigRandom << 17;
+    return g_SigRandom;
+}
+
+static void FillCode(uint8_t* bytes, size_t size)
+{
+    static const uint8_t COMMON[16] = { 0x48, 0x8B, 0x89, 0x00, 0xFF, 0xCC, 0xE8, 0x0F,
+                                        0x83, 0x85, 0xC0, 0x24, 0x44, 0x4C, 0x8D, 0x01 };
+    for (size_t i = 0; i < size; i += 4)
+    {
+        uint64_t r = NextRandom();
+        for (size_t k = 0; k < 4 && i + k < size; k++, r >>= 16)
+            bytes[i + k] = (r & 0x8000) ? COMMON[r & 15] : (uint8_t)(r >> 4);
+    }
+}
+
+// Random pattern of 8..23 bytes; every third one has a rel32 wildcard, as in call/mov sigs
+struct BenchPattern
+{
+    char ida[Signatures::MAX_PATTERN_LENGTH * 3 + 1];
+    Signatures::Pattern compiled;
+};
+
+static BenchPattern MakePattern(int index)
+{
+    BenchPattern pattern = {};
+    int length = 8 + (int)(NextRandom() % 16);
+    char* p = pattern.ida;
+    for (int i = 0; i < length; i++)
+    {
+        bool wildcard = index % 3 == 0 && i >= 3 && i < 7;
+        p += wildcard ? sprintf(p, i ? " ??" : "??") : sprintf(p, i ? " %02X" : "%02X", (unsigned)(NextRandom() & 0xFF));
+    }
+    Signatures::Compile(pattern.ida, pattern.compiled);
+    return pattern;
+}
+
+// Writes the pattern at offset, wildcards filled with random bytes
+static void Plant(uint8_t* bytes, size_t offset, const Signatures::Pattern& pattern)
+{
+    for (int i = 0; i < pattern.length; i++)
+        bytes[offset + i] = pattern.mask[i] ? pattern.bytes[i] : (uint8_t)NextRandom();
+}
+
+// One pattern at a time, every start position: what the scanner must agree with
+static Signatures::Match ReferenceScan(const uint8_t* base, const Signatures::Region* regions, int regionCount,
+    const Signatures::Pattern& pattern)
+{
+    Signatures::Match match;
+    for (int r = 0; r < regionCount; r++)
+    {
+        size_t end = regions[r].offset + regions[r].size;
+        for (size_t s = regions[r].offset; s + pattern.length <= end; s++)
+        {
+            int i = 0;
+            while (i < pattern.length && !((base[s + i] ^ pattern.bytes[i]) & pattern.mask[i]))
+                i++;
+            if (i < pattern.length)
+                continue;
+            if (match.offset < 0)
+                match.offset = (int64_t)s;
+            match.count++;
+        }
+    }
+    return match;
+}
+
+static void WriteU16(uint8_t* p, uint16_t value) { memcpy(p, &value, sizeof(value)); }
+static void WriteU32(uint8_t* p, uint32_t value) { memcpy(p, &value, sizeof(value)); }
+
+// Minimal PE32+ image as the loader maps it: headers, then sections at their RVAs
+struct BenchSection
+{
+    const char* name;
+    uint32_t rva;
+    uint32_t size;
+    bool executable;
+};
+
+static void BuildImage(std::vector<uint8_t>& image, const BenchSection* sections, int count, uint32_t timeStamp)
+{
+    const uint32_t NT = 0x80, OPTIONAL_SIZE = 240;
+    WriteU16(&image[0], 0x5A4D);
+    WriteU32(&image[0x3C], NT);
+    WriteU32(&image[NT], 0x00004550);
+    WriteU16(&image[NT + 4], 0x8664);
+    WriteU16(&image[NT + 6], (uint16_t)count);
+    WriteU32(&image[NT + 8], timeStamp);
+    WriteU16(&image[NT + 20], (uint16_t)OPTIONAL_SIZE);
+    WriteU16(&image[NT + 24], 0x20B);
+    WriteU32(&image[NT + 24 + 56], (uint32_t)image.size());
+    for (int s = 0; s < count; s++)
+    {
+        uint8_t* header = &image[NT + 24 + OPTIONAL_SIZE + s * 40];
+        memset(header, 0, 40);
+        memcpy(header, sections[s].name, strlen(sections[s].name));
+        WriteU32(header + 8, sections[s].size);
+        WriteU32(header + 12, sections[s].rva);
+        WriteU32(header + 16, sections[s].size);
+        WriteU32(header + 36, sections[s].executable ? 0x60000020u : 0x40000040u);
+    }
+}
+
+static void RunSignatures()
+{
+    static const size_t BUFFER_SIZE = 256u << 20;
+    static const size_t CHECK_SIZE = 8u << 20;
+    static const int PATTERNS = 64;
+    static const int PASSES = 3;
+    using Signatures::Backend;
+    using Signatures::Match;
+    using Signatures::Region;
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+
+    const bool avx2 = Signatures::HasAVX2();
+    const Backend defaultBackend = Signatures::GetBackend();
+    std::vector<Backend> backends = { Backend::Scalar };
+    if (avx2)
+        backends.push_back(Backend::AVX2);
+
+    printf("\nsignatures: %d patterns, %zu MB buffer, chunks of %zu KB, AVX2 %s\n",
+        PATTERNS, BUFFER_SIZE >> 20, Signatures::CHUNK_SIZE >> 10, avx2 ? "yes" : "no");
+
+    Signatures::Pattern compiled;
+    check("compile", Signatures::Compile("48 8B 05 ?? ?? ?? ?? e8 ? ? ? ? C3", compiled) &&
+        compiled.length == 13 && compiled.mask[3] == 0 && compiled.mask[12] == 0xFF && compiled.bytes[7] == 0xE8 &&
+        !Signatures::Compile("48 8B 0", compiled) && !Signatures::Compile("48 XX", compiled) &&
+        !Signatures::Compile("?? ??", compiled) && !Signatures::Compile("488B", compiled) && !Signatures::Compile("", compiled));
+
+    Signatures::PatternSet set;
+    std::vector<BenchPattern> patterns;
+    for (int i = 0; i < PATTERNS; i++)
+    {
+        patterns.push_back(MakePattern(i));
+        Signatures::Add(set, patterns.back().ida);
+    }
+
+    // Check buffer: two regions with a gap, plants on chunk and region edges. Every
+    // pattern's first match and count must equal the per-pattern reference scan
+    std::vector<uint8_t> small(CHECK_SIZE);
+    FillCode(small.data(), small.size());
+    const size_t gapBegin = 3 * Signatures::CHUNK_SIZE + 5, gapEnd = gapBegin + 100;
+    const Region smallRegions[] = { { 0, gapBegin }, { gapEnd, CHECK_SIZE - gapEnd } };
+    for (int i = 0; i < PATTERNS; i++)
+    {
+        const Signatures::Pattern& pattern = set.patterns[i];
+        if (i % 8 == 7)
+            continue;   // not planted
+        Plant(small.data(), (size_t)(i + 1) * (CHECK_SIZE / (PATTERNS + 2)) + NextRandom() % 4096, pattern);
+        Plant(small.data(), CHECK_SIZE - 64 * (i + 1) - NextRandom() % 32, pattern);
+    }
+    Plant(small.data(), Signatures::CHUNK_SIZE - 3, set.patterns[1]);                       // across a chunk edge
+    Plant(small.data(), 2 * Signatures::CHUNK_SIZE - set.patterns[2].anchor - 1, set.patterns[2]);   // anchor pair across it
+    Plant(small.data(), gapBegin - set.patterns[4].length, set.patterns[4]);                // ends at the region end
+    Plant(small.data(), gapBegin - 2, set.patterns[5]);                                     // crosses into the gap
+    Plant(small.data(), CHECK_SIZE - set.patterns[6].length, set.patterns[6]);              // last bytes of the buffer
+
+    std::vector<Match> reference(PATTERNS), results(PATTERNS);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < PATTERNS; i++)
+        reference[i] = ReferenceScan(small.data(), smallRegions, 2, set.patterns[i]);
+    double referenceMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    auto sameMatches = [](const Match* a, const Match* b, int count) {
+        for (int i = 0; i < count; i++)
+            if (a[i].offset != b[i].offset || a[i].count != b[i].count)
+                return false;
+        return true;
+    };
+    auto sameResults = [&](const std::vector<Match>& a, const std::vector<Match>& b) {
+        return sameMatches(a.data(), b.data(), PATTERNS);
+    };
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+            Jobs::Initialize();
+        for (Backend backend : backends)
+        {
+            Signatures::SetBackend(backend);
+            Signatures::Scan(set, small.data(), smallRegions, 2, results.data());
+            char name[64];
+            snprintf(name, sizeof(name), "matches reference (%s%s)", backend == Backend::AVX2 ? "AVX2" : "scalar", pass ? ", jobs" : "");
+            check(name, sameResults(results, reference));
+        }
+        if (pass == 1)
+            Jobs::Shutdown();
+    }
+    check("region edges", reference[4].count >= 2 && reference[4].offset >= 0 && reference[1].count >= 1 &&
+        reference[2].count >= 1 && reference[6].count >= 3);
+
+    // PE image: only executable sections are scanned, results cached by fingerprint
+    std::vector<uint8_t> imageBytes(0x220000);
+    FillCode(imageBytes.data(), imageBytes.size());
+    const BenchSection sections[] = {
+        { ".text", 0x1000, 0x100000, true },
+        { ".rdata", 0x101000, 0x100000, false },
+        { ".text2", 0x201000, 0x1F000, true },
+    };
+    BuildImage(imageBytes, sections, 3, 0x5F000000);
+    Signatures::PatternSet imageSet;
+    Signatures::Add(imageSet, "DE AD BE EF ?? ?? ?? ?? 13 37 C0 DE");
+    Signatures::Add(imageSet, "FA CE B0 0C 11 22 33 44");
+    Signatures::Add(imageSet, "0B AD F0 0D ?? 55 66 77");
+    Plant(imageBytes.data(), 0x1000 + 0x1234, imageSet.patterns[0]);
+    Plant(imageBytes.data(), 0x101000 + 0x40, imageSet.patterns[1]);
+    Plant(imageBytes.data(), 0x201000 + 0x1F000 - 8, imageSet.patterns[2]);
+    Match imageResults[3], cachedResults[3];
+    Signatures::ClearCache();
+    Signatures::ResetStats();
+    bool scanned = Signatures::ScanImage(imageSet, imageBytes.data(), imageResults);
+    check("executable sections only", scanned && imageResults[0].offset == 0x2234 && imageResults[0].count == 1 &&
+        imageResults[1].offset < 0 && imageResults[2].offset == 0x201000 + 0x1F000 - 8);
+
+    Signatures::ScanImage(imageSet, imageBytes.data(), cachedResults);
+    Signatures::Stats stats = Signatures::GetStats();
+    check("cache hit", stats.scans == 1 && stats.cacheHits == 1 && sameMatches(imageResults, cachedResults, 3));
+
+    std::string cachePath = std::string(BENCH_OUTPUT_DIR) + "/overlay_bench.sigcache";
+    bool saved = Signatures::SaveCache(cachePath.c_str());
+    Signatures::ClearCache();
+    bool loaded = Signatures::LoadCache(cachePath.c_str()) && Signatures::GetCacheSize() == 3;
+    Signatures::ScanImage(imageSet, imageBytes.data(), cachedResults);
+    stats = Signatures::GetStats();
+    check("cache file", saved && loaded && stats.scans == 1 && stats.cacheHits == 2 &&
+        sameMatches(imageResults, cachedResults, 3));
+
+    BuildImage(imageBytes, sections, 3, 0x5F000001);   // another build of the module
+    Signatures::ScanImage(imageSet, imageBytes.data(), cachedResults);
+    stats = Signatures::GetStats();
+    check("new fingerprint rescans", stats.scans == 2 && stats.cacheMisses == 2);
+
+    FILE* file = fopen(cachePath.c_str(), "r+b");
+    if (file)
+    {
+        fseek(file, 20, SEEK_SET);
+        fputc(0x5A, file);
+        fclose(file);
+    }
+    Signatures::ClearCache();
+    check("damaged cache file", file && !Signatures::LoadCache(cachePath.c_str()) && Signatures::GetCacheSize() == 0);
+    remove(cachePath.c_str());
+
+    // Throughput: one pass over the whole buffer for all patterns
+    std::vector<uint8_t> big(BUFFER_SIZE);
+    FillCode(big.data(), big.size());
+    for (int i = 0; i < PATTERNS; i++)
+        Plant(big.data(), (size_t)(i + 1) * (BUFFER_SIZE / (PATTERNS + 2)), set.patterns[i]);
+    const Region bigRegion = { 0, BUFFER_SIZE };
+
+    printf("  %-24s %9s %9s %12s\n", "mode", "ms", "GB/s", "cand/MB");
+    printf("  %-24s %9.2f %9.2f %12s\n", "reference, per pattern", referenceMs * (BUFFER_SIZE / CHECK_SIZE),
+        CHECK_SIZE / (referenceMs * 1e6), "-");
+    std::vector<Match> first;
+    bool agree = true;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+            Jobs::Initialize();
+        for (Backend backend : backends)
+        {
+            Signatures::SetBackend(backend);
+            double best = 0.0;
+            Signatures::ResetStats();
+            for (int i = 0; i < PASSES; i++)
+            {
+                Signatures::Scan(set, big.data(), &bigRegion, 1, results.data());
+                double ms = Signatures::GetStats().lastMs;
+                best = (i == 0 || ms < best) ? ms : best;
+            }
+            stats = Signatures::GetStats();
+            if (first.empty())
+                first = results;
+            agree &= sameResults(results, first);
+
+            char name[64];
+            snprintf(name, sizeof(name), "%s, %s", backend == Backend::AVX2 ? "AVX2" : "scalar",
+                pass ? "jobs" : "1 thread");
+            printf("  %-24s %9.2f %9.2f %12.1f\n", name, best, BUFFER_SIZE / (best * 1e6),
+                (double)stats.candidates / PASSES / (BUFFER_SIZE >> 20));
+        }
+        if (pass == 1)
+        {
+            printf("  jobs: %d worker thread(s) + caller\n", Jobs::GetWorkerCount());
+            Jobs::Shutdown();
+        }
+    }
+    check("backends agree", agree);
+    Signatures::SetBackend(defaultBackend);
+    Signatures::ResetStats();
+
+    printf("  %s\n", failures ? "SIGNATURE CHECKS FAILED" : "all signature checks passed");
+}
+
+// Job system under stress: more jobs in flight than a thread's pool holds, nested
+// ParallelFor, dependency order, several submitting threads and a Wait with nothing to
+// help with; then ParallelFor throughput from 1 to hardware_concurrency threads
+static std::atomic<int> g_JobGate(0);
+
+struct GatedJob
+{
+    std::atomic<int>* runs;
+};
+
+static void GatedJobMain(void* data)
+{
+    while (!g_JobGate.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    static_cast<GatedJob*>(data)->runs->fetch_add(1, std::memory_order_relaxed);
+}
+
+struct OrderedJob
+{
+    std::atomic<int>* clock;
+    int stamp;
+};
+
+static void OrderedJobMain(void* data)
+{
+    OrderedJob* job = static_cast<OrderedJob*>(data);
+    job->stamp = job->clock->fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+static void SleepJobMain(void* data)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(*static_cast<int*>(data)));
+}
+
+// Per-element work for the scaling runs: a few dozen dependent multiplies
+static uint64_t JobWork(uint64_t x)
+{
+    for (int i = 0; i < 32; i++)
+        x = x * 6364136223846793005ull + 1442695040888963407ull;
+    return x;
+}
+
+// A worker job that queues children in its own pool and returns without waiting for them:
+// Shutdown finds them in that worker's deque after the worker has exited
+struct SpawnJob
+{
+    std::atomic<int>* runs;
+    int children;
+    Jobs::Job* parent;
+    std::atomic<bool> spawned;
+};
+
+static void SpawnChildMain(void* data)
+{
+    volatile uint64_t sink = 0;
+    for (int i = 0; i < 500; i++)
+        sink = sink + JobWork((uint64_t)i);
+    static_cast<std::atomic<int>*>(data)->fetch_add(1, std::memory_order_relaxed);
+}
+
+static void SpawnJobMain(void* data)
+{
+    SpawnJob* spawn = static_cast<SpawnJob*>(data);
+    spawn->parent = Jobs::Create(nullptr, nullptr);
+    for (int i = 0; i < spawn->children; i++)
+    {
+        if (Jobs::Job* child = Jobs::Create(SpawnChildMain, &spawn->runs[i], spawn->parent))
+            Jobs::Run(child);
+        else
+            spawn->runs[i].store(1);
+    }
+    Jobs::Run(spawn->parent);
+    spawn->spawned.store(true, std::memory_order_release);
+}
+
+static void RunJobs(int frames)
+{
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+
+    // At least two workers, so stress runs are concurrent even on one core
+    int cores = (int)std::thread::hardware_concurrency();
+    Jobs::Initialize(std::max(2, cores - 1));
+    printf("\njobs: %d worker thread(s) + caller, %zu jobs per thread pool\n", Jobs::GetWorkerCount(), Jobs::JOBS_PER_THREAD);
+    Jobs::Stats before = Jobs::GetStats();
+
+    // Three pools' worth of jobs held open by a gate: once the pool is full Create reports
+    // it instead of reusing a live slot, and every job that was created runs exactly once
+    {
+        const size_t total = Jobs::JOBS_PER_THREAD * 3;
+        std::vector<std::atomic<int>> runs(total);
+        std::vector<GatedJob> data(total);
+        g_JobGate.store(0);
+        Jobs::Job* root = Jobs::Create(nullptr, nullptr);
+        size_t created = 0;
+        std::vector<char> wasCreated(total, 0);
+        for (size_t i = 0; i < total; i++)
+        {
+            runs[i].store(0);
+            data[i].runs = &runs[i];
+            if (Jobs::Job* job = Jobs::Create(GatedJobMain, &data[i], root))
+            {
+                Jobs::Run(job);
+                wasCreated[i] = 1;
+                created++;
+            }
+        }
+        g_JobGate.store(1, std::memory_order_release);
+        Jobs::Run(root);
+        Jobs::Wait(root);
+        bool exact = true;
+        for (size_t i = 0; i < total; i++)
+            exact &= runs[i].load() == wasCreated[i];
+        uint64_t exhausted = Jobs::GetStats().exhausted - before.exhausted;
+        printf("  pool: %zu of %zu jobs created, %llu refused while full\n", created, total, (unsigned long long)exhausted);
+        check("pool exhaustion", exact && exhausted > 0 && created < total);
+
+        // Slots are free again once the jobs finish
+        Jobs::Job* again = Jobs::Create(nullptr, nullptr);
+        check("slots recycled", again != nullptr);
+        Jobs::Run(again);
+        Jobs::Wait(again);
+    }
+
+    // Nested ParallelFor: each element visited exactly once, also when the inner loops
+    // run out of pool slots and fall back to the calling thread
+    {
+        const size_t outer = 64, inner = 20000;
+        std::vector<uint8_t> visits(outer * inner);
+        bool exact = true;
+        for (int pass = 0; pass < 8; pass++)
+        {
+            memset(visits.data(), 0, visits.size());
+            Jobs::ParallelFor(outer, 1, [&](size_t begin, size_t end) {
+                for (size_t o = begin; o < end; o++)
+                {
+                    Jobs::ParallelFor(inner, 64, [&](size_t b, size_t e) {
+                        for (size_t i = b; i < e; i++)
+                            visits[o * inner + i]++;
+                    });
+                }
+            });
+            for (uint8_t v : visits)
+                exact &= v == 1;
+        }
+        check("nested ParallelFor", exact);
+    }
+
+    // Layered graph: every job runs after all of its dependencies
+    {
+        const int LAYERS = 16, WIDTH = 16;
+        std::atomic<int> clock(0);
+        OrderedJob data[LAYERS][WIDTH] = {};
+        Jobs::Job* jobs[LAYERS][WIDTH];
+        bool ordered = true;
+        for (int pass = 0; pass < 50; pass++)
+        {
+            clock.store(0);
+            for (int l = 0; l < LAYERS; l++)
+            {
+                for (int w = 0; w < WIDTH; w++)
+                {
+                    data[l][w] = { &clock, 0 };
+                    jobs[l][w] = Jobs::Create(OrderedJobMain, &data[l][w]);
+                }
+            }
+            // Job (l, w) waits for (l - 1, w) and (l - 1, w + 1)
+            for (int l = 1; l < LAYERS; l++)
+            {
+                for (int w = 0; w < WIDTH; w++)
+                {
+                    Jobs::DependsOn(jobs[l][w], jobs[l - 1][w]);
+                    Jobs::DependsOn(jobs[l][w], jobs[l - 1][(w + 1) % WIDTH]);
+                }
+            }
+            for (int l = LAYERS - 1; l >= 0; l--)
+                for (int w = 0; w < WIDTH; w++)
+                    Jobs::Run(jobs[l][w]);
+            for (int w = 0; w < WIDTH; w++)
+                Jobs::Wait(jobs[LAYERS - 1][w]);
+            for (int l = 1; l < LAYERS; l++)
+            {
+                for (int w = 0; w < WIDTH; w++)
+                {
+                    ordered &= data[l][w].stamp > data[l - 1][w].stamp &&
+                        data[l][w].stamp > data[l - 1][(w + 1) % WIDTH].stamp;
+                }
+            }
+        }
+        check("dependency order", ordered && clock.load() == LAYERS * WIDTH);
+    }
+
+    // Threads outside the pool (render thread, InitHookThread) submit and wait concurrently
+    {
+        const int THREADS = 4;
+        const size_t COUNT = 200000;
+        uint64_t expected = 0;
+        for (size_t i = 0; i < COUNT; i++)
+            expected += JobWork(i) & 0xFF;
+        std::atomic<int> correct(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++)
+        {
+            threads.emplace_back([&]() {
+                bool ok = true;
+                for (int pass = 0; pass < 10; pass++)
+                {
+                    std::atomic<uint64_t> sum(0);
+                    Jobs::ParallelFor(COUNT, 1024, [&](size_t begin, size_t end) {
+                        uint64_t local = 0;
+                        for (size_t i = begin; i < end; i++)
+                            local += JobWork(i) & 0xFF;
+                        sum.fetch_add(local, std::memory_order_relaxed);
+                    });
+                    ok &= sum.load() == expected;
+                }
+                correct.fetch_add(ok ? 1 : 0);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+        check("external threads", correct.load() == THREADS);
+    }
+
+    // A job that sleeps on a worker: the waiting thread blocks instead of spinning
+    {
+        int sleepMs = 60;
+        Jobs::Job* job = Jobs::Create(SleepJobMain, &sleepMs);
+        Jobs::Run(job);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));   // let a worker take it
+        Jobs::Stats waitBefore = Jobs::GetStats();
+        std::clock_t cpuStart = std::clock();
+        auto start = std::chrono::steady_clock::now();
+        Jobs::Wait(job);
+        double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        double cpuMs = 1000.0 * (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        uint64_t blocked = Jobs::GetStats().blockedWaits - waitBefore.blockedWaits;
+        printf("  wait: %.1f ms wall, %.1f ms CPU, slept %llu time(s)\n", wallMs, cpuMs, (unsigned long long)blocked);
+        check("wait blocks", blocked > 0 && cpuMs < wallMs * 0.5);
+    }
+
+    // Shutdown right after a worker queued work in its own deque: the leftover jobs live in
+    // a pool owned by Jobs, run once on the calling thread, and finish their parent
+    {
+        const int CHILDREN = 2000;
+        std::vector<std::atomic<int>> runs(CHILDREN);
+        for (std::atomic<int>& r : runs)
+            r.store(0);
+        SpawnJob spawn;
+        spawn.runs = runs.data();
+        spawn.children = CHILDREN;
+        spawn.parent = nullptr;
+        spawn.spawned.store(false);
+        Jobs::Run(Jobs::Create(SpawnJobMain, &spawn));
+        while (!spawn.spawned.load(std::memory_order_acquire))
+            std::this_thread::yield();
+        int before = 0;
+        for (std::atomic<int>& r : runs)
+            before += r.load(std::memory_order_relaxed) ? 1 : 0;
+        Jobs::Shutdown();
+        bool once = true;
+        for (std::atomic<int>& r : runs)
+            once &= r.load() == 1;
+        printf("  shutdown: %d of %d worker jobs left to the calling thread\n", CHILDREN - before, CHILDREN);
+        check("shutdown drains workers", once && spawn.parent && Jobs::IsDone(spawn.parent));
+    }
+
+    // Scaling: the same ParallelFor with 1 (no workers) .. max(2, cores) threads
+    const size_t COUNT = 1 << 21;
+    const int PASSES = 5;
+    std::vector<uint64_t> out(COUNT);
+    int maxThreads = std::max(2, cores);
+    double singleMs = 0.0;
+    uint64_t firstSum = 0;
+    bool agree = true;
+    printf("  %-8s %9s %9s %12s\n", "threads", "ms", "speedup", "ns/element");
+    for (int threads = 1; threads <= maxThreads; threads++)
+    {
+        if (threads > 1)
+            Jobs::Initialize(threads - 1);
+        double best = 0.0;
+        for (int pass = 0; pass < PASSES; pass++)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            Jobs::ParallelFor(COUNT, 4096, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++)
+                    out[i] = JobWork(i);
+            });
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            best = (pass == 0 || ms < best) ? ms : best;
+        }
+        uint64_t sum = 0;
+        for (uint64_t v : out)
+            sum += v;
+        if (threads == 1)
+        {
+            singleMs = best;
+            firstSum = sum;
+        }
+        agree &= sum == firstSum;
+        printf("  %-8d %9.2f %8.2fx %12.2f\n", threads, best, singleMs / best, best * 1e6 / COUNT);
+        if (threads > 1)
+            Jobs::Shutdown();
+    }
+    if (cores < 2)
+        printf("  (%d core: more than one thread is oversubscribed)\n", cores);
+    check("same result at every width", agree);
+
+    // Cost of a job: ParallelFor with one element per chunk
+    Jobs::Initialize(std::max(1, cores - 1));
+    const size_t TINY = 1000;
+    std::atomic<uint64_t> tinySum(0);
+    int rounds = std::max(10, frames / 10);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+        Jobs::ParallelFor(TINY, 1, [&](size_t begin, size_t end) {
+            tinySum.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count() / (rounds * TINY);
+    printf("  overhead: %.0f ns per job (create + run + finish, %d worker(s))\n", ns, Jobs::GetWorkerCount());
+    check("every tiny job ran", tinySum.load() == (uint64_t)rounds * TINY);
+    Jobs::Shutdown();
+
+    printf("  %s\n", failures ? "JOB CHECKS FAILED" : "all job checks passed");
+}
+
+// Software rasterization of each scenario's last frame: what the DX11 path will have to
+// fill, single-threaded vs tiled on the job system, and (OVERLAY_GOLDEN_DIR set) a
+// comparison against reference images recorded by an earlier run
+static void RunRaster(int frames)
+{
+    static const int RENDERS = 20;
+    static const uint32_t CLEAR_COLOR = IM_COL32(32, 36, 44, 255);
+    const char* goldenDir = getenv("OVERLAY_GOLDEN_DIR");
+
+    Raster::Target target;
+    Raster::Resize(target, (int)DISPLAY_W, (int)DISPLAY_H, true);
+    Raster::Target golden;
+    int failures = 0;
+
+    printf("\nraster: last of %d frames, %dx%d tiles of %d px, %d renders each\n",
+        WARMUP_FRAMES + frames, (target.width + Raster::TILE_SIZE - 1) / Raster::TILE_SIZE,
+        (target.height + Raster::TILE_SIZE - 1) / Raster::TILE_SIZE, Raster::TILE_SIZE, RENDERS);
+    printf("%-14s %7s %7s %6s %10s %9s %8s %9s %9s %10s %s\n",
+        "scenario", "tris", "culled", "tiles", "fragments", "overdraw", "setup", "1 thread", "jobs", "hash", "golden");
+
+    for (const Scenario& scenario : g_Scenarios)
+    {
+        scenario.setup();
+        for (int i = 0; i < WARMUP_FRAMES + frames; i++)
+            RunFrame(scenario, i);
+        ImDrawData* drawData = ImGui::GetDrawData();
+
+        // Same draw data, with and without worker threads: the image must not change
+        double ms[2] = {};
+        uint32_t hash[2] = {};
+        for (int pass = 0; pass < 2; pass++)
+        {
+            if (pass == 1)
+                Jobs::Initialize();
+            for (int i = 0; i < RENDERS; i++)
+            {
+                Raster::Clear(target, CLEAR_COLOR);
+                auto start = std::chrono::steady_clock::now();
+                Raster::RenderDrawData(drawData, target);
+                ms[pass] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            ms[pass] /= RENDERS;
+            hash[pass] = Raster::Hash(target);
+            if (pass == 1)
+                Jobs::Shutdown();
+        }
+        Raster::Stats stats = Raster::GetStats();
+
+        char path[512];
+        snprintf(path, sizeof(path), "%s/raster_%s.tga", BENCH_OUTPUT_DIR, scenario.name);
+        Raster::WriteTGA(target, path);
+        snprintf(path, sizeof(path), "%s/raster_%s_overdraw.tga", BENCH_OUTPUT_DIR, scenario.name);
+        Raster::WriteOverdrawTGA(target, path);
+
+        char result[64] = "-";
+        if (goldenDir)
+        {
+            snprintf(path, sizeof(path), "%s/raster_%s.tga", goldenDir, scenario.name);
+            if (Raster::ReadTGA(golden, path))
+            {
+                long long different = (long long)Raster::Compare(target, golden, 2);
+                snprintf(result, sizeof(result), different == 0 ? "ok" : "FAIL (%lld px)", different);
+                failures += different != 0;
+            }
+            else
+            {
+                snprintf(result, sizeof(result), Raster::WriteTGA(target, path) ? "recorded" : "FAIL (write)");
+            }
+        }
+        if (hash[0] != hash[1])
+        {
+            snprintf(result, sizeof(result), "FAIL (threads)");
+            failures++;
+        }
+
+        printf("%-14s %7llu %7llu %6d %10llu %8.2fx %8.3f %9.3f %9.3f %08x  %s\n",
+            scenario.name, (unsigned long long)stats.triangles, (unsigned long long)stats.culled,
+            stats.tilesTouched, (unsigned long long)stats.fragments,
+            stats.covered ? (double)stats.fragments / stats.covered : 0.0,
+            stats.setupMs, ms[0], ms[1], hash[1], result);
+    }
+
+    printf("  overdraw = fragments / covered pixels; images in %s/raster_*.tga\n", BENCH_OUTPUT_DIR);
+    if (goldenDir)
+        printf("  %s\n", failures ? "GOLDEN IMAGE CHECKS FAILED" : "golden images match");
+}
+
+static double Percentile(std::vector<double>& values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static int g_CommandCalls = 0;
+static Console::Commands::Args g_CommandArgs;
+
+static void BenchCommand(const Console::Commands::Args& args, void*)
+{
+    g_CommandCalls++;
+    g_CommandArgs = args;
+}
+
+// Tokenizer on a copy of the line: number of tokens, or -1
+static int TokenizeCopy(const char* line, Console::Commands::Token* tokens, char* buffer)
+{
+    snprintf(buffer, Console::Commands::MAX_LINE, "%s", line);
+    return Console::Commands::Tokenize(buffer, tokens, Console::Commands::MAX_TOKENS);
+}
+
+static bool TokenIs(const Console::Commands::Token& token, const char* text, bool quoted)
+{
+    return token.quoted == quoted && token.length == strlen(text) && strcmp(token.text, text) == 0;
+}
+
+// Arguments of line parsed against signature
+static bool Parse(const char* signature, const char* line, Console::Commands::Args& args, char* error)
+{
+    using namespace Console::Commands;
+    char buffer[MAX_LINE];
+    Token tokens[MAX_TOKENS];
+    int count = TokenizeCopy(line, tokens, buffer);
+    error[0] = '\0';
+    return count >= 0 && ParseArgs(signature, tokens, count, args, error, 128);
+}
+
+// Completion of a partial command line: resulting text and number of matches
+static bool Completes(const char* partial, const char* expected, int matches)
+{
+    char buffer[Console::Commands::MAX_LINE];
+    snprintf(buffer, sizeof(buffer), "%s", partial);
+    return Console::Commands::Complete(buffer, sizeof(buffer)) == matches && strcmp(buffer, expected) == 0;
+}
+
+// Console command line (modules/console/commands.h): tokenizer, argument parsing against
+// signatures, name completion over the commands the DLL registers, and the cost of Execute
+static void RunCommands(int frames)
+{
+    using namespace Console::Commands;
+    printf("\ncommands: tokenizer, argument parser, completion\n");
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+
+    // Same set as hkPresent: builtins come from Console::Initialize
+    Perf::RegisterCommands();
+    Anim::RegisterCommands();
+    Text::RegisterCommands();
+    Fonts::RegisterCommands();
+    Audio::RegisterCommands();
+    Settings::RegisterCommands();
+    Objects::RegisterCommands();
+    Signatures::RegisterCommands();
+
+    char buffer[MAX_LINE];
+    Token tokens[MAX_TOKENS];
+    int count = TokenizeCopy("  sig.scan\t\"48 8B ?? \\\"x\\\" \\\\ y\"  42 ", tokens, buffer);
+    check("tokenize: quotes, escapes", count == 3 && TokenIs(tokens[0], "sig.scan", false) &&
+        TokenIs(tokens[1], "48 8B ?? \"x\" \\ y", true) && TokenIs(tokens[2], "42", false));
+    count = TokenizeCopy("echo \"\" a\"b\"", tokens, buffer);
+    check("tokenize: empty quoted", count == 3 && TokenIs(tokens[1], "", true) && TokenIs(tokens[2], "a\"b\"", false));
+    check("tokenize: blank line", TokenizeCopy(" \t ", tokens, buffer) == 0);
+    check("tokenize: unterminated quote", TokenizeCopy("echo \"open", tokens, buffer) < 0);
+    check("tokenize: token limit", TokenizeCopy("a 1 2 3 4 5 6 7 8", tokens, buffer) == MAX_TOKENS &&
+        TokenizeCopy("a 1 2 3 4 5 6 7 8 9", tokens, buffer) < 0);
+
+    Args args;
+    char error[128];
+    check("parse: all types", Parse("ifbs", "0x2A -1.5 OFF text", args, error) && args.count == 4 &&
+        args.GetInt(0) == 42 && args.GetFloat(1) == -1.5 && !args.GetBool(2) && strcmp(args.GetString(3), "text") == 0);
+    check("parse: bool spellings", Parse("bbbb", "yes On true 1", args, error) &&
+        args.GetBool(0) && args.GetBool(1) && args.GetBool(2) && args.GetBool(3));
+    check("parse: bad int", !Parse("i", "12abc", args, error) && strstr(error, "expected int"));
+    check("parse: int overflow", !Parse("i", "99999999999999999999", args, error));
+    check("parse: bad bool", !Parse("b", "maybe", args, error) && strstr(error, "expected bool"));
+    check("parse: optional omitted", Parse("s|i", "name", args, error) && args.count == 1 && args.GetInt(1, 7) == 7);
+    check("parse: missing argument", !Parse("s|i", "", args, error) && strstr(error, "missing argument 1"));
+    check("parse: too many arguments", !Parse("s|i", "a 1 2", args, error) && strstr(error, "too many"));
+
+    // Names moved out of Perf are still registered, once
+    static const char* const MODULE_COMMANDS[] = { "anim", "text.cache", "font", "audio", "settings",
+        "objects", "sig", "sig.scan", "perf", "sched", "alloc", "log.stats" };
+    bool registered = true;
+    for (const char* name : MODULE_COMMANDS)
+        registered &= Find(name, strlen(name)) != nullptr;
+    check("register: module commands", registered);
+    check("register: duplicate refused", !Register({ "anim", "", "", BenchCommand }));
+    check("register: bad name refused", !Register({ "Bad Name", "", "", BenchCommand }));
+
+    check("complete: unique", Completes("sig.s", "sig.scan ", 1));
+    check("complete: common prefix", Completes("SCHED.B", "sched.budget ", 1) && Completes("si", "sig", 2));
+    check("complete: no match", Completes("xyz", "xyz", 0) && Completes("sig x", "sig x", 0));
+
+    // Execute: arguments reach the handler, errors never call it
+    Register({ "bench.cmd", "ifb|s", "overlay_bench parser check", BenchCommand });
+    g_CommandCalls = 0;
+    bool executed = Execute("bench.cmd 42 1.5 on \"quoted text\"");
+    check("execute: handler called", executed && g_CommandCalls == 1 && g_CommandArgs.count == 4 &&
+        g_CommandArgs.GetInt(0) == 42 && strcmp(g_CommandArgs.GetString(3), "quoted text") == 0);
+    check("execute: errors rejected", !Execute("bench.cmd 42") && !Execute("bench.nope") &&
+        !Execute("bench.cmd 1 2 maybe") && g_CommandCalls == 1);
+    Console::Update();
+
+    int calls = std::max(100000, frames * 50);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++)
+        Execute("bench.cmd 42 1.5 on \"quoted text\"");
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("  Execute with 4 arguments: %.1f ns/call, %d commands registered\n", seconds * 1e9 / calls, GetCount());
+    check("execute: every call", g_CommandCalls == calls + 1);
+
+    printf("  %s\n", failures ? "COMMANDS CHECKS FAILED" : "all commands checks passed");
+}
+
+// Console open with a fixed history, only wheel scrolling (no new messages)
+static void ConsoleScrollFrame(ImGuiIO& io, int frame)
+{
+    io.AddMousePosEvent(400.0f, 200.0f);
+    if (frame % 60 < 30)
+        io.AddMouseWheelEvent(0.0f, (frame % 60 < 15) ? 3.0f : -3.0f);
+}
+
+// Console::Render with 1k / 10k / 100k lines of history: the list clipper submits only the
+// visible rows, so the frame time and draw data must not grow with the history
+static void RunConsoleScale(int frames)
+{
+    printf("\nconsole-scale: Console::Render with a fixed history, wheel scrolling\n");
+
+    int failures = 0;
+    auto check = [&failures](const char* name, bool ok) {
+        failures += ok ? 0 : 1;
+        printf("  %-28s %s\n", name, ok ? "ok" : "FAIL");
+    };
+
+    static const int LINES[] = { 1000, 10000, 100000 };
+    const int SIZES = sizeof(LINES) / sizeof(LINES[0]);
+    const Scenario scenario = { "console-scale", "", nullptr, ConsoleScrollFrame };
+    double p50[SIZES];
+    int vertices[SIZES];
+
+    g_ShowMenu = false;
+    if (!Console::IsOpen())
+        Console::Toggle();
+
+    std::vector<double> times;
+    times.reserve(frames);
+    printf("  %-10s %8s %8s %8s %8s %8s\n", "lines", "avg ms", "p50", "p99", "max", "vtx");
+    for (int s = 0; s < SIZES; s++)
+    {
+        FillConsole(LINES[s]);
+        for (int i = 0; i < WARMUP_FRAMES; i++)
+            RunFrame(scenario, i);
+
+        times.clear();
+        double total = 0.0;
+        uint64_t vtx = 0;
+        for (int i = 0; i < frames; i++)
+        {
+            FrameSample sample = RunFrame(scenario, WARMUP_FRAMES + i);
+            times.push_back(sample.ms);
+            total += sample.ms;
+            vtx += sample.vertices;
+        }
+
+        double maxMs = *std::max_element(times.begin(), times.end());
+        p50[s] = Percentile(times, 0.50);
+        vertices[s] = (int)(vtx / frames);
+        printf("  %-10d %8.4f %8.4f %8.4f %8.4f %8d\n", LINES[s], total / frames, p50[s],
+            Percentile(times, 0.99), maxMs, vertices[s]);
+    }
+
+    // Same visible page at every size: a few digits more per line, no more rows
+    check("draw data flat", vertices[SIZES - 1] < vertices[0] * 1.2);
+    check("frame time flat (< 3x)", p50[SIZES - 1] < p50[0] * 3.0);
+
+    // Long and multi-line messages keep their full text; the line count is taken at
+    // arrival, newlines coming from deferred arguments are flattened to keep it exact
+    Console::Clear();
+    std::string longText(150, 'a');
+    longText += '\n' + std::string(150, 'b') + '\n' + std::string(140, 'c') + " tail";
+    Console::Log("%s", longText.c_str());
+    CONSOLE_LOG("[Bench] deferred %s", "split\nargument");
+    for (int i = 0; i < 100; i++)
+        Console::Log("[Bench] line %d\nsecond half", i);
+    Console::Update();
+    for (int i = 0; i < 8; i++)
+        RunFrame(scenario, i);
+    Console::LogView full = {}, deferred = {}, last = {};
+    bool found = Console::GetMessage(0, full) && Console::GetMessage(1, deferred) && Console::GetMessage(101, last);
+    check("long text kept", found && full.length == longText.size() && full.lines == 3 &&
+        memcmp(full.text, longText.data(), longText.size()) == 0);
+    check("multi-line counted", found && deferred.lines == 1 && !memchr(deferred.text, '\n', deferred.length) &&
+        last.lines == 2);
+
+    Console::Clear();
+    Console::Toggle();
+    printf("  %s\n", failures ? "CONSOLE-SCALE CHECKS FAILED" : "all console-scale checks passed");
+}
+
+int main(int argc, char** argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 2000;
+    const char* filter = argc > 2 ? argv[2] : nullptr;
+    if (frames <= 0)
+        frames = 2000;
+
+    Memory::InstallImGuiAllocator();
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.BackendPlatformName = "headless";
+    io.BackendRendererName = "headless";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.DisplaySize = ImVec2(DISPLAY_W, DISPLAY_H);
+    ImGui::StyleColorsDark();
+    LoadFontAtlas(io.Fonts);
+
+    Console::SetStdoutMirror(false);
+    Console::Initialize();
+    RegisterHUDTasks();
+
+    printf("overlay_bench: %d frames per scenario (+%d warm-up), %.0fx%.0f\n\n",
+        frames, WARMUP_FRAMES, DISPLAY_W, DISPLAY_H);
+    printf("%-14s %8s %8s %8s %8s %8s %8s %6s %10s %10s %10s\n",
+        "scenario", "avg ms", "p50", "p99", "max", "vtx", "idx", "cmds", "allocs/f", "bytes/f", "malloc/f");
+
+    std::vector<double> times;
+    times.reserve(frames);
+    double firstFrameMs = -1.0;
+
+    for (const Scenario& scenario : g_Scenarios)
+    {
+        if (filter && !strstr(scenario.name, filter))
+            continue;
+
+        scenario.setup();
+        for (int i = 0; i < WARMUP_FRAMES; i++)
+        {
+            // The very first frame also builds the font atlas and loads glyphs
+            FrameSample sample = RunFrame(scenario, i);
+            if (firstFrameMs < 0.0)
+                firstFrameMs = sample.ms;
+        }
+
+        times.clear();
+        double total = 0.0;
+        uint64_t vertices = 0, indices = 0, commands = 0, allocations = 0, bytes = 0, mallocs = 0;
+        for (int i = 0; i < frames; i++)
+        {
+            FrameSample sample = RunFrame(scenario, WARMUP_FRAMES + i);
+            times.push_back(sample.ms);
+            total += sample.ms;
+            vertices += sample.vertices;
+            indices += sample.indices;
+            commands += sample.commands;
+            allocations += sample.allocations;
+            bytes += sample.bytes;
+            mallocs += sample.mallocs;
+        }
+
+        double maxMs = *std::max_element(times.begin(), times.end());
+        double p50 = Percentile(times, 0.50);
+        double p99 = Percentile(times, 0.99);
+        printf("%-14s %8.4f %8.4f %8.4f %8.4f %8llu %8llu %6llu %10.2f %10.1f %10.2f\n",
+            scenario.name, total / frames, p50, p99, maxMs,
+            (unsigned long long)(vertices / frames), (unsigned long long)(indices / frames),
+            (unsigned long long)(commands / frames),
+            (double)allocations / frames, (double)bytes / frames, (double)mallocs / frames);
+    }
+
+    Fonts::Stats fonts = Fonts::GetStats();
+    if (firstFrameMs >= 0.0)
+    {
+        printf("\nfirst frame %.3f ms, font atlas: %s, glyphs %llu from blob / %llu rasterized\n",
+            firstFrameMs, fonts.prebaked ? "prebaked" : "stb_truetype (no " FONT_ATLAS_BLOB ")",
+            (unsigned long long)fonts.loaded, (unsigned long long)fonts.rasterized);
+    }
+
+    if (!filter || strstr("console-scale", filter))
+        RunConsoleScale(frames);
+    if (!filter || strstr("commands", filter))
+        RunCommands(frames);
+    if (!filter || strstr("audio", filter))
+        RunAudio(frames);
+    if (!filter || strstr("settings", filter))
+        RunSettings(frames);
+    if (!filter || strstr("scheduler", filter))
+        RunScheduler(frames);
+    if (!filter || strstr("input", filter))
+        RunInput(frames);
+    if (!filter || strstr("log", filter))
+        RunLog(frames);
+    if (!filter || strstr("log-sink", filter))
+        RunLogSink(frames);
+    if (!filter || strstr("objects", filter))
+        RunObjects(frames);
+    if (!filter || strstr("signatures", filter))
+        RunSignatures();
+    if (!filter || strstr("jobs", filter))
+        RunJobs(frames);
+    if (!filter || strstr("raster", filter))
+        RunRaster(std::min(frames, 300));
+
+    printf("\n");
+    for (const Scenario& scenario : g_Scenarios)
+        printf("  %-14s %s\n", scenario.name, scenario.description);
+
+    Console::Cleanup();
+    Raster::Shutdown();
+    ImGui::DestroyContext();
+    return 0;
+}